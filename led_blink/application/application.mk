@@ -6,14 +6,18 @@
 export WRAP_DIR			=	$(APP_DIR)wrapper/
 export MSM_DIR			=	$(APP_DIR)msm/
 export API_DIR			=	$(APP_DIR)api/
+export UTIL_DIR			=	$(APP_DIR)utility/
+export DRV_DIR			=	$(APP_DIR)driver/
 export GLOBAL_INCLUDES	=	-I$(CORE_RTOS_DIR)inc \
 							-I$(CMSIS_RTOS_DIR)inc \
 							-I$(CMSIS_DEV_DIR)inc \
 							-I$(LLDRIVER_DIR)inc \
 							-I$(WRAP_DIR)inc \
 							-I$(MSM_DIR)inc \
+							-I$(UTIL_DIR)inc \
+							-I$(DRV_DIR)inc \
 
-.PHONY				: application cleanapplication api cleanapi wrap cleanwrap msm cleanmsm
+.PHONY				: application cleanapplication api cleanapi wrap cleanwrap msm cleanmsm util cleanutil drv cleandrv
 
 api					:
 	make -C $(API_DIR) && make -C $(API_DIR) install
@@ -33,7 +37,19 @@ msm					:
 cleanmsm			:
 	make -C $(MSM_DIR) clean
 
-application			: api wrap msm
+util				:
+	make -C $(UTIL_DIR) all && make -C $(UTIL_DIR) install
+
+cleanutil			:
+	make -C $(UTIL_DIR) clean
+
+drv					:
+	make -C $(DRV_DIR) all && make -C $(DRV_DIR) install
+
+cleandrv			:
+	make -C $(DRV_DIR) clean
+
+application			: api wrap msm util drv
     
-cleanapplication	: cleanapi cleanwrap cleanmsm
+cleanapplication	: cleanapi cleanwrap cleanmsm cleanutil cleandrv
 
@@ -0,0 +1,395 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        adc_bench.c
+ * @brief       host benchmark of the timer triggered ADC acquisition driver.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_adc.c against the register model on ADC1 with four inputs and
+ * blocks of 128 passes. The benchmark plays the ADC: every timer period it
+ * writes one synthetic result per rank to DR and serves the DMA request,
+ * which raises the half and full transfer interrupts. A result carries the
+ * number of its pass and its rank, so the consumer checks that every block
+ * it got intact holds whole passes in rank order and that the next block
+ * follows it, or follows it by as many blocks as the driver counted as
+ * dropped.
+ *
+ * The consumer thread holds each block for a share of the block time and
+ * may look for the next one only some blocks later. Slow and late
+ * consumers must see their overwritten and dropped blocks reported, an
+ * injected ADC overrun must restart the acquisition.
+ *
+ * 16x oversampling in hardware is compared with the same output made by
+ * summing in software: the ADC then delivers 16 times the passes, the
+ * blocks fill 16 times as fast and the CPU adds every result. The handler,
+ * thread wake and add times are assumptions for an 80 MHz Cortex-M4 given
+ * on the command line. Run "make" in this directory, then
+ * ./adc_bench [seconds] [isr us] [thread wake us] [add ns].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "periph_model.h"
+#include "drv_adc.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_HCLK          (80000000U)
+#define BENCH_INPUTS        (4U)
+#define BENCH_PASSES        (128U)      /*!< passes of a block */
+#define BENCH_RATE          (50000U)    /*!< Hz of the output passes */
+#define BENCH_RATIO         (16U)
+#define BENCH_PASS_MASK     (0xFFFU)    /*!< pass number bits of a result */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    const char* name;
+    uint32_t    ratio;      /* hardware oversampling */
+    uint32_t    shift;
+    uint32_t    sum;        /* passes the consumer adds into one */
+    double      hold;       /* block times the consumer holds a block */
+    double      lag;        /* block times the consumer sleeps after a release */
+    uint32_t    overrun;    /* blocks between injected overruns, 0 none */
+}BENCH_MODE;
+
+typedef struct
+{
+    double      ns;         /* run time */
+    uint64_t    results;    /* results the DMA moved */
+    uint32_t    irqs;       /* block interrupts */
+    uint32_t    wakes;      /* consumer wakes */
+    uint32_t    torn;       /* releases that reported an overwrite */
+    uint32_t    gaps;       /* blocks missing between consecutive acquires */
+    uint32_t    injected;   /* overruns */
+}BENCH_RUN;
+
+typedef struct
+{
+    ADC_BLOCK   block;
+    int         holding;
+    uint32_t    overruns;   /* driver overruns when the block was acquired */
+    double      until;      /* end of the hold */
+    double      look;       /* next look for a block */
+    uint32_t    last_seq;   /* block released before */
+    uint32_t    last_pass;  /* its last pass */
+    int         last_valid; /* it was intact */
+    uint32_t    last_overruns;
+}BENCH_CONSUMER;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static ADC          g_Adc;
+static uint16_t     g_Buffer[2U * BENCH_PASSES * BENCH_INPUTS];
+static const ADC_INPUT g_Inputs[BENCH_INPUTS] =
+{
+    { 4U, GPIOC, 3U },      /* ARD A2 */
+    { 3U, GPIOC, 2U },      /* ARD A3 */
+    { 2U, GPIOC, 1U },      /* ARD A4 */
+    { 1U, GPIOC, 0U }       /* ARD A5 */
+};
+static uint32_t     g_Errors    =   0;
+static volatile uint32_t g_Sum  =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+void DMA1_Channel1_IRQHandler   (void)
+{
+    adc_dma_handler(&g_Adc);
+}
+
+void ADC1_2_IRQHandler  (void)
+{
+    adc_irq_handler(&g_Adc);
+}
+
+/* what the ADC delivers for a rank of a pass */
+static uint16_t bench_result    (
+    uint32_t    pass,
+    uint32_t    rank    )
+{
+    return (uint16_t)(((pass & BENCH_PASS_MASK) << 4) | rank);
+}
+
+static int bench_setup  (
+    const BENCH_MODE*   mode    )
+{
+    ADC_CONFIG  config;
+
+    memset(&config, 0, sizeof(config));
+    config.inputs   =   g_Inputs;
+    config.count    =   BENCH_INPUTS;
+    config.sampling =   LL_ADC_SAMPLINGTIME_6CYCLES_5;
+    config.ratio    =   mode->ratio;
+    config.shift    =   mode->shift;
+    config.rate     =   BENCH_RATE * mode->sum;
+    config.hclk     =   BENCH_HCLK;
+    config.tim_clk  =   BENCH_HCLK;
+    config.buffer   =   g_Buffer;
+    config.passes   =   BENCH_PASSES;
+    config.priority =   5U;
+    if( (0 != adc_init(&g_Adc, &g_AdcPortAdc1, &config)) || (0 != adc_start(&g_Adc)) )
+    {
+        return (-1);
+    }
+    model_sync();
+    return (0);
+}
+
+/* whole passes in rank order, following the block released before */
+static void bench_check (
+    BENCH_CONSUMER*     consumer,
+    uint32_t            sum     )
+{
+    const ADC_BLOCK*    block   =   &consumer->block;
+    uint32_t            first   =   block->data[0] >> 4;
+    uint32_t            expect  =   0;
+    uint32_t            total   =   0;
+    uint32_t            i;
+
+    if( (consumer->last_valid) && (consumer->overruns == consumer->last_overruns) )
+    {
+        expect  =   consumer->last_pass + 1U + (block->seq - consumer->last_seq - 1U) * BENCH_PASSES;
+        if(first != (expect & BENCH_PASS_MASK))
+        {
+            g_Errors++;
+        }
+    }
+    for(i = 0; i < block->size; i++)
+    {
+        if(block->data[i] != bench_result(first + i / BENCH_INPUTS, i % BENCH_INPUTS))
+        {
+            g_Errors++;
+            break;
+        }
+    }
+    /* the software oversampling the hardware saves */
+    for(i = 0; (sum > 1U) && (i < block->size); i++)
+    {
+        total   +=  block->data[i];
+    }
+    g_Sum                   =   total;
+    consumer->last_pass     =   first + BENCH_PASSES - 1U;
+    consumer->last_valid    =   1;
+}
+
+/* the consumer thread at time now */
+static void bench_consume   (
+    BENCH_CONSUMER*     consumer,
+    BENCH_RUN*          run,
+    const BENCH_MODE*   mode,
+    double              now,
+    double              block_ns,
+    double              wake_ns )
+{
+    if( (consumer->holding) && (now >= consumer->until) )
+    {
+        /* read during the hold, the release tells whether that was intact */
+        if(0 == adc_release(&g_Adc, &consumer->block))
+        {
+            bench_check(consumer, mode->sum);
+        }
+        else
+        {
+            run->torn++;
+            consumer->last_valid    =   0;
+        }
+        consumer->last_seq      =   consumer->block.seq;
+        consumer->last_overruns =   consumer->overruns;
+        consumer->holding       =   0;
+        consumer->look          =   now + mode->lag * block_ns;
+    }
+    if( (!consumer->holding) && (now >= consumer->look) && (g_Adc.ready >= 0) )
+    {
+        if(0 != adc_acquire(&g_Adc, &consumer->block, 0))
+        {
+            g_Errors++;
+            return;
+        }
+        run->wakes++;
+        run->gaps           +=  consumer->block.seq - consumer->last_seq - 1U;
+        consumer->overruns  =   g_Adc.stats.overruns;
+        consumer->holding   =   1;
+        consumer->until     =   now + wake_ns + mode->hold * block_ns;
+    }
+}
+
+/* one timer period: the ADC converts the sequence, the DMA moves the results */
+static void bench_pass  (
+    BENCH_RUN*          run,
+    const BENCH_MODE*   mode,
+    uint32_t            pass,
+    uint32_t*           inject  )
+{
+    uint32_t    rank;
+
+    if( (!(TIM15->CR1 & TIM_CR1_CEN)) || (!(ADC1->CR & ADC_CR_ADSTART)) )
+    {
+        return;
+    }
+    for(rank = 0; rank < BENCH_INPUTS; rank++)
+    {
+        if( (mode->overrun) && (1U == rank) && (g_Adc.stats.blocks >= *inject) )
+        {
+            /* the DMA missed the result of the second rank, ISR is write one to clear */
+            ADC1->ISR   |=  ADC_ISR_OVR;
+            (void)model_raise(ADC1_2_IRQn);
+            ADC1->ISR   =   0;
+            *inject     =   g_Adc.stats.blocks + mode->overrun;
+            run->injected++;
+            return;
+        }
+        ADC1->DR    =   bench_result(pass, rank);
+        if(!model_dma_transfer(DMA1, LL_DMA_CHANNEL_1))
+        {
+            g_Errors++;
+            return;
+        }
+        run->results++;
+    }
+}
+
+static void bench_run   (
+    const BENCH_MODE*   mode,
+    double              seconds,
+    double              isr_ns,
+    double              wake_ns,
+    double              add_ns  )
+{
+    MODEL_IRQ_STATS irq;
+    ADC_STATS       stats;
+    BENCH_RUN       run;
+    BENCH_CONSUMER  consumer;
+    double          period  =   1e9 / (BENCH_RATE * mode->sum);
+    double          block_ns    =   period * BENCH_PASSES;
+    double          load    =   0.0;
+    uint32_t        inject  =   mode->overrun;
+    uint32_t        pass    =   0;
+    uint32_t        errors  =   g_Errors;
+
+    memset(&run, 0, sizeof(run));
+    memset(&consumer, 0, sizeof(consumer));
+    if(0 != bench_setup(mode))
+    {
+        fprintf(stderr, "%s: adc_init failed\n", mode->name);
+        g_Errors++;
+        return;
+    }
+    model_irq_stats(DMA1_Channel1_IRQn, &irq);
+    while(run.ns < seconds * 1e9)
+    {
+        run.ns  +=  period;
+        bench_pass(&run, mode, pass++, &inject);
+        bench_consume(&consumer, &run, mode, run.ns, block_ns, wake_ns);
+    }
+    adc_stop(&g_Adc);
+    if(consumer.holding)
+    {
+        consumer.until  =   run.ns;
+        consumer.look   =   run.ns + 1e9;
+        bench_consume(&consumer, &run, mode, run.ns, block_ns, wake_ns);
+    }
+    adc_stats(&g_Adc, &stats);
+    model_irq_stats(DMA1_Channel1_IRQn, &irq);
+    run.irqs    =   (uint32_t)irq.count;
+    load        =   run.irqs * isr_ns + run.wakes * wake_ns + ((mode->sum > 1U) ? run.results * add_ns : 0.0);
+    printf("%-10s %9.0f %10.0f %9.1f %9.0f %8.2f%% %8u %8u %8u %8.0f\n", mode->name,
+           (double)(run.results / BENCH_INPUTS) * 1e9 / run.ns,
+           (double)run.results * mode->ratio * 1e9 / run.ns,
+           stats.blocks * 1e9 / run.ns, run.irqs * 1e9 / run.ns, 100.0 * load / run.ns,
+           stats.dropped, stats.overwritten, stats.overruns,
+           irq.count ? (double)irq.ns / irq.count : 0.0);
+    /* every block acquired or dropped, the drops are the gaps in the numbers */
+    if( (stats.blocks != stats.acquired + stats.dropped) || (stats.acquired != run.wakes) ||
+        (run.gaps + (stats.blocks - consumer.last_seq) != stats.dropped) ||
+        (run.torn != stats.overwritten) || (run.injected != stats.overruns) || (stats.errors) )
+    {
+        g_Errors++;
+    }
+    if(g_Errors != errors)
+    {
+        fprintf(stderr, "%s: %u wrong\n", mode->name, g_Errors - errors);
+    }
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    static const BENCH_MODE modes[] =
+    {
+        /* name         ratio        shift sum          hold  lag   overrun */
+        { "hw 16x",     BENCH_RATIO, 4U,   1U,          0.5,  0.0,  0U  },
+        { "sw 16x",     1U,          0U,   BENCH_RATIO, 0.5,  0.0,  0U  },
+        { "slow",       BENCH_RATIO, 4U,   1U,          1.5,  0.0,  0U  },
+        { "late",       BENCH_RATIO, 4U,   1U,          0.2,  2.5,  0U  },
+        { "overrun",    BENCH_RATIO, 4U,   1U,          0.5,  0.0,  7U  }
+    };
+    double      seconds =   (argc > 1) ? atof(argv[1]) : 1.0;
+    double      isr_us  =   (argc > 2) ? atof(argv[2]) : 1.5;
+    double      wake_us =   (argc > 3) ? atof(argv[3]) : 10.0;
+    double      add_ns  =   (argc > 4) ? atof(argv[4]) : 25.0;
+    uint32_t    i;
+
+    if( (seconds <= 0.0) || (isr_us < 0.0) || (wake_us < 0.0) || (add_ns < 0.0) )
+    {
+        fprintf(stderr, "usage: adc_bench [seconds] [isr us] [thread wake us] [add ns]\n");
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(DMA1_Channel1_IRQn, DMA1_Channel1_IRQHandler);
+    model_attach(ADC1_2_IRQn, ADC1_2_IRQHandler);
+
+    printf("ADC1 %u inputs, %u passes per block, %u Hz output, %.1f s per mode, isr %.1f us, "
+           "thread wake %.1f us, add %.0f ns\n", BENCH_INPUTS, BENCH_PASSES, BENCH_RATE, seconds,
+           isr_us, wake_us, add_ns);
+    printf("%-10s %9s %10s %9s %9s %9s %8s %8s %8s %8s\n", "", "passes/s", "conv/s", "blocks/s",
+           "irqs/s", "cpu load", "dropped", "overwr", "overrun", "host ns");
+    for(i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        bench_run(&modes[i], seconds, isr_us * 1e3, wake_us * 1e3, add_ns);
+    }
+    printf("%u wrong\n", g_Errors);
+    return (g_Errors) ? 1 : 0;
+}
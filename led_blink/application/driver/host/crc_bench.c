@@ -0,0 +1,483 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        crc_bench.c
+ * @brief       host cross check and benchmark of the CRC engine and the software CRC.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_crc.c against the register model. The benchmark plays the CRC
+ * unit bit by bit as the reference manual describes it, the polynomial
+ * size, the input reversal, INIT and RESET, and feeds it every item the
+ * DMA channel moves to DR.
+ *
+ * First the check values of the catalogue, "123456789", with the tables and
+ * bit by bit. Then random buffers at every alignment, short and long
+ * enough for several DMA blocks, must give the same CRC through the unit,
+ * with the tables and bit by bit, for algorithms the unit has and some it
+ * has not. A call that times out must stop the DMA and leave the engine
+ * usable.
+ *
+ * The throughput of the software on this host is measured, bit by bit,
+ * one table a byte and slicing by 8. For the target the time of a call is
+ * worked out from assumed costs on an 80 MHz Cortex-M4: cycles per byte
+ * of the tables, DMA cycles per item, the handler and the thread wake.
+ * Run "make" in this directory, then
+ * ./crc_bench [MB] [table cycles/byte] [dma cycles/item] [isr us] [thread wake us].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "periph_model.h"
+#include "drv_crc.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_HCLK          (80000000.0)
+#define BENCH_BUFFER        (300000U)   /*!< more than one block of words */
+#define BENCH_CASES         (400U)      /*!< random buffers per algorithm */
+#define BENCH_DMA_MIN       (256U)
+#define BENCH_SETUP_US      (2.0)       /*!< crc_begin and crc_end around the DMA */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    const char*     name;
+    CRC_SPEC        spec;
+    uint32_t        check;          /* CRC of "123456789" */
+}BENCH_ALGO;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static CRC_ENGINE   g_Engine;
+static CRC_SOFT     g_Soft;
+static uint8_t      g_Data[BENCH_BUFFER + 8U];
+static uint32_t     g_Unit      =   0;      /* register of the CRC unit */
+static uint32_t     g_Random    =   0x2545F491U;
+static uint32_t     g_Errors    =   0;
+static volatile uint32_t g_Sink =   0;
+
+static const BENCH_ALGO g_Algos[] =
+{
+    /* name             width poly         init         refin refout xorout     check */
+    { "CRC-32",         { 32U, 0x04C11DB7U, 0xFFFFFFFFU, 1U,   1U,    0xFFFFFFFFU }, 0xCBF43926U },
+    { "CRC-32C",        { 32U, 0x1EDC6F41U, 0xFFFFFFFFU, 1U,   1U,    0xFFFFFFFFU }, 0xE3069283U },
+    { "CRC-32/BZIP2",   { 32U, 0x04C11DB7U, 0xFFFFFFFFU, 0,    0,     0xFFFFFFFFU }, 0xFC891918U },
+    { "CRC-16/CCITT",   { 16U, 0x1021U,     0xFFFFU,     0,    0,     0           }, 0x29B1U     },
+    { "CRC-16/MODBUS",  { 16U, 0x8005U,     0xFFFFU,     1U,   1U,    0           }, 0x4B37U     },
+    { "CRC-16/RIELLO",  { 16U, 0x1021U,     0xB2AAU,     1U,   1U,    0           }, 0x63D0U     },
+    { "CRC-8/SMBUS",    { 8U,  0x07U,       0,           0,    0,     0           }, 0xF4U       },
+    { "CRC-7/MMC",      { 7U,  0x09U,       0,           0,    0,     0           }, 0x75U       },
+    { "CRC-12/UMTS",    { 12U, 0x80FU,      0,           0,    1U,    0           }, 0xDAFU      },
+    { "CRC-5/USB",      { 5U,  0x05U,       0x1FU,       1U,   1U,    0x1FU       }, 0x19U       }
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+void DMA2_Channel3_IRQHandler   (void)
+{
+    crc_dma_handler(&g_Engine);
+}
+
+static uint64_t bench_ns    (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bench_random    (void)
+{
+    g_Random    ^=  g_Random << 13;
+    g_Random    ^=  g_Random >> 17;
+    g_Random    ^=  g_Random << 5;
+    return g_Random;
+}
+
+/* width of the unit from POLYSIZE */
+static uint32_t bench_unit_width    (void)
+{
+    static const uint32_t   widths[4]   =   { 32U, 16U, 8U, 7U };
+
+    return widths[(CRC->CR & CRC_CR_POLYSIZE) >> CRC_CR_POLYSIZE_Pos];
+}
+
+static uint32_t bench_reverse   (
+    uint32_t    value,
+    uint32_t    bits    )
+{
+    uint32_t    out =   0;
+    uint32_t    i;
+
+    for(i = 0; i < bits; i++)
+    {
+        out     =   (out << 1) | (value & 1U);
+        value   >>= 1;
+    }
+    return out;
+}
+
+/* RESET loads INIT, DR reads the register */
+static void bench_unit_sync (void)
+{
+    uint32_t    width   =   bench_unit_width();
+    uint32_t    mask    =   (32U == width) ? 0xFFFFFFFFU : ((1U << width) - 1U);
+
+    if(CRC->CR & CRC_CR_RESET)
+    {
+        g_Unit  =   CRC->INIT & mask;
+        CRC->CR &=  ~CRC_CR_RESET;
+        CRC->DR =   g_Unit;
+    }
+}
+
+/* an access of bytes to DR: reversed as REV_IN says, taken from its top bit */
+static void bench_unit_feed (
+    uint32_t    value,
+    uint32_t    bytes   )
+{
+    uint32_t    width   =   bench_unit_width();
+    uint32_t    mask    =   (32U == width) ? 0xFFFFFFFFU : ((1U << width) - 1U);
+    uint32_t    top     =   1U << (width - 1U);
+    uint32_t    bits    =   bytes * 8U;
+    uint32_t    chunk   =   0;
+    uint32_t    out     =   0;
+    uint32_t    bit     =   0;
+    uint32_t    i;
+
+    switch((CRC->CR & CRC_CR_REV_IN) >> CRC_CR_REV_IN_Pos)
+    {
+        case 1U:    chunk   =   8U;     break;
+        case 2U:    chunk   =   16U;    break;
+        case 3U:    chunk   =   32U;    break;
+        default:    chunk   =   0;      break;
+    }
+    if(chunk > bits)
+    {
+        chunk   =   bits;
+    }
+    for(i = 0; (chunk) && (i < bits); i += chunk)
+    {
+        out |=  bench_reverse(value >> i, chunk) << i;
+    }
+    value   =   chunk ? out : value;
+    for(i = bits; i > 0; i--)
+    {
+        bit     =   (value >> (i - 1U)) & 1U;
+        if( ((g_Unit & top) ? 1U : 0U) ^ bit )
+        {
+            g_Unit  =   ((g_Unit << 1) ^ CRC->POL) & mask;
+        }
+        else
+        {
+            g_Unit  =   (g_Unit << 1) & mask;
+        }
+    }
+    CRC->DR =   g_Unit;
+}
+
+/* serve the memory to memory channel until it stops */
+static void bench_dma   (void)
+{
+    DMA_Channel_TypeDef*    channel =   DMA2_Channel3;
+    uint32_t                bytes   =   0;
+
+    for(;;)
+    {
+        bench_unit_sync();
+        bytes   =   1U << ((channel->CCR & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+        if(!model_dma_transfer(DMA2, 3U))
+        {
+            return;
+        }
+        bench_unit_feed((4U == bytes) ? CRC->DR : (CRC->DR & 0xFFU), bytes);
+    }
+}
+
+/* the engine on the model */
+static int bench_engine (
+    const CRC_SOFT*     soft,
+    const uint8_t*      data,
+    uint32_t            size,
+    uint32_t*           crc )
+{
+    if(0 != crc_begin(&g_Engine, soft, data, size))
+    {
+        return (-1);
+    }
+    bench_dma();
+    return crc_end(&g_Engine, 0, crc);
+}
+
+static void bench_check (
+    const char*     what,
+    int             ok  )
+{
+    printf("  %-44s %s\n", what, ok ? "ok" : "WRONG");
+    if(!ok)
+    {
+        g_Errors++;
+    }
+}
+
+/* check values, then random buffers through every path */
+static void bench_verify    (
+    const BENCH_ALGO*   algo    )
+{
+    CRC_STATS   before;
+    CRC_STATS   after;
+    uint32_t    bitwise =   0;
+    uint32_t    tables  =   0;
+    uint32_t    unit    =   0;
+    uint32_t    split   =   0;
+    uint32_t    offset  =   0;
+    uint32_t    size    =   0;
+    uint32_t    reg     =   0;
+    uint32_t    wrong   =   0;
+    uint32_t    i;
+
+    (void)crc_soft_init(&g_Soft, &algo->spec);
+    crc_stats(&g_Engine, &before);
+    bitwise =   crc_soft_final(&algo->spec, crc_soft_bitwise(&algo->spec, crc_soft_start(&algo->spec), "123456789", 9U));
+    tables  =   crc_soft_calc(&g_Soft, "123456789", 9U);
+    if( (bitwise != algo->check) || (tables != algo->check) )
+    {
+        wrong++;
+    }
+    for(i = 0; i < BENCH_CASES; i++)
+    {
+        offset  =   bench_random() & 7U;
+        switch(i % 4U)
+        {
+            case 0:     size    =   bench_random() % 64U;               break;
+            case 1:     size    =   bench_random() % 4096U;             break;
+            case 2:     size    =   bench_random() % 65536U;            break;
+            default:    size    =   (3U == i % 40U) ? BENCH_BUFFER : (bench_random() % 300U);   break;
+        }
+        bitwise =   crc_soft_final(&algo->spec, crc_soft_bitwise(&algo->spec, crc_soft_start(&algo->spec),
+                                                                 &g_Data[offset], size));
+        tables  =   crc_soft_calc(&g_Soft, &g_Data[offset], size);
+        /* the tables go on from a register in plain order */
+        reg     =   crc_soft_update(&g_Soft, crc_soft_start(&algo->spec), &g_Data[offset], size / 3U);
+        reg     =   crc_soft_from_plain(&algo->spec, crc_soft_to_plain(&algo->spec, reg));
+        split   =   crc_soft_final(&algo->spec, crc_soft_update(&g_Soft, reg, &g_Data[offset + size / 3U],
+                                                                size - size / 3U));
+        if( (0 != bench_engine(&g_Soft, &g_Data[offset], size, &unit)) || (unit != bitwise) ||
+            (tables != bitwise) || (split != bitwise) )
+        {
+            wrong++;
+        }
+    }
+    crc_stats(&g_Engine, &after);
+    printf("  %-14s check %08X  %4u by the unit, %4u with the tables, %5u blocks  %s\n", algo->name, algo->check,
+           after.dma - before.dma, after.soft - before.soft, after.blocks - before.blocks, wrong ? "WRONG" : "ok");
+    g_Errors    +=  wrong;
+}
+
+/* the engine gives up on a transfer that does not end and works on */
+static void bench_timeout   (void)
+{
+    CRC_STATS   stats;
+    uint32_t    crc     =   0;
+    int         ok      =   0;
+
+    (void)crc_soft_init(&g_Soft, &g_CrcSpec32);
+    printf("timeout\n");
+    ok  =   (0 == crc_begin(&g_Engine, &g_Soft, g_Data, BENCH_BUFFER)) &&
+            (0 != crc_begin(&g_Engine, &g_Soft, g_Data, 16U)) && (0 != crc_end(&g_Engine, 0, &crc));
+    crc_stats(&g_Engine, &stats);
+    bench_check("a call that does not end times out", ok && (1U == stats.timeouts));
+    bench_check("the DMA channel is stopped", !(DMA2_Channel3->CCR & DMA_CCR_EN));
+    ok  =   (0 == bench_engine(&g_Soft, g_Data, BENCH_BUFFER, &crc)) &&
+            (crc == crc_soft_calc(&g_Soft, g_Data, BENCH_BUFFER));
+    bench_check("the next call is right", ok);
+    bench_check("crc_end without crc_begin fails", 0 != crc_end(&g_Engine, 0, &crc));
+}
+
+/* one table a byte, what the frame checks did before */
+static uint32_t bench_bytewise  (
+    const CRC_SOFT*     soft,
+    uint32_t            reg,
+    const uint8_t*      p,
+    uint32_t            size    )
+{
+    const uint32_t*     t   =   soft->table[0];
+
+    if(soft->spec.refin)
+    {
+        for(; size > 0; size--, p++)
+        {
+            reg =   t[(reg ^ *p) & 0xFFU] ^ (reg >> 8);
+        }
+    }
+    else
+    {
+        for(; size > 0; size--, p++)
+        {
+            reg =   t[(reg >> 24) ^ *p] ^ (reg << 8);
+        }
+    }
+    return reg;
+}
+
+/* MB/s of the software on this host */
+static void bench_host  (
+    const CRC_SPEC*     spec,
+    const char*         name,
+    double              megabytes   )
+{
+    uint64_t    total   =   (uint64_t)(megabytes * 1e6);
+    uint64_t    done    =   0;
+    uint64_t    start   =   0;
+    double      rate[3];
+    uint32_t    reg     =   0;
+    uint32_t    path;
+
+    (void)crc_soft_init(&g_Soft, spec);
+    for(path = 0; path < 3U; path++)
+    {
+        /* bit by bit is slow, an eighth of the data does */
+        uint64_t    bytes   =   (0U == path) ? total / 8U : total;
+
+        reg     =   crc_soft_start(spec);
+        start   =   bench_ns();
+        for(done = 0; done < bytes; done += 65536U)
+        {
+            switch(path)
+            {
+                case 0:     reg =   crc_soft_bitwise(spec, reg, g_Data, 65536U);         break;
+                case 1:     reg =   bench_bytewise(&g_Soft, reg, g_Data, 65536U);        break;
+                default:    reg =   crc_soft_update(&g_Soft, reg, g_Data, 65536U);       break;
+            }
+        }
+        rate[path]  =   done * 1e3 / (double)(bench_ns() - start);
+        g_Sink      =   reg;
+    }
+    printf("  %-14s %10.1f %10.1f %10.1f\n", name, rate[0], rate[1], rate[2]);
+}
+
+/* time of a call on the target from the assumed costs */
+static void bench_target    (
+    double      table_cycles,
+    double      dma_cycles,
+    double      isr_us,
+    double      wake_us )
+{
+    static const uint32_t   sizes[] =   { 16U, 64U, 256U, 1024U, 4096U, 65536U, 1048576U };
+    double      soft_us     =   0.0;
+    double      words_us    =   0.0;
+    double      bytes_us    =   0.0;
+    double      cpu_us      =   0.0;
+    uint32_t    blocks      =   0;
+    uint32_t    i;
+
+    printf("%-10s %10s %10s %10s %10s %10s %10s\n", "bytes", "table us", "word dma", "byte dma",
+           "table MB/s", "word MB/s", "word cpu us");
+    for(i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        blocks      =   (sizes[i] + 4U * 65535U - 1U) / (4U * 65535U);
+        soft_us     =   sizes[i] * table_cycles / BENCH_HCLK * 1e6;
+        cpu_us      =   BENCH_SETUP_US + blocks * isr_us + wake_us;
+        words_us    =   cpu_us + (sizes[i] / 4U) * dma_cycles / BENCH_HCLK * 1e6;
+        bytes_us    =   BENCH_SETUP_US + ((sizes[i] + 65534U) / 65535U) * isr_us + wake_us +
+                        sizes[i] * dma_cycles / BENCH_HCLK * 1e6;
+        printf("%-10u %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", sizes[i], soft_us, words_us, bytes_us,
+               sizes[i] / soft_us, sizes[i] / words_us, cpu_us);
+    }
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    CRC_CONFIG  config;
+    double      megabytes   =   (argc > 1) ? atof(argv[1]) : 64.0;
+    double      table_cycles    =   (argc > 2) ? atof(argv[2]) : 5.0;
+    double      dma_cycles  =   (argc > 3) ? atof(argv[3]) : 6.0;
+    double      isr_us      =   (argc > 4) ? atof(argv[4]) : 1.5;
+    double      wake_us     =   (argc > 5) ? atof(argv[5]) : 10.0;
+    uint32_t    i;
+
+    if( (megabytes <= 0.0) || (table_cycles <= 0.0) || (dma_cycles <= 0.0) || (isr_us < 0.0) || (wake_us < 0.0) )
+    {
+        fprintf(stderr, "usage: crc_bench [MB] [table cycles/byte] [dma cycles/item] [isr us] [thread wake us]\n");
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(DMA2_Channel3_IRQn, DMA2_Channel3_IRQHandler);
+    memset(&config, 0, sizeof(config));
+    config.dma_min  =   BENCH_DMA_MIN;
+    config.priority =   6U;
+    if(0 != crc_init(&g_Engine, &g_CrcPortCrc, &config))
+    {
+        fprintf(stderr, "crc_init failed\n");
+        return 1;
+    }
+    model_sync();
+    for(i = 0; i < sizeof(g_Data); i++)
+    {
+        g_Data[i]   =   (uint8_t)bench_random();
+    }
+
+    printf("unit, tables and bit by bit, %u random buffers each, DMA from %u bytes\n", BENCH_CASES, BENCH_DMA_MIN);
+    for(i = 0; i < sizeof(g_Algos) / sizeof(g_Algos[0]); i++)
+    {
+        bench_verify(&g_Algos[i]);
+    }
+    bench_timeout();
+
+    printf("software on this host, MB/s\n");
+    printf("  %-14s %10s %10s %10s\n", "", "bitwise", "bytewise", "slice by 8");
+    bench_host(&g_CrcSpec32, "CRC-32", megabytes);
+    bench_host(&g_CrcSpec16Ccitt, "CRC-16/CCITT", megabytes);
+
+    printf("80 MHz target, tables %.1f cycles/byte, DMA %.1f cycles/item, isr %.1f us, thread wake %.1f us\n",
+           table_cycles, dma_cycles, isr_us, wake_us);
+    bench_target(table_cycles, dma_cycles, isr_us, wake_us);
+    printf("%u wrong\n", g_Errors);
+    return (g_Errors) ? 1 : 0;
+}
@@ -0,0 +1,616 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        dac_bench.c
+ * @brief       host checks of the wave tables and benchmark of the DMA DAC driver.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * First checks wavetable.c against libm: the sine, the tables of every
+ * shape, the table length and timer period found for a frequency and the
+ * phase accumulator.
+ *
+ * Then runs drv_dac.c against the register model on channel 1 at 50 kHz.
+ * The benchmark plays the DAC: every timer period it moves DHR12R1 to the
+ * output and serves the DMA request. It follows every output sample against
+ * the source it must come from: a table, or for a stream the samples the
+ * phase accumulator of the producer gives. A swap must go from the last
+ * sample of the old source straight to the first of the new one, samples
+ * of the old source played again are counted as glitches.
+ *
+ * The modes swap between two tables, with the DMA interrupt served in time
+ * and three samples late, stream with a producer that refills a half in a
+ * quarter or in one and a half half times, and swap between tables and a
+ * stream. Every fourth swap to a table is called off by a \ref dac_sync
+ * timeout, one DMA underrun is injected per mode.
+ *
+ * The CPU load is compared with writing the DAC from a timer interrupt per
+ * sample. The handler and thread wake times are assumptions for an 80 MHz
+ * Cortex-M4 given on the command line. Run "make" in this directory, then
+ * ./dac_bench [seconds] [isr us] [thread wake us].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "periph_model.h"
+#include "wavetable.h"
+#include "drv_dac.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_TIM_CLK       (80000000U)
+#define BENCH_PERIOD        (1600U)     /*!< 50 kHz */
+#define BENCH_RATE          (BENCH_TIM_CLK / BENCH_PERIOD)
+#define BENCH_SIZE_A        (50U)       /*!< 1 kHz */
+#define BENCH_SIZE_B        (120U)      /*!< 3 cycles, 1.25 kHz */
+#define BENCH_HALF          (128U)
+#define BENCH_SINE_BITS     (10U)
+#define BENCH_STREAM_MHZ    (1234500U)
+#define BENCH_EVERY         (2000U)     /*!< samples between swaps */
+
+#define BENCH_PI            (3.14159265358979323846)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    const char* name;
+    uint32_t    mix;        /* 0 table and table, 1 stream only, 2 table and stream */
+    uint32_t    defer;      /* samples until the DMA handler runs, 1 is before the next one */
+    double      wake;       /* half times the producer needs for a refill */
+}BENCH_MODE;
+
+/* the source a sample must come from */
+typedef struct
+{
+    const uint16_t* data;
+    uint32_t        size;
+    uint32_t        stream;
+    const uint16_t* next_data;
+    uint32_t        next_size;
+    uint32_t        next_stream;
+    uint32_t        has_next;
+    uint32_t        idx;        /* next sample of the source */
+    uint32_t        skip;       /* samples not checked, the held output */
+    uint32_t        restart;    /* an underrun restarts the source after the next sample */
+    uint32_t        boundary;   /* the old source ended, the new one is due */
+    WAVETABLE_NCO   nco;        /* stream samples */
+    WAVETABLE_NCO   next_nco;   /* of the stream swapped in, unplayed halves dropped */
+    uint64_t        checked;
+    uint32_t        stale;      /* stream samples not refilled in time */
+    uint32_t        glitches;   /* old samples played after the end of the source */
+}BENCH_REF;
+
+typedef struct
+{
+    WAVETABLE_NCO   nco;
+    uint16_t*       half;       /* taken, refilled at until */
+    uint64_t        until;
+    uint32_t        wakes;
+}BENCH_PRODUCER;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static DAC_OUT      g_Dac;
+static uint16_t     g_TableA[BENCH_SIZE_A];
+static uint16_t     g_TableB[BENCH_SIZE_B];
+static uint16_t     g_Sine[1U << BENCH_SINE_BITS];
+static uint16_t     g_Stream[2U * BENCH_HALF];
+static uint32_t     g_Defer     =   0;
+static uint32_t     g_Deferred  =   0;
+static uint32_t     g_Errors    =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+void DMA2_Channel4_IRQHandler   (void)
+{
+    if(g_Defer)
+    {
+        g_Deferred  =   g_Defer;
+        return;
+    }
+    dac_dma_handler(&g_Dac);
+}
+
+void TIM6_DAC_IRQHandler    (void)
+{
+    dac_irq_handler(&g_Dac);
+}
+
+static void bench_check (
+    const char*     what,
+    int             ok  )
+{
+    printf("  %-44s %s\n", what, ok ? "ok" : "WRONG");
+    if(!ok)
+    {
+        g_Errors++;
+    }
+}
+
+/* wavetable.c against libm */
+static void bench_tables    (void)
+{
+    static const uint32_t   freqs[] =   { 50U, 440000U, 1000000U, 12345678U, 100000000U };
+    static uint16_t         once[1000];
+    static uint16_t         chunks[1000];
+    WAVETABLE_SPEC          spec;
+    WAVETABLE_FIT           fit;
+    WAVETABLE_NCO           a;
+    WAVETABLE_NCO           b;
+    uint16_t                shape[8];
+    double                  worst   =   0.0;
+    double                  error   =   0.0;
+    uint32_t                phase   =   0;
+    uint32_t                step    =   0;
+    uint32_t                i;
+    uint32_t                n;
+    int                     ok      =   1;
+
+    printf("wave tables\n");
+    for(i = 0; i < 0x10000U; i++)
+    {
+        phase   =   i * 0x10001U + (i >> 3);
+        error   =   fabs(wavetable_sin(phase) - sin(2.0 * BENCH_PI * phase / 4294967296.0) * 1073741824.0);
+        worst   =   (error > worst) ? error : worst;
+    }
+    printf("  sine error %.0f / 2^30\n", worst);
+    bench_check("sine within 2^-20", worst < 1024.0);
+
+    memset(&spec, 0, sizeof(spec));
+    spec.shape      =   WAVETABLE_SINE;
+    spec.cycles     =   3U;
+    spec.amplitude  =   2000U;
+    spec.offset     =   2048U;
+    (void)wavetable_fill(g_Sine, 256U, &spec);
+    for(i = 0; i < 256U; i++)
+    {
+        error   =   g_Sine[i] - (2048.0 + 2000.0 * sin(2.0 * BENCH_PI * 3.0 * i / 256.0));
+        ok      =   ok && (fabs(error) <= 0.5 + 1e-6);
+    }
+    bench_check("sine table rounded", ok);
+
+    spec.cycles     =   1U;
+    spec.amplitude  =   1000U;
+    spec.shape      =   WAVETABLE_TRIANGLE;
+    (void)wavetable_fill(shape, 8U, &spec);
+    bench_check("triangle", (2048U == shape[0]) && (2548U == shape[1]) && (3048U == shape[2]) &&
+                            (2048U == shape[4]) && (1048U == shape[6]) && (1548U == shape[7]));
+    spec.shape      =   WAVETABLE_SQUARE;
+    spec.duty       =   0x4000U;
+    (void)wavetable_fill(shape, 8U, &spec);
+    bench_check("square, quarter duty", (3048U == shape[1]) && (1048U == shape[2]) && (1048U == shape[7]));
+    spec.shape      =   WAVETABLE_SAWTOOTH;
+    (void)wavetable_fill(shape, 8U, &spec);
+    bench_check("sawtooth", (1048U == shape[0]) && (1298U == shape[1]) && (2048U == shape[4]) && (2798U == shape[7]));
+    spec.amplitude  =   4095U;
+    spec.shape      =   WAVETABLE_SINE;
+    spec.phase      =   0x40000000U;
+    (void)wavetable_fill(shape, 8U, &spec);
+    bench_check("clamped to full scale", (4095U == shape[0]) && (0U == shape[4]));
+    spec.cycles     =   0U;
+    bench_check("no cycles refused", 0 != wavetable_fill(shape, 8U, &spec));
+
+    for(i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++)
+    {
+        if(0 != wavetable_fit(freqs[i], BENCH_TIM_CLK, 1000000U, 16U, 1024U, &fit))
+        {
+            printf("  %12.3f Hz: none\n", freqs[i] / 1000.0);
+            bench_check("fit refused out of range", (50U == freqs[i]) || (100000000U == freqs[i]));
+            continue;
+        }
+        error   =   fabs((double)fit.mhz - freqs[i]) / freqs[i];
+        printf("  %12.3f Hz: %4u samples x %5u clocks = %12.3f Hz\n", freqs[i] / 1000.0, fit.size, fit.period,
+               fit.mhz / 1000.0);
+        ok  =   (fit.size >= 16U) && (fit.size <= 1024U) && (fit.period >= BENCH_TIM_CLK / 1000000U) &&
+                (fit.period <= 0x10000U) && (error < 1e-3) &&
+                (fabs(1e3 * BENCH_TIM_CLK / ((double)fit.size * fit.period) - fit.mhz) <= 0.5);
+        bench_check("fit", ok);
+    }
+
+    bench_check("step of a quarter of the rate is 2^30",
+                0x40000000U == wavetable_nco_step(BENCH_RATE * 250U, BENCH_TIM_CLK, BENCH_PERIOD));
+    bench_check("no step at half the rate", 0U == wavetable_nco_step(BENCH_RATE * 500U, BENCH_TIM_CLK, BENCH_PERIOD));
+
+    spec.cycles     =   1U;
+    spec.amplitude  =   2000U;
+    spec.phase      =   0;
+    (void)wavetable_fill(g_Sine, 1U << BENCH_SINE_BITS, &spec);
+    step    =   wavetable_nco_step(BENCH_STREAM_MHZ, BENCH_TIM_CLK, BENCH_PERIOD);
+    (void)wavetable_nco_init(&a, g_Sine, 1U << BENCH_SINE_BITS, step);
+    (void)wavetable_nco_init(&b, g_Sine, 1U << BENCH_SINE_BITS, step);
+    wavetable_nco_fill(&a, once, 1000U);
+    for(i = 0, n = 1U; i < 1000U; i += n, n = n % 13U + 1U)
+    {
+        wavetable_nco_fill(&b, &chunks[i], (i + n > 1000U) ? (1000U - i) : n);
+    }
+    bench_check("accumulator in chunks", (0 == memcmp(once, chunks, sizeof(once))) && (a.phase == b.phase));
+    worst   =   0.0;
+    for(i = 0; i < 1000U; i++)
+    {
+        error   =   fabs(once[i] - (2048.0 + 2000.0 * sin(2.0 * BENCH_PI * (double)(uint32_t)(i * step) / 4294967296.0)));
+        worst   =   (error > worst) ? error : worst;
+    }
+    printf("  accumulator error %.2f LSB\n", worst);
+    bench_check("accumulator within 1 LSB", worst <= 1.0);
+}
+
+/* a table tells which it is by the lowest bit */
+static void bench_tag   (
+    uint16_t*       table,
+    uint32_t        size,
+    uint32_t        odd )
+{
+    uint32_t    i;
+
+    for(i = 0; i < size; i++)
+    {
+        table[i]    =   (uint16_t)((table[i] & ~1U) | odd);
+    }
+}
+
+static uint16_t bench_peek  (
+    const WAVETABLE_NCO*    accumulator,
+    const uint16_t*         data,
+    uint32_t                stream,
+    uint32_t                idx )
+{
+    WAVETABLE_NCO   nco     =   *accumulator;
+    uint16_t        sample  =   0;
+
+    if(!stream)
+    {
+        return data[idx];
+    }
+    wavetable_nco_fill(&nco, &sample, 1U);
+    return sample;
+}
+
+/* one output sample */
+static void bench_expect    (
+    BENCH_REF*      ref,
+    uint16_t        out )
+{
+    uint16_t    sample  =   0;
+
+    if(ref->skip)
+    {
+        ref->skip--;
+        return;
+    }
+    if(ref->idx == ref->size)
+    {
+        ref->idx        =   0;
+        ref->boundary   =   ref->has_next;
+    }
+    if(ref->boundary)
+    {
+        if(out != bench_peek(&ref->next_nco, ref->next_data, ref->next_stream, 0))
+        {
+            ref->glitches++;
+            return;
+        }
+        ref->data       =   ref->next_data;
+        ref->size       =   ref->next_size;
+        ref->stream     =   ref->next_stream;
+        ref->nco        =   ref->next_nco;
+        ref->has_next   =   0;
+        ref->boundary   =   0;
+    }
+    if(ref->stream)
+    {
+        wavetable_nco_fill(&ref->nco, &sample, 1U);
+        ref->stale  +=  (out != sample) ? 1U : 0U;
+    }
+    else if(out != ref->data[ref->idx])
+    {
+        g_Errors++;
+    }
+    ref->idx++;
+    ref->checked++;
+    if(ref->restart)
+    {
+        ref->idx        =   0;
+        ref->restart    =   0;
+    }
+}
+
+/* one timer period: the DAC converts, the DMA fetches the next sample */
+static int bench_trigger    (
+    uint16_t*       out )
+{
+    if( (g_Deferred) && (0 == --g_Deferred) )
+    {
+        dac_dma_handler(&g_Dac);
+    }
+    /* flags cleared outside model_raise go before the next ones are set */
+    model_sync();
+    if(!(TIM6->CR1 & TIM_CR1_CEN))
+    {
+        return 0;
+    }
+    *out        =   (uint16_t)(DAC1->DHR12R1 & 0xFFFU);
+    DAC1->DOR1  =   *out;
+    if(DAC1->CR & DAC_CR_DMAEN1)
+    {
+        (void)model_dma_transfer(DMA2, 4U);
+    }
+    return 1;
+}
+
+/* the producer thread at sample now */
+static void bench_produce   (
+    BENCH_PRODUCER*     producer,
+    uint64_t            now,
+    uint64_t            wake    )
+{
+    if( (producer->half) && (now >= producer->until) )
+    {
+        wavetable_nco_fill(&producer->nco, producer->half, BENCH_HALF);
+        (void)dac_stream_put(&g_Dac);
+        producer->half  =   NULL;
+    }
+    if( (!producer->half) && (g_Dac.half) && (g_Dac.free & (1U << g_Dac.fill)) )
+    {
+        producer->half  =   dac_stream_get(&g_Dac, 0);
+        producer->until =   now + wake;
+        producer->wakes++;
+        if(!producer->half)
+        {
+            g_Errors++;
+        }
+    }
+}
+
+/* ask for a source other than the one playing, every fourth table swap is called off */
+static void bench_request   (
+    BENCH_REF*          ref,
+    BENCH_PRODUCER*     producer,
+    const BENCH_MODE*   mode,
+    uint32_t            count,
+    uint32_t*           cancelled   )
+{
+    uint32_t        stream  =   ((2U == mode->mix) && (!ref->stream)) ? 1U : 0U;
+    uint32_t        a       =   ref->stream ? (count & 2U) : (ref->data != g_TableA);
+    const uint16_t* data    =   a ? g_TableA : g_TableB;
+    uint32_t        size    =   a ? BENCH_SIZE_A : BENCH_SIZE_B;
+    int             ret     =   0;
+
+    if(0 != dac_sync(&g_Dac, 0))
+    {
+        g_Errors++;
+    }
+    if(stream)
+    {
+        /* the stream was left with the table swapped in, it starts from a full buffer */
+        producer->half  =   NULL;
+        ref->next_nco   =   producer->nco;
+        wavetable_nco_fill(&producer->nco, g_Stream, 2U * BENCH_HALF);
+        data    =   g_Stream;
+        size    =   2U * BENCH_HALF;
+        stream  =   1U;
+        ret     =   dac_stream(&g_Dac, g_Stream, BENCH_HALF);
+    }
+    else
+    {
+        ret     =   dac_play(&g_Dac, data, size);
+    }
+    if( (0 != ret) || (0 == dac_play(&g_Dac, data, size)) )
+    {
+        g_Errors++;
+        return;
+    }
+    ref->next_data      =   data;
+    ref->next_size      =   size;
+    ref->next_stream    =   stream;
+    ref->has_next       =   1;
+    if( (!stream) && (3U == count % 4U) )
+    {
+        /* on the host the wait times out at once */
+        if(0 == dac_sync(&g_Dac, 0))
+        {
+            g_Errors++;
+        }
+        ref->has_next   =   0;
+        (*cancelled)++;
+    }
+}
+
+static void bench_run   (
+    const BENCH_MODE*   mode,
+    double              seconds,
+    double              isr_ns,
+    double              wake_ns )
+{
+    DAC_CONFIG      config;
+    DAC_STATS       stats;
+    MODEL_IRQ_STATS irq;
+    BENCH_REF       ref;
+    BENCH_PRODUCER  producer;
+    uint64_t        samples =   (uint64_t)(seconds * BENCH_RATE);
+    uint64_t        wake    =   (uint64_t)(mode->wake * BENCH_HALF);
+    uint64_t        now     =   0;
+    uint32_t        step    =   wavetable_nco_step(BENCH_STREAM_MHZ, BENCH_TIM_CLK, BENCH_PERIOD);
+    uint32_t        count   =   0;
+    uint32_t        cancelled   =   0;
+    uint32_t        injected    =   0;
+    uint32_t        pending     =   0;
+    uint32_t        errors  =   g_Errors;
+    uint16_t        out     =   0;
+    double          ns      =   0.0;
+    double          load    =   0.0;
+
+    memset(&config, 0, sizeof(config));
+    memset(&ref, 0, sizeof(ref));
+    memset(&producer, 0, sizeof(producer));
+    config.period   =   BENCH_PERIOD;
+    config.priority =   5U;
+    g_Defer         =   mode->defer;
+    g_Deferred      =   0;
+    if(0 != dac_init(&g_Dac, &g_DacPortOut1, &config))
+    {
+        fprintf(stderr, "%s: dac_init failed\n", mode->name);
+        g_Errors++;
+        return;
+    }
+    model_sync();
+    (void)wavetable_nco_init(&producer.nco, g_Sine, 1U << BENCH_SINE_BITS, step);
+    (void)wavetable_nco_init(&ref.nco, g_Sine, 1U << BENCH_SINE_BITS, step);
+    if(1U == mode->mix)
+    {
+        wavetable_nco_fill(&producer.nco, g_Stream, 2U * BENCH_HALF);
+        ref.data    =   g_Stream;
+        ref.size    =   2U * BENCH_HALF;
+        ref.stream  =   1U;
+        (void)dac_stream(&g_Dac, g_Stream, BENCH_HALF);
+    }
+    else
+    {
+        ref.data    =   g_TableA;
+        ref.size    =   BENCH_SIZE_A;
+        (void)dac_play(&g_Dac, g_TableA, BENCH_SIZE_A);
+    }
+    ref.skip    =   1U;
+    model_irq_stats(DMA2_Channel4_IRQn, &irq);
+    for(now = 1U; now <= samples; now++)
+    {
+        if(!bench_trigger(&out))
+        {
+            g_Errors++;
+            break;
+        }
+        bench_expect(&ref, out);
+        bench_produce(&producer, now, wake);
+        /* asked in the middle of a source, the swap is due at its end */
+        if( (1U != mode->mix) && (now >= (count + 1U) * (uint64_t)BENCH_EVERY) && (ref.idx == ref.size / 2U) )
+        {
+            bench_request(&ref, &producer, mode, count++, &cancelled);
+        }
+        /* a stream begins again from a stale half, only a table can be followed on */
+        if( (samples / 2U == now) && (!g_Dac.pending) && (!ref.stream) )
+        {
+            /* the DMA missed a request, the DAC flags it in SR, which is write one to clear */
+            DAC1->SR    =   DAC_SR_DMAUDR1;
+            (void)model_raise(TIM6_DAC_IRQn);
+            DAC1->SR    =   0;
+            ref.restart =   1U;
+            injected++;
+        }
+    }
+    pending =   g_Dac.pending;
+    dac_stop(&g_Dac);
+    dac_stats(&g_Dac, &stats);
+    model_irq_stats(DMA2_Channel4_IRQn, &irq);
+    ns      =   samples * 1e9 / BENCH_RATE;
+    load    =   irq.count * isr_ns + producer.wakes * wake_ns;
+    printf("%-12s %8.0f %8.2f%% %8.2f%% %6u %6u %6u %6u %6u %6u %8.0f\n", mode->name,
+           irq.count * 1e9 / ns, 100.0 * load / ns, 100.0 * BENCH_RATE * isr_ns / 1e9,
+           stats.swaps, stats.late, ref.glitches, stats.halves, stats.underflows, ref.stale,
+           irq.count ? (double)irq.ns / irq.count : 0.0);
+    /* swaps on time are seamless, late ones replay the defer less one samples */
+    if( (stats.swaps + cancelled + pending != count) || (stats.underruns != injected) || (stats.errors) ||
+        (ref.glitches != stats.late * (mode->defer - 1U)) ||
+        ((mode->defer > 1U) ? ((0U == stats.swaps) || (stats.late != stats.swaps)) : (0U != stats.late)) || ((mode->wake < 1.0) != (0U == stats.underflows)) ||
+        ((0U == stats.underflows) != (0U == ref.stale)) || (ref.checked + ref.glitches + 1U != samples) )
+    {
+        g_Errors++;
+    }
+    if(g_Errors != errors)
+    {
+        fprintf(stderr, "%s: %u wrong\n", mode->name, g_Errors - errors);
+    }
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    static const BENCH_MODE modes[] =
+    {
+        /* name             mix  defer wake */
+        { "tables",         0U,  0U,   0.0  },
+        { "tables late",    0U,  3U,   0.0  },
+        { "stream",         1U,  0U,   0.25 },
+        { "stream slow",    1U,  0U,   1.5  },
+        { "mixed",          2U,  1U,   0.25 }
+    };
+    WAVETABLE_SPEC  spec;
+    double          seconds =   (argc > 1) ? atof(argv[1]) : 1.0;
+    double          isr_us  =   (argc > 2) ? atof(argv[2]) : 1.5;
+    double          wake_us =   (argc > 3) ? atof(argv[3]) : 10.0;
+    uint32_t        i;
+
+    if( (seconds <= 0.0) || (isr_us < 0.0) || (wake_us < 0.0) )
+    {
+        fprintf(stderr, "usage: dac_bench [seconds] [isr us] [thread wake us]\n");
+        return 1;
+    }
+    bench_tables();
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(DMA2_Channel4_IRQn, DMA2_Channel4_IRQHandler);
+    model_attach(TIM6_DAC_IRQn, TIM6_DAC_IRQHandler);
+
+    memset(&spec, 0, sizeof(spec));
+    spec.shape      =   WAVETABLE_SINE;
+    spec.cycles     =   1U;
+    spec.amplitude  =   2000U;
+    spec.offset     =   2048U;
+    (void)wavetable_fill(g_TableA, BENCH_SIZE_A, &spec);
+    spec.shape      =   WAVETABLE_TRIANGLE;
+    spec.cycles     =   3U;
+    (void)wavetable_fill(g_TableB, BENCH_SIZE_B, &spec);
+    bench_tag(g_TableA, BENCH_SIZE_A, 0);
+    bench_tag(g_TableB, BENCH_SIZE_B, 1U);
+
+    printf("DAC1 channel 1 at %u Hz, tables of %u and %u samples, stream halves of %u, %.1f s per mode, "
+           "isr %.1f us, thread wake %.1f us\n", BENCH_RATE, BENCH_SIZE_A, BENCH_SIZE_B, BENCH_HALF, seconds,
+           isr_us, wake_us);
+    printf("%-12s %8s %9s %9s %6s %6s %6s %6s %6s %6s %8s\n", "", "irqs/s", "cpu load", "per smpl",
+           "swaps", "late", "glitch", "halves", "underf", "stale", "host ns");
+    for(i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        bench_run(&modes[i], seconds, isr_us * 1e3, wake_us * 1e3);
+    }
+    printf("%u wrong\n", g_Errors);
+    return (g_Errors) ? 1 : 0;
+}
@@ -0,0 +1,268 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        freertos_host.c
+ * @brief       single threaded stand in for the kernel calls the drivers make.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Stream buffers with the zero copy calls, critical sections that only
+ * count their nesting and the thread flags of one thread. Nothing blocks:
+ * a call that would wait returns what is there, a delay returns at once
+ * after the register model caught up with what the driver wrote.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "cmsis_os2.h"
+#include "periph_model.h"
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* lives in the StaticStreamBuffer_t of the caller */
+typedef struct
+{
+    uint8_t*    storage;
+    size_t      size;       /* storage bytes, one more than the capacity */
+    size_t      head;       /* next byte to write */
+    size_t      tail;       /* next byte to read */
+    size_t      trigger;
+}HOST_STREAM;
+
+typedef char host_stream_fits[(sizeof(HOST_STREAM) <= sizeof(StaticStreamBuffer_t)) ? 1 : -1];
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static UBaseType_t  g_HostCritical  =   0;
+static uint32_t     g_HostFlags     =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Bytes held
+ * @param[in]           s               stream
+ * @return              bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static size_t host_used (
+    const HOST_STREAM*  s   )
+{
+    return (s->head + s->size - s->tail) % s->size;
+}
+
+/** 
+ * @brief               Describe a part of the ring as up to two spans
+ * @param[in]           s               stream
+ * @param[in]           from            first byte
+ * @param[in]           count           bytes
+ * @param[out]          spans           spans
+ * @return              count
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static size_t host_spans    (
+    const HOST_STREAM*      s,
+    size_t                  from,
+    size_t                  count,
+    StreamBufferSpans_t*    spans   )
+{
+    size_t  first   =   s->size - from;
+
+    if(first > count)
+    {
+        first   =   count;
+    }
+    spans->pucData[0]   =   &s->storage[from];
+    spans->xLength[0]   =   first;
+    spans->pucData[1]   =   s->storage;
+    spans->xLength[1]   =   count - first;
+    return count;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+StreamBufferHandle_t xStreamBufferGenericCreateStatic   (
+    size_t                          xBufferSizeBytes,
+    size_t                          xTriggerLevelBytes,
+    BaseType_t                      xIsMessageBuffer,
+    uint8_t * const                 pucStreamBufferStorageArea,
+    StaticStreamBuffer_t * const    pxStaticStreamBuffer    )
+{
+    HOST_STREAM*    s   =   (HOST_STREAM*)pxStaticStreamBuffer;
+
+    if( (xIsMessageBuffer) || (!pucStreamBufferStorageArea) || (!s) || (0 == xBufferSizeBytes) )
+    {
+        return NULL;
+    }
+    memset(s, 0, sizeof(HOST_STREAM));
+    s->storage  =   pucStreamBufferStorageArea;
+    s->size     =   xBufferSizeBytes + 1U;
+    s->trigger  =   xTriggerLevelBytes;
+    return (StreamBufferHandle_t)s;
+}
+
+size_t xStreamBufferBytesAvailable  (
+    StreamBufferHandle_t            xStreamBuffer   )
+{
+    return host_used((HOST_STREAM*)xStreamBuffer);
+}
+
+size_t xStreamBufferAcquireWriteFromISR (
+    StreamBufferHandle_t            xStreamBuffer,
+    StreamBufferSpans_t*            pxSpans )
+{
+    HOST_STREAM*    s   =   (HOST_STREAM*)xStreamBuffer;
+
+    return host_spans(s, s->head, s->size - 1U - host_used(s), pxSpans);
+}
+
+size_t xStreamBufferCommitWriteFromISR  (
+    StreamBufferHandle_t            xStreamBuffer,
+    size_t                          xCount,
+    BaseType_t * const              pxHigherPriorityTaskWoken   )
+{
+    HOST_STREAM*    s   =   (HOST_STREAM*)xStreamBuffer;
+
+    s->head =   (s->head + xCount) % s->size;
+    if(pxHigherPriorityTaskWoken)
+    {
+        *pxHigherPriorityTaskWoken  =   (host_used(s) >= s->trigger) ? pdTRUE : pdFALSE;
+    }
+    return xCount;
+}
+
+size_t xStreamBufferAcquireRead (
+    StreamBufferHandle_t            xStreamBuffer,
+    StreamBufferSpans_t*            pxSpans,
+    TickType_t                      xTicksToWait    )
+{
+    HOST_STREAM*    s   =   (HOST_STREAM*)xStreamBuffer;
+
+    (void)xTicksToWait;
+    return host_spans(s, s->tail, host_used(s), pxSpans);
+}
+
+size_t xStreamBufferReleaseRead (
+    StreamBufferHandle_t            xStreamBuffer,
+    size_t                          xCount  )
+{
+    HOST_STREAM*    s   =   (HOST_STREAM*)xStreamBuffer;
+
+    s->tail =   (s->tail + xCount) % s->size;
+    return xCount;
+}
+
+size_t xStreamBufferReceive (
+    StreamBufferHandle_t            xStreamBuffer,
+    void*                           pvRxData,
+    size_t                          xBufferLengthBytes,
+    TickType_t                      xTicksToWait    )
+{
+    StreamBufferSpans_t spans;
+    size_t              count   =   xStreamBufferAcquireRead(xStreamBuffer, &spans, xTicksToWait);
+    size_t              first   =   0;
+
+    if(count > xBufferLengthBytes)
+    {
+        count   =   xBufferLengthBytes;
+    }
+    first   =   (spans.xLength[0] < count) ? spans.xLength[0] : count;
+    memcpy(pvRxData, spans.pucData[0], first);
+    memcpy((uint8_t*)pvRxData + first, spans.pucData[1], count - first);
+    return xStreamBufferReleaseRead(xStreamBuffer, count);
+}
+
+void vPortEnterCritical (void)
+{
+    g_HostCritical++;
+}
+
+void vPortExitCritical  (void)
+{
+    g_HostCritical--;
+}
+
+osStatus_t osDelay    (
+    uint32_t    ticks   )
+{
+    (void)ticks;
+    model_sync();
+    return osOK;
+}
+
+osThreadId_t osThreadGetId  (void)
+{
+    return (osThreadId_t)&g_HostFlags;
+}
+
+uint32_t osThreadFlagsSet   (
+    osThreadId_t                    thread_id,
+    uint32_t                        flags   )
+{
+    (void)thread_id;
+    g_HostFlags |=  flags;
+    return g_HostFlags;
+}
+
+uint32_t osThreadFlagsClear (
+    uint32_t                        flags   )
+{
+    uint32_t    old =   g_HostFlags;
+
+    g_HostFlags &=  ~flags;
+    return old;
+}
+
+uint32_t osThreadFlagsWait  (
+    uint32_t                        flags,
+    uint32_t                        options,
+    uint32_t                        timeout )
+{
+    uint32_t    got =   g_HostFlags & flags;
+
+    (void)options;
+    (void)timeout;
+    if(0 == got)
+    {
+        return (uint32_t)osErrorTimeout;
+    }
+    g_HostFlags &=  ~got;
+    return got;
+}
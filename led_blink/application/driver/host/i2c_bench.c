@@ -0,0 +1,491 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        i2c_bench.c
+ * @brief       host benchmark of the I2C DMA driver.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_i2c.c against the register model on I2C2 at 400 kHz. The
+ * bench plays the I2C peripheral, counting NBYTES down one byte per step,
+ * and the five sensors of the board as register files with auto increment.
+ * A batch reads all five after writing the register address, plus 600
+ * FIFO bytes of the LSM6DSL that need NBYTES reloads, as one chain with a
+ * done call on the last descriptor only. Every byte read is checked.
+ * Then a probe of an absent address, an SCL timeout in the middle of a
+ * transaction, a stuck bus and aborts check the error paths.
+ *
+ * The CPU time is the interrupt count times an assumed handler time plus
+ * the assumed thread wakes, compared with one thread wake per read and
+ * with a polled driver that is busy for the bus time. Run "make" in this
+ * directory, then ./i2c_bench [batches] [isr us] [thread wake us].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "periph_model.h"
+#include "drv_i2c.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_BIT_NS        (2500.0)    /*!< 400 kHz */
+#define BENCH_SENSORS       (5U)
+#define BENCH_READS         (6U)
+#define BENCH_FIFO          (600U)
+#define BENCH_RATE          (50.0)      /*!< batches per second for the load figures */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    uint32_t    address;
+    uint8_t     regs[256];
+    uint8_t     ptr;
+}BENCH_SENSOR;
+
+typedef struct
+{
+    int         active;
+    int         read;
+    int         first;      /* next written byte is the register address */
+    uint32_t    count;      /* of NBYTES */
+    BENCH_SENSOR*   sensor;
+}BENCH_BUS;
+
+typedef struct
+{
+    uint8_t     reg;
+    uint32_t    size;
+    uint32_t    sensor;
+}BENCH_READ;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static I2C          g_I2c;
+static BENCH_BUS    g_Bus;
+static BENCH_SENSOR g_Sensors[BENCH_SENSORS] =
+{
+    { 0x5FU, {0}, 0 },      /* HTS221 */
+    { 0x5DU, {0}, 0 },      /* LPS22HB */
+    { 0x6AU, {0}, 0 },      /* LSM6DSL */
+    { 0x1EU, {0}, 0 },      /* LIS3MDL */
+    { 0x29U, {0}, 0 }       /* VL53L0X */
+};
+static const BENCH_READ g_Reads[BENCH_READS] =
+{
+    { 0x28U, 4U,  0U },     /* humidity and temperature */
+    { 0x28U, 5U,  1U },     /* pressure and temperature */
+    { 0x22U, 12U, 2U },     /* gyroscope and accelerometer */
+    { 0x28U, 6U,  3U },     /* magnetometer */
+    { 0x14U, 12U, 4U },     /* range status */
+    { 0x3EU, BENCH_FIFO, 2U }   /* FIFO */
+};
+static I2C_XFER     g_Xfers[BENCH_READS];
+static uint8_t      g_Regs[BENCH_READS];
+static uint8_t      g_Data[BENCH_READS][BENCH_FIFO];
+static double       g_BusNs     =   0.0;
+static uint32_t     g_Wakes     =   0;
+static uint32_t     g_Errors    =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+void I2C2_EV_IRQHandler (void)
+{
+    i2c_ev_handler(&g_I2c);
+}
+
+void I2C2_ER_IRQHandler (void)
+{
+    i2c_er_handler(&g_I2c);
+}
+
+void DMA1_Channel4_IRQHandler   (void)
+{
+    i2c_dma_handler(&g_I2c);
+}
+
+void DMA1_Channel5_IRQHandler   (void)
+{
+    i2c_dma_handler(&g_I2c);
+}
+
+static void bench_wake  (
+    I2C_XFER*   xfer    )
+{
+    (void)xfer;
+    g_Wakes++;
+}
+
+static BENCH_SENSOR* bench_sensor   (
+    uint32_t    address )
+{
+    uint32_t    i;
+
+    for(i = 0; i < BENCH_SENSORS; i++)
+    {
+        if(g_Sensors[i].address == address)
+        {
+            return &g_Sensors[i];
+        }
+    }
+    return NULL;
+}
+
+/* flag an event and take the interrupt */
+static void bench_event (
+    uint32_t    flag    )
+{
+    I2C2->ISR   |=  flag;
+    (void)model_raise(I2C2_EV_IRQn);
+}
+
+static void bench_stop  (void)
+{
+    g_BusNs         +=  BENCH_BIT_NS;
+    g_Bus.active    =   0;
+    I2C2->CR2       &=  ~I2C_CR2_STOP;
+    bench_event(I2C_ISR_STOPF);
+}
+
+/* NBYTES reached zero: reload, STOP or wait for the software */
+static void bench_count_end (void)
+{
+    uint32_t    cr2 =   I2C2->CR2;
+
+    if(cr2 & I2C_CR2_RELOAD)
+    {
+        bench_event(I2C_ISR_TCR);
+        I2C2->ISR   &=  ~I2C_ISR_TCR;
+        g_Bus.count =   (I2C2->CR2 & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos;
+    }
+    else if(cr2 & I2C_CR2_AUTOEND)
+    {
+        bench_stop();
+    }
+    else
+    {
+        bench_event(I2C_ISR_TC);
+        I2C2->ISR   &=  ~I2C_ISR_TC;
+        if(I2C2->CR2 & I2C_CR2_START)
+        {
+            g_Bus.active    =   0;
+        }
+        else if(I2C2->CR2 & I2C_CR2_STOP)
+        {
+            bench_stop();
+        }
+    }
+}
+
+/* one byte time of the bus */
+static void bench_step  (void)
+{
+    uint32_t    cr2 =   I2C2->CR2;
+
+    if(!g_Bus.active)
+    {
+        if(!(cr2 & I2C_CR2_START))
+        {
+            return;
+        }
+        /* start or repeated start, address and acknowledge */
+        I2C2->CR2       &=  ~I2C_CR2_START;
+        g_BusNs         +=  10.0 * BENCH_BIT_NS;
+        g_Bus.active    =   1;
+        g_Bus.read      =   (cr2 & I2C_CR2_RD_WRN) ? 1 : 0;
+        g_Bus.first     =   !g_Bus.read;
+        g_Bus.count     =   (cr2 & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos;
+        g_Bus.sensor    =   bench_sensor((cr2 & I2C_CR2_SADD) >> 1);
+        if(!g_Bus.sensor)
+        {
+            bench_event(I2C_ISR_NACKF);
+            if(I2C2->CR2 & (I2C_CR2_AUTOEND | I2C_CR2_STOP))
+            {
+                bench_stop();
+            }
+            return;
+        }
+        if(0 == g_Bus.count)
+        {
+            bench_count_end();
+        }
+        return;
+    }
+    if(g_Bus.read)
+    {
+        I2C2->RXDR  =   g_Bus.sensor->regs[g_Bus.sensor->ptr++];
+        if(!model_dma_transfer(DMA1, LL_DMA_CHANNEL_5))
+        {
+            g_Errors++;
+        }
+    }
+    else
+    {
+        if(!model_dma_transfer(DMA1, LL_DMA_CHANNEL_4))
+        {
+            g_Errors++;
+        }
+        if(g_Bus.first)
+        {
+            g_Bus.sensor->ptr   =   (uint8_t)I2C2->TXDR;
+            g_Bus.first         =   0;
+        }
+        else
+        {
+            g_Bus.sensor->regs[g_Bus.sensor->ptr++] =   (uint8_t)I2C2->TXDR;
+        }
+    }
+    g_BusNs +=  9.0 * BENCH_BIT_NS;
+    if(0 == --g_Bus.count)
+    {
+        bench_count_end();
+    }
+}
+
+static void bench_drain (void)
+{
+    uint32_t    guard   =   0;
+
+    while( (g_I2c.head) && (guard++ < 1000000U) )
+    {
+        bench_step();
+    }
+    if(g_I2c.head)
+    {
+        g_Errors++;
+    }
+}
+
+/* the sensor reads of one batch as a chain, the last one wakes the thread */
+static void bench_batch (void)
+{
+    uint32_t    i;
+
+    memset(g_Data, 0, sizeof(g_Data));
+    for(i = 0; i < BENCH_READS; i++)
+    {
+        memset(&g_Xfers[i], 0, sizeof(I2C_XFER));
+        g_Regs[i]               =   g_Reads[i].reg;
+        g_Xfers[i].next         =   (i + 1U < BENCH_READS) ? &g_Xfers[i + 1U] : NULL;
+        g_Xfers[i].address      =   g_Sensors[g_Reads[i].sensor].address;
+        g_Xfers[i].tx           =   &g_Regs[i];
+        g_Xfers[i].tx_size      =   1U;
+        g_Xfers[i].rx           =   g_Data[i];
+        g_Xfers[i].rx_size      =   g_Reads[i].size;
+        g_Xfers[i].done         =   (i + 1U < BENCH_READS) ? NULL : bench_wake;
+    }
+    if(0 != i2c_submit(&g_I2c, &g_Xfers[0]))
+    {
+        g_Errors++;
+    }
+    model_sync();
+    bench_drain();
+    for(i = 0; i < BENCH_READS; i++)
+    {
+        if( (I2C_OK != g_Xfers[i].status) ||
+            (0 != memcmp(g_Data[i], &g_Sensors[g_Reads[i].sensor].regs[g_Reads[i].reg], g_Reads[i].size < 256U - g_Reads[i].reg ? g_Reads[i].size : 256U - g_Reads[i].reg)) )
+        {
+            g_Errors++;
+        }
+    }
+}
+
+/* one transaction on its own, the error paths */
+static int bench_one    (
+    I2C_XFER*   xfer,
+    uint32_t    address,
+    uint32_t    rx_size )
+{
+    memset(xfer, 0, sizeof(I2C_XFER));
+    g_Regs[0]       =   0x0FU;
+    xfer->address   =   address;
+    xfer->tx        =   &g_Regs[0];
+    xfer->tx_size   =   rx_size ? 1U : 0;
+    xfer->rx        =   g_Data[0];
+    xfer->rx_size   =   rx_size;
+    return i2c_submit(&g_I2c, xfer);
+}
+
+static void bench_errors    (void)
+{
+    I2C_XFER    a;
+    I2C_XFER    b;
+    I2C_STATS   stats;
+
+    /* probe of an address nobody answers */
+    (void)bench_one(&a, 0x50U, 0);
+    bench_drain();
+    if(I2C_ERR_NACK != a.status)
+    {
+        g_Errors++;
+    }
+    /* a read that names an absent device in its write phase */
+    (void)bench_one(&a, 0x51U, 4U);
+    bench_drain();
+    if(I2C_ERR_NACK != a.status)
+    {
+        g_Errors++;
+    }
+
+    /* SCL held low in the middle of a read, the next one still runs */
+    (void)bench_one(&a, g_Sensors[2].address, 200U);
+    (void)bench_one(&b, g_Sensors[0].address, 4U);
+    model_sync();
+    bench_step();
+    bench_step();
+    bench_step();
+    I2C2->ISR       |=  I2C_ISR_TIMEOUT;
+    (void)model_raise(I2C2_ER_IRQn);
+    g_Bus.active    =   0;
+    bench_drain();
+    if( (I2C_ERR_TIMEOUT != a.status) || (I2C_OK != b.status) )
+    {
+        g_Errors++;
+    }
+
+    /* SDA held low: the recovery cannot free it, the queue fails fast */
+    I2C2->ISR   |=  I2C_ISR_BUSY;
+    (void)bench_one(&a, g_Sensors[0].address, 4U);
+    (void)bench_one(&b, g_Sensors[1].address, 4U);
+    model_sync();
+    I2C2->ISR   &=  ~I2C_ISR_BUSY;
+    if( (I2C_ERR_BUS != a.status) || (I2C_ERR_BUS != b.status) || (g_I2c.head) )
+    {
+        g_Errors++;
+    }
+    /* the pins are back with the peripheral */
+    if(0xAU != ((GPIOB->MODER >> 20) & 0xFU))
+    {
+        g_Errors++;
+    }
+
+    /* abort the running one and one still queued */
+    (void)bench_one(&a, g_Sensors[3].address, 6U);
+    (void)bench_one(&b, g_Sensors[4].address, 6U);
+    if( (0 != i2c_abort(&g_I2c, &b)) || (0 != i2c_abort(&g_I2c, &a)) || (-1 != i2c_abort(&g_I2c, &a)) )
+    {
+        g_Errors++;
+    }
+    g_Bus.active    =   0;
+    I2C2->CR2       =   0;
+    if( (I2C_ERR_TIMEOUT != a.status) || (I2C_ERR_TIMEOUT != b.status) || (g_I2c.head) )
+    {
+        g_Errors++;
+    }
+
+    i2c_stats(&g_I2c, &stats);
+    printf("error paths: %u nacks, %u errors, %u recoveries, %s\n", stats.nacks, stats.errors, stats.recoveries,
+           ( (2U == stats.nacks) && (5U == stats.errors) && (4U == stats.recoveries) ) ? "as expected" : "UNEXPECTED");
+    if( (2U != stats.nacks) || (5U != stats.errors) || (4U != stats.recoveries) )
+    {
+        g_Errors++;
+    }
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    I2C_CONFIG      config;
+    I2C_STATS       stats;
+    MODEL_IRQ_STATS ev;
+    uint32_t        batches =   (argc > 1) ? (uint32_t)atoi(argv[1]) : 1000U;
+    double          isr_us  =   (argc > 2) ? atof(argv[2]) : 2.0;
+    double          wake_us =   (argc > 3) ? atof(argv[3]) : 10.0;
+    double          bus_us  =   0.0;
+    double          irqs    =   0.0;
+    double          dma_us  =   0.0;
+    double          each_us =   0.0;
+    uint32_t        i, j;
+
+    if( (0 == batches) || (isr_us < 0.0) || (wake_us < 0.0) )
+    {
+        fprintf(stderr, "usage: i2c_bench [batches] [isr us] [thread wake us]\n");
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(I2C2_EV_IRQn, I2C2_EV_IRQHandler);
+    model_attach(I2C2_ER_IRQn, I2C2_ER_IRQHandler);
+    model_attach(DMA1_Channel4_IRQn, DMA1_Channel4_IRQHandler);
+    model_attach(DMA1_Channel5_IRQn, DMA1_Channel5_IRQHandler);
+    for(i = 0; i < BENCH_SENSORS; i++)
+    {
+        for(j = 0; j < 256U; j++)
+        {
+            g_Sensors[i].regs[j]    =   (uint8_t)(g_Sensors[i].address * 31U + j * 7U);
+        }
+    }
+    config.timing       =   0x00702991U;
+    config.pclk         =   80000000U;
+    config.scl_timeout  =   25U;
+    config.priority     =   6U;
+    if(0 != i2c_init(&g_I2c, &g_I2cPortI2c2, &config))
+    {
+        fprintf(stderr, "i2c_init failed\n");
+        return 1;
+    }
+    if(I2C2->TIMEOUTR != (I2C_TIMEOUTR_TIMOUTEN | 975U))
+    {
+        g_Errors++;
+    }
+
+    for(i = 0; i < batches; i++)
+    {
+        bench_batch();
+    }
+    model_irq_stats(I2C2_EV_IRQn, &ev);
+    i2c_stats(&g_I2c, &stats);
+    bus_us  =   g_BusNs / 1e3 / batches;
+    irqs    =   (double)ev.count / batches;
+    dma_us  =   irqs * isr_us + wake_us * g_Wakes / batches;
+    each_us =   irqs * isr_us + wake_us * BENCH_READS;
+    printf("I2C2 at 400 kHz, %u batches of %u reads, %u bytes each, isr %.1f us, thread wake %.1f us\n",
+           batches, BENCH_READS, stats.bytes / batches, isr_us, wake_us);
+    printf("bus %.0f us per batch, %.1f interrupts per batch (%u reloads), %.0f host ns per interrupt\n",
+           bus_us, irqs, stats.reloads / batches, ev.count ? (double)ev.ns / ev.count : 0.0);
+    printf("%-26s %12s %14s\n", "", "cpu us/batch", "load at 50 Hz");
+    printf("%-26s %12.1f %13.2f%%\n", "chained, one wake", dma_us, dma_us * BENCH_RATE / 1e4);
+    printf("%-26s %12.1f %13.2f%%\n", "one wake per read", each_us, each_us * BENCH_RATE / 1e4);
+    printf("%-26s %12.1f %13.2f%%\n", "polled", bus_us, bus_us * BENCH_RATE / 1e4);
+    bench_errors();
+    printf("%u wrong\n", g_Errors);
+    return (g_Errors) ? 1 : 0;
+}
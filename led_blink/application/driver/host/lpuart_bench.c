@@ -0,0 +1,352 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        lpuart_bench.c
+ * @brief       host benchmark of the LPUART log backend.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_lpuart.c against the register model at 9600 baud, 8N1, one
+ * byte time per step. The bench plays the logger thread: log records of
+ * 16 to 64 bytes arrive at random, are written to the backend and flushed
+ * with force once the latency passes without new text. Console bytes are
+ * received twice a second. Every byte on the wire and every received byte
+ * is checked.
+ *
+ * The MCU is taken to Sleep while a DMA burst runs and to STOP2 otherwise.
+ * Energy per KB counts the backend only: the wakeups it causes and the
+ * Sleep time of its bursts, above the STOP2 floor. The currents are
+ * assumptions for 80 MHz at 3 V, not measurements, and are given on the
+ * command line. For comparison the same text is sent with one interrupt
+ * per byte, which keeps the MCU in Sleep for the line time as well. Run
+ * "make" in this directory, then
+ * ./lpuart_bench [seconds] [records/s] [run mA] [sleep mA] [stop2 uA].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stm32l4xx_ll_dma.h"
+#include "periph_model.h"
+#include "drv_lpuart.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_BAUDRATE      (9600U)
+#define BENCH_BYTE_RATE     (BENCH_BAUDRATE / 10U)      /*!< 8N1 */
+#define BENCH_TX_SIZE       (1024U)
+#define BENCH_STORAGE       (64U)
+#define BENCH_LATENCY       (BENCH_BYTE_RATE / 10U)     /*!< 100 ms */
+#define BENCH_RECORD_MIN    (16U)
+#define BENCH_RECORD_MAX    (64U)
+#define BENCH_RX_EVERY      (BENCH_BYTE_RATE / 2U)
+#define BENCH_VOLT          (3.0)
+#define BENCH_WAKE_US       (5.0)       /*!< STOP2 exit */
+#define BENCH_ACTIVE_US     (20.0)      /*!< handler and return to low power */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    double      run_ma;
+    double      sleep_ma;
+    double      stop_ua;
+}BENCH_POWER;
+
+typedef struct
+{
+    uint32_t    steps;
+    uint32_t    bytes;
+    uint32_t    busy;       /* steps in Sleep */
+    uint32_t    wake_stop;  /* wakeups from STOP2 */
+    uint32_t    wake_sleep; /* wakeups from Sleep */
+}BENCH_RUN;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static uint8_t      g_Tx[BENCH_TX_SIZE];
+static uint8_t      g_Storage[BENCH_STORAGE];
+static uint32_t     g_Made      =   0;      /* pattern bytes logged */
+static uint32_t     g_Given     =   0;      /* pattern bytes the backend took */
+static uint32_t     g_Wire      =   0;      /* pattern bytes on the wire */
+static uint32_t     g_RxSent    =   0;
+static uint32_t     g_RxRead    =   0;
+static uint32_t     g_Errors    =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static uint8_t bench_pattern    (
+    uint32_t    pos )
+{
+    return (uint8_t)(pos * 13U + (pos >> 7));
+}
+
+void LPUART1_IRQHandler (void)
+{
+    lpuart_irq_handler();
+}
+
+void DMA2_Channel6_IRQHandler   (void)
+{
+    lpuart_dma_handler();
+}
+
+/* the logger thread: hand over what was logged, then flush */
+static uint32_t bench_logger    (
+    int         force   )
+{
+    uint8_t     text[BENCH_RECORD_MAX];
+    uint32_t    size    =   0;
+    uint32_t    took    =   0;
+    uint32_t    i;
+
+    while(g_Given != g_Made)
+    {
+        size    =   g_Made - g_Given;
+        if(size > sizeof(text))
+        {
+            size    =   sizeof(text);
+        }
+        for(i = 0; i < size; i++)
+        {
+            text[i] =   bench_pattern(g_Given + i);
+        }
+        took    =   lpuart_write(text, size);
+        g_Given +=  took;
+        if(took < size)
+        {
+            /* the ring is full, the rest waits for the latency */
+            return 1;
+        }
+    }
+    return lpuart_flush(force);
+}
+
+/* one byte time on the wire */
+static void bench_step  (
+    BENCH_RUN*  run )
+{
+    if(model_dma_transfer(DMA2, LL_DMA_CHANNEL_6))
+    {
+        if((uint8_t)LPUART1->TDR != bench_pattern(g_Wire))
+        {
+            g_Errors++;
+        }
+        g_Wire++;
+        run->bytes++;
+    }
+    if(lpuart_busy())
+    {
+        run->busy++;
+    }
+    run->steps++;
+}
+
+/* a console byte, RXNE wakes the MCU */
+static void bench_receive   (
+    BENCH_RUN*  run )
+{
+    uint8_t     data    =   0;
+
+    if(lpuart_busy())
+    {
+        run->wake_sleep++;
+    }
+    else
+    {
+        run->wake_stop++;
+    }
+    LPUART1->RDR    =   (uint8_t)(0x30U + g_RxSent % 10U);
+    LPUART1->ISR    |=  USART_ISR_RXNE;
+    (void)model_raise(LPUART1_IRQn);
+    LPUART1->ISR    &=  ~USART_ISR_RXNE;
+    g_RxSent++;
+    while(lpuart_read(&data, 1U, 0))
+    {
+        if(data != (uint8_t)(0x30U + g_RxRead % 10U))
+        {
+            g_Errors++;
+        }
+        g_RxRead++;
+    }
+}
+
+static double bench_energy  (
+    const BENCH_POWER*  power,
+    const BENCH_RUN*    run     )
+{
+    double  busy    =   (double)run->busy / BENCH_BYTE_RATE;
+    double  active  =   (run->wake_stop * (BENCH_WAKE_US + BENCH_ACTIVE_US) + run->wake_sleep * BENCH_ACTIVE_US) * 1e-6;
+
+    /* mJ above the STOP2 floor */
+    return BENCH_VOLT * (power->run_ma * active + (power->sleep_ma - power->stop_ua * 1e-3) * busy);
+}
+
+static void bench_report    (
+    const char*         name,
+    const BENCH_POWER*  power,
+    const BENCH_RUN*    run     )
+{
+    double      seconds =   (double)run->steps / BENCH_BYTE_RATE;
+    double      energy  =   bench_energy(power, run);
+    uint32_t    wakes   =   run->wake_stop + run->wake_sleep;
+
+    printf("%-22s %8u %9.1f %9.1f %9.1f %9.1f %10.1f\n", name, wakes,
+           wakes ? (double)run->bytes / wakes : 0.0, (double)wakes / seconds,
+           100.0 * run->busy / run->steps,
+           energy * 1e3 / seconds / BENCH_VOLT + power->stop_ua,
+           run->bytes ? energy * 1e3 * 1024.0 / run->bytes : 0.0);
+}
+
+static int bench_run    (
+    const BENCH_POWER*  power,
+    uint32_t            batch,
+    uint32_t            steps,
+    double              rate    )
+{
+    LPUART_CONFIG   config;
+    LPUART_STATS    stats;
+    BENCH_RUN       run;
+    char            name[32];
+    uint32_t        deadline    =   0;
+    uint32_t        step        =   0;
+
+    memset(&config, 0, sizeof(config));
+    config.baudrate     =   BENCH_BAUDRATE;
+    config.tx           =   g_Tx;
+    config.tx_size      =   sizeof(g_Tx);
+    config.batch        =   batch;
+    config.storage      =   g_Storage;
+    config.storage_size =   sizeof(g_Storage);
+    config.priority     =   6U;
+    if(0 != lpuart_init(&config))
+    {
+        fprintf(stderr, "lpuart_init failed\n");
+        return (-1);
+    }
+    memset(&run, 0, sizeof(run));
+    srand(1);
+    for(step = 1; step <= steps; step++)
+    {
+        /* the logger thread wakes anyway, only its timeouts count for the backend */
+        if((double)rand() / RAND_MAX < rate / BENCH_BYTE_RATE)
+        {
+            g_Made  +=  BENCH_RECORD_MIN + (uint32_t)rand() % (BENCH_RECORD_MAX - BENCH_RECORD_MIN + 1U);
+            deadline    =   bench_logger(0) ? step + BENCH_LATENCY : 0;
+        }
+        else if( (deadline) && (step >= deadline) )
+        {
+            if(lpuart_busy())
+            {
+                run.wake_sleep++;
+            }
+            else
+            {
+                run.wake_stop++;
+            }
+            deadline    =   bench_logger(1) ? step + BENCH_LATENCY : 0;
+        }
+        if(0 == (step % BENCH_RX_EVERY))
+        {
+            bench_receive(&run);
+        }
+        bench_step(&run);
+    }
+    /* send the rest */
+    while( (g_Given != g_Made) || (g_Wire != g_Given) )
+    {
+        (void)bench_logger(1);
+        bench_step(&run);
+    }
+    lpuart_stats(&stats);
+    /* every burst ends with one interrupt taken in Sleep */
+    run.wake_sleep  +=  stats.tx_bursts;
+    snprintf(name, sizeof(name), "dma batch %u", batch);
+    bench_report(name, power, &run);
+    if( (stats.tx_bytes != run.bytes) || (stats.errors) || (stats.rx_dropped) )
+    {
+        g_Errors++;
+    }
+
+    /* the same text, one transmit interrupt per byte taken in Sleep */
+    run.wake_stop   =   0;
+    run.wake_sleep  =   run.bytes;
+    run.busy        =   run.bytes;
+    bench_report("  one irq per byte", power, &run);
+    return (0);
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    static const uint32_t   batches[] = { 1U, 16U, 64U, 256U };
+    BENCH_POWER             power;
+    double                  seconds =   (argc > 1) ? atof(argv[1]) : 600.0;
+    double                  rate    =   (argc > 2) ? atof(argv[2]) : 4.0;
+    uint32_t                i;
+
+    power.run_ma    =   (argc > 3) ? atof(argv[3]) : 8.5;
+    power.sleep_ma  =   (argc > 4) ? atof(argv[4]) : 2.6;
+    power.stop_ua   =   (argc > 5) ? atof(argv[5]) : 1.1;
+    if( (seconds <= 0.0) || (rate <= 0.0) || (rate >= BENCH_BYTE_RATE) )
+    {
+        fprintf(stderr, "usage: lpuart_bench [seconds] [records/s] [run mA] [sleep mA] [stop2 uA]\n");
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(LPUART1_IRQn, LPUART1_IRQHandler);
+    model_attach(DMA2_Channel6_IRQn, DMA2_Channel6_IRQHandler);
+
+    printf("%u baud 8N1 from LSE, %.0f s, %.1f records/s of %u-%u bytes, latency %u ms\n",
+           BENCH_BAUDRATE, seconds, rate, BENCH_RECORD_MIN, BENCH_RECORD_MAX, BENCH_LATENCY * 1000U / BENCH_BYTE_RATE);
+    printf("run %.2f mA, sleep %.2f mA, stop2 %.2f uA at %.1f V, wake %.0f us, %.0f us per wakeup\n",
+           power.run_ma, power.sleep_ma, power.stop_ua, BENCH_VOLT, BENCH_WAKE_US, BENCH_ACTIVE_US);
+    printf("%-22s %8s %9s %9s %9s %9s %10s\n", "", "wakeups", "bytes/wk", "wk/s", "sleep %", "avg uA", "uJ/KB");
+    for(i = 0; i < sizeof(batches) / sizeof(batches[0]); i++)
+    {
+        if(0 != bench_run(&power, batches[i], (uint32_t)(seconds * BENCH_BYTE_RATE), rate))
+        {
+            return 1;
+        }
+    }
+    printf("%u bytes on the wire, %u console bytes, %u wrong\n", g_Wire, g_RxRead, g_Errors);
+    return ( (g_Errors) || (g_RxRead != g_RxSent) ) ? 1 : 0;
+}
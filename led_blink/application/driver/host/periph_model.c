@@ -0,0 +1,508 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        periph_model.c
+ * @brief       host register model the drivers run against.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "periph_model.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define MODEL_PERIPH_BASE       (0x40000000UL)
+#define MODEL_PERIPH_SIZE       (0x10070000UL)      /*!< APB1 to the RNG on AHB2 */
+#define MODEL_SYSTEM_BASE       (0xE0000000UL)
+#define MODEL_SYSTEM_SIZE       (0x00100000UL)      /*!< SCS and DBGMCU */
+#define MODEL_IRQS              (96U)
+#define MODEL_CHANNELS          (7U)
+#define MODEL_CLOCK             (80000000U)         /*!< SYSCLK and PCLKs as lowlayer/main.c sets them */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* what the model knows of a channel beyond its registers */
+typedef struct
+{
+    uint32_t    length;     /* CNDTR the transfer started with */
+    uint32_t    expect;     /* CNDTR the model left */
+}MODEL_CHANNEL;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static void             (*g_ModelHandlers[MODEL_IRQS])(void);
+static MODEL_IRQ_STATS  g_ModelIrqStats[MODEL_IRQS];
+static MODEL_CHANNEL    g_ModelChannels[2][MODEL_CHANNELS];
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Host clock
+ * @return              ns
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint64_t model_ns    (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/** 
+ * @brief               Map a range at its own address
+ * @param[in]           base            address
+ * @param[in]           size            bytes
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int model_map    (
+    uintptr_t   base,
+    size_t      size    )
+{
+    void*   p   =   mmap((void*)base, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0);
+
+    if( (MAP_FAILED == p) || ((uintptr_t)p != base) )
+    {
+        fprintf(stderr, "cannot map 0x%08lx\n", (unsigned long)base);
+        return (-1);
+    }
+    return (0);
+}
+
+/** 
+ * @brief               Read one item
+ * @param[in]           address         where
+ * @param[in]           size            1, 2 or 4 bytes
+ * @return              item, zero extended
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t model_load  (
+    uintptr_t   address,
+    uint32_t    size    )
+{
+    if(1U == size)
+    {
+        return *(volatile uint8_t*)address;
+    }
+    if(2U == size)
+    {
+        return *(volatile uint16_t*)address;
+    }
+    return *(volatile uint32_t*)address;
+}
+
+/** 
+ * @brief               Write one item
+ * @param[in]           address         where
+ * @param[in]           size            1, 2 or 4 bytes
+ * @param[in]           value           item, truncated to size
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_store (
+    uintptr_t   address,
+    uint32_t    size,
+    uint32_t    value   )
+{
+    if(1U == size)
+    {
+        *(volatile uint8_t*)address     =   (uint8_t)value;
+    }
+    else if(2U == size)
+    {
+        *(volatile uint16_t*)address    =   (uint16_t)value;
+    }
+    else
+    {
+        *(volatile uint32_t*)address    =   value;
+    }
+}
+
+/** 
+ * @brief               Clear the DMA flags a handler wrote to IFCR
+ * @param[in]           dma             DMA1 or DMA2
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_sync_dma  (
+    DMA_TypeDef*    dma )
+{
+    uint32_t    ifcr    =   dma->IFCR;
+    uint32_t    clear   =   0;
+    uint32_t    i;
+
+    for(i = 0; i < MODEL_CHANNELS; i++)
+    {
+        /* the global flag clears all four */
+        if(ifcr & (DMA_IFCR_CGIF1 << (i * 4U)))
+        {
+            clear   |=  0xFU << (i * 4U);
+        }
+    }
+    dma->ISR    &=  ~(clear | ifcr);
+    dma->IFCR   =   0;
+}
+
+/** 
+ * @brief               Clear the USART flags a handler wrote to ICR
+ * @param[in]           usart           USART
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_sync_usart    (
+    USART_TypeDef*  usart   )
+{
+    usart->ISR  &=  ~usart->ICR;
+    usart->ICR  =   0;
+}
+
+/** 
+ * @brief               Clear the I2C flags a handler wrote to ICR
+ * @param[in]           i2c             I2C
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_sync_i2c  (
+    I2C_TypeDef*    i2c )
+{
+    i2c->ISR    &=  ~i2c->ICR;
+    i2c->ICR    =   0;
+}
+
+/** 
+ * @brief               Finish the calibration, stop and disable the driver started
+ * @param[in]           adc             ADC
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_sync_adc  (
+    ADC_TypeDef*    adc )
+{
+    /* ADSTART stays, a stop and a restart in one handler look like a stop */
+    adc->CR &=  ~(ADC_CR_ADSTP | ADC_CR_ADCAL);
+    if(adc->CR & ADC_CR_ADDIS)
+    {
+        adc->CR &=  ~(ADC_CR_ADDIS | ADC_CR_ADEN);
+    }
+}
+
+/** 
+ * @brief               Apply the set and reset registers of the GPIO ports to ODR
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void model_sync_gpio (void)
+{
+    GPIO_TypeDef*   gpio    =   NULL;
+    uint32_t        i;
+
+    /* GPIOA to GPIOH */
+    for(i = 0; i < 8U; i++)
+    {
+        gpio        =   (GPIO_TypeDef*)(GPIOA_BASE + i * 0x400U);
+        gpio->ODR   =   (gpio->ODR | (gpio->BSRR & 0xFFFFU)) & ~((gpio->BSRR >> 16) | gpio->BRR);
+        gpio->BSRR  =   0;
+        gpio->BRR   =   0;
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Map the peripherals and load reset values
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_init   (void)
+{
+    if( (0 != model_map(MODEL_PERIPH_BASE, MODEL_PERIPH_SIZE)) || (0 != model_map(MODEL_SYSTEM_BASE, MODEL_SYSTEM_SIZE)) )
+    {
+        return (-1);
+    }
+    /* MSI at 4 MHz as after reset */
+    RCC->CR     =   0x00000063U;
+    /* LSE running, the backup domain keeps it over resets */
+    RCC->BDCR   =   RCC_BDCR_LSEON | RCC_BDCR_LSERDY;
+    /* transmitter empty, enable acknowledged */
+    USART1->ISR     =   USART_ISR_TXE | USART_ISR_TC | USART_ISR_TEACK | USART_ISR_REACK;
+    USART2->ISR     =   USART1->ISR;
+    USART3->ISR     =   USART1->ISR;
+    UART4->ISR      =   USART1->ISR;
+    UART5->ISR      =   USART1->ISR;
+    LPUART1->ISR    =   USART1->ISR;
+    memset(g_ModelChannels, 0, sizeof(g_ModelChannels));
+    return (0);
+}
+
+/**
+ * @brief               Attach an interrupt handler
+ * @param[in]           irq             interrupt number
+ * @param[in]           handler         handler
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_attach    (
+    IRQn_Type           irq,
+    void                (*handler)(void)    )
+{
+    if( (irq >= 0) && ((uint32_t)irq < MODEL_IRQS) )
+    {
+        g_ModelHandlers[irq]    =   handler;
+    }
+}
+
+/**
+ * @brief               Take an interrupt
+ * @param[in]           irq             interrupt number
+ * @retval              1               the handler ran
+ * @retval              0               no handler
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_raise  (
+    IRQn_Type           irq )
+{
+    uint64_t    start   =   0;
+
+    if( (irq < 0) || ((uint32_t)irq >= MODEL_IRQS) || (!g_ModelHandlers[irq]) )
+    {
+        return 0;
+    }
+    start   =   model_ns();
+    g_ModelHandlers[irq]();
+    g_ModelIrqStats[irq].ns +=  model_ns() - start;
+    g_ModelIrqStats[irq].count++;
+    model_sync();
+    return 1;
+}
+
+/**
+ * @brief               Apply the write one to clear registers
+ * @return              None
+ * @note                For flags cleared and pins driven outside a handler
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_sync  (void)
+{
+    model_sync_dma(DMA1);
+    model_sync_dma(DMA2);
+    model_sync_usart(USART1);
+    model_sync_usart(USART2);
+    model_sync_usart(USART3);
+    model_sync_usart(UART4);
+    model_sync_usart(UART5);
+    model_sync_usart(LPUART1);
+    model_sync_i2c(I2C1);
+    model_sync_i2c(I2C2);
+    model_sync_i2c(I2C3);
+    model_sync_adc(ADC1);
+    model_sync_adc(ADC2);
+    model_sync_adc(ADC3);
+    model_sync_gpio();
+}
+
+/**
+ * @brief               Handler time of an interrupt, cleared on reading
+ * @param[in]           irq             interrupt number
+ * @param[out]          stats           calls and time
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_irq_stats (
+    IRQn_Type           irq,
+    MODEL_IRQ_STATS*    stats   )
+{
+    memset(stats, 0, sizeof(MODEL_IRQ_STATS));
+    if( (irq >= 0) && ((uint32_t)irq < MODEL_IRQS) )
+    {
+        *stats  =   g_ModelIrqStats[irq];
+        memset(&g_ModelIrqStats[irq], 0, sizeof(MODEL_IRQ_STATS));
+    }
+}
+
+/**
+ * @brief               Interrupt of a DMA channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         1 to 7
+ * @return              interrupt number
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern IRQn_Type model_dma_irq  (
+    DMA_TypeDef*        dma,
+    uint32_t            channel )
+{
+    if(DMA1 == dma)
+    {
+        return (IRQn_Type)(DMA1_Channel1_IRQn + (int)channel - 1);
+    }
+    if(channel <= 5U)
+    {
+        return (IRQn_Type)(DMA2_Channel1_IRQn + (int)channel - 1);
+    }
+    return (6U == channel) ? DMA2_Channel6_IRQn : DMA2_Channel7_IRQn;
+}
+
+/**
+ * @brief               Serve one request of a DMA channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         1 to 7
+ * @retval              1               one item moved
+ * @retval              0               channel disabled or done
+ * @note                Moves one item between the CPAR and CMAR sides in the direction,
+ *                      sizes and increments of CCR, sets the half and full transfer flags,
+ *                      reloads in circular mode and raises the channel interrupt.
+ *                      A CNDTR that differs from what the model left there starts a
+ *                      new transfer of that length.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_dma_transfer   (
+    DMA_TypeDef*        dma,
+    uint32_t            channel )
+{
+    DMA_Channel_TypeDef*    regs    =   (DMA_Channel_TypeDef*)((uintptr_t)dma + 0x08U + 0x14U * (channel - 1U));
+    MODEL_CHANNEL*          shadow  =   &g_ModelChannels[(DMA1 == dma) ? 0 : 1][channel - 1U];
+    uint32_t                ccr     =   regs->CCR;
+    uint32_t                left    =   regs->CNDTR & 0xFFFFU;
+    uint32_t                psize   =   1U << ((ccr & DMA_CCR_PSIZE) >> DMA_CCR_PSIZE_Pos);
+    uint32_t                msize   =   1U << ((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+    uint32_t                flags   =   0;
+    uint32_t                done    =   0;
+    uintptr_t               per     =   0;
+    uintptr_t               mem     =   0;
+
+    if( (!(ccr & DMA_CCR_EN)) || (0 == left) )
+    {
+        return 0;
+    }
+    if(left != shadow->expect)
+    {
+        shadow->length  =   left;
+    }
+    done    =   shadow->length - left;
+    per     =   regs->CPAR + ((ccr & DMA_CCR_PINC) ? done * psize : 0);
+    mem     =   regs->CMAR + ((ccr & DMA_CCR_MINC) ? done * msize : 0);
+    if(ccr & DMA_CCR_DIR)
+    {
+        model_store(per, psize, model_load(mem, msize));
+    }
+    else
+    {
+        model_store(mem, msize, model_load(per, psize));
+    }
+    left--;
+    done++;
+    if(done == shadow->length / 2U)
+    {
+        flags   |=  DMA_ISR_HTIF1;
+    }
+    if(0 == left)
+    {
+        flags   |=  DMA_ISR_TCIF1;
+        if(ccr & DMA_CCR_CIRC)
+        {
+            left    =   shadow->length;
+        }
+    }
+    regs->CNDTR     =   left;
+    shadow->expect  =   left;
+    if(flags)
+    {
+        dma->ISR    |=  (flags | DMA_ISR_GIF1) << ((channel - 1U) * 4U);
+        if( ((flags & DMA_ISR_HTIF1) && (ccr & DMA_CCR_HTIE)) || ((flags & DMA_ISR_TCIF1) && (ccr & DMA_CCR_TCIE)) )
+        {
+            (void)model_raise(model_dma_irq(dma, channel));
+        }
+    }
+    return 1;
+}
+
+/*
+ * The LL sources find bit positions with the Cortex-M rbit instruction, the
+ * few calls the drivers make into them are replaced here. Pins are not
+ * modelled and the clock tree is taken as lowlayer/main.c sets it up.
+ */
+
+void LL_GPIO_StructInit (
+    LL_GPIO_InitTypeDef*    GPIO_InitStruct )
+{
+    memset(GPIO_InitStruct, 0, sizeof(LL_GPIO_InitTypeDef));
+}
+
+ErrorStatus LL_GPIO_Init    (
+    GPIO_TypeDef*           GPIOx,
+    LL_GPIO_InitTypeDef*    GPIO_InitStruct )
+{
+    (void)GPIOx;
+    (void)GPIO_InitStruct;
+    return SUCCESS;
+}
+
+uint32_t LL_RCC_GetUSARTClockFreq   (
+    uint32_t                USARTxSource    )
+{
+    (void)USARTxSource;
+    return MODEL_CLOCK;
+}
@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        periph_model.h
+ * @brief       host register model the drivers run against.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The peripheral and system control address ranges of the STM32L475 are
+ * mapped as plain memory at their real addresses, so the drivers and the LL
+ * headers run unchanged on a 64 bit Linux host. The benchmark plays the
+ * hardware: it moves bytes with \ref model_dma_transfer, sets status flags
+ * and calls \ref model_raise, which runs the attached handler, times it and
+ * then applies the write one to clear registers the handler wrote, and
+ * the GPIO set and reset registers to ODR. An ADC ends its calibration and
+ * its stop and disable requests there as well. The NVIC
+ * enable registers are write one to set on the chip and plain memory here,
+ * so an attached handler counts as enabled. Link with -no-pie so that static buffers
+ * have addresses that fit the 32 bit DMA address registers.
+ */
+
+#ifndef _PERIPH_MODEL_H_
+#define _PERIPH_MODEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx.h"
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Interrupt handler time
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint64_t            count;      /*!< handler calls */
+    uint64_t            ns;         /*!< host time in the handler */
+}MODEL_IRQ_STATS;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Map the peripherals and load reset values
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_init   (void);
+
+/**
+ * @brief               Attach an interrupt handler
+ * @param[in]           irq             interrupt number
+ * @param[in]           handler         handler
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_attach    (
+    IRQn_Type           irq,
+    void                (*handler)(void)
+);
+
+/**
+ * @brief               Take an interrupt
+ * @param[in]           irq             interrupt number
+ * @retval              1               the handler ran
+ * @retval              0               no handler
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_raise  (
+    IRQn_Type           irq
+);
+
+/**
+ * @brief               Apply the write one to clear registers
+ * @return              None
+ * @note                For flags cleared and pins driven outside a handler
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_sync  (void);
+
+/**
+ * @brief               Handler time of an interrupt, cleared on reading
+ * @param[in]           irq             interrupt number
+ * @param[out]          stats           calls and time
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void model_irq_stats (
+    IRQn_Type           irq,
+    MODEL_IRQ_STATS*    stats
+);
+
+/**
+ * @brief               Interrupt of a DMA channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         1 to 7
+ * @return              interrupt number
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern IRQn_Type model_dma_irq  (
+    DMA_TypeDef*        dma,
+    uint32_t            channel
+);
+
+/**
+ * @brief               Serve one request of a DMA channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         1 to 7
+ * @retval              1               one item moved
+ * @retval              0               channel disabled or done
+ * @note                Moves one item between the CPAR and CMAR sides in the direction,
+ *                      sizes and increments of CCR, sets the half and full transfer flags,
+ *                      reloads in circular mode and raises the channel interrupt.
+ *                      A CNDTR that differs from what the model left there starts a
+ *                      new transfer of that length.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int model_dma_transfer   (
+    DMA_TypeDef*        dma,
+    uint32_t            channel
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PERIPH_MODEL_H_ */
@@ -0,0 +1,587 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        rng_bench.c
+ * @brief       host check and throughput benchmark of the entropy pool.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * rng_bench runs drv_rng.c against the register model. The benchmark plays
+ * the RNG: it puts a word in DR, sets DRDY and raises the interrupt while
+ * RNGEN and IE are set, and now and then sets a seed or clock error or
+ * repeats the word before. A reference of the ring follows every event,
+ * and each read of a random size, from a few bytes to more than the ring,
+ * must give the words of the reference or nothing. The interrupt enable
+ * must follow the fill level, taken words must be wiped, a seed error or
+ * a repeat must empty the ring and a thread in rng_wait must be woken once
+ * the ring holds its request.
+ *
+ * Then the host time of rng_read is measured for several sizes with the
+ * ring full, best of the rounds, and for one size with words of one set bit against random
+ * ones, which must cost the same. For the target the refill rate of the
+ * RNG and the CPU time per byte served are worked out from assumed costs
+ * on an 80 MHz Cortex-M4: the interrupt per word and the cycles per word
+ * copied.
+ * Run "make" in this directory, then
+ * ./rng_bench [rounds] [isr us] [copy cycles/word] [RNG clocks/word].
+ *
+ * rng_host_bench is the same file built with BENCH_STANDIN against the
+ * software stand in of rng_host.c: the calls behave the same for the
+ * caller, and their host throughput is measured.
+ * Run ./rng_host_bench [rounds].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32l4xx_ll_rcc.h"
+#ifndef BENCH_STANDIN
+#include "periph_model.h"
+#endif
+#include "drv_rng.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_HCLK          (80000000.0)
+#define BENCH_RNG_CLOCK     (48000000.0)
+#define BENCH_WORDS         (64U)       /*!< ring of the checks and the throughput */
+#define BENCH_EVENTS        (200000U)   /*!< steps of the random check */
+#define BENCH_LOCK_CYCLES   (40.0)      /*!< call, checks and lock of rng_read */
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static RNG_POOL         g_Pool;
+static uint32_t         g_Ring[BENCH_WORDS];
+static uint8_t          g_Data[BENCH_WORDS * 4U + 16U];
+static uint32_t         g_Random    =   0x2545F491U;
+static uint32_t         g_Errors    =   0;
+static volatile uint32_t g_Sink     =   0;
+
+static const uint32_t   g_Sizes[]   =   { 4U, 16U, 32U, 64U, 128U, 256U };
+
+#ifndef BENCH_STANDIN
+/* the ring as it must be */
+static uint32_t         g_Ref[BENCH_WORDS];
+static uint32_t         g_RefHead   =   0;
+static uint32_t         g_RefTail   =   0;
+static uint32_t         g_RefLast   =   0;
+static uint32_t         g_RefPrimed =   0;
+static RNG_STATS        g_RefStats;
+static uint32_t         g_Source    =   0x6B43A9B5U;
+static uint32_t         g_Low       =   0;
+#endif
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static uint64_t bench_ns    (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t bench_random    (void)
+{
+    g_Random    ^=  g_Random << 13;
+    g_Random    ^=  g_Random >> 17;
+    g_Random    ^=  g_Random << 5;
+    return g_Random;
+}
+
+static void bench_fail  (
+    const char*     what,
+    uint32_t        step    )
+{
+    if(g_Errors < 10U)
+    {
+        printf("  step %u: %s\n", step, what);
+    }
+    g_Errors++;
+}
+
+#ifndef BENCH_STANDIN
+
+void RNG_IRQHandler (void)
+{
+    rng_irq_handler(&g_Pool);
+}
+
+static void bench_ref_flush (void)
+{
+    g_RefStats.discarded    +=  g_RefHead - g_RefTail;
+    g_RefTail               =   g_RefHead;
+    g_RefPrimed             =   0;
+}
+
+/* one interrupt of the RNG with SR and DR as given, and the reference of it */
+static void bench_event (
+    uint32_t        sr,
+    uint32_t        word,
+    uint32_t        step    )
+{
+    if( (!(RNG->CR & RNG_CR_RNGEN)) || (!(RNG->CR & RNG_CR_IE)) )
+    {
+        return;
+    }
+    RNG->DR =   word;
+    RNG->SR =   sr;
+    (void)model_raise(RNG_IRQn);
+    if( ((sr & RNG_SR_CEIS) && (RNG->SR & RNG_SR_CEIS)) || ((sr & RNG_SR_SEIS) && (RNG->SR & RNG_SR_SEIS)) )
+    {
+        bench_fail("error flag not cleared", step);
+    }
+    /* reading DR clears DRDY, the clear of a flag wrote ones elsewhere */
+    RNG->SR =   0;
+
+    if(sr & RNG_SR_CEIS)
+    {
+        g_RefStats.clock_errors++;
+    }
+    if(sr & RNG_SR_SEIS)
+    {
+        g_RefStats.seed_errors++;
+        bench_ref_flush();
+    }
+    else if( (sr & RNG_SR_DRDY) && ((g_RefHead - g_RefTail) < BENCH_WORDS) )
+    {
+        if( (g_RefPrimed) && (word == g_RefLast) )
+        {
+            g_RefStats.repeats++;
+            bench_ref_flush();
+        }
+        else
+        {
+            if(g_RefPrimed)
+            {
+                g_Ref[g_RefHead % BENCH_WORDS]  =   word;
+                g_RefHead++;
+                g_RefStats.words++;
+            }
+            g_RefLast   =   word;
+            g_RefPrimed =   1U;
+        }
+    }
+}
+
+/* the next word of the RNG */
+static uint32_t bench_word  (void)
+{
+    g_Source    ^=  g_Source << 13;
+    g_Source    ^=  g_Source >> 17;
+    g_Source    ^=  g_Source << 5;
+    return g_Source;
+}
+
+/* offer words until the interrupt is switched off, low gives words of one set bit */
+static void bench_fill  (
+    uint32_t        step,
+    uint32_t        low     )
+{
+    uint32_t    i;
+
+    for(i = 0; (RNG->CR & RNG_CR_IE) && (i <= BENCH_WORDS * 2U); i++)
+    {
+        /* never the same word twice in a row */
+        bench_event(RNG_SR_DRDY, low ? (1U << (g_Low++ & 31U)) : bench_word(), step);
+    }
+    if(RNG->CR & RNG_CR_IE)
+    {
+        bench_fail("interrupt on with the ring full", step);
+    }
+}
+
+/* what the registers and the ring must show after a step */
+static void bench_check_state   (
+    uint32_t        step    )
+{
+    uint32_t    count   =   g_RefHead - g_RefTail;
+    uint32_t    i;
+
+    if(rng_level(&g_Pool) != count * 4U)
+    {
+        bench_fail("level", step);
+    }
+    if( (!(RNG->CR & RNG_CR_RNGEN)) || ((0 != (RNG->CR & RNG_CR_IE)) != (count < BENCH_WORDS)) )
+    {
+        bench_fail("interrupt enable does not follow the level", step);
+    }
+    for(i = 0; i < BENCH_WORDS; i++)
+    {
+        /* slot i holds a word when it lies between tail and head */
+        if( (((i - g_Pool.tail) & (BENCH_WORDS - 1U)) >= count) && (0 != g_Ring[i]) )
+        {
+            bench_fail("taken word not wiped", step);
+            break;
+        }
+    }
+}
+
+static void bench_read  (
+    uint32_t        size,
+    uint32_t        step    )
+{
+    uint32_t    need    =   (size + 3U) / 4U;
+    int         expect  =   ( (need <= BENCH_WORDS) && (need <= (g_RefHead - g_RefTail)) ) ? 0 : -1;
+    uint32_t    word    =   0;
+    uint32_t    i;
+
+    memset(g_Data, 0xA5, sizeof(g_Data));
+    if(expect != rng_read(&g_Pool, g_Data, size))
+    {
+        bench_fail("read result", step);
+        return;
+    }
+    if(0 != expect)
+    {
+        /* a request over the ring is refused as a bad argument */
+        g_RefStats.empty    +=  (need <= BENCH_WORDS) ? 1U : 0;
+        for(i = 0; i < sizeof(g_Data); i++)
+        {
+            if(0xA5U != g_Data[i])
+            {
+                bench_fail("refused read wrote data", step);
+                break;
+            }
+        }
+        return;
+    }
+    for(i = 0; i < size; i += 4U)
+    {
+        word    =   g_Ref[(g_RefTail + i / 4U) % BENCH_WORDS];
+        if(0 != memcmp(&g_Data[i], &word, ((size - i) < 4U) ? (size - i) : 4U))
+        {
+            bench_fail("data", step);
+            break;
+        }
+    }
+    g_RefTail   +=  need;
+    if(0xA5U != g_Data[size])
+    {
+        bench_fail("read wrote past the end", step);
+    }
+    g_RefStats.reads++;
+    g_RefStats.bytes    +=  size;
+}
+
+/* random events and reads against the reference */
+static void bench_check (void)
+{
+    RNG_STATS   stats;
+    uint32_t    step;
+    uint32_t    pick    =   0;
+    uint32_t    count   =   0;
+    uint32_t    flags   =   0;
+    uint32_t    i;
+
+    printf("check, %u steps on a ring of %u words\n", BENCH_EVENTS, BENCH_WORDS);
+    bench_fill(0, 0);
+    bench_check_state(0);
+    for(step = 1; step <= BENCH_EVENTS; step++)
+    {
+        pick    =   bench_random() % 100U;
+        if(pick < 40U)
+        {
+            count   =   bench_random() % 24U;
+            for(i = 0; i < count; i++)
+            {
+                bench_event(RNG_SR_DRDY, bench_word(), step);
+            }
+        }
+        else if(pick < 85U)
+        {
+            /* mostly within the ring, some over it */
+            bench_read(1U + bench_random() % (BENCH_WORDS * 4U + 8U), step);
+        }
+        else if(pick < 90U)
+        {
+            bench_read(1U + bench_random() % 16U, step);
+        }
+        else if(pick < 94U)
+        {
+            /* a clock error, with a word ready or not */
+            flags   =   RNG_SR_CEIS | RNG_SR_CECS | ((bench_random() & 1U) ? RNG_SR_DRDY : 0);
+            bench_event(flags, bench_word(), step);
+        }
+        else if(pick < 97U)
+        {
+            /* the word in DR must not get into the ring */
+            bench_event(RNG_SR_SEIS | RNG_SR_SECS | RNG_SR_DRDY, bench_word(), step);
+        }
+        else
+        {
+            bench_event(RNG_SR_DRDY, g_RefLast, step);
+        }
+        bench_check_state(step);
+    }
+
+    /* a thread waits for 40 bytes, the interrupt wakes it at the tenth word */
+    bench_read(rng_level(&g_Pool), 0);
+    (void)osThreadFlagsClear(RNG_FLAG_FILL);
+    g_RefStats.empty++;
+    if(-1 != rng_wait(&g_Pool, g_Data, 40U, 0))
+    {
+        bench_fail("wait on an empty ring", 0);
+    }
+    if(g_Pool.waiter)
+    {
+        bench_fail("waiter left after the wait", 0);
+    }
+    g_Pool.waiter   =   osThreadGetId();
+    g_Pool.want     =   10U;
+    for(i = 0; i < 10U; i++)
+    {
+        if(RNG_FLAG_FILL == osThreadFlagsWait(RNG_FLAG_FILL, osFlagsWaitAny, 0))
+        {
+            bench_fail("woken too early", i);
+        }
+        bench_event(RNG_SR_DRDY, bench_word(), i);
+    }
+    if(RNG_FLAG_FILL != osThreadFlagsWait(RNG_FLAG_FILL, osFlagsWaitAny, 0))
+    {
+        bench_fail("not woken", 0);
+    }
+    bench_read(40U, 0);
+    bench_check_state(0);
+
+    rng_stats(&g_Pool, &stats);
+    if(0 != memcmp(&stats, &g_RefStats, sizeof(RNG_STATS)))
+    {
+        bench_fail("counters", 0);
+    }
+    printf("  %u words, %u reads, %u refused, %u seed errors, %u clock errors, %u repeats, %u discarded\n",
+           stats.words, stats.reads, stats.empty, stats.seed_errors, stats.clock_errors,
+           stats.repeats, stats.discarded);
+}
+
+/* host ns of one read of size in the best round, the ring full before each */
+static double bench_time    (
+    uint32_t        size,
+    uint32_t        rounds,
+    uint32_t        low     )
+{
+    double      best    =   0;
+    double      ns      =   0;
+    uint64_t    start   =   0;
+    uint32_t    calls   =   0;
+    uint32_t    r;
+
+    for(r = 0; r < rounds; r++)
+    {
+        bench_fill(r, low);
+        calls   =   0;
+        start   =   bench_ns();
+        while(0 == rng_read(&g_Pool, g_Data, size))
+        {
+            calls++;
+        }
+        ns      =   (double)(bench_ns() - start) / (double)calls;
+        best    =   ( (0 == r) || (ns < best) ) ? ns : best;
+        g_RefTail   =   g_Pool.tail;
+        g_Sink  +=  g_Data[0];
+    }
+    return best;
+}
+
+#else
+
+/* the stand in serves every request that fits the ring */
+static void bench_check (void)
+{
+    RNG_STATS   stats;
+    RNG_POOL    pool;
+    RNG_CONFIG  config      =   { g_Ring, 48U, 0 };
+    uint32_t    first[4];
+    uint32_t    step;
+    uint32_t    size;
+
+    printf("check, %u reads on a ring of %u words\n", BENCH_EVENTS, BENCH_WORDS);
+    if(-1 != rng_init(&pool, &g_RngPortRng, &config))
+    {
+        bench_fail("ring of 48 words taken", 0);
+    }
+    if(rng_level(&g_Pool) != BENCH_WORDS * 4U)
+    {
+        bench_fail("ring not full after init", 0);
+    }
+    if( (-1 != rng_read(&g_Pool, g_Data, BENCH_WORDS * 4U + 1U)) || (0 != rng_read(&g_Pool, NULL, 0)) )
+    {
+        bench_fail("size limits", 0);
+    }
+    (void)rng_read(&g_Pool, first, sizeof(first));
+    for(step = 1; step <= BENCH_EVENTS; step++)
+    {
+        size    =   1U + bench_random() % (BENCH_WORDS * 4U);
+        memset(g_Data, 0xA5, sizeof(g_Data));
+        if( (0 != rng_wait(&g_Pool, g_Data, size, 0)) || (0xA5U != g_Data[size]) )
+        {
+            bench_fail("read", step);
+        }
+        if( (size >= sizeof(first)) && (0 == memcmp(g_Data, first, sizeof(first))) )
+        {
+            bench_fail("same 16 bytes again", step);
+        }
+        if(rng_level(&g_Pool) != BENCH_WORDS * 4U)
+        {
+            bench_fail("ring not topped up", step);
+        }
+    }
+    rng_stats(&g_Pool, &stats);
+    if( (stats.reads != BENCH_EVENTS + 2U) || (stats.empty) )
+    {
+        bench_fail("counters", 0);
+    }
+    printf("  %u words, %u reads, %llu bytes\n", stats.words, stats.reads, (unsigned long long)stats.bytes);
+}
+
+/* host ns of one read of size in the best round of 64 */
+static double bench_time    (
+    uint32_t        size,
+    uint32_t        rounds,
+    uint32_t        low     )
+{
+    double      best    =   0;
+    double      ns      =   0;
+    uint64_t    start   =   0;
+    uint32_t    r;
+    uint32_t    c;
+
+    (void)low;
+    for(r = 0; r < rounds; r++)
+    {
+        start   =   bench_ns();
+        for(c = 0; c < 64U; c++)
+        {
+            (void)rng_read(&g_Pool, g_Data, size);
+            g_Sink  +=  g_Data[0];
+        }
+        ns      =   (double)(bench_ns() - start) / 64.0;
+        best    =   ( (0 == r) || (ns < best) ) ? ns : best;
+    }
+    return best;
+}
+
+#endif
+
+int main    (
+    int             argc,
+    char**          argv    )
+{
+    RNG_CONFIG      config      =   { g_Ring, BENCH_WORDS, 5U };
+    uint32_t        rounds      =   (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000U;
+    double          isr_us      =   (argc > 2) ? strtod(argv[2], NULL) : 0.5;
+    double          copy_cycles =   (argc > 3) ? strtod(argv[3], NULL) : 8.0;
+    double          rng_clocks  =   (argc > 4) ? strtod(argv[4], NULL) : 42.0;
+    double          ns          =   0;
+    double          rate        =   0;
+    double          read_us     =   0;
+    uint32_t        words       =   0;
+    uint32_t        i;
+#ifndef BENCH_STANDIN
+    MODEL_IRQ_STATS irq;
+    double          low_ns      =   0;
+
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(RNG_IRQn, RNG_IRQHandler);
+    /* PLLSAI1 locks at once here */
+    RCC->CR |=  RCC_CR_PLLSAI1RDY;
+#endif
+    if(0 == rounds)
+    {
+        printf("usage: %s [rounds] [isr us] [copy cycles/word] [RNG clocks/word]\n", argv[0]);
+        return 1;
+    }
+    if(0 != rng_init(&g_Pool, &g_RngPortRng, &config))
+    {
+        printf("init failed\n");
+        return 1;
+    }
+#ifndef BENCH_STANDIN
+    if( (LL_RCC_RNG_CLKSOURCE_PLLSAI1 != LL_RCC_GetRNGClockSource(LL_RCC_RNG_CLKSOURCE)) ||
+        (!(RCC->AHB2ENR & RCC_AHB2ENR_RNGEN)) )
+    {
+        bench_fail("RNG clock", 0);
+    }
+    /* clearing the flags at init wrote ones to the read only bits */
+    RNG->SR =   0;
+#endif
+
+    bench_check();
+    printf("  %u wrong\n\n", g_Errors);
+
+    printf("host rng_read, ring full, best of %u rounds\n", rounds);
+    printf("  %6s %10s %10s\n", "bytes", "ns/call", "MB/s");
+    for(i = 0; i < sizeof(g_Sizes) / sizeof(g_Sizes[0]); i++)
+    {
+        ns  =   bench_time(g_Sizes[i], rounds, 0);
+        printf("  %6u %10.1f %10.1f\n", g_Sizes[i], ns, (ns > 0) ? (double)g_Sizes[i] * 1000.0 / ns : 0);
+    }
+#ifndef BENCH_STANDIN
+    model_irq_stats(RNG_IRQn, &irq);
+    printf("  handler %.1f ns a word on this host\n", irq.count ? (double)irq.ns / (double)irq.count : 0);
+    low_ns  =   bench_time(64U, rounds, 1U);
+    ns      =   bench_time(64U, rounds, 0);
+    printf("  64 bytes of words with one set bit %.1f ns, of random words %.1f ns\n\n", low_ns, ns);
+
+    rate    =   BENCH_RNG_CLOCK / rng_clocks;
+    printf("target, %.0f MHz RNG clock, %.0f clocks a word, handler %.2f us, copy %.0f cycles a word\n",
+           BENCH_RNG_CLOCK / 1e6, rng_clocks, isr_us, copy_cycles);
+    printf("  refill at most %.2f Mword/s, %.2f MB/s, the handler takes %.0f %% of the CPU meanwhile\n",
+           rate / 1e6, rate * 4.0 / 1e6, rate * isr_us / 1e6 * 100.0);
+    printf("  %6s %10s %14s %14s\n", "bytes", "read us", "refill us", "CPU us/byte");
+    for(i = 0; i < sizeof(g_Sizes) / sizeof(g_Sizes[0]); i++)
+    {
+        words   =   (g_Sizes[i] + 3U) / 4U;
+        read_us =   (BENCH_LOCK_CYCLES + copy_cycles * words) / BENCH_HCLK * 1e6;
+        printf("  %6u %10.2f %14.2f %14.3f\n", g_Sizes[i], read_us, (double)words / rate * 1e6,
+               (read_us + isr_us * words) / g_Sizes[i]);
+    }
+#else
+    (void)isr_us;
+    (void)copy_cycles;
+    (void)rng_clocks;
+    (void)rate;
+    (void)read_us;
+    (void)words;
+#endif
+    return (0 == g_Errors) ? 0 : 1;
+}
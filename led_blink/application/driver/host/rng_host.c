@@ -0,0 +1,270 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        rng_host.c
+ * @brief       software stand in for drv_rng.c in host builds.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The calls and the pool of drv_rng.h without the RNG. The words come from
+ * xoshiro128** seeded from /dev/urandom, and the ring is topped up at once
+ * where the interrupt would refill it, so every request that fits the ring
+ * is served. The port is never touched. Fine for protocol code on the
+ * host, not for keys.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "drv_rng.h"
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const RNG_PORT g_RngPortRng =
+{
+    RNG,                            /*!< rng */
+    LL_AHB2_GRP1_PERIPH_RNG,        /*!< clock */
+    LL_RCC_RNG_CLKSOURCE_PLLSAI1,   /*!< source */
+    24U,                            /*!< pllsai1_n */
+    RNG_IRQn                        /*!< irq */
+};
+
+static uint32_t g_RngHostState[4];
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Seed the generator from /dev/urandom, or from the clock without it
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void rng_host_seed   (void)
+{
+    FILE*           file    =   fopen("/dev/urandom", "rb");
+    struct timespec ts;
+    size_t          got     =   0;
+
+    if(file)
+    {
+        got =   fread(g_RngHostState, 1, sizeof(g_RngHostState), file);
+        fclose(file);
+    }
+    if(sizeof(g_RngHostState) != got)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        g_RngHostState[0]   =   (uint32_t)ts.tv_nsec;
+        g_RngHostState[1]   =   (uint32_t)ts.tv_sec;
+        g_RngHostState[2]   =   0x9E3779B9U;
+        g_RngHostState[3]   =   0x7F4A7C15U;
+    }
+    /* the all zero state never leaves zero */
+    g_RngHostState[3]   |=  1U;
+}
+
+/** 
+ * @brief               Next word of xoshiro128**
+ * @return              word
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t rng_host_next   (void)
+{
+    uint32_t*   s       =   g_RngHostState;
+    uint32_t    x       =   s[1] * 5U;
+    uint32_t    word    =   ((x << 7) | (x >> 25)) * 9U;
+    uint32_t    t       =   s[1] << 9;
+
+    s[2]    ^=  s[0];
+    s[3]    ^=  s[1];
+    s[1]    ^=  s[2];
+    s[0]    ^=  s[3];
+    s[2]    ^=  t;
+    s[3]    =   (s[3] << 11) | (s[3] >> 21);
+    return word;
+}
+
+/** 
+ * @brief               Top the ring up, what the interrupt does on the target
+ * @param[in]           pool            pool state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void rng_host_fill   (
+    RNG_POOL*           pool    )
+{
+    while((pool->head - pool->tail) <= pool->mask)
+    {
+        pool->buffer[pool->head & pool->mask]   =   rng_host_next();
+        pool->head++;
+        pool->stats.words++;
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Seed the generator and fill the ring
+ * @param[out]          pool            pool state
+ * @param[in]           port            not used
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_init (
+    RNG_POOL*           pool,
+    const RNG_PORT*     port,
+    const RNG_CONFIG*   config  )
+{
+    if( (!pool) || (!port) || (!config) || (!config->buffer) ||
+        (config->words < 2U) || (config->words & (config->words - 1U)) )
+    {
+        return (-1);
+    }
+    memset(pool, 0, sizeof(RNG_POOL));
+    pool->port      =   port;
+    pool->buffer    =   config->buffer;
+    pool->mask      =   config->words - 1U;
+    rng_host_seed();
+    rng_host_fill(pool);
+    return (0);
+}
+
+/**
+ * @brief               Take random bytes from the pool
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @retval              0               all served
+ * @retval              -1              bad arguments, nothing served
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_read (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size    )
+{
+    uint8_t*    out     =   (uint8_t*)data;
+    uint32_t    word    =   0;
+    uint32_t    i;
+
+    if( (!pool) || ( (!data) && (size) ) || ( (size) && ((size - 1U) / 4U > pool->mask) ) )
+    {
+        return (-1);
+    }
+    /* whole words as on the target, the rest of the last one is dropped */
+    for(i = 0; i < size; i += 4U)
+    {
+        word    =   pool->buffer[pool->tail & pool->mask];
+        pool->buffer[pool->tail & pool->mask]   =   0;
+        pool->tail++;
+        memcpy(&out[i], &word, ((size - i) < 4U) ? (size - i) : 4U);
+    }
+    pool->stats.reads++;
+    pool->stats.bytes   +=  size;
+    rng_host_fill(pool);
+    return (0);
+}
+
+/**
+ * @brief               Take random bytes, never waits here
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @param[in]           timeout         not used
+ * @retval              0               all served
+ * @retval              -1              bad arguments, nothing served
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_wait (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size,
+    uint32_t            timeout )
+{
+    (void)timeout;
+    return rng_read(pool, data, size);
+}
+
+/**
+ * @brief               Bytes \ref rng_read can serve now
+ * @param[in]           pool            pool state
+ * @return              bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t rng_level   (
+    RNG_POOL*           pool    )
+{
+    return (pool->head - pool->tail) * 4U;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           pool            pool state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_stats   (
+    RNG_POOL*           pool,
+    RNG_STATS*          stats   )
+{
+    memcpy(stats, &pool->stats, sizeof(RNG_STATS));
+}
+
+/**
+ * @brief               Top the ring up
+ * @param[in]           pool            pool state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_irq_handler (
+    RNG_POOL*           pool    )
+{
+    rng_host_fill(pool);
+}
@@ -0,0 +1,387 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        spi_bench.c
+ * @brief       host benchmark of the queued SPI DMA driver.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_spi.c against the register model on SPI3 with PCLK at 80 MHz
+ * and MOSI looped back to MISO, one byte time of the selected clock per
+ * step. Three devices share the bus: the Wi-Fi module in mode 0 at
+ * 20 MHz with blocks of 64 to 1024 bytes, a sensor in mode 3 at 10 MHz
+ * read as a held command byte and 6 to 12 data bytes, and a flash in mode 0
+ * at 625 kHz with 4 to 64 bytes. Every byte checks the chip selects and the
+ * mode, every transfer its received data.
+ *
+ * The bus stands still while the reception interrupt ends one transfer and
+ * starts the next, and also while a thread wakes to queue more when the
+ * queue ran empty. Both times are assumptions for an 80 MHz Cortex-M4 and
+ * are given on the command line. Bus utilization is the wire time over the
+ * run time for 1, 2 and 4 transactions kept in the queue. A polled driver
+ * keeps the CPU busy for at least the bus utilization. Run "make" in this
+ * directory, then ./spi_bench [seconds] [isr us] [thread wake us].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "periph_model.h"
+#include "drv_spi.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_PCLK          (80000000U)
+#define BENCH_XFERS         (16U)       /*!< descriptors */
+#define BENCH_SIZE_MAX      (1024U)
+#define BENCH_DEVICES       (3U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    SPI_XFER    xfer;
+    uint8_t     tx[BENCH_SIZE_MAX];
+    uint8_t     rx[BENCH_SIZE_MAX];
+    int         last;       /* ends a transaction */
+    int         busy;
+}BENCH_XFER;
+
+typedef struct
+{
+    double      ns;         /* run time */
+    double      wire_ns;    /* clocking bytes */
+    uint32_t    irqs;
+    uint32_t    stalls;     /* the queue ran empty, the bus waited for a thread */
+    uint32_t    bytes;
+}BENCH_RUN;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static SPI          g_Spi;
+static SPI_DEVICE   g_Devices[BENCH_DEVICES] =
+{
+    { GPIOE, LL_GPIO_PIN_0,  SPI_MODE_0, 20000000U, 0 },    /* Wi-Fi */
+    { GPIOD, LL_GPIO_PIN_7,  SPI_MODE_3, 10000000U, 0 },    /* sensor */
+    { GPIOB, LL_GPIO_PIN_12, SPI_MODE_0, 1000000U,  0 }     /* flash */
+};
+static BENCH_XFER   g_Xfers[BENCH_XFERS];
+static uint32_t     g_Pending   =   0;      /* transactions queued */
+static uint32_t     g_Done      =   0;      /* done calls */
+static uint32_t     g_Errors    =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+void SPI3_IRQHandler    (void)
+{
+    spi_irq_handler(&g_Spi);
+}
+
+void DMA2_Channel1_IRQHandler   (void)
+{
+    spi_rx_dma_handler(&g_Spi);
+}
+
+void DMA2_Channel2_IRQHandler   (void)
+{
+    spi_tx_dma_handler(&g_Spi);
+}
+
+/* loopback: what was sent comes back, 0xFF for a NULL tx */
+static void bench_done  (
+    SPI_XFER*   xfer    )
+{
+    BENCH_XFER* bench   =   (BENCH_XFER*)xfer->arg;
+    uint32_t    i;
+
+    if(xfer->status)
+    {
+        g_Errors++;
+    }
+    for(i = 0; (xfer->rx) && (i < xfer->size); i++)
+    {
+        if(xfer->rx[i] != (xfer->tx ? xfer->tx[i] : 0xFFU))
+        {
+            g_Errors++;
+            break;
+        }
+    }
+    if(bench->last)
+    {
+        g_Pending--;
+    }
+    bench->busy =   0;
+    g_Done++;
+}
+
+static BENCH_XFER* bench_get    (void)
+{
+    uint32_t    i;
+
+    for(i = 0; i < BENCH_XFERS; i++)
+    {
+        if(!g_Xfers[i].busy)
+        {
+            g_Xfers[i].busy =   1;
+            return &g_Xfers[i];
+        }
+    }
+    return NULL;
+}
+
+static int bench_queue  (
+    BENCH_XFER*         bench,
+    const SPI_DEVICE*   device,
+    uint32_t            size,
+    uint32_t            flags,
+    int                 tx,
+    int                 rx  )
+{
+    uint32_t    i;
+
+    for(i = 0; (tx) && (i < size); i++)
+    {
+        bench->tx[i]    =   (uint8_t)rand();
+    }
+    memset(&bench->xfer, 0, sizeof(SPI_XFER));
+    bench->xfer.device  =   device;
+    bench->xfer.tx      =   tx ? bench->tx : NULL;
+    bench->xfer.rx      =   rx ? bench->rx : NULL;
+    bench->xfer.size    =   size;
+    bench->xfer.flags   =   flags;
+    bench->xfer.done    =   bench_done;
+    bench->xfer.arg     =   bench;
+    bench->last         =   !(flags & SPI_XFER_HOLD);
+    return spi_submit(&g_Spi, &bench->xfer);
+}
+
+/* a thread queues transactions until depth are pending */
+static void bench_fill  (
+    uint32_t    depth   )
+{
+    BENCH_XFER* cmd     =   NULL;
+    BENCH_XFER* data    =   NULL;
+    uint32_t    pick    =   0;
+
+    while(g_Pending < depth)
+    {
+        cmd     =   bench_get();
+        data    =   bench_get();
+        if( (!cmd) || (!data) )
+        {
+            g_Errors++;
+            return;
+        }
+        pick    =   (uint32_t)rand() % 100U;
+        g_Pending++;
+        if(pick < 50U)
+        {
+            data->busy  =   0;
+            pick        =   (uint32_t)rand() % 10U;
+            (void)bench_queue(cmd, &g_Devices[0], 64U + (uint32_t)rand() % (BENCH_SIZE_MAX - 63U), 0, pick != 0, pick < 8U);
+        }
+        else if(pick < 85U)
+        {
+            (void)bench_queue(cmd, &g_Devices[1], 1U, SPI_XFER_HOLD, 1, 0);
+            (void)bench_queue(data, &g_Devices[1], 6U + (uint32_t)rand() % 7U, 0, 0, 1);
+        }
+        else
+        {
+            data->busy  =   0;
+            (void)bench_queue(cmd, &g_Devices[2], 4U + (uint32_t)rand() % 61U, 0, 1, 1);
+        }
+    }
+    /* pins driven from thread context */
+    model_sync();
+}
+
+/* chip select of the device low and every other high, its mode and clock set */
+static void bench_check (
+    const SPI_DEVICE*   device  )
+{
+    uint32_t    i;
+    int         low     =   0;
+
+    for(i = 0; i < BENCH_DEVICES; i++)
+    {
+        low =   !(g_Devices[i].cs_gpio->ODR & g_Devices[i].cs_pin);
+        if(low != (&g_Devices[i] == device))
+        {
+            g_Errors++;
+        }
+    }
+    if(SPI3->CR1 != (device->cr1 | SPI_CR1_SPE))
+    {
+        g_Errors++;
+    }
+}
+
+/*
+ * One byte on the wire. After a done call the bus stands still for the
+ * handler, the thread it woke queues more while the next transfer runs,
+ * unless the queue ran empty and the bus waits for the thread as well.
+ */
+static void bench_step  (
+    BENCH_RUN*  run,
+    uint32_t    depth,
+    double      isr_ns,
+    double      wake_ns )
+{
+    const SPI_DEVICE*   device  =   NULL;
+    double              byte_ns =   0.0;
+    uint32_t            done    =   g_Done;
+
+    if(!g_Spi.head)
+    {
+        run->stalls++;
+        run->ns +=  wake_ns;
+        bench_fill(depth);
+        return;
+    }
+    device  =   g_Spi.head->device;
+    bench_check(device);
+    byte_ns =   8.0 * (2U << ((SPI3->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos)) * 1e9 / BENCH_PCLK;
+    if( (!model_dma_transfer(DMA2, LL_DMA_CHANNEL_2)) || (!model_dma_transfer(DMA2, LL_DMA_CHANNEL_1)) )
+    {
+        g_Errors++;
+        return;
+    }
+    run->ns         +=  byte_ns;
+    run->wire_ns    +=  byte_ns;
+    run->bytes++;
+    if(done != g_Done)
+    {
+        /* the reception interrupt ran in the transfer call */
+        run->irqs++;
+        run->ns +=  isr_ns;
+        if(g_Spi.head)
+        {
+            bench_fill(depth);
+        }
+    }
+}
+
+static void bench_run   (
+    uint32_t    depth,
+    double      seconds,
+    double      isr_ns,
+    double      wake_ns )
+{
+    MODEL_IRQ_STATS irq;
+    SPI_STATS       before;
+    SPI_STATS       after;
+    BENCH_RUN       run;
+
+    memset(&run, 0, sizeof(run));
+    spi_stats(&g_Spi, &before);
+    while(run.ns < seconds * 1e9)
+    {
+        bench_step(&run, depth, isr_ns, wake_ns);
+    }
+    /* let the queue run dry */
+    while( (g_Spi.head) && (!g_Errors) )
+    {
+        bench_step(&run, 0, isr_ns, wake_ns);
+    }
+    spi_stats(&g_Spi, &after);
+    model_irq_stats(DMA2_Channel1_IRQn, &irq);
+    printf("depth %u %13.0f %10.3f %9.1f%% %9.0f %9.2f%% %9.0f\n", depth,
+           (after.xfers - before.xfers) * 1e9 / run.ns, run.bytes * 1e3 / run.ns,
+           100.0 * run.wire_ns / run.ns, run.stalls * 1e9 / run.ns,
+           100.0 * run.irqs * isr_ns / run.ns,
+           irq.count ? (double)irq.ns / irq.count : 0.0);
+    if( (after.bytes - before.bytes != run.bytes) || (after.errors != before.errors) )
+    {
+        g_Errors++;
+    }
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    static const uint32_t   depths[] = { 1U, 2U, 4U };
+    SPI_CONFIG              config;
+    SPI_STATS               stats;
+    double                  seconds =   (argc > 1) ? atof(argv[1]) : 2.0;
+    double                  isr_us  =   (argc > 2) ? atof(argv[2]) : 2.0;
+    double                  wake_us =   (argc > 3) ? atof(argv[3]) : 10.0;
+    uint32_t                i;
+
+    if( (seconds <= 0.0) || (isr_us < 0.0) || (wake_us < 0.0) )
+    {
+        fprintf(stderr, "usage: spi_bench [seconds] [isr us] [thread wake us]\n");
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(SPI3_IRQn, SPI3_IRQHandler);
+    model_attach(DMA2_Channel1_IRQn, DMA2_Channel1_IRQHandler);
+    model_attach(DMA2_Channel2_IRQn, DMA2_Channel2_IRQHandler);
+    config.pclk     =   BENCH_PCLK;
+    config.priority =   6U;
+    if(0 != spi_init(&g_Spi, &g_SpiPortSpi3, &config))
+    {
+        fprintf(stderr, "spi_init failed\n");
+        return 1;
+    }
+    for(i = 0; i < BENCH_DEVICES; i++)
+    {
+        if(0 != spi_device_init(&g_Spi, &g_Devices[i]))
+        {
+            fprintf(stderr, "spi_device_init failed\n");
+            return 1;
+        }
+    }
+    model_sync();
+    srand(1);
+
+    printf("SPI3 at PCLK %u MHz, %.1f s per depth, isr %.1f us, thread wake %.1f us\n",
+           BENCH_PCLK / 1000000U, seconds, isr_us, wake_us);
+    printf("%-7s %13s %10s %10s %9s %10s %9s\n", "", "transfers/s", "MB/s", "bus util",
+           "stalls/s", "isr load", "host ns");
+    for(i = 0; i < sizeof(depths) / sizeof(depths[0]); i++)
+    {
+        bench_run(depths[i], seconds, isr_us * 1e3, wake_us * 1e3);
+    }
+    spi_stats(&g_Spi, &stats);
+    printf("%u transfers, %u bytes, %u mode or clock changes, %u errors, %u wrong\n",
+           stats.xfers, stats.bytes, stats.reconfigs, stats.errors, g_Errors);
+    return (g_Errors) ? 1 : 0;
+}
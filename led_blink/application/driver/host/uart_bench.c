@@ -0,0 +1,349 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        uart_bench.c
+ * @brief       host benchmark of the DMA USART driver.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs drv_uart.c against the register model at 921600 baud, 8N1, one
+ * byte time per step, in both directions at once. Reception is framed
+ * traffic with idle gaps and then an unbroken stream, transmission keeps
+ * the descriptor queue full. A reader drains the stream buffer every
+ * simulated millisecond and checks every byte. For comparison the same
+ * bytes go through a handler taking one interrupt per byte. Interrupt rate
+ * and host time in the handlers are reported per simulated second; the
+ * load on the target scales with the rate. Run "make" in this directory,
+ * then ./uart_bench [seconds] [dma buffer bytes].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "periph_model.h"
+#include "drv_uart.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_BAUDRATE      (921600U)
+#define BENCH_BYTE_RATE     (BENCH_BAUDRATE / 10U)      /*!< 8N1 */
+#define BENCH_DMA_MAX       (4096U)
+#define BENCH_STORAGE       (2048U)
+#define BENCH_FRAME_MAX     (256U)
+#define BENCH_READ_EVERY    (BENCH_BYTE_RATE / 1000U)   /*!< reader runs every millisecond */
+#define BENCH_TX_COUNT      (4U)
+#define BENCH_TX_SIZE       (128U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    uint32_t    next;       /* position of the next byte in the pattern */
+    uint32_t    bytes;
+    uint32_t    errors;
+}BENCH_CHECK;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static UART         g_Uart;
+static uint8_t      g_Dma[BENCH_DMA_MAX];
+static uint8_t      g_Storage[BENCH_STORAGE];
+static UART_TX      g_Tx[BENCH_TX_COUNT];
+static uint8_t      g_TxData[BENCH_TX_COUNT][BENCH_TX_SIZE];
+static uint32_t     g_TxFree    =   (1U << BENCH_TX_COUNT) - 1U;
+static uint32_t     g_TxNext    =   0;
+static BENCH_CHECK  g_RxCheck;
+static BENCH_CHECK  g_TxCheck;
+
+/* reference: one interrupt per byte into a stream buffer of its own */
+static StreamBufferHandle_t g_ByteRx;
+static StaticStreamBuffer_t g_ByteRxCb;
+static uint8_t              g_ByteStorage[BENCH_STORAGE];
+static BENCH_CHECK          g_ByteCheck;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static uint8_t bench_pattern    (
+    uint32_t    pos )
+{
+    return (uint8_t)(pos * 7U + (pos >> 8));
+}
+
+void USART1_IRQHandler  (void)
+{
+    uart_irq_handler(&g_Uart);
+}
+
+void DMA1_Channel5_IRQHandler   (void)
+{
+    uart_rx_dma_handler(&g_Uart);
+}
+
+void DMA1_Channel4_IRQHandler   (void)
+{
+    uart_tx_dma_handler(&g_Uart);
+}
+
+/* what a driver without DMA does at least for every byte */
+void USART2_IRQHandler  (void)
+{
+    StreamBufferSpans_t spans;
+    BaseType_t          woken   =   pdFALSE;
+    uint8_t             data    =   (uint8_t)USART2->RDR;
+
+    if(xStreamBufferAcquireWriteFromISR(g_ByteRx, &spans))
+    {
+        spans.pucData[0][0] =   data;
+        (void)xStreamBufferCommitWriteFromISR(g_ByteRx, 1U, &woken);
+    }
+}
+
+static void bench_tx_done   (
+    UART_TX*    tx  )
+{
+    g_TxFree    |=  1U << (uint32_t)(tx - g_Tx);
+}
+
+/* reader: check what arrived in place, then keep the transmit queue full */
+static void bench_task  (void)
+{
+    StreamBufferSpans_t spans;
+    BENCH_CHECK*        check   =   NULL;
+    StreamBufferHandle_t stream =   NULL;
+    uint32_t            count   =   0;
+    uint32_t            i, j, k;
+
+    for(k = 0; k < 2U; k++)
+    {
+        stream  =   (0 == k) ? uart_rx_stream(&g_Uart) : g_ByteRx;
+        check   =   (0 == k) ? &g_RxCheck : &g_ByteCheck;
+        count   =   (uint32_t)xStreamBufferAcquireRead(stream, &spans, 0);
+        for(i = 0; i < 2U; i++)
+        {
+            for(j = 0; j < spans.xLength[i]; j++)
+            {
+                if(spans.pucData[i][j] != bench_pattern(check->next))
+                {
+                    check->errors++;
+                }
+                check->next++;
+            }
+        }
+        check->bytes    +=  count;
+        (void)xStreamBufferReleaseRead(stream, count);
+    }
+    for(i = 0; i < BENCH_TX_COUNT; i++)
+    {
+        if(g_TxFree & (1U << i))
+        {
+            for(j = 0; j < BENCH_TX_SIZE; j++)
+            {
+                g_TxData[i][j]  =   bench_pattern(g_TxNext++);
+            }
+            g_TxFree        &=  ~(1U << i);
+            g_Tx[i].data    =   g_TxData[i];
+            g_Tx[i].size    =   BENCH_TX_SIZE;
+            g_Tx[i].done    =   bench_tx_done;
+            if(0 != uart_send(&g_Uart, &g_Tx[i]))
+            {
+                g_TxCheck.errors++;
+            }
+        }
+    }
+}
+
+/* one byte time on the wire */
+static void bench_step  (
+    uint32_t    step,
+    int         receive,
+    int         idle    )
+{
+    static uint32_t rx  =   0;
+
+    if(receive)
+    {
+        USART1->RDR =   bench_pattern(rx);
+        USART2->RDR =   bench_pattern(rx);
+        rx++;
+        if(!model_dma_transfer(DMA1, LL_DMA_CHANNEL_5))
+        {
+            g_RxCheck.errors++;
+        }
+        (void)model_raise(USART2_IRQn);
+    }
+    else if(idle)
+    {
+        USART1->ISR |=  USART_ISR_IDLE;
+        if(USART1->CR1 & USART_CR1_IDLEIE)
+        {
+            (void)model_raise(USART1_IRQn);
+        }
+    }
+    if(model_dma_transfer(DMA1, LL_DMA_CHANNEL_4))
+    {
+        if((uint8_t)USART1->TDR != bench_pattern(g_TxCheck.next))
+        {
+            g_TxCheck.errors++;
+        }
+        g_TxCheck.next++;
+        g_TxCheck.bytes++;
+    }
+    if(0 == (step % BENCH_READ_EVERY))
+    {
+        bench_task();
+    }
+}
+
+static void bench_report    (
+    const char*     name,
+    IRQn_Type       irq,
+    double          seconds,
+    uint32_t        bytes   )
+{
+    MODEL_IRQ_STATS stats;
+
+    model_irq_stats(irq, &stats);
+    printf("%-26s %10.0f %10.1f %10.0f %9.2f%%\n", name, (double)stats.count / seconds,
+           stats.count ? (double)bytes / (double)stats.count : 0.0,
+           stats.count ? (double)stats.ns / (double)stats.count : 0.0,
+           (double)stats.ns / (seconds * 1e7));
+}
+
+/* RX figures of a phase, the TX channel runs all along */
+static void bench_phase (
+    const char*     name,
+    uint32_t        steps,
+    int             framed  )
+{
+    MODEL_IRQ_STATS rx_dma;
+    MODEL_IRQ_STATS rx_irq;
+    double          seconds =   (double)steps / BENCH_BYTE_RATE;
+    uint32_t        bytes   =   g_RxCheck.bytes;
+    uint32_t        frame   =   0;
+    uint32_t        gap     =   0;
+    uint32_t        step    =   0;
+
+    for(step = 1; step <= steps; step++)
+    {
+        if( (framed) && (0 == frame) && (0 == gap) )
+        {
+            frame   =   1U + (uint32_t)rand() % BENCH_FRAME_MAX;
+            gap     =   1U + (uint32_t)rand() % 4U;
+        }
+        if( (!framed) || (frame) )
+        {
+            bench_step(step, 1, 0);
+            if(frame)
+            {
+                frame--;
+            }
+        }
+        else
+        {
+            bench_step(step, 0, 1);
+            gap--;
+        }
+    }
+    bench_task();
+    bytes   =   g_RxCheck.bytes - bytes;
+    model_irq_stats(DMA1_Channel5_IRQn, &rx_dma);
+    model_irq_stats(USART1_IRQn, &rx_irq);
+    printf("%-26s %10.0f %10.1f %10.0f %9.2f%%\n", name, (double)(rx_dma.count + rx_irq.count) / seconds,
+           (rx_dma.count + rx_irq.count) ? (double)bytes / (double)(rx_dma.count + rx_irq.count) : 0.0,
+           (rx_dma.count + rx_irq.count) ? (double)(rx_dma.ns + rx_irq.ns) / (double)(rx_dma.count + rx_irq.count) : 0.0,
+           (double)(rx_dma.ns + rx_irq.ns) / (seconds * 1e7));
+    bench_report("  rx one irq per byte", USART2_IRQn, seconds, bytes);
+}
+
+int main    (
+    int     argc,
+    char*   argv[]  )
+{
+    UART_CONFIG config;
+    UART_STATS  stats;
+    double      seconds     =   (argc > 1) ? atof(argv[1]) : 10.0;
+    uint32_t    dma_size    =   (argc > 2) ? (uint32_t)atoi(argv[2]) : 256U;
+    uint32_t    steps       =   0;
+    uint32_t    tx_bytes    =   0;
+
+    if( (seconds <= 0.0) || (dma_size < 2U) || (dma_size > BENCH_DMA_MAX) || (dma_size & 1U) )
+    {
+        fprintf(stderr, "usage: uart_bench [seconds] [even dma buffer bytes up to %u]\n", BENCH_DMA_MAX);
+        return 1;
+    }
+    if(0 != model_init())
+    {
+        return 1;
+    }
+    model_attach(USART1_IRQn, USART1_IRQHandler);
+    model_attach(DMA1_Channel5_IRQn, DMA1_Channel5_IRQHandler);
+    model_attach(DMA1_Channel4_IRQn, DMA1_Channel4_IRQHandler);
+    model_attach(USART2_IRQn, USART2_IRQHandler);
+    NVIC_EnableIRQ(USART2_IRQn);
+    g_ByteRx    =   xStreamBufferCreateStatic(sizeof(g_ByteStorage) - 1U, 1U, g_ByteStorage, &g_ByteRxCb);
+
+    memset(&config, 0, sizeof(config));
+    config.baudrate     =   BENCH_BAUDRATE;
+    config.dma          =   g_Dma;
+    config.dma_size     =   dma_size;
+    config.storage      =   g_Storage;
+    config.storage_size =   sizeof(g_Storage);
+    config.trigger      =   1U;
+    config.priority     =   6U;
+    if(0 != uart_init(&g_Uart, &g_UartPortUsart1, &config))
+    {
+        fprintf(stderr, "uart_init failed\n");
+        return 1;
+    }
+
+    steps   =   (uint32_t)(seconds * BENCH_BYTE_RATE);
+    printf("%u baud 8N1, %u byte/s, %.1f s per phase, dma buffer %u bytes\n",
+           BENCH_BAUDRATE, BENCH_BYTE_RATE, seconds, dma_size);
+    printf("%-26s %10s %10s %10s %10s\n", "", "irq/s", "bytes/irq", "ns/irq", "host load");
+    bench_phase("rx frames 1-256, idle gaps", steps, 1);
+    bench_phase("rx continuous", steps, 0);
+    tx_bytes    =   g_TxCheck.bytes;
+    bench_report("tx queued 128 byte blocks", DMA1_Channel4_IRQn, 2.0 * seconds, tx_bytes);
+
+    uart_stats(&g_Uart, &stats);
+    printf("rx %u delivered, %u dropped, %u checked, %u wrong, %u in %u events\n",
+           stats.rx_bytes, stats.rx_dropped, g_RxCheck.bytes, g_RxCheck.errors, stats.rx_bytes, stats.rx_events);
+    printf("tx %u sent in %u blocks, %u checked, %u wrong\n",
+           stats.tx_bytes, stats.tx_done, g_TxCheck.bytes, g_TxCheck.errors);
+    printf("reference %u checked, %u wrong\n", g_ByteCheck.bytes, g_ByteCheck.errors);
+    return ( (g_RxCheck.errors) || (g_TxCheck.errors) || (g_ByteCheck.errors) || (stats.rx_dropped) ) ? 1 : 0;
+}
@@ -0,0 +1,321 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_adc.h
+ * @brief       Timer triggered multi channel ADC acquisition into circular DMA blocks.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The timer update event starts one pass over the channel sequence, the
+ * DMA writes the results into a caller owned buffer of two blocks in
+ * circular mode. The half transfer interrupt hands the first block to the
+ * consumer thread and the transfer complete interrupt the second, so the
+ * CPU sees two interrupts per buffer and no sample passes through it.
+ *
+ * The hardware oversampler converts every channel of a pass ratio times
+ * back to back and sums and shifts the results. The DMA and the CPU see the
+ * pass rate, not the conversion rate, and the averaging costs nothing.
+ *
+ * Zero copy: \ref adc_acquire lends the consumer the newest full block in
+ * place and \ref adc_release gives it back. The DMA fills the other block
+ * meanwhile, a consumer that holds a block longer than one block time has
+ * it overwritten, which the release reports. A block nobody acquired before
+ * the next one completes is dropped, the consumer always gets the newest.
+ *
+ * The vector table handlers call \ref adc_dma_handler and
+ * \ref adc_irq_handler, both at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_ADC_H_
+#define _DRV_ADC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_adc.h"
+#include "stm32l4xx_ll_dma.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "cmsis_os2.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref adc_acquire waits on */
+#ifndef ADC_FLAG_BLOCK
+#define ADC_FLAG_BLOCK      0x00100000U
+#endif
+
+/** Ticks \ref adc_init waits for the calibration and the enable */
+#ifndef ADC_WAIT_TICKS
+#define ADC_WAIT_TICKS      10U
+#endif
+
+/** Busy loop bound of a conversion stop in the overrun interrupt */
+#ifndef ADC_STOP_SPIN
+#define ADC_STOP_SPIN       1000U
+#endif
+
+#define ADC_INPUTS_MAX      16U         /*!< ranks of the regular sequence */
+
+/* ADC_INPUT channel of the internal inputs, no pin */
+#define ADC_VREFINT         0U
+#define ADC_TEMPSENSOR      17U
+#define ADC_VBAT            18U
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Hardware of one ADC and the timer and DMA channel that serve it
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    ADC_TypeDef*        adc;
+    ADC_Common_TypeDef* common;
+    IRQn_Type           irq;
+    uint32_t            clock;          /*!< LL_AHB2_GRP1_PERIPH_ADC */
+    TIM_TypeDef*        tim;
+    uint32_t            tim_clock;      /*!< LL_APB2_GRP1_PERIPH_TIMx */
+    uint32_t            trigger;        /*!< LL_ADC_REG_TRIG_EXT_TIMx_TRGO */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            request;        /*!< LL_DMA_REQUEST_x */
+    uint32_t            channel;        /*!< LL_DMA_CHANNEL_x */
+    IRQn_Type           dma_irq;
+}ADC_PORT;
+
+/**
+ * @brief      One rank of the sequence
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            channel;        /*!< 0 to 18, \ref ADC_VREFINT, ... */
+    GPIO_TypeDef*       gpio;           /*!< port of the pin, NULL for an internal input */
+    uint32_t            pin;            /*!< pin number 0 to 15 */
+}ADC_INPUT;
+
+/**
+ * @brief      Driver configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const ADC_INPUT*    inputs;         /*!< sequence in rank order */
+    uint32_t            count;          /*!< 1 to \ref ADC_INPUTS_MAX */
+    uint32_t            sampling;       /*!< LL_ADC_SAMPLINGTIME_x of every input */
+    uint32_t            ratio;          /*!< oversampling 1 (off), 2, 4, ... 256 */
+    uint32_t            shift;          /*!< right shift of the sum, 0 to 8, at most 16 bits must remain */
+    uint32_t            rate;           /*!< Hz of the passes over the sequence */
+    uint32_t            hclk;           /*!< Hz, the ADC runs on HCLK / 1, the AHB prescaler must be 1 */
+    uint32_t            tim_clk;        /*!< Hz of the timer kernel clock */
+    uint16_t*           buffer;         /*!< two blocks of passes x count results */
+    uint32_t            passes;         /*!< passes of one block */
+    uint32_t            priority;       /*!< NVIC priority of both interrupts */
+}ADC_CONFIG;
+
+/**
+ * @brief      Block lent to the consumer by \ref adc_acquire
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const uint16_t*     data;           /*!< passes x count results, rank order within a pass */
+    uint32_t            size;           /*!< results */
+    uint32_t            seq;            /*!< 1 for the first block after \ref adc_start, gaps are drops */
+    uint32_t            half;           /*!< 0 or 1, for \ref adc_release */
+}ADC_BLOCK;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            blocks;         /*!< blocks the DMA filled */
+    uint32_t            acquired;       /*!< blocks lent to the consumer */
+    uint32_t            dropped;        /*!< blocks replaced before anybody acquired them */
+    uint32_t            overwritten;    /*!< blocks the DMA wrote while the consumer held them */
+    uint32_t            overruns;       /*!< ADC overruns, the acquisition restarted */
+    uint32_t            errors;         /*!< DMA transfer errors, the acquisition stopped */
+}ADC_STATS;
+
+/**
+ * @brief      Driver state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const ADC_PORT*     port;
+    uint16_t*           buffer;
+    uint32_t            size;           /*!< results of one block */
+    int                 ready;          /*!< half waiting for \ref adc_acquire, -1 none */
+    int                 held;           /*!< half the consumer holds, -1 none */
+    uint32_t            torn;           /*!< the held half was written meanwhile */
+    uint32_t            seq;            /*!< blocks since \ref adc_start */
+    osThreadId_t        waiter;         /*!< thread in \ref adc_acquire */
+    ADC_STATS           stats;
+}ADC;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** ADC1 triggered by TIM15, DMA1 channel 1 */
+extern const ADC_PORT g_AdcPortAdc1;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Calibrate and enable the ADC, set up the sequence, the timer and the DMA channel
+ * @param[out]          adc             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail, bad configuration or the ADC did not come up
+ * @note                Thread context, sleeps some ticks. Fails when a pass of
+ *                      ratio x count conversions does not fit the period of rate.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_init (
+    ADC*                adc,
+    const ADC_PORT*     port,
+    const ADC_CONFIG*   config
+);
+
+/**
+ * @brief               Start the timer and the acquisition from the first block
+ * @param[in]           adc             driver state
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_start    (
+    ADC*                adc
+);
+
+/**
+ * @brief               Stop the timer, the conversions and the DMA
+ * @param[in]           adc             driver state
+ * @return              None
+ * @note                A block the consumer holds stays valid
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_stop    (
+    ADC*                adc
+);
+
+/**
+ * @brief               Wait for the next full block and borrow it
+ * @param[in]           adc             driver state
+ * @param[out]          block           the block, valid until \ref adc_release
+ * @param[in]           timeout         ticks
+ * @retval              0               success
+ * @retval              -1              timeout, or a block is still held
+ * @note                One consumer thread, waits on thread flag \ref ADC_FLAG_BLOCK
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_acquire  (
+    ADC*                adc,
+    ADC_BLOCK*          block,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Give a block back
+ * @param[in]           adc             driver state
+ * @param[in]           block           from \ref adc_acquire
+ * @retval              0               the block stayed intact while held
+ * @retval              -1              the DMA wrote into it, the results read from it are mixed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_release  (
+    ADC*                adc,
+    const ADC_BLOCK*    block
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           adc             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_stats   (
+    ADC*                adc,
+    ADC_STATS*          stats
+);
+
+/**
+ * @brief               DMA channel interrupt: a block is full, or a transfer error
+ * @param[in]           adc             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_dma_handler (
+    ADC*                adc
+);
+
+/**
+ * @brief               ADC interrupt: overrun, restarts the acquisition at the first block
+ * @param[in]           adc             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_irq_handler (
+    ADC*                adc
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_ADC_H_ */
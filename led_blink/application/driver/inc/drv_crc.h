@@ -0,0 +1,263 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_crc.h
+ * @brief       CRC unit fed by memory to memory DMA, with the tables of crc_soft for short inputs.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * One engine owns the CRC unit and a DMA channel. Every call gives the
+ * algorithm as a \ref CRC_SOFT, so frame checks and image checks of
+ * different algorithms share the unit, one call at a time.
+ *
+ * Inputs shorter than dma_min, and algorithms whose width the unit does not
+ * have, are computed with the tables. Longer ones go to the unit by memory
+ * to memory DMA, in blocks of up to 65535 items:
+ * - With reflected input the DMA moves aligned words and the unit reverses
+ *   their bits. The CPU takes the unaligned head and tail bytes, the head
+ *   goes into the INIT value and the tail goes on from the unit result.
+ * - Otherwise the DMA moves bytes, because the unit takes a word from its
+ *   top byte.
+ * The output reflection and the final XOR are done in software, for every
+ * width the same way, so both paths give identical results.
+ *
+ * \ref crc_begin starts and returns, \ref crc_end waits for the result, so
+ * the caller may work on in between. The vector table handler of the DMA
+ * channel calls \ref crc_dma_handler, at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_CRC_H_
+#define _DRV_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_crc.h"
+#include "stm32l4xx_ll_dma.h"
+#include "cmsis_os2.h"
+#include "crc_soft.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref crc_end waits on */
+#ifndef CRC_FLAG_DONE
+#define CRC_FLAG_DONE       0x00020000U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      CRC unit and the DMA channel that feeds it
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    CRC_TypeDef*        crc;
+    uint32_t            clock;          /*!< LL_AHB1_GRP1_PERIPH_CRC */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            dma_channel;    /*!< LL_DMA_CHANNEL_x, any free one */
+    IRQn_Type           dma_irq;
+}CRC_PORT;
+
+/**
+ * @brief      Engine configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            dma_min;        /*!< bytes from which the unit computes, e.g. 256, see crc_bench */
+    uint32_t            priority;       /*!< NVIC priority of the DMA interrupt */
+}CRC_CONFIG;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            calls;
+    uint32_t            soft;           /*!< calls computed with the tables */
+    uint32_t            dma;            /*!< calls computed by the unit */
+    uint32_t            blocks;         /*!< DMA blocks */
+    uint64_t            bytes;          /*!< bytes the DMA moved */
+    uint32_t            timeouts;       /*!< \ref crc_end gave up, the transfer was stopped */
+    uint32_t            errors;         /*!< DMA transfer errors */
+}CRC_STATS;
+
+/**
+ * @brief      Engine state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const CRC_PORT*     port;
+    uint32_t            dma_min;
+    const CRC_SOFT*     soft;           /*!< algorithm of the call */
+    const uint8_t*      next;           /*!< source of the next DMA block */
+    uint32_t            left;           /*!< items not yet given to the DMA */
+    uint32_t            item;           /*!< bytes of an item, 1 or 4 */
+    const uint8_t*      tail;           /*!< bytes after the last word */
+    uint32_t            tail_size;
+    uint32_t            result;         /*!< CRC of a call computed with the tables */
+    uint32_t            busy;           /*!< between \ref crc_begin and \ref crc_end */
+    uint32_t            unit;           /*!< the unit computes the call */
+    uint32_t            done;
+    uint32_t            error;
+    osThreadId_t        waiter;         /*!< thread in \ref crc_end */
+    CRC_STATS           stats;
+}CRC_ENGINE;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** CRC unit fed by DMA2 channel 3 */
+extern const CRC_PORT g_CrcPortCrc;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Enable the CRC unit and configure the DMA channel
+ * @param[out]          engine          engine state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_init (
+    CRC_ENGINE*         engine,
+    const CRC_PORT*     port,
+    const CRC_CONFIG*   config
+);
+
+/**
+ * @brief               Start the CRC of a buffer
+ * @param[in]           engine          engine state
+ * @param[in]           soft            algorithm and tables, valid until \ref crc_end
+ * @param[in]           data            bytes, valid until \ref crc_end
+ * @param[in]           size            bytes
+ * @retval              0               started, or done with the tables
+ * @retval              -1              bad arguments, or a call is not ended
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_begin    (
+    CRC_ENGINE*         engine,
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size
+);
+
+/**
+ * @brief               Wait for the CRC started by \ref crc_begin
+ * @param[in]           engine          engine state
+ * @param[in]           timeout         ticks
+ * @param[out]          crc             CRC
+ * @retval              0               success
+ * @retval              -1              nothing started, timeout or DMA error, the call is ended anyway
+ * @note                Thread context, waits on thread flag \ref CRC_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_end  (
+    CRC_ENGINE*         engine,
+    uint32_t            timeout,
+    uint32_t*           crc
+);
+
+/**
+ * @brief               CRC of a buffer, \ref crc_begin and \ref crc_end
+ * @param[in]           engine          engine state
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @param[in]           timeout         ticks
+ * @param[out]          crc             CRC
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_calc (
+    CRC_ENGINE*         engine,
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size,
+    uint32_t            timeout,
+    uint32_t*           crc
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           engine          engine state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void crc_stats   (
+    CRC_ENGINE*         engine,
+    CRC_STATS*          stats
+);
+
+/**
+ * @brief               DMA channel interrupt: next block, end or transfer error
+ * @param[in]           engine          engine state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void crc_dma_handler (
+    CRC_ENGINE*         engine
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_CRC_H_ */
@@ -0,0 +1,336 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_dac.h
+ * @brief       DAC waveform generator, timer paced DMA from looping tables and streams.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The update event of the timer converts one sample, the conversion asks
+ * the DMA for the next one. The CPU does nothing per sample and the timer
+ * alone sets the sample times, so thread scheduling adds no jitter.
+ *
+ * A table loops in circular DMA without any interrupt. \ref dac_play swaps
+ * to another table, or \ref dac_stream to a stream, at the end of the one
+ * playing: the transfer complete interrupt of its last sample points the
+ * channel to the new source before the next conversion asks for a sample,
+ * so the last sample of the old and the first of the new one follow each
+ * other one period apart. That takes the interrupt less than a sample
+ * period, a swap that came later is counted. \ref dac_sync tells when the
+ * old source is no longer read.
+ *
+ * A stream is a caller buffer of two halves. The DMA plays one half while
+ * the producer refills the other through \ref dac_stream_get and
+ * \ref dac_stream_put. A half the producer did not refill in time plays
+ * again and is counted.
+ *
+ * \ref dac_period changes the sample rate through the preloaded timer
+ * registers, at the next sample boundary. The vector table handlers call
+ * \ref dac_dma_handler, and \ref dac_irq_handler of both channels from
+ * TIM6_DAC_IRQHandler, at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_DAC_H_
+#define _DRV_DAC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_dac.h"
+#include "stm32l4xx_ll_dma.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "cmsis_os2.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref dac_sync waits on */
+#ifndef DAC_FLAG_SWAP
+#define DAC_FLAG_SWAP       0x00080000U
+#endif
+
+/** Thread flag \ref dac_stream_get waits on */
+#ifndef DAC_FLAG_HALF
+#define DAC_FLAG_HALF       0x00040000U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Hardware of one DAC channel and the timer and DMA channel that serve it
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    DAC_TypeDef*        dac;
+    uint32_t            channel;        /*!< LL_DAC_CHANNEL_x */
+    IRQn_Type           irq;            /*!< underrun */
+    uint32_t            clock;          /*!< LL_APB1_GRP1_PERIPH_DAC1 */
+    TIM_TypeDef*        tim;
+    uint32_t            tim_clock;      /*!< LL_APB1_GRP1_PERIPH_TIMx */
+    uint32_t            trigger;        /*!< LL_DAC_TRIG_EXT_TIMx_TRGO */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            request;        /*!< LL_DMA_REQUEST_x */
+    uint32_t            dma_channel;    /*!< LL_DMA_CHANNEL_x */
+    IRQn_Type           dma_irq;
+    GPIO_TypeDef*       gpio;
+    uint32_t            gpio_clock;     /*!< LL_AHB2_GRP1_PERIPH_GPIOx */
+    uint32_t            pin;            /*!< pin number 0 to 15 */
+}DAC_PORT;
+
+/**
+ * @brief      Driver configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            period;         /*!< timer clocks per sample, e.g. from wavetable_fit */
+    uint32_t            unbuffered;     /*!< 1 bypasses the output buffer for a high impedance load */
+    uint32_t            priority;       /*!< NVIC priority of both interrupts */
+}DAC_CONFIG;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            swaps;          /*!< sources swapped at the end of the one playing */
+    uint32_t            late;           /*!< swaps after the old source began again */
+    uint32_t            halves;         /*!< stream halves played */
+    uint32_t            underflows;     /*!< stream halves played again, not refilled */
+    uint32_t            underruns;      /*!< DMA underruns, the source restarted */
+    uint32_t            errors;         /*!< DMA transfer errors, the output stopped */
+}DAC_STATS;
+
+/**
+ * @brief      Driver state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const DAC_PORT*     port;
+    const uint16_t*     data;           /*!< source playing */
+    uint32_t            size;           /*!< its samples */
+    uint32_t            half;           /*!< samples of a stream half, 0 for a table */
+    const uint16_t*     next_data;      /*!< source waiting for the end of the one playing */
+    uint32_t            next_size;
+    uint32_t            next_half;
+    uint32_t            pending;        /*!< a swap waits */
+    uint32_t            free;           /*!< stream halves to refill, bit 0 and bit 1 */
+    uint32_t            fill;           /*!< stream half the producer fills next */
+    uint32_t            running;
+    osThreadId_t        waiter;         /*!< thread in \ref dac_sync */
+    osThreadId_t        producer;       /*!< thread in \ref dac_stream_get */
+    DAC_STATS           stats;
+}DAC_OUT;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** DAC channel 1 on PA4, TIM6, DMA2 channel 4 */
+extern const DAC_PORT g_DacPortOut1;
+
+/** DAC channel 2 on PA5, TIM7, DMA2 channel 5 */
+extern const DAC_PORT g_DacPortOut2;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the DAC channel, its timer and DMA channel
+ * @param[out]          dac             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                The output holds 0 until a source plays
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_init (
+    DAC_OUT*            dac,
+    const DAC_PORT*     port,
+    const DAC_CONFIG*   config
+);
+
+/**
+ * @brief               Loop a table, now or at the end of the source playing
+ * @param[in]           dac             driver state
+ * @param[in]           samples         12 bit right aligned
+ * @param[in]           size            1 to 65535
+ * @retval              0               playing or swapping at the end of the source playing
+ * @retval              -1              bad arguments, or a swap still waits
+ * @note                The table must stay valid while it plays. The first
+ *                      sample after a start repeats the value the output held.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_play (
+    DAC_OUT*            dac,
+    const uint16_t*     samples,
+    uint32_t            size
+);
+
+/**
+ * @brief               Stream from a buffer of two halves, now or at the end of the source playing
+ * @param[in]           dac             driver state
+ * @param[in]           buffer          2 x half samples, filled
+ * @param[in]           half            1 to 32767
+ * @retval              0               playing or swapping at the end of the source playing
+ * @retval              -1              bad arguments, or a swap still waits
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_stream   (
+    DAC_OUT*            dac,
+    uint16_t*           buffer,
+    uint32_t            half
+);
+
+/**
+ * @brief               Wait until the swap of \ref dac_play or \ref dac_stream took place
+ * @param[in]           dac             driver state
+ * @param[in]           timeout         ticks
+ * @retval              0               no swap waits, the old source is free
+ * @retval              -1              timeout, the swap is called off and the old source plays on
+ * @note                Thread context, waits on thread flag \ref DAC_FLAG_SWAP
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_sync (
+    DAC_OUT*            dac,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Wait for a stream half to refill
+ * @param[in]           dac             driver state
+ * @param[in]           timeout         ticks
+ * @return              the half, NULL on timeout or when no stream plays
+ * @note                One producer thread, waits on thread flag \ref DAC_FLAG_HALF
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint16_t* dac_stream_get (
+    DAC_OUT*            dac,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Hand back the half \ref dac_stream_get gave
+ * @param[in]           dac             driver state
+ * @retval              0               success
+ * @retval              -1              no half was taken
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_stream_put   (
+    DAC_OUT*            dac
+);
+
+/**
+ * @brief               Change the sample rate at the next sample boundary
+ * @param[in]           dac             driver state
+ * @param[in]           period          timer clocks per sample, 2 or more
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_period   (
+    DAC_OUT*            dac,
+    uint32_t            period
+);
+
+/**
+ * @brief               Stop the timer and the DMA, the output holds its value
+ * @param[in]           dac             driver state
+ * @return              None
+ * @note                A waiting swap is called off
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_stop    (
+    DAC_OUT*            dac
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           dac             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_stats   (
+    DAC_OUT*            dac,
+    DAC_STATS*          stats
+);
+
+/**
+ * @brief               DMA channel interrupt: end of a source or of a stream half, transfer error
+ * @param[in]           dac             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_dma_handler (
+    DAC_OUT*            dac
+);
+
+/**
+ * @brief               DAC underrun interrupt of the channel, restarts the source
+ * @param[in]           dac             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_irq_handler (
+    DAC_OUT*            dac
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_DAC_H_ */
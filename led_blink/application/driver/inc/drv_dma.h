@@ -0,0 +1,140 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_dma.h
+ * @brief       DMA channel flag helpers shared by the drivers.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The LL flag functions are named after a fixed channel. The drivers take
+ * their channel from a port description, so they read and clear the four
+ * flags of a channel shifted down to bit 0 instead.
+ */
+
+#ifndef _DRV_DMA_H_
+#define _DRV_DMA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_dma.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* Flags of one channel, see \ref drv_dma_flags */
+#define DRV_DMA_GI          0x1U        /*!< global, any of the others */
+#define DRV_DMA_TC          0x2U        /*!< transfer complete */
+#define DRV_DMA_HT          0x4U        /*!< half transfer */
+#define DRV_DMA_TE          0x8U        /*!< transfer error, the channel is disabled */
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Read the flags of a channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         LL_DMA_CHANNEL_1 to LL_DMA_CHANNEL_7
+ * @return              \ref DRV_DMA_GI, ...
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static inline uint32_t drv_dma_flags    (
+    DMA_TypeDef*        dma,
+    uint32_t            channel )
+{
+    return ((READ_REG(dma->ISR) >> ((channel - 1U) * 4U)) & 0xFU);
+}
+
+/**
+ * @brief               Clear flags of a channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         LL_DMA_CHANNEL_1 to LL_DMA_CHANNEL_7
+ * @param[in]           flags           \ref DRV_DMA_GI clears all of them
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static inline void drv_dma_clear    (
+    DMA_TypeDef*        dma,
+    uint32_t            channel,
+    uint32_t            flags   )
+{
+    WRITE_REG(dma->IFCR, flags << ((channel - 1U) * 4U));
+}
+
+/**
+ * @brief               Route a peripheral request to a channel
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         LL_DMA_CHANNEL_1 to LL_DMA_CHANNEL_7
+ * @param[in]           request         LL_DMA_REQUEST_0 to LL_DMA_REQUEST_7
+ * @return              None
+ * @note                LL_DMA_SetPeriphRequest finds the field with a bit reversal at run
+ *                      time, the field of a channel is simply 4 bits per channel.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static inline void drv_dma_request  (
+    DMA_TypeDef*        dma,
+    uint32_t            channel,
+    uint32_t            request )
+{
+    DMA_Request_TypeDef*    csel    =   (DMA_Request_TypeDef*)((uint32_t)dma + DMA_CSELR_OFFSET);
+    uint32_t                shift   =   (channel - 1U) * 4U;
+
+    MODIFY_REG(csel->CSELR, DMA_CSELR_C1S << shift, request << shift);
+}
+
+/**
+ * @brief               Take the flags of a channel for its interrupt handler
+ * @param[in]           dma             DMA1 or DMA2
+ * @param[in]           channel         LL_DMA_CHANNEL_1 to LL_DMA_CHANNEL_7
+ * @return              the flags that were set, all cleared now
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static inline uint32_t drv_dma_take (
+    DMA_TypeDef*        dma,
+    uint32_t            channel )
+{
+    uint32_t    flags   =   drv_dma_flags(dma, channel);
+
+    drv_dma_clear(dma, channel, flags);
+    return flags;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_DMA_H_ */
@@ -0,0 +1,321 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_i2c.h
+ * @brief       I2C master with a queue of write then read DMA transactions.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * A transaction writes tx_size bytes, then reads rx_size bytes after a
+ * repeated start, either phase may be empty. The DMA moves the data and
+ * the peripheral counts it: NBYTES covers up to 255 bytes with RELOAD for
+ * longer phases, the write phase of a write then read ends in TC for the
+ * repeated start, and the last phase ends with AUTOEND. The interrupts come
+ * per 255 bytes, per repeated start and per STOP, not per byte.
+ *
+ * Transactions are caller owned descriptors. \ref i2c_submit queues a
+ * chain of them at once and the STOP interrupt of one starts the next, so
+ * a batch of sensor reads runs without a thread in between when only the
+ * last descriptor has a done call.
+ *
+ * Recovery: the SCL low timeout of the peripheral catches a device that
+ * stretches the clock for good. A bus error, arbitration loss or timeout
+ * resets the peripheral and clocks SCL until a device holding SDA lets go,
+ * then sends a STOP. The same happens before a start when the bus is busy.
+ * \ref i2c_transfer gives up after its timeout through \ref i2c_abort.
+ *
+ * The vector table handlers of the port call \ref i2c_ev_handler,
+ * \ref i2c_er_handler and, for errors, \ref i2c_dma_handler on both channels.
+ * All of them must sit at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_I2C_H_
+#define _DRV_I2C_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_dma.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_i2c.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref i2c_transfer waits on */
+#ifndef I2C_FLAG_DONE
+#define I2C_FLAG_DONE       0x00200000U
+#endif
+
+/** SCL periods of a bus recovery */
+#ifndef I2C_RECOVER_CLOCKS
+#define I2C_RECOVER_CLOCKS  9U
+#endif
+
+/** Busy loop of a half SCL period of a bus recovery, about 5 us at 80 MHz */
+#ifndef I2C_RECOVER_SPIN
+#define I2C_RECOVER_SPIN    100U
+#endif
+
+/* I2C_XFER status */
+#define I2C_OK              0
+#define I2C_PENDING         1           /*!< queued or running */
+#define I2C_ERR_NACK        (-1)        /*!< address or data not acknowledged */
+#define I2C_ERR_BUS         (-2)        /*!< bus error, arbitration lost, stuck bus */
+#define I2C_ERR_TIMEOUT     (-3)        /*!< SCL held low, or aborted */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Hardware of one I2C
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    I2C_TypeDef*        i2c;
+    IRQn_Type           ev_irq;
+    IRQn_Type           er_irq;
+    uint32_t            clock;          /*!< LL_APB1_GRP1_PERIPH_I2Cx */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            request;        /*!< LL_DMA_REQUEST_x of both channels */
+    uint32_t            rx_channel;     /*!< LL_DMA_CHANNEL_x */
+    IRQn_Type           rx_irq;
+    uint32_t            tx_channel;
+    IRQn_Type           tx_irq;
+    GPIO_TypeDef*       gpio;           /*!< port of SCL and SDA */
+    uint32_t            gpio_clock;     /*!< LL_AHB2_GRP1_PERIPH_GPIOx */
+    uint32_t            scl;            /*!< pin number 0 to 15 */
+    uint32_t            sda;
+    uint32_t            alternate;      /*!< LL_GPIO_AF_x */
+}I2C_PORT;
+
+/**
+ * @brief      Driver configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            timing;         /*!< TIMINGR, e.g. 0x00702991 for 400 kHz from 80 MHz */
+    uint32_t            pclk;           /*!< Hz of the I2C kernel clock */
+    uint32_t            scl_timeout;    /*!< ms SCL may stay low, up to 100, 0 off */
+    uint32_t            priority;       /*!< NVIC priority of the four interrupts */
+}I2C_CONFIG;
+
+/**
+ * @brief      Transaction descriptor, owned by the driver from \ref i2c_submit to its done call
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct I2C_XFER_S
+{
+    struct I2C_XFER_S*  next;           /*!< chain given to \ref i2c_submit, NULL ends it */
+    uint32_t            address;        /*!< 7 bit */
+    const uint8_t*      tx;             /*!< register address and data */
+    uint32_t            tx_size;        /*!< 0 to 65535 */
+    uint8_t*            rx;
+    uint32_t            rx_size;        /*!< 0 to 65535, both 0 only addresses the device */
+    void                (*done)(struct I2C_XFER_S* xfer);   /*!< interrupt context, may be NULL */
+    void*               arg;            /*!< for the done call */
+    int                 status;         /*!< \ref I2C_OK, ... */
+}I2C_XFER;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            xfers;          /*!< transactions done */
+    uint32_t            bytes;
+    uint32_t            reloads;        /*!< NBYTES reloads of long phases */
+    uint32_t            nacks;
+    uint32_t            errors;         /*!< bus errors, arbitration losses, timeouts and aborts */
+    uint32_t            recoveries;     /*!< bus recoveries */
+}I2C_STATS;
+
+/**
+ * @brief      Driver state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const I2C_PORT*     port;
+    I2C_XFER*           head;           /*!< running */
+    I2C_XFER*           tail;
+    uint32_t            left;           /*!< bytes of the phase NBYTES has not covered yet */
+    uint32_t            reading;        /*!< the phase is the read */
+    I2C_STATS           stats;
+}I2C;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/**
+ * I2C2 to the on board sensors, PB10/PB11, DMA1 channel 4/5. The channels are
+ * those of \ref g_UartPortUsart1, an application uses one of the two with DMA.
+ */
+extern const I2C_PORT g_I2cPortI2c2;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the I2C as master, its pins and DMA channels
+ * @param[out]          i2c             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Recovers the bus when a device holds SDA low
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_init (
+    I2C*                i2c,
+    const I2C_PORT*     port,
+    const I2C_CONFIG*   config
+);
+
+/**
+ * @brief               Queue a chain of transactions
+ * @param[in]           i2c             driver state
+ * @param[in]           xfer            first descriptor, the others linked through next
+ * @retval              0               success
+ * @retval              -1              fail, nothing queued
+ * @note                Thread context. The buffers must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_submit   (
+    I2C*                i2c,
+    I2C_XFER*           xfer
+);
+
+/**
+ * @brief               Take a transaction back
+ * @param[in]           i2c             driver state
+ * @param[in]           xfer            descriptor
+ * @retval              0               it ended with \ref I2C_ERR_TIMEOUT and its done call ran
+ * @retval              -1              it was not queued, it has ended before
+ * @note                A running transaction stops with a bus recovery
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_abort    (
+    I2C*                i2c,
+    I2C_XFER*           xfer
+);
+
+/**
+ * @brief               Write then read and wait for the end
+ * @param[in]           i2c             driver state
+ * @param[in]           address         7 bit
+ * @param[in]           tx              bytes to write
+ * @param[in]           tx_size         0 to 65535
+ * @param[out]          rx              bytes read
+ * @param[in]           rx_size         0 to 65535
+ * @param[in]           timeout         ticks before \ref i2c_abort
+ * @return              \ref I2C_OK, ..., -1 for bad arguments
+ * @note                Thread context, waits on thread flag \ref I2C_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_transfer (
+    I2C*                i2c,
+    uint32_t            address,
+    const uint8_t*      tx,
+    uint32_t            tx_size,
+    uint8_t*            rx,
+    uint32_t            rx_size,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           i2c             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_stats   (
+    I2C*                i2c,
+    I2C_STATS*          stats
+);
+
+/**
+ * @brief               I2C event interrupt: reload, repeated start, STOP and NACK
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_ev_handler  (
+    I2C*                i2c
+);
+
+/**
+ * @brief               I2C error interrupt: bus error, arbitration loss, overrun and SCL timeout
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_er_handler  (
+    I2C*                i2c
+);
+
+/**
+ * @brief               DMA channel interrupt of either direction: errors only
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_dma_handler (
+    I2C*                i2c
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_I2C_H_ */
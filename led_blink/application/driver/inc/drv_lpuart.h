@@ -0,0 +1,217 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_lpuart.h
+ * @brief       LPUART1 log and console backend clocked from LSE.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * LPUART1 runs from the 32.768 kHz LSE with its kernel clock kept in Stop
+ * mode, so it keeps receiving in STOP2 and a received byte wakes the MCU.
+ * Received bytes go to a stream buffer from the RXNE interrupt.
+ *
+ * The DMA does not run in Stop modes. Log text is therefore held in a RAM
+ * ring and sent in bursts: a burst starts once \ref LPUART_CONFIG::batch bytes
+ * are waiting, or when a flush is forced (the logger does this after its
+ * latency), and a burst ends with one DMA interrupt. While
+ * \ref lpuart_busy is true the low power entry must stop at Sleep, after it
+ * the last bytes shift out under LSE even in STOP2. The counters give the
+ * bytes sent per wakeup. \ref g_LpuartSink selects the backend as the logger
+ * output.
+ *
+ * The vector table handlers LPUART1_IRQHandler and DMA2_Channel6_IRQHandler
+ * call \ref lpuart_irq_handler and \ref lpuart_dma_handler, at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_LPUART_H_
+#define _DRV_LPUART_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "logger.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define LPUART_LSE_HZ       32768U      /*!< kernel clock */
+#define LPUART_BAUD_MAX     (LPUART_LSE_HZ / 3U)
+
+/** ms to wait for the LSE to start */
+#ifndef LPUART_LSE_TIMEOUT
+#define LPUART_LSE_TIMEOUT  5000U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Backend configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            baudrate;       /*!< up to \ref LPUART_BAUD_MAX */
+    uint8_t*            tx;             /*!< held text */
+    uint32_t            tx_size;        /*!< power of two */
+    uint32_t            batch;          /*!< bytes that start a burst, 1 to tx_size */
+    uint8_t*            storage;        /*!< received bytes stream buffer storage */
+    uint32_t            storage_size;   /*!< holds storage_size - 1 bytes */
+    uint32_t            priority;       /*!< NVIC priority of both interrupts */
+}LPUART_CONFIG;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            tx_bytes;       /*!< sent */
+    uint32_t            tx_bursts;      /*!< DMA bursts, one wakeup each */
+    uint32_t            rx_bytes;       /*!< delivered to the stream buffer */
+    uint32_t            rx_dropped;     /*!< lost because the stream buffer was full */
+    uint32_t            rx_wakeups;     /*!< reception interrupts */
+    uint32_t            errors;         /*!< overrun, framing, noise and DMA errors */
+}LPUART_STATS;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** Logger output through this backend */
+extern const LOGGER_SINK g_LpuartSink;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the LSE and configure LPUART1, its pins and DMA channel
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail, also when the LSE does not start
+ * @note                Thread context, 8 data bits, no parity, 1 stop bit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int lpuart_init  (
+    const LPUART_CONFIG*    config
+);
+
+/**
+ * @brief               Queue text
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              bytes taken, less when the ring is full
+ * @note                One writer thread, the logger thread when the sink is selected.
+ *                      Starts a burst once a batch is waiting.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_write    (
+    const uint8_t*      data,
+    uint32_t            size
+);
+
+/**
+ * @brief               Start sending what is waiting
+ * @param[in]           force           0 waits for a batch, otherwise sends everything
+ * @return              bytes not yet in a burst
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_flush    (
+    int                 force
+);
+
+/**
+ * @brief               Read received bytes
+ * @param[out]          data            buffer
+ * @param[in]           size            buffer size
+ * @param[in]           timeout         ticks to wait for the first byte
+ * @return              bytes read
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_read (
+    uint8_t*            data,
+    uint32_t            size,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Tell whether a DMA burst runs
+ * @retval              1               only Sleep until the burst ends
+ * @retval              0               STOP2 allowed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int lpuart_busy  (void);
+
+/**
+ * @brief               Copy the counters
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_stats    (
+    LPUART_STATS*       stats
+);
+
+/**
+ * @brief               LPUART1 interrupt: reception, also the wakeup from Stop
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_irq_handler  (void);
+
+/**
+ * @brief               Transmission DMA channel interrupt: burst sent
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_dma_handler  (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_LPUART_H_ */
@@ -0,0 +1,251 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_rng.h
+ * @brief       entropy pool the RNG refills by interrupt, read in bulk from threads and interrupts.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The RNG gives a 32 bit word about every 42 cycles of its 48 MHz clock.
+ * Its interrupt moves each word into a ring of words the caller provides
+ * and is switched off while the ring is full, so the CPU pays one short
+ * interrupt per word served and nothing while nobody reads.
+ *
+ * \ref rng_read serves whole requests or nothing, from threads and from
+ * interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY. Its time
+ * depends on the size only, never on the data, and every word it takes is
+ * wiped from the ring. A request takes whole words, the bytes left of the
+ * last one are dropped rather than served twice. \ref rng_wait blocks a
+ * thread until the ring holds the request.
+ *
+ * Errors follow the reference manual:
+ * - Seed error: the words in the ring are discarded, the RNG is disabled
+ *   and enabled again.
+ * - Clock error: counted and cleared. The RNG resumes once its clock is
+ *   right again, the words taken before stay valid.
+ * - The first word after enabling is only kept for comparison, a word equal
+ *   to the one before fails the continuous test and is handled as a seed
+ *   error.
+ * Errors are seen by the interrupt, so one that happens while the ring is
+ * full is handled when refilling starts again.
+ *
+ * The vector table handler calls \ref rng_irq_handler. The host build links
+ * the software stand-in of host/rng_host.c in place of this driver.
+ */
+
+#ifndef _DRV_RNG_H_
+#define _DRV_RNG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_rng.h"
+#include "cmsis_os2.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref rng_wait waits on */
+#ifndef RNG_FLAG_FILL
+#define RNG_FLAG_FILL       0x00010000U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      RNG and its 48 MHz clock
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    RNG_TypeDef*        rng;
+    uint32_t            clock;          /*!< LL_AHB2_GRP1_PERIPH_RNG */
+    uint32_t            source;         /*!< LL_RCC_RNG_CLKSOURCE_x giving 48 MHz */
+    uint32_t            pllsai1_n;      /*!< PLLSAI1 N for 96 MHz from the PLL input, 0 to leave PLLSAI1 alone */
+    IRQn_Type           irq;
+}RNG_PORT;
+
+/**
+ * @brief      Pool configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t*           buffer;         /*!< ring */
+    uint32_t            words;          /*!< power of two, 2 or more */
+    uint32_t            priority;       /*!< NVIC priority of the RNG interrupt */
+}RNG_CONFIG;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            words;          /*!< words put into the ring */
+    uint32_t            reads;          /*!< requests served */
+    uint64_t            bytes;          /*!< bytes served */
+    uint32_t            empty;          /*!< requests refused, the ring held too little */
+    uint32_t            seed_errors;
+    uint32_t            clock_errors;
+    uint32_t            repeats;        /*!< continuous test failures */
+    uint32_t            discarded;      /*!< words thrown away after errors */
+}RNG_STATS;
+
+/**
+ * @brief      Pool state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const RNG_PORT*     port;
+    uint32_t*           buffer;
+    uint32_t            mask;           /*!< words - 1 */
+    uint32_t            head;           /*!< words put, free running */
+    uint32_t            tail;           /*!< words taken, free running */
+    uint32_t            last;           /*!< word before, for the continuous test */
+    uint32_t            primed;         /*!< last holds a word */
+    uint32_t            want;           /*!< words the waiting thread needs */
+    osThreadId_t        waiter;         /*!< thread in \ref rng_wait */
+    RNG_STATS           stats;
+}RNG_POOL;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** RNG clocked by PLLSAI1 Q, 48 MHz from the 4 MHz MSI */
+extern const RNG_PORT g_RngPortRng;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the 48 MHz clock and the RNG, refilling begins
+ * @param[out]          pool            pool state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_init (
+    RNG_POOL*           pool,
+    const RNG_PORT*     port,
+    const RNG_CONFIG*   config
+);
+
+/**
+ * @brief               Take random bytes from the pool
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @retval              0               all served
+ * @retval              -1              bad arguments or too little pooled, nothing served
+ * @note                Thread and interrupt context, time depends on size only
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_read (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size
+);
+
+/**
+ * @brief               Take random bytes, waiting for the pool to hold them
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @param[in]           timeout         ticks
+ * @retval              0               all served
+ * @retval              -1              bad arguments or timeout, nothing served
+ * @note                Thread context, one thread at a time, waits on thread flag \ref RNG_FLAG_FILL
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_wait (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Bytes \ref rng_read can serve now
+ * @param[in]           pool            pool state
+ * @return              bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t rng_level   (
+    RNG_POOL*           pool
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           pool            pool state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_stats   (
+    RNG_POOL*           pool,
+    RNG_STATS*          stats
+);
+
+/**
+ * @brief               RNG interrupt: next word, seed or clock error
+ * @param[in]           pool            pool state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_irq_handler (
+    RNG_POOL*           pool
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_RNG_H_ */
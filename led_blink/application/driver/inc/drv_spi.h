@@ -0,0 +1,312 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_spi.h
+ * @brief       SPI master with a queue of full duplex DMA transfers.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Several devices share one SPI. Each \ref SPI_DEVICE has its own mode,
+ * clock and chip select pin, prepared once by \ref spi_device_init.
+ * Transfers are caller owned descriptors queued by \ref spi_submit. The
+ * reception DMA interrupt of a transfer selects the device of the next
+ * one, reloads both channels and starts it before running the done call,
+ * so queued transfers follow each other without a thread in between. A
+ * transfer with \ref SPI_XFER_HOLD keeps its chip select low for a
+ * following transfer of the same device, for command and data phases.
+ *
+ * A NULL tx sends 0xFF, a NULL rx discards what was received. Frames are
+ * 8 bits, MSB first, and chip selects are active low.
+ *
+ * The vector table handlers of the port call \ref spi_irq_handler,
+ * \ref spi_rx_dma_handler and \ref spi_tx_dma_handler. All three must sit at
+ * or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_SPI_H_
+#define _DRV_SPI_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_dma.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_spi.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref spi_transfer waits on */
+#ifndef SPI_FLAG_DONE
+#define SPI_FLAG_DONE       0x00400000U
+#endif
+
+/* SPI_DEVICE mode, clock polarity and phase */
+#define SPI_MODE_0          0U
+#define SPI_MODE_1          1U          /*!< second edge */
+#define SPI_MODE_2          2U          /*!< clock high when idle */
+#define SPI_MODE_3          3U
+
+/* SPI_XFER flags */
+#define SPI_XFER_HOLD       0x1U        /*!< chip select stays low after the transfer */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Hardware of one SPI
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    SPI_TypeDef*        spi;
+    IRQn_Type           irq;
+    uint32_t            apb;            /*!< 1 or 2, bus of the SPI clock */
+    uint32_t            clock;          /*!< LL_APBx_GRP1_PERIPH_SPIx */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            request;        /*!< LL_DMA_REQUEST_x of both channels */
+    uint32_t            rx_channel;     /*!< LL_DMA_CHANNEL_x */
+    IRQn_Type           rx_irq;
+    uint32_t            tx_channel;
+    IRQn_Type           tx_irq;
+    GPIO_TypeDef*       gpio;           /*!< port of SCK, MISO and MOSI */
+    uint32_t            gpio_clock;     /*!< LL_AHB2_GRP1_PERIPH_GPIOx */
+    uint32_t            pins;           /*!< LL_GPIO_PIN_x of the three */
+    uint32_t            alternate;      /*!< LL_GPIO_AF_x */
+}SPI_PORT;
+
+/**
+ * @brief      Driver configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            pclk;           /*!< Hz of the APB clock of the SPI */
+    uint32_t            priority;       /*!< NVIC priority of the three interrupts */
+}SPI_CONFIG;
+
+/**
+ * @brief      One device on the bus
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    GPIO_TypeDef*       cs_gpio;        /*!< port of the chip select */
+    uint32_t            cs_pin;         /*!< LL_GPIO_PIN_x */
+    uint32_t            mode;           /*!< \ref SPI_MODE_0 to \ref SPI_MODE_3 */
+    uint32_t            speed;          /*!< highest clock in Hz */
+    uint32_t            cr1;            /*!< set by \ref spi_device_init */
+}SPI_DEVICE;
+
+/**
+ * @brief      Transfer descriptor, owned by the driver from \ref spi_submit to its done call
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct SPI_XFER_S
+{
+    struct SPI_XFER_S*  next;
+    const SPI_DEVICE*   device;
+    const uint8_t*      tx;             /*!< NULL sends 0xFF */
+    uint8_t*            rx;             /*!< NULL discards */
+    uint32_t            size;           /*!< 1 to 65535 */
+    uint32_t            flags;          /*!< \ref SPI_XFER_HOLD */
+    void                (*done)(struct SPI_XFER_S* xfer);   /*!< interrupt context, may be NULL */
+    void*               arg;            /*!< for the done call */
+    int                 status;         /*!< 0, or -1 after a DMA or SPI error */
+}SPI_XFER;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            xfers;          /*!< transfers done */
+    uint32_t            bytes;
+    uint32_t            reconfigs;      /*!< mode or clock changes between devices */
+    uint32_t            errors;         /*!< overrun, mode fault and DMA errors */
+}SPI_STATS;
+
+/**
+ * @brief      Driver state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const SPI_PORT*     port;
+    uint32_t            pclk;
+    uint32_t            cr1;            /*!< of the device last selected */
+    const SPI_DEVICE*   held;           /*!< device with its chip select low */
+    SPI_XFER*           head;           /*!< running */
+    SPI_XFER*           tail;
+    uint8_t             fill;           /*!< sent for a NULL tx */
+    uint8_t             sink;           /*!< receives for a NULL rx */
+    SPI_STATS           stats;
+}SPI;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** SPI3 to the Wi-Fi module and the extension header, PC10/PC11/PC12, DMA2 channel 1/2 */
+extern const SPI_PORT g_SpiPortSpi3;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the SPI as master, its pins and DMA channels
+ * @param[out]          spi             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_init (
+    SPI*                spi,
+    const SPI_PORT*     port,
+    const SPI_CONFIG*   config
+);
+
+/**
+ * @brief               Prepare a device and drive its chip select high
+ * @param[in]           spi             driver state
+ * @param[in,out]       device          cs_gpio, cs_pin, mode and speed filled in
+ * @retval              0               success
+ * @retval              -1              fail, also when the speed is below pclk / 256
+ * @note                The clock is the fastest the prescaler gives up to the speed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_device_init  (
+    SPI*                spi,
+    SPI_DEVICE*         device
+);
+
+/**
+ * @brief               Queue a transfer
+ * @param[in]           spi             driver state
+ * @param[in]           xfer            descriptor, device, size, buffers and done filled in
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context. The buffers must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_submit   (
+    SPI*                spi,
+    SPI_XFER*           xfer
+);
+
+/**
+ * @brief               Transfer and wait for the end
+ * @param[in]           spi             driver state
+ * @param[in]           device          device
+ * @param[in]           tx              bytes to send, NULL sends 0xFF
+ * @param[out]          rx              received bytes, NULL discards
+ * @param[in]           size            1 to 65535
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, waits on thread flag \ref SPI_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_transfer (
+    SPI*                spi,
+    const SPI_DEVICE*   device,
+    const uint8_t*      tx,
+    uint8_t*            rx,
+    uint32_t            size
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           spi             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_stats   (
+    SPI*                spi,
+    SPI_STATS*          stats
+);
+
+/**
+ * @brief               SPI interrupt: overrun and mode fault
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_irq_handler (
+    SPI*                spi
+);
+
+/**
+ * @brief               Reception DMA channel interrupt: transfer done
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_rx_dma_handler  (
+    SPI*                spi
+);
+
+/**
+ * @brief               Transmission DMA channel interrupt: errors only
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_tx_dma_handler  (
+    SPI*                spi
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_SPI_H_ */
@@ -0,0 +1,305 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_uart.h
+ * @brief       USART driver with circular DMA reception and queued DMA transmission.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Reception never stops: a DMA channel in circular mode fills a small
+ * buffer, and the half transfer, transfer complete and USART idle line
+ * interrupts move what arrived since the last of them into a stream buffer
+ * in one copy. A frame is delivered as soon as the line goes quiet, a long
+ * burst every half buffer, and there is no interrupt per byte. The buffer
+ * must hold what arrives during the longest interrupt latency twice over.
+ *
+ * Transmission takes caller owned descriptors. They queue in a list, the DMA
+ * sends one after the other and each completion runs from the interrupt.
+ *
+ * The vector table handlers of the port call \ref uart_irq_handler,
+ * \ref uart_rx_dma_handler and \ref uart_tx_dma_handler. All three must sit at
+ * or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+
+#ifndef _DRV_UART_H_
+#define _DRV_UART_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "stm32l4xx_ll_dma.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_usart.h"
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Thread flag \ref uart_write waits on */
+#ifndef UART_FLAG_TX
+#define UART_FLAG_TX        0x00800000U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Hardware of one USART
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    USART_TypeDef*      usart;
+    IRQn_Type           irq;
+    uint32_t            apb;            /*!< 1 or 2, bus of the USART clock */
+    uint32_t            clock;          /*!< LL_APBx_GRP1_PERIPH_USARTx */
+    uint32_t            source;         /*!< LL_RCC_USARTx_CLKSOURCE */
+    DMA_TypeDef*        dma;
+    uint32_t            dma_clock;      /*!< LL_AHB1_GRP1_PERIPH_DMAx */
+    uint32_t            request;        /*!< LL_DMA_REQUEST_x of both channels */
+    uint32_t            rx_channel;     /*!< LL_DMA_CHANNEL_x */
+    IRQn_Type           rx_irq;
+    uint32_t            tx_channel;
+    IRQn_Type           tx_irq;
+    GPIO_TypeDef*       gpio;           /*!< port of both pins */
+    uint32_t            gpio_clock;     /*!< LL_AHB2_GRP1_PERIPH_GPIOx */
+    uint32_t            pins;           /*!< LL_GPIO_PIN_x of TX and RX */
+    uint32_t            alternate;      /*!< LL_GPIO_AF_x */
+}UART_PORT;
+
+/**
+ * @brief      Driver configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            baudrate;
+    uint8_t*            dma;            /*!< circular reception buffer */
+    uint32_t            dma_size;       /*!< even, up to 65534 */
+    uint8_t*            storage;        /*!< stream buffer storage */
+    uint32_t            storage_size;   /*!< holds storage_size - 1 bytes */
+    uint32_t            trigger;        /*!< bytes that wake a reader, at least 1 */
+    uint32_t            priority;       /*!< NVIC priority of the three interrupts */
+}UART_CONFIG;
+
+/**
+ * @brief      Transmission descriptor, owned by the driver from \ref uart_send to its done call
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct UART_TX_S
+{
+    struct UART_TX_S*   next;
+    const uint8_t*      data;
+    uint32_t            size;           /*!< 1 to 65535 */
+    void                (*done)(struct UART_TX_S* tx);  /*!< interrupt context, may be NULL */
+    void*               arg;            /*!< for the done call */
+}UART_TX;
+
+/**
+ * @brief      Counters
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            rx_bytes;       /*!< delivered to the stream buffer */
+    uint32_t            rx_dropped;     /*!< lost because the stream buffer was full */
+    uint32_t            rx_events;      /*!< interrupts that delivered data */
+    uint32_t            tx_bytes;
+    uint32_t            tx_done;        /*!< descriptors sent */
+    uint32_t            errors;         /*!< overrun, framing, noise and DMA errors */
+}UART_STATS;
+
+/**
+ * @brief      Driver state
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const UART_PORT*        port;
+    uint8_t*                dma;
+    uint32_t                dma_size;
+    uint32_t                rx_pos;     /*!< next byte of dma to deliver */
+    StreamBufferHandle_t    rx;
+    StaticStreamBuffer_t    rx_cb;
+    UART_TX*                tx_head;    /*!< being sent */
+    UART_TX*                tx_tail;
+    UART_STATS              stats;
+}UART;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** USART1 to the ST-LINK virtual COM port, PB6/PB7, DMA1 channel 4/5 */
+extern const UART_PORT g_UartPortUsart1;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the USART, its pins and DMA channels and start reception
+ * @param[out]          uart            driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                8 data bits, no parity, 1 stop bit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_init    (
+    UART*               uart,
+    const UART_PORT*    port,
+    const UART_CONFIG*  config
+);
+
+/**
+ * @brief               Stream buffer received bytes are delivered to
+ * @param[in]           uart            driver state
+ * @return              stream buffer, for xStreamBufferReceive or the zero copy read calls
+ * @note                Any number of readers as long as only one reads at a time
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern StreamBufferHandle_t uart_rx_stream  (
+    UART*               uart
+);
+
+/**
+ * @brief               Read received bytes
+ * @param[in]           uart            driver state
+ * @param[out]          data            buffer
+ * @param[in]           size            buffer size
+ * @param[in]           timeout         ticks to wait for the first byte
+ * @return              bytes read
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t uart_read   (
+    UART*               uart,
+    uint8_t*            data,
+    uint32_t            size,
+    uint32_t            timeout
+);
+
+/**
+ * @brief               Queue a transmission
+ * @param[in]           uart            driver state
+ * @param[in]           tx              descriptor, data and done filled in
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context. The data must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_send    (
+    UART*               uart,
+    UART_TX*            tx
+);
+
+/**
+ * @brief               Send and wait until the DMA has handed the last byte to the USART
+ * @param[in]           uart            driver state
+ * @param[in]           data            bytes to send
+ * @param[in]           size            1 to 65535
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, waits on thread flag \ref UART_FLAG_TX
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_write   (
+    UART*               uart,
+    const uint8_t*      data,
+    uint32_t            size
+);
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           uart            driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_stats  (
+    UART*               uart,
+    UART_STATS*         stats
+);
+
+/**
+ * @brief               USART interrupt: idle line and reception errors
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_irq_handler    (
+    UART*               uart
+);
+
+/**
+ * @brief               Reception DMA channel interrupt: half and full buffer
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_rx_dma_handler (
+    UART*               uart
+);
+
+/**
+ * @brief               Transmission DMA channel interrupt: descriptor sent
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_tx_dma_handler (
+    UART*               uart
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_UART_H_ */
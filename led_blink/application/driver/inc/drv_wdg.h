@@ -0,0 +1,223 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_wdg.h
+ * @brief       task health supervisor feeding the hardware watchdog.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Each supervised thread registers with a deadline and calls
+ * \ref wdg_checkin at least that often. The check-in is a single increment
+ * of a counter owned by the thread, it takes no lock and masks nothing, so it
+ * may sit in a hot loop. The supervisor thread looks at every counter once a
+ * period and feeds the watchdog only while all of them moved in time.
+ *
+ * A thread that misses its deadline is recorded, in the crash dump with its
+ * saved registers and stack when configUSE_CRASH_DUMP is 1, and the device is
+ * reset at once rather than on the watchdog timeout. If the supervisor itself
+ * is starved, the watchdog expires: the window watchdog then records the
+ * running code through its early warning interrupt first, the independent
+ * watchdog only leaves its reset flag. \ref wdg_last_reset tells what happened
+ * after the reboot.
+ *
+ * Both watchdogs are frozen while the core is halted by a debugger.
+ */
+
+#ifndef _DRV_WDG_H_
+#define _DRV_WDG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Supervised threads */
+#ifndef WDG_SLOTS
+#define WDG_SLOTS           16U
+#endif
+
+/* Hardware watchdog fed by the supervisor */
+#define WDG_HW_IWDG         0U          /*!< independent watchdog, LSI clocked, timeout up to 32 s */
+#define WDG_HW_WWDG         1U          /*!< window watchdog, PCLK1 clocked, timeout up to 26 ms at 80 MHz */
+
+/* Cause of the last reset, see \ref wdg_last_reset */
+#define WDG_RESET_OTHER     0U          /*!< not the watchdog */
+#define WDG_RESET_MISSED    1U          /*!< a thread missed its deadline, see WDG_REPORT::name */
+#define WDG_RESET_IWDG      2U          /*!< independent watchdog expired */
+#define WDG_RESET_WWDG      3U          /*!< window watchdog expired */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Check-in slot of a supervised thread
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    volatile uint32_t   count;      /*!< check-ins, written by the owner only */
+    volatile uint32_t   deadline;   /*!< ms between check-ins, 0 for a free slot */
+    volatile uint32_t   paused;     /*!< not supervised while non zero */
+    osThreadId_t        thread;     /*!< owner */
+    uint32_t            seen;       /*!< count at the last pass that saw it move, supervisor only */
+    uint32_t            last;       /*!< tick of that pass, supervisor only */
+    uint32_t            worst;      /*!< longest time between two check-ins seen, ms */
+}WDG_SLOT;
+
+/**
+ * @brief      Supervisor configuration
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            hw;         /*!< \ref WDG_HW_IWDG or \ref WDG_HW_WWDG */
+    uint32_t            timeout;    /*!< ms without feeding before the watchdog resets */
+    uint32_t            period;     /*!< ms between supervisor passes, below the timeout the watchdog gets */
+    osPriority_t        priority;   /*!< supervisor thread priority */
+}WDG_CONFIG;
+
+/**
+ * @brief      What caused the last reset
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            cause;      /*!< \ref WDG_RESET_OTHER, ... */
+    osThreadId_t        thread;     /*!< thread that missed its deadline */
+    char                name[16];   /*!< its name */
+    uint32_t            late;       /*!< ms since its last check-in */
+}WDG_REPORT;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the supervisor and the hardware watchdog
+ * @param[in]           config          supervisor configuration
+ * @retval              0               success
+ * @retval              -1              fail, also when the timeout does not fit the watchdog
+ *                      or the period is not below the timeout it really gets
+ * @note                Thread context or before the kernel is started. The watchdog
+ *                      cannot be stopped again.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wdg_init (
+    const WDG_CONFIG*   config
+);
+
+/**
+ * @brief               Supervise the calling thread
+ * @param[in]           deadline        longest time in ms between two check-ins
+ * @return              slot to check in with, NULL when all slots are used
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern WDG_SLOT* wdg_register   (
+    uint32_t            deadline
+);
+
+/**
+ * @brief               Stop supervising a thread
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_unregister  (
+    WDG_SLOT*           slot
+);
+
+/**
+ * @brief               Report progress
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @note                Meant for the owner thread, a check-in from elsewhere may be lost
+ *                      but never makes a stuck thread look alive for long.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static inline void wdg_checkin  (
+    WDG_SLOT*           slot    )
+{
+    slot->count =   slot->count + 1U;
+}
+
+/**
+ * @brief               Suspend supervision of a thread around a wait of unbounded length
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_pause   (
+    WDG_SLOT*           slot
+);
+
+/**
+ * @brief               Resume supervision of a thread, counts as a check-in
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_resume  (
+    WDG_SLOT*           slot
+);
+
+/**
+ * @brief               Tell whether the watchdog caused the last reset
+ * @param[out]          report          cause and the thread that missed its deadline
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Valid after \ref wdg_init
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wdg_last_reset   (
+    WDG_REPORT*         report
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _DRV_WDG_H_ */
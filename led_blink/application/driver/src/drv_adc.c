@@ -0,0 +1,598 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_adc.c
+ * @brief       Timer triggered multi channel ADC acquisition into circular DMA blocks.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "drv_dma.h"
+#include "drv_adc.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define ADC_CHANNEL_MAX     (18U)
+#define ADC_RATIO_MAX       (256U)
+#define ADC_SHIFT_MAX       (8U)
+#define ADC_CONVERSION_2    (25U)       /*!< twice the 12.5 cycles of a 12 bit conversion */
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const ADC_PORT g_AdcPortAdc1 =
+{
+    ADC1,                           /*!< adc */
+    ADC123_COMMON,                  /*!< common */
+    ADC1_2_IRQn,                    /*!< irq */
+    LL_AHB2_GRP1_PERIPH_ADC,        /*!< clock */
+    TIM15,                          /*!< tim */
+    LL_APB2_GRP1_PERIPH_TIM15,      /*!< tim_clock */
+    LL_ADC_REG_TRIG_EXT_TIM15_TRGO, /*!< trigger */
+    DMA1,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA1,       /*!< dma_clock */
+    LL_DMA_REQUEST_0,               /*!< request */
+    LL_DMA_CHANNEL_1,               /*!< channel */
+    DMA1_Channel1_IRQn              /*!< dma_irq */
+};
+
+/* twice the sampling cycles of LL_ADC_SAMPLINGTIME_x */
+static const uint16_t g_AdcSampling2[8] = { 5U, 13U, 25U, 49U, 95U, 185U, 495U, 1281U };
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Number of the lowest set bit
+ * @param[in]           value           power of two
+ * @return              log2 of value
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t adc_log2    (
+    uint32_t            value   )
+{
+    uint32_t    bits    =   0;
+
+    while( (value > 1U) && (!(value & 1U)) )
+    {
+        value   >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+/** 
+ * @brief               Check a configuration
+ * @param[in]           config          configuration
+ * @retval              0               valid
+ * @retval              -1              invalid
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int adc_check    (
+    const ADC_CONFIG*   config  )
+{
+    const ADC_INPUT*    input   =   NULL;
+    uint64_t            cycles  =   0;
+    uint32_t            i;
+
+    if( (!config->inputs) || (0 == config->count) || (config->count > ADC_INPUTS_MAX) ||
+        (config->sampling > LL_ADC_SAMPLINGTIME_640CYCLES_5) || (0 == config->ratio) ||
+        (config->ratio > ADC_RATIO_MAX) || (config->ratio & (config->ratio - 1U)) ||
+        (config->shift > ADC_SHIFT_MAX) || (12U + adc_log2(config->ratio) > 16U + config->shift) ||
+        (0 == config->rate) || (0 == config->hclk) || (config->tim_clk / config->rate < 2U) ||
+        (!config->buffer) || (0 == config->passes) || (2U * config->passes * config->count > 0xFFFFU) )
+    {
+        return (-1);
+    }
+    for(i = 0; i < config->count; i++)
+    {
+        input   =   &config->inputs[i];
+        if( (input->channel > ADC_CHANNEL_MAX) || (input->pin > 15U) ||
+            ((NULL == input->gpio) != ((ADC_VREFINT == input->channel) || (input->channel >= ADC_TEMPSENSOR))) )
+        {
+            return (-1);
+        }
+    }
+    /* a pass converts every input ratio times and must end before the next trigger */
+    cycles  =   (uint64_t)config->count * config->ratio * (g_AdcSampling2[config->sampling] + ADC_CONVERSION_2);
+    if(cycles * config->rate > 2ULL * config->hclk)
+    {
+        return (-1);
+    }
+    return (0);
+}
+
+/** 
+ * @brief               Sleep until a condition of the ADC holds
+ * @param[in]           reg             register
+ * @param[in]           mask            bits
+ * @param[in]           value           mask or 0
+ * @retval              0               success
+ * @retval              -1              timeout
+ * @note                Sleeps first, which covers the delays the reference manual asks for
+ *                      after the regulator start and the calibration
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int adc_wait (
+    volatile uint32_t*  reg,
+    uint32_t            mask,
+    uint32_t            value   )
+{
+    uint32_t    i;
+
+    for(i = 0; i < ADC_WAIT_TICKS; i++)
+    {
+        (void)osDelay(1);
+        if((READ_REG(*reg) & mask) == value)
+        {
+            return (0);
+        }
+    }
+    return (-1);
+}
+
+/** 
+ * @brief               Stop the conversions and the DMA, the timer keeps running
+ * @param[in]           adc             driver state
+ * @return              None
+ * @note                A block nobody acquired yet counts as dropped
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void adc_halt    (
+    ADC*                adc )
+{
+    const ADC_PORT*     port    =   adc->port;
+    uint32_t            i;
+
+    if(READ_BIT(port->adc->CR, ADC_CR_ADSTART))
+    {
+        SET_BIT(port->adc->CR, ADC_CR_ADSTP);
+        for(i = 0; (i < ADC_STOP_SPIN) && (READ_BIT(port->adc->CR, ADC_CR_ADSTART)); i++)
+        {
+        }
+    }
+    LL_DMA_DisableChannel(port->dma, port->channel);
+    if(adc->ready >= 0)
+    {
+        adc->stats.dropped++;
+        adc->ready  =   -1;
+    }
+}
+
+/** 
+ * @brief               Start the DMA at the first block and arm the ADC for the next trigger
+ * @param[in]           adc             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void adc_arm (
+    ADC*                adc )
+{
+    const ADC_PORT*     port    =   adc->port;
+
+    if( (0 == adc->held) && (!adc->torn) )
+    {
+        adc->torn   =   1;
+        adc->stats.overwritten++;
+    }
+    drv_dma_clear(port->dma, port->channel, DRV_DMA_GI);
+    LL_DMA_SetDataLength(port->dma, port->channel, 2U * adc->size);
+    LL_DMA_EnableChannel(port->dma, port->channel);
+    WRITE_REG(port->adc->ISR, ADC_ISR_OVR);
+    SET_BIT(port->adc->CR, ADC_CR_ADSTART);
+}
+
+/** 
+ * @brief               A block is full, lend it to the consumer
+ * @param[in]           adc             driver state
+ * @param[in]           half            0 or 1
+ * @return              None
+ * @note                Interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void adc_block   (
+    ADC*                adc,
+    int                 half    )
+{
+    adc->stats.blocks++;
+    adc->seq++;
+    /* the DMA goes on into the other half */
+    if( (adc->held == (half ^ 1)) && (!adc->torn) )
+    {
+        adc->torn   =   1;
+        adc->stats.overwritten++;
+    }
+    if(adc->ready >= 0)
+    {
+        adc->stats.dropped++;
+    }
+    adc->ready  =   half;
+    if(adc->waiter)
+    {
+        (void)osThreadFlagsSet(adc->waiter, ADC_FLAG_BLOCK);
+    }
+}
+
+/** 
+ * @brief               Hand the ready block to the consumer
+ * @param[in]           adc             driver state
+ * @param[out]          block           the block
+ * @retval              0               success
+ * @retval              -1              no block ready, the caller is the waiter now
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int adc_take (
+    ADC*                adc,
+    ADC_BLOCK*          block   )
+{
+    int     ret =   -1;
+
+    taskENTER_CRITICAL();
+    if(adc->ready >= 0)
+    {
+        adc->held       =   adc->ready;
+        adc->ready      =   -1;
+        adc->torn       =   0;
+        adc->waiter     =   NULL;
+        block->data     =   &adc->buffer[(uint32_t)adc->held * adc->size];
+        block->size     =   adc->size;
+        block->seq      =   adc->seq;
+        block->half     =   (uint32_t)adc->held;
+        adc->stats.acquired++;
+        ret =   0;
+    }
+    else
+    {
+        adc->waiter =   osThreadGetId();
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Calibrate and enable the ADC, set up the sequence, the timer and the DMA channel
+ * @param[out]          adc             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail, bad configuration or the ADC did not come up
+ * @note                Thread context, sleeps some ticks. Fails when a pass of
+ *                      ratio x count conversions does not fit the period of rate.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_init (
+    ADC*                adc,
+    const ADC_PORT*     port,
+    const ADC_CONFIG*   config  )
+{
+    const ADC_INPUT*    input   =   NULL;
+    ADC_TypeDef*        regs    =   NULL;
+    uint32_t            paths   =   0;
+    uint32_t            ticks   =   0;
+    uint32_t            psc     =   0;
+    uint32_t            rank    =   0;
+    uint32_t            i;
+
+    if( (!adc) || (!port) || (!config) || (0 != adc_check(config)) )
+    {
+        return (-1);
+    }
+    memset(adc, 0, sizeof(ADC));
+    adc->port   =   port;
+    adc->buffer =   config->buffer;
+    adc->size   =   config->passes * config->count;
+    adc->ready  =   -1;
+    adc->held   =   -1;
+    regs        =   port->adc;
+
+    /* clocks and analog pins */
+    LL_AHB2_GRP1_EnableClock(port->clock);
+    LL_APB2_GRP1_EnableClock(port->tim_clock);
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+    LL_RCC_SetADCClockSource(LL_RCC_ADC_CLKSOURCE_SYSCLK);
+    for(i = 0; i < config->count; i++)
+    {
+        input   =   &config->inputs[i];
+        if(input->gpio)
+        {
+            LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_GPIOA << (((uint32_t)input->gpio - GPIOA_BASE) / 0x400U));
+            SET_BIT(input->gpio->MODER, GPIO_MODER_MODE0 << (input->pin * 2U));
+            SET_BIT(input->gpio->ASCR, 1U << input->pin);
+        }
+        else
+        {
+            paths   |=  (ADC_VREFINT == input->channel) ? ADC_CCR_VREFEN :
+                        (ADC_TEMPSENSOR == input->channel) ? ADC_CCR_TSEN : ADC_CCR_VBATEN;
+        }
+    }
+    MODIFY_REG(port->common->CCR, ADC_CCR_CKMODE | ADC_CCR_VREFEN | ADC_CCR_TSEN | ADC_CCR_VBATEN,
+               ADC_CCR_CKMODE_0 | paths);
+
+    /* out of deep power down, regulator on, calibration, enable */
+    WRITE_REG(regs->CR, 0);
+    WRITE_REG(regs->CR, ADC_CR_ADVREGEN);
+    (void)osDelay(1);
+    WRITE_REG(regs->CR, ADC_CR_ADVREGEN | ADC_CR_ADCAL);
+    if(0 != adc_wait(&regs->CR, ADC_CR_ADCAL, 0))
+    {
+        return (-1);
+    }
+    WRITE_REG(regs->ISR, ADC_ISR_ADRDY);
+    SET_BIT(regs->CR, ADC_CR_ADEN);
+    if(0 != adc_wait(&regs->ISR, ADC_ISR_ADRDY, ADC_ISR_ADRDY))
+    {
+        return (-1);
+    }
+
+    /* sequence, oversampler, trigger and DMA in circular mode */
+    for(i = 0; i < config->count; i++)
+    {
+        input   =   &config->inputs[i];
+        rank    =   i + 1U;
+        MODIFY_REG((&regs->SMPR1)[input->channel / 10U], ADC_SMPR1_SMP0 << ((input->channel % 10U) * 3U),
+                   config->sampling << ((input->channel % 10U) * 3U));
+        MODIFY_REG((&regs->SQR1)[rank / 5U], ADC_SQR2_SQ5 << ((rank % 5U) * 6U),
+                   input->channel << ((rank % 5U) * 6U));
+    }
+    MODIFY_REG(regs->SQR1, ADC_SQR1_L, (config->count - 1U) << ADC_SQR1_L_Pos);
+    WRITE_REG(regs->CFGR2, (config->ratio > 1U) ? (ADC_CFGR2_ROVSE | ((adc_log2(config->ratio) - 1U) << ADC_CFGR2_OVSR_Pos) |
+                                                   (config->shift << ADC_CFGR2_OVSS_Pos)) : 0);
+    WRITE_REG(regs->CFGR, ADC_CFGR_JQDIS | LL_ADC_REG_DMA_TRANSFER_UNLIMITED | port->trigger);
+    WRITE_REG(regs->IER, ADC_IER_OVRIE);
+
+    /* the update event of the timer is the trigger */
+    ticks   =   (config->tim_clk + config->rate / 2U) / config->rate;
+    psc     =   (ticks - 1U) / 0x10000U;
+    WRITE_REG(port->tim->CR1, 0);
+    WRITE_REG(port->tim->PSC, psc);
+    WRITE_REG(port->tim->ARR, ticks / (psc + 1U) - 1U);
+    WRITE_REG(port->tim->CR2, TIM_CR2_MMS_1);
+    WRITE_REG(port->tim->EGR, TIM_EGR_UG);
+
+    LL_DMA_DisableChannel(port->dma, port->channel);
+    LL_DMA_ConfigTransfer(port->dma, port->channel, LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR |
+                                                    LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                    LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD |
+                                                    LL_DMA_PRIORITY_VERYHIGH);
+    drv_dma_request(port->dma, port->channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->channel, LL_ADC_DMA_GetRegAddr(regs, LL_ADC_DMA_REG_REGULAR_DATA));
+    LL_DMA_SetMemoryAddress(port->dma, port->channel, (uint32_t)adc->buffer);
+    drv_dma_clear(port->dma, port->channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_HT(port->dma, port->channel);
+    LL_DMA_EnableIT_TC(port->dma, port->channel);
+    LL_DMA_EnableIT_TE(port->dma, port->channel);
+
+    NVIC_SetPriority(port->irq, config->priority);
+    NVIC_SetPriority(port->dma_irq, config->priority);
+    NVIC_EnableIRQ(port->irq);
+    NVIC_EnableIRQ(port->dma_irq);
+    return (0);
+}
+
+/**
+ * @brief               Start the timer and the acquisition from the first block
+ * @param[in]           adc             driver state
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_start    (
+    ADC*                adc )
+{
+    TIM_TypeDef*    tim =   NULL;
+
+    if( (!adc) || (!adc->port) )
+    {
+        return (-1);
+    }
+    tim =   adc->port->tim;
+    taskENTER_CRITICAL();
+    adc_halt(adc);
+    adc->seq    =   0;
+    adc_arm(adc);
+    WRITE_REG(tim->CNT, 0);
+    SET_BIT(tim->CR1, TIM_CR1_CEN);
+    taskEXIT_CRITICAL();
+    return (0);
+}
+
+/**
+ * @brief               Stop the timer, the conversions and the DMA
+ * @param[in]           adc             driver state
+ * @return              None
+ * @note                A block the consumer holds stays valid
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_stop    (
+    ADC*                adc )
+{
+    taskENTER_CRITICAL();
+    CLEAR_BIT(adc->port->tim->CR1, TIM_CR1_CEN);
+    adc_halt(adc);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               Wait for the next full block and borrow it
+ * @param[in]           adc             driver state
+ * @param[out]          block           the block, valid until \ref adc_release
+ * @param[in]           timeout         ticks
+ * @retval              0               success
+ * @retval              -1              timeout, or a block is still held
+ * @note                One consumer thread, waits on thread flag \ref ADC_FLAG_BLOCK
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_acquire  (
+    ADC*                adc,
+    ADC_BLOCK*          block,
+    uint32_t            timeout )
+{
+    uint32_t    flags   =   0;
+
+    if( (!adc) || (!block) || (adc->held >= 0) )
+    {
+        return (-1);
+    }
+    (void)osThreadFlagsClear(ADC_FLAG_BLOCK);
+    if(0 == adc_take(adc, block))
+    {
+        return (0);
+    }
+    flags   =   osThreadFlagsWait(ADC_FLAG_BLOCK, osFlagsWaitAny, timeout);
+    if( (!(flags & osFlagsError)) && (0 == adc_take(adc, block)) )
+    {
+        return (0);
+    }
+    taskENTER_CRITICAL();
+    adc->waiter =   NULL;
+    taskEXIT_CRITICAL();
+    return (-1);
+}
+
+/**
+ * @brief               Give a block back
+ * @param[in]           adc             driver state
+ * @param[in]           block           from \ref adc_acquire
+ * @retval              0               the block stayed intact while held
+ * @retval              -1              the DMA wrote into it, the results read from it are mixed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int adc_release  (
+    ADC*                adc,
+    const ADC_BLOCK*    block   )
+{
+    int     ret =   -1;
+
+    if( (!adc) || (!block) )
+    {
+        return (-1);
+    }
+    taskENTER_CRITICAL();
+    if(adc->held == (int)block->half)
+    {
+        ret         =   adc->torn ? -1 : 0;
+        adc->held   =   -1;
+        adc->torn   =   0;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           adc             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_stats   (
+    ADC*                adc,
+    ADC_STATS*          stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &adc->stats, sizeof(ADC_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               DMA channel interrupt: a block is full, or a transfer error
+ * @param[in]           adc             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_dma_handler (
+    ADC*                adc )
+{
+    const ADC_PORT*     port    =   adc->port;
+    uint32_t            flags   =   drv_dma_take(port->dma, port->channel);
+
+    if(flags & DRV_DMA_TE)
+    {
+        adc->stats.errors++;
+        CLEAR_BIT(port->tim->CR1, TIM_CR1_CEN);
+        adc_halt(adc);
+        return;
+    }
+    /* both are set when the interrupt came late, the first half is the older */
+    if(flags & DRV_DMA_HT)
+    {
+        adc_block(adc, 0);
+    }
+    if(flags & DRV_DMA_TC)
+    {
+        adc_block(adc, 1);
+    }
+}
+
+/**
+ * @brief               ADC interrupt: overrun, restarts the acquisition at the first block
+ * @param[in]           adc             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void adc_irq_handler (
+    ADC*                adc )
+{
+    if(READ_REG(adc->port->adc->ISR) & ADC_ISR_OVR)
+    {
+        /* the DMA missed a result, the ranks no longer line up with the buffer */
+        adc->stats.overruns++;
+        adc_halt(adc);
+        adc_arm(adc);
+    }
+}
@@ -0,0 +1,418 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_crc.c
+ * @brief       CRC unit fed by memory to memory DMA, with the tables of crc_soft for short inputs.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "drv_dma.h"
+#include "drv_crc.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define CRC_BLOCK_MAX       (0xFFFFU)   /*!< CNDTR */
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const CRC_PORT g_CrcPortCrc =
+{
+    CRC,                            /*!< crc */
+    LL_AHB1_GRP1_PERIPH_CRC,        /*!< clock */
+    DMA2,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA2,       /*!< dma_clock */
+    LL_DMA_CHANNEL_3,               /*!< dma_channel */
+    DMA2_Channel3_IRQn              /*!< dma_irq */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Polynomial size of the unit for a width
+ * @param[in]           width           bits
+ * @param[out]          size            LL_CRC_POLYLENGTH_xB
+ * @retval              0               the unit has it
+ * @retval              -1              it has not
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int crc_size (
+    uint32_t            width,
+    uint32_t*           size    )
+{
+    switch(width)
+    {
+        case 32U:
+            *size   =   LL_CRC_POLYLENGTH_32B;
+            return (0);
+        case 16U:
+            *size   =   LL_CRC_POLYLENGTH_16B;
+            return (0);
+        case 8U:
+            *size   =   LL_CRC_POLYLENGTH_8B;
+            return (0);
+        case 7U:
+            *size   =   LL_CRC_POLYLENGTH_7B;
+            return (0);
+        default:
+            return (-1);
+    }
+}
+
+/** 
+ * @brief               Give the next block to the DMA
+ * @param[in]           engine          engine state
+ * @return              None
+ * @note                Thread context with the channel idle, or interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void crc_block   (
+    CRC_ENGINE*         engine  )
+{
+    const CRC_PORT*     port    =   engine->port;
+    uint32_t            count   =   (engine->left > CRC_BLOCK_MAX) ? CRC_BLOCK_MAX : engine->left;
+
+    /* memory to memory: the source is on the peripheral side */
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    LL_DMA_SetPeriphAddress(port->dma, port->dma_channel, (uint32_t)engine->next);
+    LL_DMA_SetDataLength(port->dma, port->dma_channel, count);
+    drv_dma_clear(port->dma, port->dma_channel, DRV_DMA_GI);
+    engine->next    +=  count * engine->item;
+    engine->left    -=  count;
+    engine->stats.blocks++;
+    engine->stats.bytes +=  count * engine->item;
+    LL_DMA_EnableChannel(port->dma, port->dma_channel);
+}
+
+/** 
+ * @brief               Set up the unit and the DMA for a call
+ * @param[in]           engine          engine state
+ * @param[in]           size            LL_CRC_POLYLENGTH_xB
+ * @param[in]           data            bytes
+ * @param[in]           count           bytes
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void crc_start   (
+    CRC_ENGINE*         engine,
+    uint32_t            size,
+    const uint8_t*      data,
+    uint32_t            count   )
+{
+    const CRC_PORT*     port    =   engine->port;
+    const CRC_SPEC*     spec    =   &engine->soft->spec;
+    uint32_t            reg     =   crc_soft_start(spec);
+    uint32_t            head    =   0;
+
+    engine->item        =   1U;
+    engine->tail_size   =   0;
+    if(spec->refin)
+    {
+        /* the unit reverses whole words, so it takes the bytes of an aligned word from bit 0 */
+        head                =   (uint32_t)(-(uintptr_t)data) & 3U;
+        reg                 =   crc_soft_update(engine->soft, reg, data, head);
+        engine->item        =   4U;
+        engine->tail_size   =   (count - head) & 3U;
+    }
+    engine->next    =   data + head;
+    engine->left    =   (count - head) / engine->item;
+    engine->tail    =   engine->next + engine->left * engine->item;
+
+    LL_CRC_SetPolynomialSize(port->crc, size);
+    LL_CRC_SetPolynomialCoef(port->crc, spec->poly);
+    LL_CRC_SetInputDataReverseMode(port->crc, spec->refin ? LL_CRC_INDATA_REVERSE_WORD : LL_CRC_INDATA_REVERSE_NONE);
+    LL_CRC_SetOutputDataReverseMode(port->crc, LL_CRC_OUTDATA_REVERSE_NONE);
+    LL_CRC_SetInitialData(port->crc, crc_soft_to_plain(spec, reg));
+    LL_CRC_ResetCRCCalculationUnit(port->crc);
+
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    LL_DMA_SetPeriphSize(port->dma, port->dma_channel, spec->refin ? LL_DMA_PDATAALIGN_WORD : LL_DMA_PDATAALIGN_BYTE);
+    LL_DMA_SetMemorySize(port->dma, port->dma_channel, spec->refin ? LL_DMA_MDATAALIGN_WORD : LL_DMA_MDATAALIGN_BYTE);
+    crc_block(engine);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Enable the CRC unit and configure the DMA channel
+ * @param[out]          engine          engine state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_init (
+    CRC_ENGINE*         engine,
+    const CRC_PORT*     port,
+    const CRC_CONFIG*   config  )
+{
+    if( (!engine) || (!port) || (!config) )
+    {
+        return (-1);
+    }
+    memset(engine, 0, sizeof(CRC_ENGINE));
+    engine->port    =   port;
+    engine->dma_min =   config->dma_min;
+
+    LL_AHB1_GRP1_EnableClock(port->clock);
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+
+    /* the low priority leaves the bus to the streaming channels */
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->dma_channel, LL_DMA_DIRECTION_MEMORY_TO_MEMORY | LL_DMA_MODE_NORMAL |
+                                                        LL_DMA_PERIPH_INCREMENT | LL_DMA_MEMORY_NOINCREMENT |
+                                                        LL_DMA_PDATAALIGN_WORD | LL_DMA_MDATAALIGN_WORD |
+                                                        LL_DMA_PRIORITY_LOW);
+    LL_DMA_SetMemoryAddress(port->dma, port->dma_channel, (uint32_t)&port->crc->DR);
+    drv_dma_clear(port->dma, port->dma_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TC(port->dma, port->dma_channel);
+    LL_DMA_EnableIT_TE(port->dma, port->dma_channel);
+
+    NVIC_SetPriority(port->dma_irq, config->priority);
+    NVIC_EnableIRQ(port->dma_irq);
+    return (0);
+}
+
+/**
+ * @brief               Start the CRC of a buffer
+ * @param[in]           engine          engine state
+ * @param[in]           soft            algorithm and tables, valid until \ref crc_end
+ * @param[in]           data            bytes, valid until \ref crc_end
+ * @param[in]           size            bytes
+ * @retval              0               started, or done with the tables
+ * @retval              -1              bad arguments, or a call is not ended
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_begin    (
+    CRC_ENGINE*         engine,
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size    )
+{
+    uint32_t    poly_size   =   0;
+
+    if( (!engine) || (!soft) || ( (!data) && (size) ) )
+    {
+        return (-1);
+    }
+    taskENTER_CRITICAL();
+    if(engine->busy)
+    {
+        taskEXIT_CRITICAL();
+        return (-1);
+    }
+    engine->busy    =   1U;
+    taskEXIT_CRITICAL();
+
+    engine->soft    =   soft;
+    engine->error   =   0;
+    engine->stats.calls++;
+    if( (size < engine->dma_min) || (size < 8U) || (0 != crc_size(soft->spec.width, &poly_size)) )
+    {
+        engine->result  =   crc_soft_calc(soft, data, size);
+        engine->unit    =   0;
+        engine->done    =   1U;
+        engine->stats.soft++;
+        return (0);
+    }
+    engine->unit    =   1U;
+    engine->done    =   0;
+    engine->stats.dma++;
+    crc_start(engine, poly_size, (const uint8_t*)data, size);
+    return (0);
+}
+
+/**
+ * @brief               Wait for the CRC started by \ref crc_begin
+ * @param[in]           engine          engine state
+ * @param[in]           timeout         ticks
+ * @param[out]          crc             CRC
+ * @retval              0               success
+ * @retval              -1              nothing started, timeout or DMA error, the call is ended anyway
+ * @note                Thread context, waits on thread flag \ref CRC_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_end  (
+    CRC_ENGINE*         engine,
+    uint32_t            timeout,
+    uint32_t*           crc )
+{
+    const CRC_PORT*     port    =   NULL;
+    const CRC_SPEC*     spec    =   NULL;
+    uint32_t            reg     =   0;
+    int                 ret     =   0;
+
+    if( (!engine) || (!crc) || (!engine->busy) )
+    {
+        return (-1);
+    }
+    port    =   engine->port;
+    spec    =   &engine->soft->spec;
+    (void)osThreadFlagsClear(CRC_FLAG_DONE);
+    taskENTER_CRITICAL();
+    engine->waiter  =   engine->done ? NULL : osThreadGetId();
+    taskEXIT_CRITICAL();
+    if(engine->waiter)
+    {
+        (void)osThreadFlagsWait(CRC_FLAG_DONE, osFlagsWaitAny, timeout);
+    }
+    taskENTER_CRITICAL();
+    if(!engine->done)
+    {
+        LL_DMA_DisableChannel(port->dma, port->dma_channel);
+        engine->stats.timeouts++;
+        ret =   -1;
+    }
+    engine->waiter  =   NULL;
+    taskEXIT_CRITICAL();
+
+    if( (0 == ret) && (engine->error) )
+    {
+        ret =   -1;
+    }
+    if( (0 == ret) && (engine->unit) )
+    {
+        /* the unit left the register in plain order, the tail bytes go on from it */
+        reg             =   crc_soft_from_plain(spec, LL_CRC_ReadData32(port->crc));
+        reg             =   crc_soft_update(engine->soft, reg, engine->tail, engine->tail_size);
+        engine->result  =   crc_soft_final(spec, reg);
+    }
+    if(0 == ret)
+    {
+        *crc    =   engine->result;
+    }
+    engine->busy    =   0;
+    return ret;
+}
+
+/**
+ * @brief               CRC of a buffer, \ref crc_begin and \ref crc_end
+ * @param[in]           engine          engine state
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @param[in]           timeout         ticks
+ * @param[out]          crc             CRC
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_calc (
+    CRC_ENGINE*         engine,
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size,
+    uint32_t            timeout,
+    uint32_t*           crc )
+{
+    if(0 != crc_begin(engine, soft, data, size))
+    {
+        return (-1);
+    }
+    return crc_end(engine, timeout, crc);
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           engine          engine state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void crc_stats   (
+    CRC_ENGINE*         engine,
+    CRC_STATS*          stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &engine->stats, sizeof(CRC_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               DMA channel interrupt: next block, end or transfer error
+ * @param[in]           engine          engine state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void crc_dma_handler (
+    CRC_ENGINE*         engine  )
+{
+    const CRC_PORT*     port    =   engine->port;
+    uint32_t            flags   =   drv_dma_take(port->dma, port->dma_channel);
+
+    if(flags & DRV_DMA_TE)
+    {
+        LL_DMA_DisableChannel(port->dma, port->dma_channel);
+        engine->stats.errors++;
+        engine->error   =   1U;
+    }
+    else if(flags & DRV_DMA_TC)
+    {
+        if(engine->left)
+        {
+            crc_block(engine);
+            return;
+        }
+        LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    }
+    else
+    {
+        return;
+    }
+    engine->done    =   1U;
+    if(engine->waiter)
+    {
+        (void)osThreadFlagsSet(engine->waiter, CRC_FLAG_DONE);
+    }
+}
@@ -0,0 +1,666 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_dac.c
+ * @brief       DAC waveform generator, timer paced DMA from looping tables and streams.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "drv_dma.h"
+#include "drv_dac.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define DAC_SIZE_MAX        (0xFFFFU)   /*!< CNDTR */
+
+/* bit position of the channel in CR, MCR and SR */
+#define DAC_SHIFT(port)     ((port)->channel & DAC_CR_CHX_BITOFFSET_MASK)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const DAC_PORT g_DacPortOut1 =
+{
+    DAC1,                           /*!< dac */
+    LL_DAC_CHANNEL_1,               /*!< channel */
+    TIM6_DAC_IRQn,                  /*!< irq */
+    LL_APB1_GRP1_PERIPH_DAC1,       /*!< clock */
+    TIM6,                           /*!< tim */
+    LL_APB1_GRP1_PERIPH_TIM6,       /*!< tim_clock */
+    LL_DAC_TRIG_EXT_TIM6_TRGO,      /*!< trigger */
+    DMA2,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA2,       /*!< dma_clock */
+    LL_DMA_REQUEST_3,               /*!< request */
+    LL_DMA_CHANNEL_4,               /*!< dma_channel */
+    DMA2_Channel4_IRQn,             /*!< dma_irq */
+    GPIOA,                          /*!< gpio */
+    LL_AHB2_GRP1_PERIPH_GPIOA,      /*!< gpio_clock */
+    4                               /*!< pin */
+};
+
+const DAC_PORT g_DacPortOut2 =
+{
+    DAC1,                           /*!< dac */
+    LL_DAC_CHANNEL_2,               /*!< channel */
+    TIM6_DAC_IRQn,                  /*!< irq */
+    LL_APB1_GRP1_PERIPH_DAC1,       /*!< clock */
+    TIM7,                           /*!< tim */
+    LL_APB1_GRP1_PERIPH_TIM7,       /*!< tim_clock */
+    LL_DAC_TRIG_EXT_TIM7_TRGO,      /*!< trigger */
+    DMA2,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA2,       /*!< dma_clock */
+    LL_DMA_REQUEST_3,               /*!< request */
+    LL_DMA_CHANNEL_5,               /*!< dma_channel */
+    DMA2_Channel5_IRQn,             /*!< dma_irq */
+    GPIOA,                          /*!< gpio */
+    LL_AHB2_GRP1_PERIPH_GPIOA,      /*!< gpio_clock */
+    5                               /*!< pin */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Write prescaler and reload of a sample period
+ * @param[in]           tim             timer
+ * @param[in]           period          timer clocks, 2 or more
+ * @return              None
+ * @note                Both registers are preloaded, they apply from the next update.
+ *                      Periods above 65536 round down to a multiple of the prescaler.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void dac_timer   (
+    TIM_TypeDef*        tim,
+    uint32_t            period  )
+{
+    uint32_t    psc =   (period - 1U) / 0x10000U;
+
+    WRITE_REG(tim->PSC, psc);
+    WRITE_REG(tim->ARR, period / (psc + 1U) - 1U);
+}
+
+/** 
+ * @brief               Point the DMA channel to a source from its first sample
+ * @param[in]           dac             driver state
+ * @param[in]           data            samples
+ * @param[in]           size            samples
+ * @param[in]           half            stream half, 0 for a table
+ * @return              None
+ * @note                Interrupt context or a critical section
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void dac_load    (
+    DAC_OUT*            dac,
+    const uint16_t*     data,
+    uint32_t            size,
+    uint32_t            half    )
+{
+    const DAC_PORT*     port    =   dac->port;
+
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    LL_DMA_SetMemoryAddress(port->dma, port->dma_channel, (uint32_t)data);
+    LL_DMA_SetDataLength(port->dma, port->dma_channel, size);
+    drv_dma_clear(port->dma, port->dma_channel, DRV_DMA_GI);
+    /* a table loops without interrupts */
+    if(half)
+    {
+        LL_DMA_EnableIT_HT(port->dma, port->dma_channel);
+        LL_DMA_EnableIT_TC(port->dma, port->dma_channel);
+    }
+    else
+    {
+        LL_DMA_DisableIT_HT(port->dma, port->dma_channel);
+        LL_DMA_DisableIT_TC(port->dma, port->dma_channel);
+    }
+    dac->data   =   data;
+    dac->size   =   size;
+    dac->half   =   half;
+    dac->free   =   0;
+    dac->fill   =   0;
+    LL_DMA_EnableChannel(port->dma, port->dma_channel);
+}
+
+/** 
+ * @brief               Start a source with the timer stopped
+ * @param[in]           dac             driver state
+ * @param[in]           data            samples
+ * @param[in]           size            samples
+ * @param[in]           half            stream half, 0 for a table
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void dac_begin   (
+    DAC_OUT*            dac,
+    const uint16_t*     data,
+    uint32_t            size,
+    uint32_t            half    )
+{
+    const DAC_PORT*     port    =   dac->port;
+
+    /* drops a request left from the last stop, the first conversion repeats the output */
+    LL_DAC_DisableDMAReq(port->dac, port->channel);
+    LL_DAC_ConvertData12RightAligned(port->dac, port->channel, LL_DAC_RetrieveOutputData(port->dac, port->channel));
+    dac_load(dac, data, size, half);
+    LL_DAC_EnableDMAReq(port->dac, port->channel);
+    WRITE_REG(port->tim->CNT, 0);
+    SET_BIT(port->tim->CR1, TIM_CR1_CEN);
+    dac->running    =   1;
+}
+
+/** 
+ * @brief               Play a source now or at the end of the one playing
+ * @param[in]           dac             driver state
+ * @param[in]           data            samples
+ * @param[in]           size            samples
+ * @param[in]           half            stream half, 0 for a table
+ * @retval              0               success
+ * @retval              -1              a swap still waits
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int dac_schedule (
+    DAC_OUT*            dac,
+    const uint16_t*     data,
+    uint32_t            size,
+    uint32_t            half    )
+{
+    const DAC_PORT*     port    =   dac->port;
+    int                 ret     =   0;
+
+    taskENTER_CRITICAL();
+    if(dac->pending)
+    {
+        ret =   -1;
+    }
+    else if(!dac->running)
+    {
+        dac_begin(dac, data, size, half);
+    }
+    else
+    {
+        dac->next_data  =   data;
+        dac->next_size  =   size;
+        dac->next_half  =   half;
+        dac->pending    =   1;
+        LL_DMA_EnableIT_TC(port->dma, port->dma_channel);
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/** 
+ * @brief               Swap to the waiting source, the last sample of the old one was fetched
+ * @param[in]           dac             driver state
+ * @return              None
+ * @note                Interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void dac_swap    (
+    DAC_OUT*            dac )
+{
+    const DAC_PORT*     port    =   dac->port;
+
+    /* the channel reloaded, it has fetched old samples again when the interrupt came late */
+    if(LL_DMA_GetDataLength(port->dma, port->dma_channel) != dac->size)
+    {
+        dac->stats.late++;
+    }
+    dac_load(dac, dac->next_data, dac->next_size, dac->next_half);
+    dac->pending    =   0;
+    dac->stats.swaps++;
+    if(dac->waiter)
+    {
+        (void)osThreadFlagsSet(dac->waiter, DAC_FLAG_SWAP);
+    }
+}
+
+/** 
+ * @brief               A stream half has played, the DMA went on into the other one
+ * @param[in]           dac             driver state
+ * @param[in]           half            0 or 1
+ * @return              None
+ * @note                Interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void dac_played  (
+    DAC_OUT*            dac,
+    uint32_t            half    )
+{
+    dac->stats.halves++;
+    if(dac->free & (1U << (half ^ 1U)))
+    {
+        dac->stats.underflows++;
+    }
+    dac->free   |=  1U << half;
+    if(dac->producer)
+    {
+        (void)osThreadFlagsSet(dac->producer, DAC_FLAG_HALF);
+    }
+}
+
+/** 
+ * @brief               Hand the half to refill to the producer
+ * @param[in]           dac             driver state
+ * @return              the half, NULL when none is free, the caller is the producer now
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint16_t* dac_take   (
+    DAC_OUT*            dac )
+{
+    uint16_t*   half    =   NULL;
+
+    taskENTER_CRITICAL();
+    if( (dac->half) && (dac->free & (1U << dac->fill)) )
+    {
+        half            =   (uint16_t*)&dac->data[dac->fill * dac->half];
+        dac->producer   =   NULL;
+    }
+    else
+    {
+        dac->producer   =   osThreadGetId();
+    }
+    taskEXIT_CRITICAL();
+    return half;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the DAC channel, its timer and DMA channel
+ * @param[out]          dac             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                The output holds 0 until a source plays
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_init (
+    DAC_OUT*            dac,
+    const DAC_PORT*     port,
+    const DAC_CONFIG*   config  )
+{
+    if( (!dac) || (!port) || (!config) || (config->period < 2U) )
+    {
+        return (-1);
+    }
+    memset(dac, 0, sizeof(DAC_OUT));
+    dac->port   =   port;
+
+    LL_APB1_GRP1_EnableClock(port->clock);
+    LL_APB1_GRP1_EnableClock(port->tim_clock);
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+    LL_AHB2_GRP1_EnableClock(port->gpio_clock);
+    SET_BIT(port->gpio->MODER, GPIO_MODER_MODE0 << (port->pin * 2U));
+
+    /* the update event loading the prescaler converts nothing yet */
+    WRITE_REG(port->tim->CR1, TIM_CR1_ARPE);
+    dac_timer(port->tim, config->period);
+    WRITE_REG(port->tim->CR2, TIM_CR2_MMS_1);
+    WRITE_REG(port->tim->EGR, TIM_EGR_UG);
+
+    LL_DAC_Disable(port->dac, port->channel);
+    LL_DAC_ConfigOutput(port->dac, port->channel, LL_DAC_OUTPUT_MODE_NORMAL,
+                        config->unbuffered ? LL_DAC_OUTPUT_BUFFER_DISABLE : LL_DAC_OUTPUT_BUFFER_ENABLE,
+                        LL_DAC_OUTPUT_CONNECT_GPIO);
+    LL_DAC_SetTriggerSource(port->dac, port->channel, port->trigger);
+    LL_DAC_EnableTrigger(port->dac, port->channel);
+    LL_DAC_ConvertData12RightAligned(port->dac, port->channel, 0);
+    WRITE_REG(port->dac->SR, DAC_SR_DMAUDR1 << DAC_SHIFT(port));
+    SET_BIT(port->dac->CR, DAC_CR_DMAUDRIE1 << DAC_SHIFT(port));
+    LL_DAC_Enable(port->dac, port->channel);
+
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->dma_channel, LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_CIRCULAR |
+                                                        LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                        LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD |
+                                                        LL_DMA_PRIORITY_HIGH);
+    drv_dma_request(port->dma, port->dma_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->dma_channel,
+                            LL_DAC_DMA_GetRegAddr(port->dac, port->channel, LL_DAC_DMA_REG_DATA_12BITS_RIGHT_ALIGNED));
+    drv_dma_clear(port->dma, port->dma_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TE(port->dma, port->dma_channel);
+
+    NVIC_SetPriority(port->irq, config->priority);
+    NVIC_SetPriority(port->dma_irq, config->priority);
+    NVIC_EnableIRQ(port->irq);
+    NVIC_EnableIRQ(port->dma_irq);
+    return (0);
+}
+
+/**
+ * @brief               Loop a table, now or at the end of the source playing
+ * @param[in]           dac             driver state
+ * @param[in]           samples         12 bit right aligned
+ * @param[in]           size            1 to 65535
+ * @retval              0               playing or swapping at the end of the source playing
+ * @retval              -1              bad arguments, or a swap still waits
+ * @note                The table must stay valid while it plays. The first
+ *                      sample after a start repeats the value the output held.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_play (
+    DAC_OUT*            dac,
+    const uint16_t*     samples,
+    uint32_t            size    )
+{
+    if( (!dac) || (!samples) || (0 == size) || (size > DAC_SIZE_MAX) )
+    {
+        return (-1);
+    }
+    return dac_schedule(dac, samples, size, 0);
+}
+
+/**
+ * @brief               Stream from a buffer of two halves, now or at the end of the source playing
+ * @param[in]           dac             driver state
+ * @param[in]           buffer          2 x half samples, filled
+ * @param[in]           half            1 to 32767
+ * @retval              0               playing or swapping at the end of the source playing
+ * @retval              -1              bad arguments, or a swap still waits
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_stream   (
+    DAC_OUT*            dac,
+    uint16_t*           buffer,
+    uint32_t            half    )
+{
+    if( (!dac) || (!buffer) || (0 == half) || (2U * half > DAC_SIZE_MAX) )
+    {
+        return (-1);
+    }
+    return dac_schedule(dac, buffer, 2U * half, half);
+}
+
+/**
+ * @brief               Wait until the swap of \ref dac_play or \ref dac_stream took place
+ * @param[in]           dac             driver state
+ * @param[in]           timeout         ticks
+ * @retval              0               no swap waits, the old source is free
+ * @retval              -1              timeout, the swap is called off and the old source plays on
+ * @note                Thread context, waits on thread flag \ref DAC_FLAG_SWAP
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_sync (
+    DAC_OUT*            dac,
+    uint32_t            timeout )
+{
+    const DAC_PORT*     port    =   NULL;
+    int                 ret     =   0;
+
+    if(!dac)
+    {
+        return (-1);
+    }
+    port    =   dac->port;
+    (void)osThreadFlagsClear(DAC_FLAG_SWAP);
+    taskENTER_CRITICAL();
+    dac->waiter =   dac->pending ? osThreadGetId() : NULL;
+    taskEXIT_CRITICAL();
+    if(!dac->waiter)
+    {
+        return (0);
+    }
+    (void)osThreadFlagsWait(DAC_FLAG_SWAP, osFlagsWaitAny, timeout);
+    taskENTER_CRITICAL();
+    if(dac->pending)
+    {
+        dac->pending    =   0;
+        if(!dac->half)
+        {
+            LL_DMA_DisableIT_TC(port->dma, port->dma_channel);
+        }
+        ret =   -1;
+    }
+    dac->waiter =   NULL;
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**
+ * @brief               Wait for a stream half to refill
+ * @param[in]           dac             driver state
+ * @param[in]           timeout         ticks
+ * @return              the half, NULL on timeout or when no stream plays
+ * @note                One producer thread, waits on thread flag \ref DAC_FLAG_HALF
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint16_t* dac_stream_get (
+    DAC_OUT*            dac,
+    uint32_t            timeout )
+{
+    uint16_t*   half    =   NULL;
+    uint32_t    flags   =   0;
+
+    if( (!dac) || (!dac->half) )
+    {
+        return NULL;
+    }
+    (void)osThreadFlagsClear(DAC_FLAG_HALF);
+    half    =   dac_take(dac);
+    if(!half)
+    {
+        flags   =   osThreadFlagsWait(DAC_FLAG_HALF, osFlagsWaitAny, timeout);
+        half    =   (flags & osFlagsError) ? NULL : dac_take(dac);
+    }
+    if(!half)
+    {
+        taskENTER_CRITICAL();
+        dac->producer   =   NULL;
+        taskEXIT_CRITICAL();
+    }
+    return half;
+}
+
+/**
+ * @brief               Hand back the half \ref dac_stream_get gave
+ * @param[in]           dac             driver state
+ * @retval              0               success
+ * @retval              -1              no half was taken
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_stream_put   (
+    DAC_OUT*            dac )
+{
+    int     ret =   -1;
+
+    if(!dac)
+    {
+        return (-1);
+    }
+    taskENTER_CRITICAL();
+    if( (dac->half) && (dac->free & (1U << dac->fill)) )
+    {
+        dac->free   &=  ~(1U << dac->fill);
+        dac->fill   ^=  1U;
+        ret         =   0;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**
+ * @brief               Change the sample rate at the next sample boundary
+ * @param[in]           dac             driver state
+ * @param[in]           period          timer clocks per sample, 2 or more
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int dac_period   (
+    DAC_OUT*            dac,
+    uint32_t            period  )
+{
+    if( (!dac) || (period < 2U) )
+    {
+        return (-1);
+    }
+    taskENTER_CRITICAL();
+    dac_timer(dac->port->tim, period);
+    taskEXIT_CRITICAL();
+    return (0);
+}
+
+/**
+ * @brief               Stop the timer and the DMA, the output holds its value
+ * @param[in]           dac             driver state
+ * @return              None
+ * @note                A waiting swap is called off
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_stop    (
+    DAC_OUT*            dac )
+{
+    const DAC_PORT*     port    =   dac->port;
+
+    taskENTER_CRITICAL();
+    CLEAR_BIT(port->tim->CR1, TIM_CR1_CEN);
+    LL_DMA_DisableChannel(port->dma, port->dma_channel);
+    dac->running    =   0;
+    dac->pending    =   0;
+    dac->half       =   0;
+    dac->free       =   0;
+    /* nothing reads the old source any more, and no half comes free */
+    if(dac->waiter)
+    {
+        (void)osThreadFlagsSet(dac->waiter, DAC_FLAG_SWAP);
+    }
+    if(dac->producer)
+    {
+        (void)osThreadFlagsSet(dac->producer, DAC_FLAG_HALF);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           dac             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_stats   (
+    DAC_OUT*            dac,
+    DAC_STATS*          stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &dac->stats, sizeof(DAC_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               DMA channel interrupt: end of a source or of a stream half, transfer error
+ * @param[in]           dac             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_dma_handler (
+    DAC_OUT*            dac )
+{
+    const DAC_PORT*     port    =   dac->port;
+    uint32_t            flags   =   drv_dma_take(port->dma, port->dma_channel);
+
+    if(flags & DRV_DMA_TE)
+    {
+        dac->stats.errors++;
+        CLEAR_BIT(port->tim->CR1, TIM_CR1_CEN);
+        dac->running    =   0;
+        return;
+    }
+    if(dac->half)
+    {
+        if(flags & DRV_DMA_HT)
+        {
+            dac_played(dac, 0);
+        }
+        if(flags & DRV_DMA_TC)
+        {
+            dac_played(dac, 1);
+        }
+    }
+    if( (flags & DRV_DMA_TC) && (dac->pending) )
+    {
+        dac_swap(dac);
+    }
+}
+
+/**
+ * @brief               DAC underrun interrupt of the channel, restarts the source
+ * @param[in]           dac             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void dac_irq_handler (
+    DAC_OUT*            dac )
+{
+    const DAC_PORT*     port    =   dac->port;
+    uint32_t            flag    =   DAC_SR_DMAUDR1 << DAC_SHIFT(port);
+
+    if(READ_REG(port->dac->SR) & flag)
+    {
+        /* the DMA request of the channel stays off until DMAEN is cleared */
+        WRITE_REG(port->dac->SR, flag);
+        dac->stats.underruns++;
+        LL_DAC_DisableDMAReq(port->dac, port->channel);
+        if(dac->running)
+        {
+            dac_load(dac, dac->data, dac->size, dac->half);
+            LL_DAC_EnableDMAReq(port->dac, port->channel);
+        }
+    }
+}
@@ -0,0 +1,703 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_i2c.c
+ * @brief       I2C master with a queue of write then read DMA transactions.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "drv_dma.h"
+#include "drv_i2c.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define I2C_CR1_DMA         (I2C_CR1_PE | I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN | I2C_CR1_ERRIE | \
+                             I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE)
+#define I2C_ISR_ERRORS      (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT)
+#define I2C_ICR_ERRORS      (I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF | I2C_ICR_PECCF | I2C_ICR_TIMOUTCF)
+#define I2C_NBYTES_MAX      (255U)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const I2C_PORT g_I2cPortI2c2 =
+{
+    I2C2,                           /*!< i2c */
+    I2C2_EV_IRQn,                   /*!< ev_irq */
+    I2C2_ER_IRQn,                   /*!< er_irq */
+    LL_APB1_GRP1_PERIPH_I2C2,       /*!< clock */
+    DMA1,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA1,       /*!< dma_clock */
+    LL_DMA_REQUEST_3,               /*!< request */
+    LL_DMA_CHANNEL_5,               /*!< rx_channel */
+    DMA1_Channel5_IRQn,             /*!< rx_irq */
+    LL_DMA_CHANNEL_4,               /*!< tx_channel */
+    DMA1_Channel4_IRQn,             /*!< tx_irq */
+    GPIOB,                          /*!< gpio */
+    LL_AHB2_GRP1_PERIPH_GPIOB,      /*!< gpio_clock */
+    10,                             /*!< scl */
+    11,                             /*!< sda */
+    LL_GPIO_AF_4                    /*!< alternate */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Half an SCL period of a bus recovery
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_spin    (void)
+{
+    volatile uint32_t   i;
+
+    for(i = 0; i < I2C_RECOVER_SPIN; i++)
+    {
+    }
+}
+
+/** 
+ * @brief               Switch SCL and SDA between GPIO and the peripheral
+ * @param[in]           port            hardware
+ * @param[in]           mode            GPIO_MODER_MODE0_0 output, GPIO_MODER_MODE0_1 alternate
+ * @return              None
+ * @note                The pins stay open drain
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_pins    (
+    const I2C_PORT*     port,
+    uint32_t            mode    )
+{
+    MODIFY_REG(port->gpio->MODER, (GPIO_MODER_MODE0 << (port->scl * 2U)) | (GPIO_MODER_MODE0 << (port->sda * 2U)),
+               (mode << (port->scl * 2U)) | (mode << (port->sda * 2U)));
+}
+
+/** 
+ * @brief               Reset the peripheral and free the bus
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @note                Clocks SCL until a device that holds SDA low lets go, then sends a STOP.
+ *                      Busy waits about 100 us.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_recover (
+    I2C*                i2c )
+{
+    const I2C_PORT*     port    =   i2c->port;
+    GPIO_TypeDef*       gpio    =   port->gpio;
+    uint32_t            scl     =   1U << port->scl;
+    uint32_t            sda     =   1U << port->sda;
+    uint32_t            i;
+
+    CLEAR_BIT(port->i2c->CR1, I2C_CR1_PE);
+    WRITE_REG(gpio->BSRR, scl | sda);
+    i2c_pins(port, GPIO_MODER_MODE0_0);
+    for(i = 0; (i < I2C_RECOVER_CLOCKS) && (!(READ_REG(gpio->IDR) & sda)); i++)
+    {
+        WRITE_REG(gpio->BRR, scl);
+        i2c_spin();
+        WRITE_REG(gpio->BSRR, scl);
+        i2c_spin();
+    }
+    /* STOP: SDA rises while SCL is high */
+    WRITE_REG(gpio->BRR, scl);
+    i2c_spin();
+    WRITE_REG(gpio->BRR, sda);
+    i2c_spin();
+    WRITE_REG(gpio->BSRR, scl);
+    i2c_spin();
+    WRITE_REG(gpio->BSRR, sda);
+    i2c_spin();
+    i2c_pins(port, GPIO_MODER_MODE0_1);
+    WRITE_REG(port->i2c->CR1, I2C_CR1_DMA);
+    i2c->stats.recoveries++;
+}
+
+/** 
+ * @brief               End bits of the NBYTES now programmed
+ * @param[in]           i2c             driver state
+ * @return              RELOAD while more follows, AUTOEND after the last phase, 0 before the repeated start
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t i2c_end_bits    (
+    I2C*                i2c )
+{
+    if(i2c->left)
+    {
+        return I2C_CR2_RELOAD;
+    }
+    return ( (i2c->reading) || (0 == i2c->head->rx_size) ) ? I2C_CR2_AUTOEND : 0;
+}
+
+/** 
+ * @brief               Start the write or the read phase of the running transaction
+ * @param[in]           i2c             driver state
+ * @param[in]           read            0 write, 1 read after a repeated start
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_phase   (
+    I2C*                i2c,
+    int                 read    )
+{
+    const I2C_PORT*     port    =   i2c->port;
+    const I2C_XFER*     xfer    =   i2c->head;
+    uint32_t            channel =   read ? port->rx_channel : port->tx_channel;
+    uint32_t            size    =   read ? xfer->rx_size : xfer->tx_size;
+    uint32_t            chunk   =   (size > I2C_NBYTES_MAX) ? I2C_NBYTES_MAX : size;
+
+    LL_DMA_DisableChannel(port->dma, channel);
+    LL_DMA_SetMemoryAddress(port->dma, channel, read ? (uint32_t)xfer->rx : (uint32_t)xfer->tx);
+    LL_DMA_SetDataLength(port->dma, channel, size);
+    LL_DMA_EnableChannel(port->dma, channel);
+    i2c->reading    =   (uint32_t)read;
+    i2c->left       =   size - chunk;
+    WRITE_REG(port->i2c->CR2, ((xfer->address << 1) & I2C_CR2_SADD) | (read ? I2C_CR2_RD_WRN : 0) |
+                              (chunk << I2C_CR2_NBYTES_Pos) | i2c_end_bits(i2c) | I2C_CR2_START);
+}
+
+/** 
+ * @brief               Start the transaction at the head
+ * @param[in]           i2c             driver state
+ * @retval              0               started
+ * @retval              -1              the bus stays busy after a recovery
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int i2c_start    (
+    I2C*                i2c )
+{
+    I2C_TypeDef*        regs    =   i2c->port->i2c;
+    const I2C_XFER*     xfer    =   i2c->head;
+
+    if(READ_REG(regs->ISR) & I2C_ISR_BUSY)
+    {
+        i2c_recover(i2c);
+        if(READ_REG(regs->ISR) & I2C_ISR_BUSY)
+        {
+            return (-1);
+        }
+    }
+    if(xfer->tx_size)
+    {
+        i2c_phase(i2c, 0);
+    }
+    else if(xfer->rx_size)
+    {
+        i2c_phase(i2c, 1);
+    }
+    else
+    {
+        /* address only, to probe a device */
+        i2c->reading    =   0;
+        i2c->left       =   0;
+        WRITE_REG(regs->CR2, ((xfer->address << 1) & I2C_CR2_SADD) | I2C_CR2_AUTOEND | I2C_CR2_START);
+    }
+    return (0);
+}
+
+/** 
+ * @brief               Start queued transactions until one runs
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @note                Those that cannot start end with \ref I2C_ERR_BUS
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_next    (
+    I2C*                i2c )
+{
+    I2C_XFER*   xfer    =   NULL;
+
+    while(i2c->head)
+    {
+        if(0 == i2c_start(i2c))
+        {
+            return;
+        }
+        xfer        =   i2c->head;
+        i2c->head   =   xfer->next;
+        xfer->status    =   I2C_ERR_BUS;
+        i2c->stats.errors++;
+        if(xfer->done)
+        {
+            xfer->done(xfer);
+        }
+    }
+    i2c->tail   =   NULL;
+}
+
+/** 
+ * @brief               End the running transaction and start the next one
+ * @param[in]           i2c             driver state
+ * @param[in]           status          \ref I2C_OK, ...
+ * @return              None
+ * @note                Interrupt context or a critical section
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_end (
+    I2C*                i2c,
+    int                 status  )
+{
+    const I2C_PORT*     port    =   i2c->port;
+    I2C_XFER*           xfer    =   i2c->head;
+
+    if(!xfer)
+    {
+        return;
+    }
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    /* a byte left in TXDR after a NACK would go out first in the next write */
+    SET_BIT(port->i2c->ISR, I2C_ISR_TXE);
+    if(I2C_OK == status)
+    {
+        i2c->stats.bytes    +=  xfer->tx_size + xfer->rx_size;
+        i2c->stats.xfers++;
+    }
+    else if(I2C_ERR_NACK != status)
+    {
+        i2c->stats.errors++;
+    }
+    xfer->status    =   status;
+    i2c->head       =   xfer->next;
+    i2c_next(i2c);
+    if(xfer->done)
+    {
+        xfer->done(xfer);
+    }
+}
+
+/** 
+ * @brief               Stop the running transaction with a bus recovery
+ * @param[in]           i2c             driver state
+ * @param[in]           status          \ref I2C_ERR_BUS or \ref I2C_ERR_TIMEOUT
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_fail    (
+    I2C*                i2c,
+    int                 status  )
+{
+    const I2C_PORT*     port    =   i2c->port;
+
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    i2c_recover(i2c);
+    i2c_end(i2c, status);
+}
+
+/** 
+ * @brief               Done call of \ref i2c_transfer
+ * @param[in]           xfer            descriptor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void i2c_transfer_done   (
+    I2C_XFER*   xfer    )
+{
+    (void)osThreadFlagsSet((osThreadId_t)xfer->arg, I2C_FLAG_DONE);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the I2C as master, its pins and DMA channels
+ * @param[out]          i2c             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Recovers the bus when a device holds SDA low
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_init (
+    I2C*                i2c,
+    const I2C_PORT*     port,
+    const I2C_CONFIG*   config  )
+{
+    LL_GPIO_InitTypeDef gpio;
+    I2C_TypeDef*        regs    =   NULL;
+    uint32_t            ticks   =   0;
+
+    if( (!i2c) || (!port) || (!config) || (0 == config->pclk) || (config->scl_timeout > 100U) )
+    {
+        return (-1);
+    }
+    /* tTIMEOUT = (TIMEOUTA + 1) x 2048 x tI2CCLK */
+    ticks   =   (uint32_t)((uint64_t)config->pclk * config->scl_timeout / 2048000U);
+    if( (config->scl_timeout) && ((0 == ticks) || (ticks > 0x1000U)) )
+    {
+        return (-1);
+    }
+    memset(i2c, 0, sizeof(I2C));
+    i2c->port   =   port;
+    regs        =   port->i2c;
+
+    /* clocks and pins */
+    LL_APB1_GRP1_EnableClock(port->clock);
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+    LL_AHB2_GRP1_EnableClock(port->gpio_clock);
+    LL_GPIO_StructInit(&gpio);
+    gpio.Pin        =   (1U << port->scl) | (1U << port->sda);
+    gpio.Mode       =   LL_GPIO_MODE_ALTERNATE;
+    gpio.Speed      =   LL_GPIO_SPEED_FREQ_HIGH;
+    gpio.OutputType =   LL_GPIO_OUTPUT_OPENDRAIN;
+    gpio.Pull       =   LL_GPIO_PULL_UP;
+    gpio.Alternate  =   port->alternate;
+    (void)LL_GPIO_Init(port->gpio, &gpio);
+
+    /* timing and SCL low timeout are written with the peripheral off */
+    WRITE_REG(regs->CR1, 0);
+    WRITE_REG(regs->TIMINGR, config->timing);
+    WRITE_REG(regs->TIMEOUTR, config->scl_timeout ? (I2C_TIMEOUTR_TIMOUTEN | (ticks - 1U)) : 0);
+    WRITE_REG(regs->CR2, 0);
+    WRITE_REG(regs->CR1, I2C_CR1_DMA);
+
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->rx_channel, LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_NORMAL |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_HIGH);
+    drv_dma_request(port->dma, port->rx_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->rx_channel, LL_I2C_DMA_GetRegAddr(regs, LL_I2C_DMA_REG_DATA_RECEIVE));
+    drv_dma_clear(port->dma, port->rx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TE(port->dma, port->rx_channel);
+
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->tx_channel, LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_MEDIUM);
+    drv_dma_request(port->dma, port->tx_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->tx_channel, LL_I2C_DMA_GetRegAddr(regs, LL_I2C_DMA_REG_DATA_TRANSMIT));
+    drv_dma_clear(port->dma, port->tx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TE(port->dma, port->tx_channel);
+
+    /* a device may still hold SDA from a read the reset cut short */
+    if(READ_REG(regs->ISR) & I2C_ISR_BUSY)
+    {
+        i2c_recover(i2c);
+    }
+
+    NVIC_SetPriority(port->ev_irq, config->priority);
+    NVIC_SetPriority(port->er_irq, config->priority);
+    NVIC_SetPriority(port->rx_irq, config->priority);
+    NVIC_SetPriority(port->tx_irq, config->priority);
+    NVIC_EnableIRQ(port->ev_irq);
+    NVIC_EnableIRQ(port->er_irq);
+    NVIC_EnableIRQ(port->rx_irq);
+    NVIC_EnableIRQ(port->tx_irq);
+    return (0);
+}
+
+/**
+ * @brief               Queue a chain of transactions
+ * @param[in]           i2c             driver state
+ * @param[in]           xfer            first descriptor, the others linked through next
+ * @retval              0               success
+ * @retval              -1              fail, nothing queued
+ * @note                Thread context. The buffers must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_submit   (
+    I2C*                i2c,
+    I2C_XFER*           xfer    )
+{
+    I2C_XFER*   last    =   NULL;
+    I2C_XFER*   each    =   NULL;
+
+    if( (!i2c) || (!xfer) )
+    {
+        return (-1);
+    }
+    for(each = xfer; each; each = each->next)
+    {
+        if( (each->address > 0x7FU) || (each->tx_size > 0xFFFFU) || (each->rx_size > 0xFFFFU) ||
+            ((each->tx_size) && (!each->tx)) || ((each->rx_size) && (!each->rx)) )
+        {
+            return (-1);
+        }
+        last    =   each;
+    }
+    for(each = xfer; each; each = each->next)
+    {
+        each->status    =   I2C_PENDING;
+    }
+    /* the STOP interrupt takes the head and starts the next one */
+    taskENTER_CRITICAL();
+    if(i2c->tail)
+    {
+        i2c->tail->next =   xfer;
+        i2c->tail       =   last;
+    }
+    else
+    {
+        i2c->head   =   xfer;
+        i2c->tail   =   last;
+        i2c_next(i2c);
+    }
+    taskEXIT_CRITICAL();
+    return (0);
+}
+
+/**
+ * @brief               Take a transaction back
+ * @param[in]           i2c             driver state
+ * @param[in]           xfer            descriptor
+ * @retval              0               it ended with \ref I2C_ERR_TIMEOUT and its done call ran
+ * @retval              -1              it was not queued, it has ended before
+ * @note                A running transaction stops with a bus recovery
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_abort    (
+    I2C*                i2c,
+    I2C_XFER*           xfer    )
+{
+    I2C_XFER*   prev    =   NULL;
+    I2C_XFER*   each    =   NULL;
+    int         ret     =   -1;
+
+    if( (!i2c) || (!xfer) )
+    {
+        return (-1);
+    }
+    taskENTER_CRITICAL();
+    if(i2c->head == xfer)
+    {
+        i2c_fail(i2c, I2C_ERR_TIMEOUT);
+        ret =   0;
+    }
+    else if(i2c->head)
+    {
+        for(prev = i2c->head, each = prev->next; (each) && (each != xfer); prev = each, each = each->next)
+        {
+        }
+        if(each)
+        {
+            prev->next  =   xfer->next;
+            if(i2c->tail == xfer)
+            {
+                i2c->tail   =   prev;
+            }
+            xfer->status    =   I2C_ERR_TIMEOUT;
+            i2c->stats.errors++;
+            if(xfer->done)
+            {
+                xfer->done(xfer);
+            }
+            ret =   0;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+/**
+ * @brief               Write then read and wait for the end
+ * @param[in]           i2c             driver state
+ * @param[in]           address         7 bit
+ * @param[in]           tx              bytes to write
+ * @param[in]           tx_size         0 to 65535
+ * @param[out]          rx              bytes read
+ * @param[in]           rx_size         0 to 65535
+ * @param[in]           timeout         ticks before \ref i2c_abort
+ * @return              \ref I2C_OK, ..., -1 for bad arguments
+ * @note                Thread context, waits on thread flag \ref I2C_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int i2c_transfer (
+    I2C*                i2c,
+    uint32_t            address,
+    const uint8_t*      tx,
+    uint32_t            tx_size,
+    uint8_t*            rx,
+    uint32_t            rx_size,
+    uint32_t            timeout )
+{
+    I2C_XFER    xfer;
+    uint32_t    flags   =   0;
+
+    memset(&xfer, 0, sizeof(xfer));
+    xfer.address    =   address;
+    xfer.tx         =   tx;
+    xfer.tx_size    =   tx_size;
+    xfer.rx         =   rx;
+    xfer.rx_size    =   rx_size;
+    xfer.done       =   i2c_transfer_done;
+    xfer.arg        =   (void*)osThreadGetId();
+    (void)osThreadFlagsClear(I2C_FLAG_DONE);
+    if(0 != i2c_submit(i2c, &xfer))
+    {
+        return (-1);
+    }
+    flags   =   osThreadFlagsWait(I2C_FLAG_DONE, osFlagsWaitAny, timeout);
+    if(flags & osFlagsError)
+    {
+        /* the descriptor lives on this stack, it must leave the queue */
+        (void)i2c_abort(i2c, &xfer);
+        (void)osThreadFlagsClear(I2C_FLAG_DONE);
+    }
+    return xfer.status;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           i2c             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_stats   (
+    I2C*                i2c,
+    I2C_STATS*          stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &i2c->stats, sizeof(I2C_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               I2C event interrupt: reload, repeated start, STOP and NACK
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_ev_handler  (
+    I2C*                i2c )
+{
+    I2C_TypeDef*    regs    =   i2c->port->i2c;
+    uint32_t        isr     =   READ_REG(regs->ISR);
+    I2C_XFER*       xfer    =   i2c->head;
+    uint32_t        chunk   =   0;
+
+    if(!xfer)
+    {
+        WRITE_REG(regs->ICR, I2C_ICR_STOPCF | I2C_ICR_NACKCF);
+        return;
+    }
+    if(isr & I2C_ISR_NACKF)
+    {
+        WRITE_REG(regs->ICR, I2C_ICR_NACKCF);
+        xfer->status    =   I2C_ERR_NACK;
+        i2c->stats.nacks++;
+        /* AUTOEND sends the STOP by itself */
+        if(!(READ_REG(regs->CR2) & I2C_CR2_AUTOEND))
+        {
+            SET_BIT(regs->CR2, I2C_CR2_STOP);
+        }
+    }
+    if(isr & I2C_ISR_STOPF)
+    {
+        WRITE_REG(regs->ICR, I2C_ICR_STOPCF);
+        i2c_end(i2c, (I2C_PENDING == xfer->status) ? I2C_OK : xfer->status);
+    }
+    else if(I2C_PENDING != xfer->status)
+    {
+        /* the STOP after the NACK is coming */
+    }
+    else if(isr & I2C_ISR_TCR)
+    {
+        chunk       =   (i2c->left > I2C_NBYTES_MAX) ? I2C_NBYTES_MAX : i2c->left;
+        i2c->left   -=  chunk;
+        MODIFY_REG(regs->CR2, I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND,
+                   (chunk << I2C_CR2_NBYTES_Pos) | i2c_end_bits(i2c));
+        i2c->stats.reloads++;
+    }
+    else if(isr & I2C_ISR_TC)
+    {
+        /* the write is out, the read follows after a repeated start */
+        i2c_phase(i2c, 1);
+    }
+}
+
+/**
+ * @brief               I2C error interrupt: bus error, arbitration loss, overrun and SCL timeout
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_er_handler  (
+    I2C*                i2c )
+{
+    I2C_TypeDef*    regs    =   i2c->port->i2c;
+    uint32_t        isr     =   READ_REG(regs->ISR);
+
+    if(isr & I2C_ISR_ERRORS)
+    {
+        WRITE_REG(regs->ICR, I2C_ICR_ERRORS);
+        i2c_fail(i2c, (isr & I2C_ISR_TIMEOUT) ? I2C_ERR_TIMEOUT : I2C_ERR_BUS);
+    }
+}
+
+/**
+ * @brief               DMA channel interrupt of either direction: errors only
+ * @param[in]           i2c             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void i2c_dma_handler (
+    I2C*                i2c )
+{
+    const I2C_PORT*     port    =   i2c->port;
+    uint32_t            flags   =   0;
+
+    flags   =   drv_dma_take(port->dma, port->rx_channel) | drv_dma_take(port->dma, port->tx_channel);
+    if(flags & DRV_DMA_TE)
+    {
+        i2c_fail(i2c, I2C_ERR_BUS);
+    }
+}
@@ -0,0 +1,472 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_lpuart.c
+ * @brief       LPUART1 log and console backend clocked from LSE.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "stm32l4xx_ll_pwr.h"
+#include "stm32l4xx_ll_exti.h"
+#include "stm32l4xx_ll_gpio.h"
+#include "stm32l4xx_ll_lpuart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "cmsis_os2.h"
+#include "drv_dma.h"
+#include "drv_lpuart.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* Context switch on leaving an interrupt, the host model has no scheduler */
+#ifndef LPUART_YIELD_FROM_ISR
+#define LPUART_YIELD_FROM_ISR(woken)    portYIELD_FROM_ISR(woken)
+#endif
+
+#define LPUART_DMA          DMA2
+#define LPUART_TX_CHANNEL   LL_DMA_CHANNEL_6
+#define LPUART_TX_IRQ       DMA2_Channel6_IRQn
+#define LPUART_REQUEST      LL_DMA_REQUEST_4
+#define LPUART_EXTI_LINE    LL_EXTI_LINE_31     /*!< LPUART1 wakeup */
+#define LPUART_RX_ERRORS    (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static uint8_t*                 g_LpuartTx      =   NULL;
+static uint32_t                 g_LpuartMask    =   0;      /*!< ring size - 1 */
+static uint32_t                 g_LpuartBatch   =   0;
+static volatile uint32_t        g_LpuartHead    =   0;      /*!< written by the writer, free running */
+static volatile uint32_t        g_LpuartTail    =   0;      /*!< sent, free running */
+static volatile uint32_t        g_LpuartBurst   =   0;      /*!< bytes of the running burst, 0 idle */
+static volatile uint32_t        g_LpuartForce   =   0;      /*!< send below a batch until the ring is empty */
+static StreamBufferHandle_t     g_LpuartRx      =   NULL;
+static StaticStreamBuffer_t     g_LpuartRxCb;
+static LPUART_STATS             g_LpuartStats;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Start a burst when idle and enough is waiting
+ * @return              None
+ * @note                Interrupts of the DMA channel masked or from its handler.
+ *                      A burst stops at the end of the ring, the next one starts at its top.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void lpuart_tx_start (void)
+{
+    uint32_t    tail    =   g_LpuartTail;
+    uint32_t    pending =   g_LpuartHead - tail;
+    uint32_t    size    =   0;
+
+    if( (g_LpuartBurst) || (0 == pending) )
+    {
+        return;
+    }
+    if( (pending < g_LpuartBatch) && (!g_LpuartForce) )
+    {
+        return;
+    }
+    size    =   g_LpuartMask + 1U - (tail & g_LpuartMask);
+    if(size > pending)
+    {
+        size    =   pending;
+    }
+    if(size > 0xFFFFU)
+    {
+        size    =   0xFFFFU;
+    }
+    g_LpuartBurst   =   size;
+    LL_DMA_DisableChannel(LPUART_DMA, LPUART_TX_CHANNEL);
+    LL_DMA_SetMemoryAddress(LPUART_DMA, LPUART_TX_CHANNEL, (uint32_t)&g_LpuartTx[tail & g_LpuartMask]);
+    LL_DMA_SetDataLength(LPUART_DMA, LPUART_TX_CHANNEL, size);
+    LL_DMA_EnableChannel(LPUART_DMA, LPUART_TX_CHANNEL);
+}
+
+/** 
+ * @brief               \ref LOGGER_SINK write
+ * @param[in]           ctx             not used
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              bytes taken
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t lpuart_sink_write   (
+    void*           ctx,
+    const uint8_t*  data,
+    uint32_t        size    )
+{
+    (void)ctx;
+    return lpuart_write(data, size);
+}
+
+/** 
+ * @brief               \ref LOGGER_SINK flush
+ * @param[in]           ctx             not used
+ * @param[in]           force           send what is below a batch
+ * @return              bytes held back
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t lpuart_sink_flush   (
+    void*           ctx,
+    int             force   )
+{
+    (void)ctx;
+    return lpuart_flush(force);
+}
+
+/* after its functions, declared in drv_lpuart.h */
+const LOGGER_SINK g_LpuartSink =
+{
+    "lpuart",                   /*!< name */
+    lpuart_sink_write,          /*!< write */
+    lpuart_sink_flush,          /*!< flush */
+    NULL                        /*!< ctx */
+};
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the LSE and configure LPUART1, its pins and DMA channel
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail, also when the LSE does not start
+ * @note                Thread context, 8 data bits, no parity, 1 stop bit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int lpuart_init  (
+    const LPUART_CONFIG*    config  )
+{
+    LL_GPIO_InitTypeDef gpio;
+    uint32_t            wait    =   0;
+
+    if( (!config) || (0 == config->baudrate) || (config->baudrate > LPUART_BAUD_MAX) )
+    {
+        return (-1);
+    }
+    if( (!config->tx) || (config->tx_size < 2U) || (config->tx_size & (config->tx_size - 1U)) )
+    {
+        return (-1);
+    }
+    if( (0 == config->batch) || (config->batch > config->tx_size) || (!config->storage) || (config->storage_size < 2U) )
+    {
+        return (-1);
+    }
+    g_LpuartTx      =   config->tx;
+    g_LpuartMask    =   config->tx_size - 1U;
+    g_LpuartBatch   =   config->batch;
+    g_LpuartHead    =   0;
+    g_LpuartTail    =   0;
+    g_LpuartBurst   =   0;
+    g_LpuartForce   =   0;
+    memset(&g_LpuartStats, 0, sizeof(LPUART_STATS));
+    g_LpuartRx      =   xStreamBufferCreateStatic(config->storage_size - 1U, 1, config->storage, &g_LpuartRxCb);
+    if(NULL == g_LpuartRx)
+    {
+        return (-1);
+    }
+
+    /* LSE in the backup domain, it may still run from before the reset */
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_PWR);
+    LL_PWR_EnableBkUpAccess();
+    if(!LL_RCC_LSE_IsReady())
+    {
+        LL_RCC_LSE_SetDriveCapability(LL_RCC_LSEDRIVE_LOW);
+        LL_RCC_LSE_Enable();
+        while(!LL_RCC_LSE_IsReady())
+        {
+            if(wait++ >= LPUART_LSE_TIMEOUT)
+            {
+                return (-1);
+            }
+            (void)osDelay(1);
+        }
+    }
+
+    /* kernel clock from LSE, kept in Sleep and Stop */
+    LL_RCC_SetLPUARTClockSource(LL_RCC_LPUART1_CLKSOURCE_LSE);
+    LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_LPUART1);
+    LL_APB1_GRP2_EnableClockStopSleep(LL_APB1_GRP2_PERIPH_LPUART1);
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA2);
+    LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_GPIOC);
+
+    /* PC0 RX, PC1 TX */
+    LL_GPIO_StructInit(&gpio);
+    gpio.Pin        =   LL_GPIO_PIN_0 | LL_GPIO_PIN_1;
+    gpio.Mode       =   LL_GPIO_MODE_ALTERNATE;
+    gpio.Speed      =   LL_GPIO_SPEED_FREQ_LOW;
+    gpio.OutputType =   LL_GPIO_OUTPUT_PUSHPULL;
+    gpio.Pull       =   LL_GPIO_PULL_UP;
+    gpio.Alternate  =   LL_GPIO_AF_8;
+    (void)LL_GPIO_Init(GPIOC, &gpio);
+
+    /* 8N1, transmission through the DMA, a received byte wakes from Stop */
+    LL_LPUART_Disable(LPUART1);
+    LL_LPUART_ConfigCharacter(LPUART1, LL_LPUART_DATAWIDTH_8B, LL_LPUART_PARITY_NONE, LL_LPUART_STOPBITS_1);
+    LL_LPUART_SetTransferDirection(LPUART1, LL_LPUART_DIRECTION_TX_RX);
+    LL_LPUART_SetHWFlowCtrl(LPUART1, LL_LPUART_HWCONTROL_NONE);
+    LL_LPUART_SetBaudRate(LPUART1, LPUART_LSE_HZ, config->baudrate);
+    LL_LPUART_SetWKUPType(LPUART1, LL_LPUART_WAKEUP_ON_RXNE);
+    LL_LPUART_EnableInStopMode(LPUART1);
+    LL_LPUART_EnableDMAReq_TX(LPUART1);
+    LL_LPUART_EnableIT_RXNE(LPUART1);
+    LL_LPUART_EnableIT_ERROR(LPUART1);
+    LL_EXTI_EnableIT_0_31(LPUART_EXTI_LINE);
+
+    /* transmission, started per burst */
+    LL_DMA_DisableChannel(LPUART_DMA, LPUART_TX_CHANNEL);
+    LL_DMA_ConfigTransfer(LPUART_DMA, LPUART_TX_CHANNEL, LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+                                                         LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                         LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_LOW);
+    drv_dma_request(LPUART_DMA, LPUART_TX_CHANNEL, LPUART_REQUEST);
+    LL_DMA_SetPeriphAddress(LPUART_DMA, LPUART_TX_CHANNEL, LL_LPUART_DMA_GetRegAddr(LPUART1, LL_LPUART_DMA_REG_DATA_TRANSMIT));
+    drv_dma_clear(LPUART_DMA, LPUART_TX_CHANNEL, DRV_DMA_GI);
+    LL_DMA_EnableIT_TC(LPUART_DMA, LPUART_TX_CHANNEL);
+    LL_DMA_EnableIT_TE(LPUART_DMA, LPUART_TX_CHANNEL);
+
+    NVIC_SetPriority(LPUART1_IRQn, config->priority);
+    NVIC_SetPriority(LPUART_TX_IRQ, config->priority);
+    NVIC_EnableIRQ(LPUART1_IRQn);
+    NVIC_EnableIRQ(LPUART_TX_IRQ);
+    LL_LPUART_Enable(LPUART1);
+    return (0);
+}
+
+/**
+ * @brief               Queue text
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              bytes taken, less when the ring is full
+ * @note                One writer thread, the logger thread when the sink is selected.
+ *                      Starts a burst once a batch is waiting.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_write    (
+    const uint8_t*      data,
+    uint32_t            size    )
+{
+    uint32_t    head    =   g_LpuartHead;
+    uint32_t    space   =   0;
+    uint32_t    part    =   0;
+
+    if( (!data) || (!g_LpuartTx) )
+    {
+        return 0;
+    }
+    space   =   g_LpuartMask + 1U - (head - g_LpuartTail);
+    if(size > space)
+    {
+        size    =   space;
+    }
+    part    =   g_LpuartMask + 1U - (head & g_LpuartMask);
+    if(part > size)
+    {
+        part    =   size;
+    }
+    memcpy(&g_LpuartTx[head & g_LpuartMask], data, part);
+    memcpy(g_LpuartTx, &data[part], size - part);
+    g_LpuartHead    =   head + size;
+    taskENTER_CRITICAL();
+    lpuart_tx_start();
+    taskEXIT_CRITICAL();
+    return size;
+}
+
+/**
+ * @brief               Start sending what is waiting
+ * @param[in]           force           0 waits for a batch, otherwise sends everything
+ * @return              bytes not yet in a burst
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_flush    (
+    int                 force   )
+{
+    uint32_t    held    =   0;
+
+    if(!g_LpuartTx)
+    {
+        return 0;
+    }
+    taskENTER_CRITICAL();
+    if( (force) && (g_LpuartHead != g_LpuartTail) )
+    {
+        g_LpuartForce   =   1;
+    }
+    lpuart_tx_start();
+    /* forced text goes out burst after burst without the caller */
+    if(!g_LpuartForce)
+    {
+        held    =   g_LpuartHead - g_LpuartTail - g_LpuartBurst;
+    }
+    taskEXIT_CRITICAL();
+    return held;
+}
+
+/**
+ * @brief               Read received bytes
+ * @param[out]          data            buffer
+ * @param[in]           size            buffer size
+ * @param[in]           timeout         ticks to wait for the first byte
+ * @return              bytes read
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t lpuart_read (
+    uint8_t*            data,
+    uint32_t            size,
+    uint32_t            timeout )
+{
+    if( (!g_LpuartRx) || (!data) || (0 == size) )
+    {
+        return 0;
+    }
+    return (uint32_t)xStreamBufferReceive(g_LpuartRx, data, size, (TickType_t)timeout);
+}
+
+/**
+ * @brief               Tell whether a DMA burst runs
+ * @retval              1               only Sleep until the burst ends
+ * @retval              0               STOP2 allowed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int lpuart_busy  (void)
+{
+    return (0 != g_LpuartBurst) ? 1 : 0;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_stats    (
+    LPUART_STATS*       stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &g_LpuartStats, sizeof(LPUART_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               LPUART1 interrupt: reception, also the wakeup from Stop
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_irq_handler  (void)
+{
+    uint32_t            isr     =   READ_REG(LPUART1->ISR);
+    StreamBufferSpans_t spans;
+    BaseType_t          woken   =   pdFALSE;
+    uint8_t             data    =   0;
+
+    if(isr & LPUART_RX_ERRORS)
+    {
+        WRITE_REG(LPUART1->ICR, USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF);
+        g_LpuartStats.errors++;
+    }
+    if(isr & USART_ISR_WUF)
+    {
+        WRITE_REG(LPUART1->ICR, USART_ICR_WUCF);
+    }
+    if(isr & USART_ISR_RXNE)
+    {
+        /* reading the data register clears the flag */
+        data    =   LL_LPUART_ReceiveData8(LPUART1);
+        g_LpuartStats.rx_wakeups++;
+        if(0 != xStreamBufferAcquireWriteFromISR(g_LpuartRx, &spans))
+        {
+            spans.pucData[0][0] =   data;
+            (void)xStreamBufferCommitWriteFromISR(g_LpuartRx, 1, &woken);
+            g_LpuartStats.rx_bytes++;
+        }
+        else
+        {
+            g_LpuartStats.rx_dropped++;
+        }
+    }
+    LPUART_YIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief               Transmission DMA channel interrupt: burst sent
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void lpuart_dma_handler  (void)
+{
+    uint32_t    flags   =   drv_dma_take(LPUART_DMA, LPUART_TX_CHANNEL);
+    uint32_t    burst   =   g_LpuartBurst;
+
+    if( (!(flags & (DRV_DMA_TC | DRV_DMA_TE))) || (0 == burst) )
+    {
+        return;
+    }
+    if(flags & DRV_DMA_TE)
+    {
+        /* the burst is lost, carry on with the next one */
+        g_LpuartStats.errors++;
+    }
+    else
+    {
+        g_LpuartStats.tx_bytes  +=  burst;
+        g_LpuartStats.tx_bursts++;
+    }
+    g_LpuartTail    =   g_LpuartTail + burst;
+    g_LpuartBurst   =   0;
+    if(g_LpuartHead == g_LpuartTail)
+    {
+        g_LpuartForce   =   0;
+    }
+    lpuart_tx_start();
+}
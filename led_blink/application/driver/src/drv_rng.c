@@ -0,0 +1,408 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_rng.c
+ * @brief       entropy pool the RNG refills by interrupt, read in bulk from threads and interrupts.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "drv_rng.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* interrupts read the pool as well, the lock masks up to configMAX_SYSCALL_INTERRUPT_PRIORITY in any context */
+#ifndef RNG_LOCK
+#define RNG_LOCK()          taskENTER_CRITICAL_FROM_ISR()
+#endif
+#ifndef RNG_UNLOCK
+#define RNG_UNLOCK(saved)   taskEXIT_CRITICAL_FROM_ISR(saved)
+#endif
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const RNG_PORT g_RngPortRng =
+{
+    RNG,                            /*!< rng */
+    LL_AHB2_GRP1_PERIPH_RNG,        /*!< clock */
+    LL_RCC_RNG_CLKSOURCE_PLLSAI1,   /*!< source */
+    24U,                            /*!< pllsai1_n */
+    RNG_IRQn                        /*!< irq */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Start the 48 MHz clock and select it for the RNG
+ * @param[in]           port            hardware
+ * @return              None
+ * @note                CLK48SEL feeds USB and SDMMC as well
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void rng_clock   (
+    const RNG_PORT*     port    )
+{
+    if( (LL_RCC_RNG_CLKSOURCE_PLLSAI1 == port->source) && (port->pllsai1_n) && (1 != LL_RCC_PLLSAI1_IsReady()) )
+    {
+        /* the input and its divider are shared with the running main PLL and written unchanged */
+        LL_RCC_PLLSAI1_ConfigDomain_48M(LL_RCC_PLL_GetMainSource(), LL_RCC_PLL_GetDivider(),
+                                        port->pllsai1_n, LL_RCC_PLLSAI1Q_DIV_2);
+        LL_RCC_PLLSAI1_EnableDomain_48M();
+        LL_RCC_PLLSAI1_Enable();
+        while(1 != LL_RCC_PLLSAI1_IsReady()) {};
+    }
+    LL_RCC_SetRNGClockSource(port->source);
+    LL_AHB2_GRP1_EnableClock(port->clock);
+}
+
+/** 
+ * @brief               Take words from the ring into bytes and wipe them
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes, NULL to discard
+ * @param[in]           size            bytes
+ * @return              None
+ * @note                With the lock. The loop depends on size only.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void rng_copy    (
+    RNG_POOL*           pool,
+    uint8_t*            data,
+    uint32_t            size    )
+{
+    uint32_t    word    =   0;
+    uint32_t    i;
+
+    for(i = 0; i < size; i += 4U)
+    {
+        word    =   pool->buffer[pool->tail & pool->mask];
+        pool->buffer[pool->tail & pool->mask]   =   0;
+        pool->tail++;
+        if(data)
+        {
+            memcpy(&data[i], &word, ((size - i) < 4U) ? (size - i) : 4U);
+        }
+    }
+}
+
+/** 
+ * @brief               Serve a request if the ring holds it
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, checked against the ring
+ * @retval              0               served
+ * @retval              -1              too little pooled
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int rng_take (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size    )
+{
+    UBaseType_t saved   =   RNG_LOCK();
+
+    if((pool->head - pool->tail) < ((size + 3U) / 4U))
+    {
+        RNG_UNLOCK(saved);
+        return (-1);
+    }
+    rng_copy(pool, (uint8_t*)data, size);
+    pool->stats.reads++;
+    pool->stats.bytes   +=  size;
+    /* room again, refilling goes on */
+    LL_RNG_EnableIT(pool->port->rng);
+    RNG_UNLOCK(saved);
+    return (0);
+}
+
+/** 
+ * @brief               Discard the ring and restart the RNG after a seed or continuous test error
+ * @param[in]           pool            pool state
+ * @return              None
+ * @note                With the lock
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void rng_restart (
+    RNG_POOL*           pool    )
+{
+    uint32_t    count   =   pool->head - pool->tail;
+
+    pool->stats.discarded   +=  count;
+    rng_copy(pool, NULL, count * 4U);
+    pool->primed    =   0;
+    LL_RNG_Disable(pool->port->rng);
+    LL_RNG_Enable(pool->port->rng);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the 48 MHz clock and the RNG, refilling begins
+ * @param[out]          pool            pool state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_init (
+    RNG_POOL*           pool,
+    const RNG_PORT*     port,
+    const RNG_CONFIG*   config  )
+{
+    if( (!pool) || (!port) || (!config) || (!config->buffer) ||
+        (config->words < 2U) || (config->words & (config->words - 1U)) )
+    {
+        return (-1);
+    }
+    memset(pool, 0, sizeof(RNG_POOL));
+    memset(config->buffer, 0, config->words * sizeof(uint32_t));
+    pool->port      =   port;
+    pool->buffer    =   config->buffer;
+    pool->mask      =   config->words - 1U;
+
+    rng_clock(port);
+    /* this RNG has no CED bit, clock errors are always detected */
+    LL_RNG_Disable(port->rng);
+    LL_RNG_ClearFlag_SEIS(port->rng);
+    LL_RNG_ClearFlag_CEIS(port->rng);
+    /* one enable for data ready, seed and clock errors */
+    LL_RNG_EnableIT(port->rng);
+
+    NVIC_SetPriority(port->irq, config->priority);
+    NVIC_EnableIRQ(port->irq);
+    LL_RNG_Enable(port->rng);
+    return (0);
+}
+
+/**
+ * @brief               Take random bytes from the pool
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @retval              0               all served
+ * @retval              -1              bad arguments or too little pooled, nothing served
+ * @note                Thread and interrupt context, time depends on size only
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_read (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size    )
+{
+    UBaseType_t saved   =   0;
+
+    if( (!pool) || ( (!data) && (size) ) || ( (size) && ((size - 1U) / 4U > pool->mask) ) )
+    {
+        return (-1);
+    }
+    if(0 != rng_take(pool, data, size))
+    {
+        saved   =   RNG_LOCK();
+        pool->stats.empty++;
+        RNG_UNLOCK(saved);
+        return (-1);
+    }
+    return (0);
+}
+
+/**
+ * @brief               Take random bytes, waiting for the pool to hold them
+ * @param[in]           pool            pool state
+ * @param[out]          data            bytes
+ * @param[in]           size            bytes, up to 4 times the words of the ring
+ * @param[in]           timeout         ticks
+ * @retval              0               all served
+ * @retval              -1              bad arguments or timeout, nothing served
+ * @note                Thread context, one thread at a time, waits on thread flag \ref RNG_FLAG_FILL
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int rng_wait (
+    RNG_POOL*           pool,
+    void*               data,
+    uint32_t            size,
+    uint32_t            timeout )
+{
+    UBaseType_t     saved   =   0;
+    osThreadId_t    waiter  =   NULL;
+    int             ret     =   0;
+
+    if( (!pool) || ( (!data) && (size) ) || ( (size) && ((size - 1U) / 4U > pool->mask) ) )
+    {
+        return (-1);
+    }
+    if(0 == rng_take(pool, data, size))
+    {
+        return (0);
+    }
+    (void)osThreadFlagsClear(RNG_FLAG_FILL);
+    saved           =   RNG_LOCK();
+    pool->want      =   (size + 3U) / 4U;
+    waiter          =   ((pool->head - pool->tail) < pool->want) ? osThreadGetId() : NULL;
+    pool->waiter    =   waiter;
+    RNG_UNLOCK(saved);
+    if(waiter)
+    {
+        (void)osThreadFlagsWait(RNG_FLAG_FILL, osFlagsWaitAny, timeout);
+    }
+    saved           =   RNG_LOCK();
+    pool->waiter    =   NULL;
+    RNG_UNLOCK(saved);
+
+    /* an interrupt may have taken the words first */
+    ret =   rng_take(pool, data, size);
+    if(0 != ret)
+    {
+        saved   =   RNG_LOCK();
+        pool->stats.empty++;
+        RNG_UNLOCK(saved);
+    }
+    return ret;
+}
+
+/**
+ * @brief               Bytes \ref rng_read can serve now
+ * @param[in]           pool            pool state
+ * @return              bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t rng_level   (
+    RNG_POOL*           pool    )
+{
+    UBaseType_t saved   =   RNG_LOCK();
+    uint32_t    count   =   pool->head - pool->tail;
+
+    RNG_UNLOCK(saved);
+    return count * 4U;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           pool            pool state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_stats   (
+    RNG_POOL*           pool,
+    RNG_STATS*          stats   )
+{
+    UBaseType_t saved   =   RNG_LOCK();
+
+    memcpy(stats, &pool->stats, sizeof(RNG_STATS));
+    RNG_UNLOCK(saved);
+}
+
+/**
+ * @brief               RNG interrupt: next word, seed or clock error
+ * @param[in]           pool            pool state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void rng_irq_handler (
+    RNG_POOL*           pool    )
+{
+    RNG_TypeDef*        rng     =   pool->port->rng;
+    osThreadId_t        waiter  =   NULL;
+    UBaseType_t         saved   =   RNG_LOCK();
+    /* read once, clearing a flag writes ones to the read only bits */
+    uint32_t            sr      =   rng->SR;
+    uint32_t            word    =   0;
+
+    if(sr & RNG_SR_CEIS)
+    {
+        LL_RNG_ClearFlag_CEIS(rng);
+        pool->stats.clock_errors++;
+    }
+    if(sr & RNG_SR_SEIS)
+    {
+        /* the word in DR must not be used */
+        LL_RNG_ClearFlag_SEIS(rng);
+        pool->stats.seed_errors++;
+        rng_restart(pool);
+    }
+    else if( (sr & RNG_SR_DRDY) && ((pool->head - pool->tail) <= pool->mask) )
+    {
+        word    =   LL_RNG_ReadRandData32(rng);
+        if( (pool->primed) && (word == pool->last) )
+        {
+            pool->stats.repeats++;
+            rng_restart(pool);
+        }
+        else
+        {
+            if(pool->primed)
+            {
+                pool->buffer[pool->head & pool->mask]   =   word;
+                pool->head++;
+                pool->stats.words++;
+            }
+            pool->last      =   word;
+            pool->primed    =   1U;
+        }
+    }
+    if((pool->head - pool->tail) > pool->mask)
+    {
+        LL_RNG_DisableIT(rng);
+    }
+    if( (pool->waiter) && ((pool->head - pool->tail) >= pool->want) )
+    {
+        waiter          =   pool->waiter;
+        pool->waiter    =   NULL;
+    }
+    RNG_UNLOCK(saved);
+
+    if(waiter)
+    {
+        (void)osThreadFlagsSet(waiter, RNG_FLAG_FILL);
+    }
+}
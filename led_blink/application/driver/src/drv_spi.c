@@ -0,0 +1,496 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_spi.c
+ * @brief       SPI master with a queue of full duplex DMA transfers.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "drv_dma.h"
+#include "drv_spi.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* Master, software slave select, the chip selects are GPIOs */
+#define SPI_CR1_MASTER      (SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI)
+#define SPI_CR2_DMA         (LL_SPI_DATAWIDTH_8BIT | SPI_CR2_FRXTH | SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN | SPI_CR2_ERRIE)
+#define SPI_SR_ERRORS       (SPI_SR_OVR | SPI_SR_MODF)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const SPI_PORT g_SpiPortSpi3 =
+{
+    SPI3,                           /*!< spi */
+    SPI3_IRQn,                      /*!< irq */
+    1,                              /*!< apb */
+    LL_APB1_GRP1_PERIPH_SPI3,       /*!< clock */
+    DMA2,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA2,       /*!< dma_clock */
+    LL_DMA_REQUEST_3,               /*!< request */
+    LL_DMA_CHANNEL_1,               /*!< rx_channel */
+    DMA2_Channel1_IRQn,             /*!< rx_irq */
+    LL_DMA_CHANNEL_2,               /*!< tx_channel */
+    DMA2_Channel2_IRQn,             /*!< tx_irq */
+    GPIOC,                          /*!< gpio */
+    LL_AHB2_GRP1_PERIPH_GPIOC,      /*!< gpio_clock */
+    LL_GPIO_PIN_10 | LL_GPIO_PIN_11 | LL_GPIO_PIN_12,   /*!< pins */
+    LL_GPIO_AF_6                    /*!< alternate */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Load one DMA channel for a transfer
+ * @param[in]           port            hardware
+ * @param[in]           channel         LL_DMA_CHANNEL_x
+ * @param[in]           data            buffer, NULL for the fixed byte
+ * @param[in]           fixed           byte used when data is NULL
+ * @param[in]           size            bytes
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void spi_channel (
+    const SPI_PORT*     port,
+    uint32_t            channel,
+    const uint8_t*      data,
+    const uint8_t*      fixed,
+    uint32_t            size    )
+{
+    LL_DMA_DisableChannel(port->dma, channel);
+    LL_DMA_SetMemoryAddress(port->dma, channel, (uint32_t)(data ? data : fixed));
+    LL_DMA_SetMemoryIncMode(port->dma, channel, data ? LL_DMA_MEMORY_INCREMENT : LL_DMA_MEMORY_NOINCREMENT);
+    LL_DMA_SetDataLength(port->dma, channel, size);
+    LL_DMA_EnableChannel(port->dma, channel);
+}
+
+/** 
+ * @brief               Select the device of a transfer and start the DMA on it
+ * @param[in]           spi             driver state
+ * @param[in]           xfer            descriptor
+ * @return              None
+ * @note                The bus is idle. Reception is loaded first so that it takes every
+ *                      byte the transmission clocks in.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void spi_start   (
+    SPI*                spi,
+    SPI_XFER*           xfer    )
+{
+    const SPI_PORT*     port    =   spi->port;
+    const SPI_DEVICE*   device  =   xfer->device;
+
+    if( (spi->held) && (spi->held != device) )
+    {
+        LL_GPIO_SetOutputPin(spi->held->cs_gpio, spi->held->cs_pin);
+        spi->held   =   NULL;
+    }
+    /* mode and clock change only with every chip select high */
+    if(device->cr1 != spi->cr1)
+    {
+        CLEAR_BIT(port->spi->CR1, SPI_CR1_SPE);
+        WRITE_REG(port->spi->CR1, device->cr1);
+        spi->cr1    =   device->cr1;
+        spi->stats.reconfigs++;
+    }
+    if(!spi->held)
+    {
+        LL_GPIO_ResetOutputPin(device->cs_gpio, device->cs_pin);
+        spi->held   =   device;
+    }
+    spi_channel(port, port->rx_channel, xfer->rx, &spi->sink, xfer->size);
+    spi_channel(port, port->tx_channel, xfer->tx, &spi->fill, xfer->size);
+    SET_BIT(port->spi->CR1, SPI_CR1_SPE);
+}
+
+/** 
+ * @brief               End the running transfer and start the next one
+ * @param[in]           spi             driver state
+ * @param[in]           status          0, or -1 on an error
+ * @return              None
+ * @note                Interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void spi_end (
+    SPI*                spi,
+    int                 status  )
+{
+    const SPI_PORT*     port    =   spi->port;
+    SPI_XFER*           xfer    =   spi->head;
+
+    if(!xfer)
+    {
+        return;
+    }
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    if(status)
+    {
+        /* drop what is left in the FIFOs, the next start enables the SPI again */
+        CLEAR_BIT(port->spi->CR1, SPI_CR1_SPE);
+        spi->stats.errors++;
+    }
+    else
+    {
+        spi->stats.bytes    +=  xfer->size;
+        spi->stats.xfers++;
+    }
+    if( (status) || (!(xfer->flags & SPI_XFER_HOLD)) )
+    {
+        LL_GPIO_SetOutputPin(xfer->device->cs_gpio, xfer->device->cs_pin);
+        spi->held   =   NULL;
+    }
+    xfer->status    =   status;
+    spi->head       =   xfer->next;
+    if(spi->head)
+    {
+        spi_start(spi, spi->head);
+    }
+    else
+    {
+        spi->tail   =   NULL;
+    }
+    if(xfer->done)
+    {
+        xfer->done(xfer);
+    }
+}
+
+/** 
+ * @brief               Done call of \ref spi_transfer
+ * @param[in]           xfer            descriptor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void spi_transfer_done   (
+    SPI_XFER*   xfer    )
+{
+    (void)osThreadFlagsSet((osThreadId_t)xfer->arg, SPI_FLAG_DONE);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the SPI as master, its pins and DMA channels
+ * @param[out]          spi             driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_init (
+    SPI*                spi,
+    const SPI_PORT*     port,
+    const SPI_CONFIG*   config  )
+{
+    LL_GPIO_InitTypeDef gpio;
+    SPI_TypeDef*        regs    =   NULL;
+
+    if( (!spi) || (!port) || (!config) || (0 == config->pclk) )
+    {
+        return (-1);
+    }
+    memset(spi, 0, sizeof(SPI));
+    spi->port   =   port;
+    spi->pclk   =   config->pclk;
+    spi->fill   =   0xFFU;
+    regs        =   port->spi;
+
+    /* clocks and pins */
+    if(1U == port->apb)
+    {
+        LL_APB1_GRP1_EnableClock(port->clock);
+    }
+    else
+    {
+        LL_APB2_GRP1_EnableClock(port->clock);
+    }
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+    LL_AHB2_GRP1_EnableClock(port->gpio_clock);
+    LL_GPIO_StructInit(&gpio);
+    gpio.Pin        =   port->pins;
+    gpio.Mode       =   LL_GPIO_MODE_ALTERNATE;
+    gpio.Speed      =   LL_GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.OutputType =   LL_GPIO_OUTPUT_PUSHPULL;
+    gpio.Pull       =   LL_GPIO_PULL_NO;
+    gpio.Alternate  =   port->alternate;
+    (void)LL_GPIO_Init(port->gpio, &gpio);
+
+    /* 8 bit frames through the DMA, the slowest clock until a device is selected */
+    WRITE_REG(regs->CR1, 0);
+    WRITE_REG(regs->CR2, SPI_CR2_DMA);
+    WRITE_REG(regs->CR1, SPI_CR1_MASTER | SPI_CR1_BR);
+    spi->cr1    =   SPI_CR1_MASTER | SPI_CR1_BR;
+
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->rx_channel, LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_NORMAL |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_VERYHIGH);
+    drv_dma_request(port->dma, port->rx_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->rx_channel, LL_SPI_DMA_GetRegAddr(regs));
+    drv_dma_clear(port->dma, port->rx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TC(port->dma, port->rx_channel);
+    LL_DMA_EnableIT_TE(port->dma, port->rx_channel);
+
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->tx_channel, LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_HIGH);
+    drv_dma_request(port->dma, port->tx_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->tx_channel, LL_SPI_DMA_GetRegAddr(regs));
+    drv_dma_clear(port->dma, port->tx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TE(port->dma, port->tx_channel);
+
+    NVIC_SetPriority(port->irq, config->priority);
+    NVIC_SetPriority(port->rx_irq, config->priority);
+    NVIC_SetPriority(port->tx_irq, config->priority);
+    NVIC_EnableIRQ(port->irq);
+    NVIC_EnableIRQ(port->rx_irq);
+    NVIC_EnableIRQ(port->tx_irq);
+    return (0);
+}
+
+/**
+ * @brief               Prepare a device and drive its chip select high
+ * @param[in]           spi             driver state
+ * @param[in,out]       device          cs_gpio, cs_pin, mode and speed filled in
+ * @retval              0               success
+ * @retval              -1              fail, also when the speed is below pclk / 256
+ * @note                The clock is the fastest the prescaler gives up to the speed
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_device_init  (
+    SPI*                spi,
+    SPI_DEVICE*         device  )
+{
+    LL_GPIO_InitTypeDef gpio;
+    uint32_t            br  =   0;
+
+    if( (!spi) || (!device) || (!device->cs_gpio) || (0 == device->cs_pin) || (device->mode > SPI_MODE_3) )
+    {
+        return (-1);
+    }
+    /* fPCLK / 2^(br + 1) */
+    while( (br < 8U) && ((spi->pclk >> (br + 1U)) > device->speed) )
+    {
+        br++;
+    }
+    if(br >= 8U)
+    {
+        return (-1);
+    }
+    device->cr1 =   SPI_CR1_MASTER | (br << SPI_CR1_BR_Pos) |
+                    ((device->mode & 1U) ? LL_SPI_PHASE_2EDGE : 0) | ((device->mode & 2U) ? LL_SPI_POLARITY_HIGH : 0);
+
+    /* GPIOA to GPIOH sit 0x400 apart, their clock enables are bits 0 to 7 */
+    LL_AHB2_GRP1_EnableClock(LL_AHB2_GRP1_PERIPH_GPIOA << (((uint32_t)device->cs_gpio - GPIOA_BASE) / 0x400U));
+    LL_GPIO_SetOutputPin(device->cs_gpio, device->cs_pin);
+    LL_GPIO_StructInit(&gpio);
+    gpio.Pin        =   device->cs_pin;
+    gpio.Mode       =   LL_GPIO_MODE_OUTPUT;
+    gpio.Speed      =   LL_GPIO_SPEED_FREQ_HIGH;
+    gpio.OutputType =   LL_GPIO_OUTPUT_PUSHPULL;
+    gpio.Pull       =   LL_GPIO_PULL_NO;
+    (void)LL_GPIO_Init(device->cs_gpio, &gpio);
+    return (0);
+}
+
+/**
+ * @brief               Queue a transfer
+ * @param[in]           spi             driver state
+ * @param[in]           xfer            descriptor, device, size, buffers and done filled in
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context. The buffers must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_submit   (
+    SPI*                spi,
+    SPI_XFER*           xfer    )
+{
+    if( (!spi) || (!xfer) || (!xfer->device) || (0 == xfer->device->cr1) || (0 == xfer->size) || (xfer->size > 0xFFFFU) )
+    {
+        return (-1);
+    }
+    xfer->next      =   NULL;
+    xfer->status    =   0;
+    /* the reception interrupt takes the head and starts the next one */
+    taskENTER_CRITICAL();
+    if(spi->tail)
+    {
+        spi->tail->next =   xfer;
+        spi->tail       =   xfer;
+    }
+    else
+    {
+        spi->head   =   xfer;
+        spi->tail   =   xfer;
+        spi_start(spi, xfer);
+    }
+    taskEXIT_CRITICAL();
+    return (0);
+}
+
+/**
+ * @brief               Transfer and wait for the end
+ * @param[in]           spi             driver state
+ * @param[in]           device          device
+ * @param[in]           tx              bytes to send, NULL sends 0xFF
+ * @param[out]          rx              received bytes, NULL discards
+ * @param[in]           size            1 to 65535
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, waits on thread flag \ref SPI_FLAG_DONE
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int spi_transfer (
+    SPI*                spi,
+    const SPI_DEVICE*   device,
+    const uint8_t*      tx,
+    uint8_t*            rx,
+    uint32_t            size    )
+{
+    SPI_XFER    xfer;
+
+    memset(&xfer, 0, sizeof(xfer));
+    xfer.device =   device;
+    xfer.tx     =   tx;
+    xfer.rx     =   rx;
+    xfer.size   =   size;
+    xfer.done   =   spi_transfer_done;
+    xfer.arg    =   (void*)osThreadGetId();
+    (void)osThreadFlagsClear(SPI_FLAG_DONE);
+    if(0 != spi_submit(spi, &xfer))
+    {
+        return (-1);
+    }
+    (void)osThreadFlagsWait(SPI_FLAG_DONE, osFlagsWaitAny, osWaitForever);
+    return xfer.status;
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           spi             driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_stats   (
+    SPI*                spi,
+    SPI_STATS*          stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &spi->stats, sizeof(SPI_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               SPI interrupt: overrun and mode fault
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_irq_handler (
+    SPI*                spi )
+{
+    SPI_TypeDef*    regs    =   spi->port->spi;
+    uint32_t        sr      =   READ_REG(regs->SR);
+
+    if(sr & SPI_SR_ERRORS)
+    {
+        /* reading DR then SR clears an overrun, writing CR1 a mode fault */
+        (void)READ_REG(regs->DR);
+        (void)READ_REG(regs->SR);
+        WRITE_REG(regs->CR1, spi->cr1);
+        spi_end(spi, -1);
+    }
+}
+
+/**
+ * @brief               Reception DMA channel interrupt: transfer done
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_rx_dma_handler  (
+    SPI*                spi )
+{
+    uint32_t    flags   =   drv_dma_take(spi->port->dma, spi->port->rx_channel);
+
+    if(flags & DRV_DMA_TE)
+    {
+        spi_end(spi, -1);
+    }
+    else if(flags & DRV_DMA_TC)
+    {
+        /* the last byte is in, the clock has stopped */
+        spi_end(spi, 0);
+    }
+}
+
+/**
+ * @brief               Transmission DMA channel interrupt: errors only
+ * @param[in]           spi             driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void spi_tx_dma_handler  (
+    SPI*                spi )
+{
+    if(drv_dma_take(spi->port->dma, spi->port->tx_channel) & DRV_DMA_TE)
+    {
+        spi_end(spi, -1);
+    }
+}
@@ -0,0 +1,547 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_uart.c
+ * @brief       USART driver with circular DMA reception and queued DMA transmission.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "drv_dma.h"
+#include "drv_uart.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* Context switch on leaving an interrupt, the host model has no scheduler */
+#ifndef UART_YIELD_FROM_ISR
+#define UART_YIELD_FROM_ISR(woken)      portYIELD_FROM_ISR(woken)
+#endif
+
+#define UART_RX_ERRORS      (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const UART_PORT g_UartPortUsart1 =
+{
+    USART1,                         /*!< usart */
+    USART1_IRQn,                    /*!< irq */
+    2,                              /*!< apb */
+    LL_APB2_GRP1_PERIPH_USART1,     /*!< clock */
+    LL_RCC_USART1_CLKSOURCE,        /*!< source */
+    DMA1,                           /*!< dma */
+    LL_AHB1_GRP1_PERIPH_DMA1,       /*!< dma_clock */
+    LL_DMA_REQUEST_2,               /*!< request */
+    LL_DMA_CHANNEL_5,               /*!< rx_channel */
+    DMA1_Channel5_IRQn,             /*!< rx_irq */
+    LL_DMA_CHANNEL_4,               /*!< tx_channel */
+    DMA1_Channel4_IRQn,             /*!< tx_irq */
+    GPIOB,                          /*!< gpio */
+    LL_AHB2_GRP1_PERIPH_GPIOB,      /*!< gpio_clock */
+    LL_GPIO_PIN_6 | LL_GPIO_PIN_7,  /*!< pins */
+    LL_GPIO_AF_7                    /*!< alternate */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Copy into the free spans of the stream buffer
+ * @param[in]           spans           free part of the stream buffer
+ * @param[in]           offset          bytes of the spans already written
+ * @param[in]           data            bytes to copy
+ * @param[in]           size            bytes to copy, fit into the spans
+ * @return              bytes of the spans written now
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t uart_rx_copy    (
+    const StreamBufferSpans_t*  spans,
+    uint32_t                    offset,
+    const uint8_t*              data,
+    uint32_t                    size    )
+{
+    uint32_t    part    =   0;
+
+    if(offset < spans->xLength[0])
+    {
+        part    =   spans->xLength[0] - offset;
+        if(part > size)
+        {
+            part    =   size;
+        }
+        memcpy(&spans->pucData[0][offset], data, part);
+        offset  +=  part;
+        data    +=  part;
+        size    -=  part;
+    }
+    if(size)
+    {
+        memcpy(&spans->pucData[1][offset - spans->xLength[0]], data, size);
+        offset  +=  size;
+    }
+    return offset;
+}
+
+/** 
+ * @brief               Deliver what the DMA wrote since the last call
+ * @param[in]           uart            driver state
+ * @return              None
+ * @note                Interrupt context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void uart_rx_flush   (
+    UART*   uart    )
+{
+    const UART_PORT*    port    =   uart->port;
+    StreamBufferSpans_t spans;
+    BaseType_t          woken   =   pdFALSE;
+    uint32_t            pos     =   0;
+    uint32_t            first   =   0;
+    uint32_t            second  =   0;
+    uint32_t            space   =   0;
+    uint32_t            done    =   0;
+
+    pos =   uart->dma_size - LL_DMA_GetDataLength(port->dma, port->rx_channel);
+    if(pos >= uart->dma_size)
+    {
+        pos =   0;
+    }
+    if(pos == uart->rx_pos)
+    {
+        return;
+    }
+    /* the new bytes wrap around the end of the circular buffer at most once */
+    if(pos > uart->rx_pos)
+    {
+        first   =   pos - uart->rx_pos;
+    }
+    else
+    {
+        first   =   uart->dma_size - uart->rx_pos;
+        second  =   pos;
+    }
+    space   =   xStreamBufferAcquireWriteFromISR(uart->rx, &spans);
+    if(first > space)
+    {
+        first   =   space;
+    }
+    if(second > space - first)
+    {
+        second  =   space - first;
+    }
+    done    =   uart_rx_copy(&spans, 0, &uart->dma[uart->rx_pos], first);
+    done    =   uart_rx_copy(&spans, done, uart->dma, second);
+    if(done)
+    {
+        /* one commit, the reader is woken once per event */
+        (void)xStreamBufferCommitWriteFromISR(uart->rx, done, &woken);
+    }
+    uart->stats.rx_dropped  +=  ((pos + uart->dma_size - uart->rx_pos) % uart->dma_size) - done;
+    uart->stats.rx_bytes    +=  done;
+    uart->stats.rx_events++;
+    uart->rx_pos    =   pos;
+    UART_YIELD_FROM_ISR(woken);
+}
+
+/** 
+ * @brief               Start the DMA on a descriptor
+ * @param[in]           uart            driver state
+ * @param[in]           tx              descriptor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void uart_tx_start   (
+    UART*           uart,
+    const UART_TX*  tx  )
+{
+    const UART_PORT*    port    =   uart->port;
+
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_SetMemoryAddress(port->dma, port->tx_channel, (uint32_t)tx->data);
+    LL_DMA_SetDataLength(port->dma, port->tx_channel, tx->size);
+    LL_DMA_EnableChannel(port->dma, port->tx_channel);
+}
+
+/** 
+ * @brief               Done call of \ref uart_write
+ * @param[in]           tx              descriptor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void uart_write_done (
+    UART_TX*    tx  )
+{
+    (void)osThreadFlagsSet((osThreadId_t)tx->arg, UART_FLAG_TX);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Configure the USART, its pins and DMA channels and start reception
+ * @param[out]          uart            driver state
+ * @param[in]           port            hardware
+ * @param[in]           config          configuration
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                8 data bits, no parity, 1 stop bit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_init    (
+    UART*               uart,
+    const UART_PORT*    port,
+    const UART_CONFIG*  config  )
+{
+    LL_GPIO_InitTypeDef gpio;
+    USART_TypeDef*      usart   =   NULL;
+
+    if( (!uart) || (!port) || (!config) || (0 == config->baudrate) )
+    {
+        return (-1);
+    }
+    if( (!config->dma) || (config->dma_size < 2U) || (config->dma_size > 0xFFFEU) || (config->dma_size & 1U) )
+    {
+        return (-1);
+    }
+    if( (!config->storage) || (config->storage_size < 2U) || (0 == config->trigger) || (config->trigger >= config->storage_size) )
+    {
+        return (-1);
+    }
+    memset(uart, 0, sizeof(UART));
+    uart->port      =   port;
+    uart->dma       =   config->dma;
+    uart->dma_size  =   config->dma_size;
+    uart->rx        =   xStreamBufferCreateStatic(config->storage_size - 1U, config->trigger, config->storage, &uart->rx_cb);
+    if(NULL == uart->rx)
+    {
+        return (-1);
+    }
+    usart   =   port->usart;
+
+    /* clocks and pins */
+    if(1U == port->apb)
+    {
+        LL_APB1_GRP1_EnableClock(port->clock);
+    }
+    else
+    {
+        LL_APB2_GRP1_EnableClock(port->clock);
+    }
+    LL_AHB1_GRP1_EnableClock(port->dma_clock);
+    LL_AHB2_GRP1_EnableClock(port->gpio_clock);
+    LL_GPIO_StructInit(&gpio);
+    gpio.Pin        =   port->pins;
+    gpio.Mode       =   LL_GPIO_MODE_ALTERNATE;
+    gpio.Speed      =   LL_GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.OutputType =   LL_GPIO_OUTPUT_PUSHPULL;
+    gpio.Pull       =   LL_GPIO_PULL_UP;
+    gpio.Alternate  =   port->alternate;
+    (void)LL_GPIO_Init(port->gpio, &gpio);
+
+    /* 8N1, both directions through the DMA, interrupts only for idle line and errors */
+    LL_USART_Disable(usart);
+    LL_USART_ConfigCharacter(usart, LL_USART_DATAWIDTH_8B, LL_USART_PARITY_NONE, LL_USART_STOPBITS_1);
+    LL_USART_SetTransferDirection(usart, LL_USART_DIRECTION_TX_RX);
+    LL_USART_SetHWFlowCtrl(usart, LL_USART_HWCONTROL_NONE);
+    LL_USART_SetOverSampling(usart, LL_USART_OVERSAMPLING_16);
+    LL_USART_SetBaudRate(usart, LL_RCC_GetUSARTClockFreq(port->source), LL_USART_OVERSAMPLING_16, config->baudrate);
+    LL_USART_EnableDMAReq_RX(usart);
+    LL_USART_EnableDMAReq_TX(usart);
+    LL_USART_ClearFlag_IDLE(usart);
+    LL_USART_EnableIT_IDLE(usart);
+    LL_USART_EnableIT_ERROR(usart);
+
+    /* reception, circular over the whole buffer */
+    LL_DMA_DisableChannel(port->dma, port->rx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->rx_channel, LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_MODE_CIRCULAR |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_HIGH);
+    drv_dma_request(port->dma, port->rx_channel, port->request);
+    LL_DMA_ConfigAddresses(port->dma, port->rx_channel, LL_USART_DMA_GetRegAddr(usart, LL_USART_DMA_REG_DATA_RECEIVE),
+                           (uint32_t)uart->dma, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+    LL_DMA_SetDataLength(port->dma, port->rx_channel, uart->dma_size);
+    drv_dma_clear(port->dma, port->rx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_HT(port->dma, port->rx_channel);
+    LL_DMA_EnableIT_TC(port->dma, port->rx_channel);
+    LL_DMA_EnableIT_TE(port->dma, port->rx_channel);
+    LL_DMA_EnableChannel(port->dma, port->rx_channel);
+
+    /* transmission, started per descriptor */
+    LL_DMA_DisableChannel(port->dma, port->tx_channel);
+    LL_DMA_ConfigTransfer(port->dma, port->tx_channel, LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+                                                       LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_INCREMENT |
+                                                       LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE | LL_DMA_PRIORITY_MEDIUM);
+    drv_dma_request(port->dma, port->tx_channel, port->request);
+    LL_DMA_SetPeriphAddress(port->dma, port->tx_channel, LL_USART_DMA_GetRegAddr(usart, LL_USART_DMA_REG_DATA_TRANSMIT));
+    drv_dma_clear(port->dma, port->tx_channel, DRV_DMA_GI);
+    LL_DMA_EnableIT_TC(port->dma, port->tx_channel);
+    LL_DMA_EnableIT_TE(port->dma, port->tx_channel);
+
+    NVIC_SetPriority(port->irq, config->priority);
+    NVIC_SetPriority(port->rx_irq, config->priority);
+    NVIC_SetPriority(port->tx_irq, config->priority);
+    NVIC_EnableIRQ(port->irq);
+    NVIC_EnableIRQ(port->rx_irq);
+    NVIC_EnableIRQ(port->tx_irq);
+    LL_USART_Enable(usart);
+    return (0);
+}
+
+/**
+ * @brief               Stream buffer received bytes are delivered to
+ * @param[in]           uart            driver state
+ * @return              stream buffer, for xStreamBufferReceive or the zero copy read calls
+ * @note                Any number of readers as long as only one reads at a time
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern StreamBufferHandle_t uart_rx_stream  (
+    UART*               uart    )
+{
+    return uart->rx;
+}
+
+/**
+ * @brief               Read received bytes
+ * @param[in]           uart            driver state
+ * @param[out]          data            buffer
+ * @param[in]           size            buffer size
+ * @param[in]           timeout         ticks to wait for the first byte
+ * @return              bytes read
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t uart_read   (
+    UART*               uart,
+    uint8_t*            data,
+    uint32_t            size,
+    uint32_t            timeout )
+{
+    if( (!uart) || (!data) || (0 == size) )
+    {
+        return 0;
+    }
+    return (uint32_t)xStreamBufferReceive(uart->rx, data, size, (TickType_t)timeout);
+}
+
+/**
+ * @brief               Queue a transmission
+ * @param[in]           uart            driver state
+ * @param[in]           tx              descriptor, data and done filled in
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context. The data must stay valid until done is called.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_send    (
+    UART*               uart,
+    UART_TX*            tx  )
+{
+    if( (!uart) || (!tx) || (!tx->data) || (0 == tx->size) || (tx->size > 0xFFFFU) )
+    {
+        return (-1);
+    }
+    tx->next    =   NULL;
+    /* the transmission interrupt takes the head and starts the next one */
+    taskENTER_CRITICAL();
+    if(uart->tx_tail)
+    {
+        uart->tx_tail->next =   tx;
+        uart->tx_tail       =   tx;
+    }
+    else
+    {
+        uart->tx_head   =   tx;
+        uart->tx_tail   =   tx;
+        uart_tx_start(uart, tx);
+    }
+    taskEXIT_CRITICAL();
+    return (0);
+}
+
+/**
+ * @brief               Send and wait until the DMA has handed the last byte to the USART
+ * @param[in]           uart            driver state
+ * @param[in]           data            bytes to send
+ * @param[in]           size            1 to 65535
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, waits on thread flag \ref UART_FLAG_TX
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int uart_write   (
+    UART*               uart,
+    const uint8_t*      data,
+    uint32_t            size    )
+{
+    UART_TX     tx;
+
+    tx.data =   data;
+    tx.size =   size;
+    tx.done =   uart_write_done;
+    tx.arg  =   (void*)osThreadGetId();
+    (void)osThreadFlagsClear(UART_FLAG_TX);
+    if(0 != uart_send(uart, &tx))
+    {
+        return (-1);
+    }
+    (void)osThreadFlagsWait(UART_FLAG_TX, osFlagsWaitAny, osWaitForever);
+    return (0);
+}
+
+/**
+ * @brief               Copy the counters
+ * @param[in]           uart            driver state
+ * @param[out]          stats           counters
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_stats  (
+    UART*               uart,
+    UART_STATS*         stats   )
+{
+    taskENTER_CRITICAL();
+    memcpy(stats, &uart->stats, sizeof(UART_STATS));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief               USART interrupt: idle line and reception errors
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_irq_handler    (
+    UART*               uart    )
+{
+    USART_TypeDef*  usart   =   uart->port->usart;
+    uint32_t        isr     =   READ_REG(usart->ISR);
+
+    if(isr & UART_RX_ERRORS)
+    {
+        WRITE_REG(usart->ICR, USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF);
+        uart->stats.errors++;
+    }
+    if(isr & USART_ISR_IDLE)
+    {
+        LL_USART_ClearFlag_IDLE(usart);
+        uart_rx_flush(uart);
+    }
+}
+
+/**
+ * @brief               Reception DMA channel interrupt: half and full buffer
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_rx_dma_handler (
+    UART*               uart    )
+{
+    const UART_PORT*    port    =   uart->port;
+    uint32_t            flags   =   drv_dma_take(port->dma, port->rx_channel);
+
+    if(flags & DRV_DMA_TE)
+    {
+        /* the channel stopped, restart it from the top of the buffer */
+        uart->stats.errors++;
+        LL_DMA_DisableChannel(port->dma, port->rx_channel);
+        LL_DMA_SetDataLength(port->dma, port->rx_channel, uart->dma_size);
+        uart->rx_pos    =   0;
+        LL_DMA_EnableChannel(port->dma, port->rx_channel);
+    }
+    else if(flags & (DRV_DMA_HT | DRV_DMA_TC))
+    {
+        uart_rx_flush(uart);
+    }
+}
+
+/**
+ * @brief               Transmission DMA channel interrupt: descriptor sent
+ * @param[in]           uart            driver state
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void uart_tx_dma_handler (
+    UART*               uart    )
+{
+    const UART_PORT*    port    =   uart->port;
+    uint32_t            flags   =   drv_dma_take(port->dma, port->tx_channel);
+    UART_TX*            tx      =   uart->tx_head;
+
+    if( (!(flags & (DRV_DMA_TC | DRV_DMA_TE))) || (!tx) )
+    {
+        return;
+    }
+    if(flags & DRV_DMA_TE)
+    {
+        uart->stats.errors++;
+    }
+    else
+    {
+        uart->stats.tx_bytes    +=  tx->size;
+        uart->stats.tx_done++;
+    }
+    uart->tx_head   =   tx->next;
+    if(uart->tx_head)
+    {
+        uart_tx_start(uart, uart->tx_head);
+    }
+    else
+    {
+        uart->tx_tail   =   NULL;
+    }
+    if(tx->done)
+    {
+        tx->done(tx);
+    }
+}
@@ -0,0 +1,545 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        drv_wdg.c
+ * @brief       task health supervisor feeding the hardware watchdog.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx_ll_bus.h"
+#include "stm32l4xx_ll_iwdg.h"
+#include "stm32l4xx_ll_rcc.h"
+#include "stm32l4xx_ll_system.h"
+#include "stm32l4xx_ll_wwdg.h"
+#include "FreeRTOS.h"
+#include "cmsis_os2.h"
+#include "drv_wdg.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define WDG_MAGIC               (0x21474457UL)      /*!< "WDG!", retained record is valid */
+#define WDG_LSI_KHZ             (32U)               /*!< IWDG clock */
+#define WDG_IWDG_RELOAD_MAX     (0x1000U)           /*!< IWDG reload register + 1 */
+#define WDG_IWDG_PRESCALERS     (7U)                /*!< dividers 4 to 256 */
+#define WDG_WWDG_TICKS_MAX      (64U)               /*!< WWDG counter from 0x7F down to 0x40 */
+#define WDG_WWDG_PRESCALERS     (4U)                /*!< dividers 1 to 8 */
+#define WDG_WWDG_RESET          (0x3FU)             /*!< WWDG resets when the counter drops to this */
+#define WDG_STACK_SIZE          (512U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Thread that missed its deadline, kept over the reset
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            magic;      /*!< \ref WDG_MAGIC while valid */
+    osThreadId_t        thread;
+    char                name[16];
+    uint32_t            late;       /*!< ms since its last check-in */
+}WDG_RECORD;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static WDG_RECORD   g_WdgRecord __attribute__((section(".retained.wdg")));
+static WDG_SLOT     g_WdgSlots[WDG_SLOTS];
+static WDG_REPORT   g_WdgReport;
+static uint32_t     g_WdgHw         =   WDG_HW_IWDG;
+static uint32_t     g_WdgPeriod     =   0;          /*!< ticks */
+static uint32_t     g_WdgWwdgReload =   0x7FU;      /*!< WWDG counter value on feeding */
+static uint64_t     g_WdgStack[WDG_STACK_SIZE / sizeof(uint64_t)];
+static uint8_t      g_WdgCb[sizeof(StaticTask_t)];
+static osThreadAttr_t g_WdgAttr =
+{
+    "WDG",                  /*!< name of the thread */
+    osThreadDetached,       /*!< attribute bits */
+    (void*)g_WdgCb,         /*!< memory for control block */
+    sizeof(g_WdgCb),        /*!< size of provided memory for control block */
+    (void*)g_WdgStack,      /*!< memory for stack */
+    sizeof(g_WdgStack),     /*!< size of stack */
+    osPriorityRealtime,     /*!< initial thread priority, set by wdg_init */
+    0,                      /*!< TrustZone module identifier(not used) */
+    0                       /*!< reserved(not used) */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Milliseconds to kernel ticks, rounded up
+ * @param[in]           ms              milliseconds
+ * @return              ticks
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t wdg_ticks   (
+    uint32_t    ms  )
+{
+    return (uint32_t)(((uint64_t)ms * osKernelGetTickFreq() + 999U) / 1000U);
+}
+
+/** 
+ * @brief               Kernel ticks to milliseconds
+ * @param[in]           ticks           kernel ticks
+ * @return              milliseconds
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t wdg_ms  (
+    uint32_t    ticks   )
+{
+    return (uint32_t)(((uint64_t)ticks * 1000U) / osKernelGetTickFreq());
+}
+
+/** 
+ * @brief               Pick the independent watchdog divider for a timeout
+ * @param[in]           timeout         ms
+ * @param[out]          prescaler       divider 4 << prescaler
+ * @param[out]          reload          LSI ticks / divider until the reset
+ * @return              timeout in ms the watchdog really gets, 0 when above 32768
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t wdg_fit_iwdg    (
+    uint32_t    timeout,
+    uint32_t*   prescaler,
+    uint32_t*   reload      )
+{
+    /* smallest divider 4 << prescaler that fits the timeout */
+    for(*prescaler = 0; *prescaler < WDG_IWDG_PRESCALERS; (*prescaler)++)
+    {
+        *reload =   (timeout * WDG_LSI_KHZ) >> (*prescaler + 2U);
+        if(*reload <= WDG_IWDG_RELOAD_MAX)
+        {
+            break;
+        }
+    }
+    if(*prescaler == WDG_IWDG_PRESCALERS)
+    {
+        return (0);
+    }
+    if(*reload == 0)
+    {
+        *reload =   1;
+    }
+    return ((*reload << (*prescaler + 2U)) / WDG_LSI_KHZ);
+}
+
+/** 
+ * @brief               Pick the window watchdog divider for a timeout
+ * @param[in]           timeout         ms
+ * @param[out]          prescaler       divider 4096 << prescaler
+ * @param[out]          ticks           counter ticks until the reset
+ * @return              timeout in ms the watchdog really gets, 0 when above 64 counter
+ *                      ticks at the largest divider (about 26 ms at 80 MHz)
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t wdg_fit_wwdg    (
+    uint32_t    timeout,
+    uint32_t*   prescaler,
+    uint32_t*   ticks       )
+{
+    LL_RCC_ClocksTypeDef    clocks;
+
+    LL_RCC_GetSystemClocksFreq(&clocks);
+    /* counter clock is PCLK1 / 4096 / (1 << prescaler) */
+    for(*prescaler = 0; *prescaler < WDG_WWDG_PRESCALERS; (*prescaler)++)
+    {
+        *ticks  =   (uint32_t)(((uint64_t)timeout * (clocks.PCLK1_Frequency >> (12U + *prescaler))) / 1000U);
+        if(*ticks <= WDG_WWDG_TICKS_MAX)
+        {
+            break;
+        }
+    }
+    if(*prescaler == WDG_WWDG_PRESCALERS)
+    {
+        return (0);
+    }
+    if(*ticks == 0)
+    {
+        *ticks  =   1;
+    }
+    return (uint32_t)(((uint64_t)*ticks * 1000U) / (clocks.PCLK1_Frequency >> (12U + *prescaler)));
+}
+
+/** 
+ * @brief               Start the independent watchdog
+ * @param[in]           prescaler       from \ref wdg_fit_iwdg
+ * @param[in]           reload          from \ref wdg_fit_iwdg
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_start_iwdg  (
+    uint32_t    prescaler,
+    uint32_t    reload      )
+{
+    LL_IWDG_Enable(IWDG);
+    LL_IWDG_EnableWriteAccess(IWDG);
+    LL_IWDG_SetPrescaler(IWDG, prescaler);
+    LL_IWDG_SetReloadCounter(IWDG, reload - 1U);
+    while(1 != LL_IWDG_IsReady(IWDG)) {};
+    LL_IWDG_ReloadCounter(IWDG);
+}
+
+/** 
+ * @brief               Start the window watchdog
+ * @param[in]           prescaler       from \ref wdg_fit_wwdg
+ * @param[in]           ticks           from \ref wdg_fit_wwdg
+ * @return              None
+ * @note                The window is left fully open, the early warning interrupt records
+ *                      the running code in the crash dump when there is one.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_start_wwdg  (
+    uint32_t    prescaler,
+    uint32_t    ticks       )
+{
+    g_WdgWwdgReload =   WDG_WWDG_RESET + ticks;
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_WWDG);
+    LL_WWDG_SetPrescaler(WWDG, prescaler << WWDG_CFR_WDGTB_Pos);
+    LL_WWDG_SetWindow(WWDG, 0x7FU);
+    LL_WWDG_SetCounter(WWDG, g_WdgWwdgReload);
+#if ( configUSE_CRASH_DUMP == 1 )
+    /* xCrashDumpWatchdogHandler is the WWDG interrupt handler */
+    LL_WWDG_ClearFlag_EWKUP(WWDG);
+    LL_WWDG_EnableIT_EWKUP(WWDG);
+    NVIC_SetPriority(WWDG_IRQn, 0);
+    NVIC_EnableIRQ(WWDG_IRQn);
+#endif
+    LL_WWDG_Enable(WWDG);
+}
+
+/** 
+ * @brief               Feed the hardware watchdog
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_feed (void)
+{
+    if(WDG_HW_WWDG == g_WdgHw)
+    {
+        LL_WWDG_SetCounter(WWDG, g_WdgWwdgReload);
+    }
+    else
+    {
+        LL_IWDG_ReloadCounter(IWDG);
+    }
+}
+
+/** 
+ * @brief               Record a thread that missed its deadline and reset
+ * @param[in]           slot            its slot
+ * @param[in]           late            ticks since its last check-in
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_fire    (
+    const WDG_SLOT* slot,
+    uint32_t        late    )
+{
+    const char* name    =   osThreadGetName(slot->thread);
+
+    memset(&g_WdgRecord, 0, sizeof(g_WdgRecord));
+    g_WdgRecord.thread  =   slot->thread;
+    g_WdgRecord.late    =   wdg_ms(late);
+    if(name)
+    {
+        strncpy(g_WdgRecord.name, name, sizeof(g_WdgRecord.name) - 1U);
+    }
+    g_WdgRecord.magic   =   WDG_MAGIC;
+#if ( configUSE_CRASH_DUMP == 1 )
+    /* registers and stack of the thread as it was last switched out */
+    vCrashDumpTask(crashdumpCAUSE_WATCHDOG, (void*)slot->thread);
+#else
+    NVIC_SystemReset();
+#endif
+}
+
+/** 
+ * @brief               Look at every supervised thread once
+ * @param[in]           now             current tick
+ * @return              None
+ * @note                Feeds the watchdog when all threads are in time, resets otherwise
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_pass    (
+    uint32_t    now )
+{
+    WDG_SLOT*   slot    =   NULL;
+    uint32_t    count   =   0;
+    uint32_t    gap     =   0;
+    uint32_t    i;
+
+    for(i = 0; i < WDG_SLOTS; i++)
+    {
+        slot    =   &g_WdgSlots[i];
+        if(0 == slot->deadline)
+        {
+            continue;
+        }
+        count   =   slot->count;
+        gap     =   now - slot->last;
+        if( (count != slot->seen) || (slot->paused) )
+        {
+            if( (count != slot->seen) && (wdg_ms(gap) > slot->worst) )
+            {
+                slot->worst =   wdg_ms(gap);
+            }
+            slot->seen  =   count;
+            slot->last  =   now;
+        }
+        else if(gap > wdg_ticks(slot->deadline))
+        {
+            wdg_fire(slot, gap);
+        }
+    }
+    wdg_feed();
+}
+
+/** 
+ * @brief               Supervisor thread
+ * @param[in]           argument        not used
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void wdg_thread  (
+    void*   argument    )
+{
+    uint32_t    tick    =   osKernelGetTickCount();
+
+    (void)argument;
+    for(;;)
+    {
+        tick    +=  g_WdgPeriod;
+        (void)osDelayUntil(tick);
+        wdg_pass(osKernelGetTickCount());
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the supervisor and the hardware watchdog
+ * @param[in]           config          supervisor configuration
+ * @retval              0               success
+ * @retval              -1              fail, also when the timeout does not fit the watchdog
+ *                      or the period is not below the timeout it really gets
+ * @note                Thread context or before the kernel is started. The watchdog
+ *                      cannot be stopped again. Clears the RCC reset flags.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wdg_init (
+    const WDG_CONFIG*   config  )
+{
+    uint32_t    prescaler   =   0;
+    uint32_t    reload      =   0;
+    uint32_t    timeout     =   0;
+
+    if( (!config) || (config->hw > WDG_HW_WWDG) || (0 == config->period) )
+    {
+        return (-1);
+    }
+    if(WDG_HW_WWDG == config->hw)
+    {
+        timeout =   wdg_fit_wwdg(config->timeout, &prescaler, &reload);
+    }
+    else
+    {
+        timeout =   wdg_fit_iwdg(config->timeout, &prescaler, &reload);
+    }
+    /* the supervisor has to feed within what the hardware really counts */
+    if( (0 == timeout) || (config->period >= timeout) )
+    {
+        return (-1);
+    }
+    /* why the last reset happened, the record is only good after our own reset */
+    memset(&g_WdgReport, 0, sizeof(g_WdgReport));
+    if(LL_RCC_IsActiveFlag_IWDGRST())
+    {
+        g_WdgReport.cause   =   WDG_RESET_IWDG;
+    }
+    else if(LL_RCC_IsActiveFlag_WWDGRST())
+    {
+        g_WdgReport.cause   =   WDG_RESET_WWDG;
+    }
+    else if( (LL_RCC_IsActiveFlag_SFTRST()) && (WDG_MAGIC == g_WdgRecord.magic) )
+    {
+        g_WdgReport.cause   =   WDG_RESET_MISSED;
+        g_WdgReport.thread  =   g_WdgRecord.thread;
+        g_WdgReport.late    =   g_WdgRecord.late;
+        memcpy(g_WdgReport.name, g_WdgRecord.name, sizeof(g_WdgReport.name) - 1U);
+    }
+    g_WdgRecord.magic   =   0;
+    LL_RCC_ClearResetFlags();
+
+    memset(g_WdgSlots, 0, sizeof(g_WdgSlots));
+    g_WdgHw             =   config->hw;
+    g_WdgPeriod         =   wdg_ticks(config->period);
+    g_WdgAttr.priority  =   config->priority;
+    if(NULL == osThreadNew(wdg_thread, NULL, &g_WdgAttr))
+    {
+        return (-1);
+    }
+
+    LL_DBGMCU_APB1_GRP1_FreezePeriph(LL_DBGMCU_APB1_GRP1_IWDG_STOP | LL_DBGMCU_APB1_GRP1_WWDG_STOP);
+    if(WDG_HW_WWDG == config->hw)
+    {
+        wdg_start_wwdg(prescaler, reload);
+    }
+    else
+    {
+        wdg_start_iwdg(prescaler, reload);
+    }
+    return (0);
+}
+
+/**
+ * @brief               Supervise the calling thread
+ * @param[in]           deadline        longest time in ms between two check-ins
+ * @return              slot to check in with, NULL when all slots are used
+ * @note                Thread context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern WDG_SLOT* wdg_register   (
+    uint32_t            deadline    )
+{
+    WDG_SLOT*   slot    =   NULL;
+    osThreadId_t thread =   osThreadGetId();
+    int32_t     lock;
+    uint32_t    i;
+
+    if( (0 == deadline) || (NULL == thread) )
+    {
+        return (NULL);
+    }
+    lock    =   osKernelLock();
+    for(i = 0; i < WDG_SLOTS; i++)
+    {
+        if(0 == g_WdgSlots[i].deadline)
+        {
+            slot            =   &g_WdgSlots[i];
+            slot->thread    =   thread;
+            slot->paused    =   0;
+            slot->worst     =   0;
+            slot->seen      =   slot->count;
+            slot->last      =   osKernelGetTickCount();
+            /* the supervisor looks at the slot from here */
+            slot->deadline  =   deadline;
+            break;
+        }
+    }
+    (void)osKernelRestoreLock(lock);
+    return slot;
+}
+
+/**
+ * @brief               Stop supervising a thread
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_unregister  (
+    WDG_SLOT*           slot    )
+{
+    if(slot)
+    {
+        slot->deadline  =   0;
+    }
+}
+
+/**
+ * @brief               Suspend supervision of a thread around a wait of unbounded length
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_pause   (
+    WDG_SLOT*           slot    )
+{
+    slot->paused    =   1;
+}
+
+/**
+ * @brief               Resume supervision of a thread, counts as a check-in
+ * @param[in]           slot            slot from \ref wdg_register
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wdg_resume  (
+    WDG_SLOT*           slot    )
+{
+    /* move the count first so the next pass starts the deadline afresh */
+    slot->count     =   slot->count + 1U;
+    slot->paused    =   0;
+}
+
+/**
+ * @brief               Tell whether the watchdog caused the last reset
+ * @param[out]          report          cause and the thread that missed its deadline
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Valid after \ref wdg_init
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wdg_last_reset   (
+    WDG_REPORT*         report  )
+{
+    if(!report)
+    {
+        return (-1);
+    }
+    memcpy(report, &g_WdgReport, sizeof(WDG_REPORT));
+    return (0);
+}
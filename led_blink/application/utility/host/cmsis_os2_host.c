@@ -0,0 +1,408 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        cmsis_os2_host.c
+ * @brief       single threaded stand in for the CMSIS RTOS calls coro_os.cpp makes.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Only what the host benchmark needs: message queues, semaphores, event
+ * flags and wait sets with the rules of cmsis_os2_waitset.c, objects from the
+ * host heap, timeouts other than 0 only in osWaitSetWait, where an empty set
+ * moves the tick count forward instead of sleeping.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cmsis_os2.h"
+#include "cmsis_os2_ext.h"
+#include "coro.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define HOST_MQ             (1U)
+#define HOST_SEM            (2U)
+#define HOST_EF             (3U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct
+{
+    void**      ring;
+    uint32_t    size;
+    uint32_t    head;
+    uint32_t    count;
+}HOST_SET;
+
+/* common head of the objects */
+typedef struct
+{
+    uint32_t    type;
+    HOST_SET*   set;
+}HOST_OBJ;
+
+typedef struct
+{
+    HOST_OBJ    obj;
+    uint8_t*    buf;
+    uint32_t    msg_size;
+    uint32_t    msg_count;
+    uint32_t    head;
+    uint32_t    count;
+}HOST_MQ_CB;
+
+typedef struct
+{
+    HOST_OBJ    obj;
+    uint32_t    max;
+    uint32_t    count;
+}HOST_SEM_CB;
+
+typedef struct
+{
+    HOST_OBJ    obj;
+    uint32_t    flags;
+    uint32_t    notify;
+    int         posted;
+}HOST_EF_CB;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+uint32_t    host_tick   =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static void host_post   (
+    HOST_OBJ*   obj )
+{
+    HOST_SET*   set =   obj->set;
+
+    if(!set)
+    {
+        return;
+    }
+    if(set->count == set->size)
+    {
+        /* the kernel asserts here, a set that is too small */
+        abort();
+    }
+    set->ring[(set->head + set->count) % set->size] =   obj;
+    set->count++;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+uint32_t coro_port_lock (void)
+{
+    return 0;
+}
+
+void coro_port_unlock   (
+    uint32_t    key )
+{
+    (void)key;
+}
+
+void coro_port_notify   (
+    CORO_SCHED* sched   )
+{
+    (void)sched;
+}
+
+uint32_t osKernelGetTickCount   (void)
+{
+    return host_tick;
+}
+
+osMessageQueueId_t osMessageQueueNew    (
+    uint32_t                    msg_count,
+    uint32_t                    msg_size,
+    const osMessageQueueAttr_t* attr    )
+{
+    HOST_MQ_CB* mq  =   calloc(1, sizeof(HOST_MQ_CB));
+
+    (void)attr;
+    mq->obj.type    =   HOST_MQ;
+    mq->buf         =   malloc(msg_count * msg_size);
+    mq->msg_size    =   msg_size;
+    mq->msg_count   =   msg_count;
+
+    return mq;
+}
+
+osStatus_t osMessageQueuePut    (
+    osMessageQueueId_t  mq_id,
+    const void*         msg_ptr,
+    uint8_t             msg_prio,
+    uint32_t            timeout )
+{
+    HOST_MQ_CB* mq  =   (HOST_MQ_CB*)mq_id;
+
+    (void)msg_prio;
+    (void)timeout;
+    if(mq->count == mq->msg_count)
+    {
+        return osErrorResource;
+    }
+    memcpy(mq->buf + ((mq->head + mq->count) % mq->msg_count) * mq->msg_size, msg_ptr, mq->msg_size);
+    mq->count++;
+    host_post(&mq->obj);
+
+    return osOK;
+}
+
+osStatus_t osMessageQueueGet    (
+    osMessageQueueId_t  mq_id,
+    void*               msg_ptr,
+    uint8_t*            msg_prio,
+    uint32_t            timeout )
+{
+    HOST_MQ_CB* mq  =   (HOST_MQ_CB*)mq_id;
+
+    (void)timeout;
+    if(!mq->count)
+    {
+        return osErrorResource;
+    }
+    memcpy(msg_ptr, mq->buf + mq->head * mq->msg_size, mq->msg_size);
+    mq->head    =   (mq->head + 1U) % mq->msg_count;
+    mq->count--;
+    if(msg_prio)
+    {
+        *msg_prio   =   0;
+    }
+
+    return osOK;
+}
+
+osSemaphoreId_t osSemaphoreNew  (
+    uint32_t                    max_count,
+    uint32_t                    initial_count,
+    const osSemaphoreAttr_t*    attr    )
+{
+    HOST_SEM_CB*    sem =   calloc(1, sizeof(HOST_SEM_CB));
+
+    (void)attr;
+    sem->obj.type   =   HOST_SEM;
+    sem->max        =   max_count;
+    sem->count      =   initial_count;
+
+    return sem;
+}
+
+osStatus_t osSemaphoreAcquire   (
+    osSemaphoreId_t     semaphore_id,
+    uint32_t            timeout )
+{
+    HOST_SEM_CB*    sem =   (HOST_SEM_CB*)semaphore_id;
+
+    (void)timeout;
+    if(!sem->count)
+    {
+        return osErrorResource;
+    }
+    sem->count--;
+
+    return osOK;
+}
+
+osStatus_t osSemaphoreRelease   (
+    osSemaphoreId_t     semaphore_id    )
+{
+    HOST_SEM_CB*    sem =   (HOST_SEM_CB*)semaphore_id;
+
+    if(sem->count == sem->max)
+    {
+        return osErrorResource;
+    }
+    sem->count++;
+    host_post(&sem->obj);
+
+    return osOK;
+}
+
+osEventFlagsId_t osEventFlagsNew    (
+    const osEventFlagsAttr_t*   attr    )
+{
+    HOST_EF_CB* ef  =   calloc(1, sizeof(HOST_EF_CB));
+
+    (void)attr;
+    ef->obj.type    =   HOST_EF;
+
+    return ef;
+}
+
+uint32_t osEventFlagsSet    (
+    osEventFlagsId_t    ef_id,
+    uint32_t            flags   )
+{
+    HOST_EF_CB* ef  =   (HOST_EF_CB*)ef_id;
+
+    ef->flags   |=  flags;
+    if( (ef->obj.set) && (!ef->posted) && (ef->flags & ef->notify) )
+    {
+        ef->posted  =   1;
+        host_post(&ef->obj);
+    }
+
+    return ef->flags;
+}
+
+uint32_t osEventFlagsClear  (
+    osEventFlagsId_t    ef_id,
+    uint32_t            flags   )
+{
+    HOST_EF_CB* ef  =   (HOST_EF_CB*)ef_id;
+    uint32_t    ret =   ef->flags;
+
+    ef->flags   &=  ~flags;
+    ef->posted  =   0;
+
+    return ret;
+}
+
+uint32_t osEventFlagsGet    (
+    osEventFlagsId_t    ef_id   )
+{
+    HOST_EF_CB* ef  =   (HOST_EF_CB*)ef_id;
+
+    ef->posted  =   0;
+
+    return ef->flags;
+}
+
+uint32_t osEventFlagsWait   (
+    osEventFlagsId_t    ef_id,
+    uint32_t            flags,
+    uint32_t            options,
+    uint32_t            timeout )
+{
+    HOST_EF_CB* ef  =   (HOST_EF_CB*)ef_id;
+    uint32_t    ret =   ef->flags;
+    int         met;
+
+    (void)timeout;
+    ef->posted  =   0;
+    met         =   (options & osFlagsWaitAll)?((ret & flags) == flags):(0U != (ret & flags));
+    if(!met)
+    {
+        return osFlagsErrorResource;
+    }
+    if(!(options & osFlagsNoClear))
+    {
+        ef->flags   &=  ~flags;
+    }
+
+    return ret;
+}
+
+osWaitSetId_t osWaitSetNew  (
+    uint32_t                count,
+    const osWaitSetAttr_t*  attr    )
+{
+    HOST_SET*   set =   calloc(1, sizeof(HOST_SET));
+
+    (void)attr;
+    set->ring   =   calloc(count, sizeof(void*));
+    set->size   =   count;
+
+    return set;
+}
+
+osStatus_t osWaitSetAdd (
+    osWaitSetId_t       set_id,
+    void*               object_id   )
+{
+    HOST_OBJ*   obj     =   (HOST_OBJ*)object_id;
+    uint32_t    count   =   (HOST_MQ == obj->type)?((HOST_MQ_CB*)obj)->count:((HOST_SEM_CB*)obj)->count;
+
+    if( (obj->set) || (count) || (HOST_EF == obj->type) )
+    {
+        return osErrorResource;
+    }
+    obj->set    =   (HOST_SET*)set_id;
+
+    return osOK;
+}
+
+osStatus_t osWaitSetAddEventFlags   (
+    osWaitSetId_t       set_id,
+    osEventFlagsId_t    ef_id,
+    uint32_t            flags   )
+{
+    HOST_EF_CB* ef  =   (HOST_EF_CB*)ef_id;
+
+    if(ef->obj.set)
+    {
+        return osErrorResource;
+    }
+    ef->obj.set =   (HOST_SET*)set_id;
+    ef->notify  =   flags;
+    ef->posted  =   0;
+    (void)osEventFlagsSet(ef, 0);
+
+    return osOK;
+}
+
+osStatus_t osWaitSetWait    (
+    osWaitSetId_t       set_id,
+    void**              object_id,
+    uint32_t            timeout )
+{
+    HOST_SET*   set =   (HOST_SET*)set_id;
+
+    if(!set->count)
+    {
+        *object_id  =   NULL;
+        if(!timeout)
+        {
+            return osErrorResource;
+        }
+        if(osWaitForever != timeout)
+        {
+            host_tick   +=  timeout;
+        }
+        return osErrorTimeout;
+    }
+    *object_id  =   set->ring[set->head];
+    set->head   =   (set->head + 1U) % set->size;
+    set->count--;
+
+    return osOK;
+}
@@ -0,0 +1,347 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro_bench.c
+ * @brief       host benchmark of the coroutine executor.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Builds coro.c with a single threaded port and measures, with the host
+ * clock, the cost of a resume through each await and the memory of a
+ * coroutine. Run "make" in this directory, then ./coro_bench [coroutines].
+ *
+ * The port lock can run a signal the way an interrupt would come in just
+ * before the lock is taken. The last case signals an event and a queue
+ * between the check of the await and the wait list, and the coroutine must
+ * still be woken.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _POSIX_C_SOURCE     199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "coro.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_ROUNDS        (1000U)
+#define BENCH_MAX_COROS     (10000U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* a coroutine that passes a token around a ring of events */
+typedef struct
+{
+    CORO        co;
+    CORO_EVENT* in;
+    CORO_EVENT* out;
+    uint32_t    rounds;
+}RING_CORO;
+
+/* a coroutine that receives items from a queue */
+typedef struct
+{
+    CORO        co;
+    CORO_QUEUE* q;
+    uint32_t    sum;
+}RECV_CORO;
+
+/* a coroutine whose awaits are signalled between the check and the wait list */
+typedef struct
+{
+    CORO        co;
+    CORO_EVENT* ev;
+    CORO_QUEUE* q;
+    uint32_t    got;
+}RACE_CORO;
+
+/* a coroutine that sleeps one tick at a time */
+typedef struct
+{
+    CORO        co;
+    uint32_t    rounds;
+}SLEEP_CORO;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static CORO_SCHED   g_Sched;
+static RING_CORO    g_Ring[BENCH_MAX_COROS];
+static CORO_EVENT   g_Events[BENCH_MAX_COROS];
+static SLEEP_CORO   g_Sleep[BENCH_MAX_COROS];
+static RECV_CORO    g_Recv;
+static CORO_QUEUE   g_Queue;
+static uint32_t     g_QueueMem[16];
+static CORO_EVENT   g_RaceEvent;
+static RACE_CORO    g_Race;
+static uint32_t     g_Inject    =   0;      /* lock calls until the injected signal, 0 for none */
+static void         (*g_InjectFn)(void);
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+extern uint32_t coro_port_lock  (void)
+{
+    /* the signal nests a lock of its own, disarm first */
+    if( (g_Inject) && (0 == --g_Inject) )
+    {
+        g_InjectFn();
+    }
+    return 0;
+}
+
+extern void coro_port_unlock    (
+    uint32_t    key )
+{
+    (void)key;
+}
+
+extern void coro_port_notify    (
+    CORO_SCHED* sched   )
+{
+    (void)sched;
+}
+
+static double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int ring_coro    (
+    CORO*   co  )
+{
+    RING_CORO*  r   =   (RING_CORO*)co;
+
+    CORO_BEGIN(co);
+    while(r->rounds < BENCH_ROUNDS)
+    {
+        CORO_WAIT_EVENT(co, r->in, 1U, CORO_FOREVER);
+        r->rounds++;
+        coro_event_set(r->out, 1U);
+    }
+    CORO_END(co);
+}
+
+static int recv_coro    (
+    CORO*   co  )
+{
+    RECV_CORO*  r   =   (RECV_CORO*)co;
+    uint32_t    item;
+
+    CORO_BEGIN(co);
+    for(;;)
+    {
+        CORO_RECV(co, r->q, &item, CORO_FOREVER);
+        r->sum  +=  item;
+    }
+    CORO_END(co);
+}
+
+static void race_set    (void)
+{
+    coro_event_set(g_Race.ev, 1U);
+}
+
+static void race_put    (void)
+{
+    uint32_t    item    =   7U;
+
+    (void)coro_queue_put(g_Race.q, &item);
+}
+
+static int race_coro    (
+    CORO*   co  )
+{
+    RACE_CORO*  r   =   (RACE_CORO*)co;
+    uint32_t    item;
+
+    CORO_BEGIN(co);
+    /* the first lock is the take that finds nothing, the second the one of coro_wait_on */
+    g_Inject    =   2U;
+    g_InjectFn  =   race_set;
+    CORO_WAIT_EVENT(co, r->ev, 1U, CORO_FOREVER);
+    r->got++;
+    g_Inject    =   2U;
+    g_InjectFn  =   race_put;
+    CORO_RECV(co, r->q, &item, CORO_FOREVER);
+    r->got  +=  (7U == item) ? 1U : 0;
+    CORO_END(co);
+}
+
+static int sleep_coro   (
+    CORO*   co  )
+{
+    SLEEP_CORO* s   =   (SLEEP_CORO*)co;
+
+    CORO_BEGIN(co);
+    while(s->rounds < BENCH_ROUNDS)
+    {
+        CORO_DELAY(co, 1);
+        s->rounds++;
+    }
+    CORO_END(co);
+}
+
+static int yield_coro   (
+    CORO*   co  )
+{
+    SLEEP_CORO* s   =   (SLEEP_CORO*)co;
+
+    CORO_BEGIN(co);
+    while(s->rounds < BENCH_ROUNDS)
+    {
+        CORO_YIELD(co);
+        s->rounds++;
+    }
+    CORO_END(co);
+}
+
+static void bench_report    (
+    const char* name,
+    double      ns,
+    uint32_t    resumes )
+{
+    printf("%-24s %10u resumes %8.1f ns/resume\n", name, resumes, ns / (double)resumes);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (
+    int     argc,
+    char**  argv    )
+{
+    uint32_t    n       =   1000U;
+    uint32_t    i;
+    uint32_t    tick    =   0;
+    uint32_t    item;
+    double      start;
+
+    if(argc > 1)
+    {
+        n   =   (uint32_t)strtoul(argv[1], NULL, 0);
+        if( (n < 2U) || (n > BENCH_MAX_COROS) )
+        {
+            fprintf(stderr, "coroutines must be between 2 and %u\n", BENCH_MAX_COROS);
+            return 1;
+        }
+    }
+
+    printf("sizeof(CORO)        %u bytes (36 on a 32-bit target)\n", (unsigned)sizeof(CORO));
+    printf("sizeof(CORO_EVENT)  %u bytes\n", (unsigned)sizeof(CORO_EVENT));
+    printf("sizeof(CORO_SCHED)  %u bytes\n", (unsigned)sizeof(CORO_SCHED));
+    printf("%u coroutines, %u rounds each\n\n", n, BENCH_ROUNDS);
+
+    /* token ring: every resume is one event wait satisfied by the previous coroutine */
+    coro_sched_init(&g_Sched, tick);
+    for(i = 0; i < n; i++)
+    {
+        coro_event_init(&g_Events[i], &g_Sched);
+        g_Ring[i].in        =   &g_Events[i];
+        g_Ring[i].out       =   &g_Events[(i + 1U) % n];
+        g_Ring[i].rounds    =   0;
+        coro_start(&g_Sched, &g_Ring[i].co, ring_coro);
+    }
+    (void)coro_sched_run(&g_Sched, tick);
+    g_Sched.resumes =   0;
+    start   =   bench_now();
+    coro_event_set(&g_Events[0], 1U);
+    while(0 == coro_sched_run(&g_Sched, tick))
+    {
+    }
+    bench_report("event wait", bench_now() - start, g_Sched.resumes);
+
+    /* queue: one receiver woken for every item */
+    coro_sched_init(&g_Sched, tick);
+    (void)coro_queue_init(&g_Queue, &g_Sched, g_QueueMem, 16U, sizeof(uint32_t));
+    coro_start(&g_Sched, &g_Recv.co, recv_coro);
+    g_Recv.q    =   &g_Queue;
+    (void)coro_sched_run(&g_Sched, tick);
+    g_Sched.resumes =   0;
+    start   =   bench_now();
+    for(item = 0; item < n * BENCH_ROUNDS; item++)
+    {
+        (void)coro_queue_put(&g_Queue, &item);
+        (void)coro_sched_run(&g_Sched, tick);
+    }
+    bench_report("queue receive", bench_now() - start, g_Sched.resumes);
+
+    /* yield: round robin without any wait */
+    coro_sched_init(&g_Sched, tick);
+    for(i = 0; i < n; i++)
+    {
+        g_Sleep[i].rounds   =   0;
+        coro_start(&g_Sched, &g_Sleep[i].co, yield_coro);
+    }
+    start   =   bench_now();
+    while(CORO_FOREVER != coro_sched_run(&g_Sched, tick))
+    {
+    }
+    bench_report("yield", bench_now() - start, g_Sched.resumes);
+
+    /* delay: all coroutines sleep one tick, the wheel expires them every tick */
+    coro_sched_init(&g_Sched, tick);
+    for(i = 0; i < n; i++)
+    {
+        g_Sleep[i].rounds   =   0;
+        coro_start(&g_Sched, &g_Sleep[i].co, sleep_coro);
+    }
+    start   =   bench_now();
+    while(CORO_FOREVER != coro_sched_run(&g_Sched, tick))
+    {
+        tick++;
+    }
+    bench_report("delay (incl. wheel)", bench_now() - start, g_Sched.resumes);
+
+    /* signals in the gap between the check of an await and its wait list */
+    coro_sched_init(&g_Sched, tick);
+    coro_event_init(&g_RaceEvent, &g_Sched);
+    (void)coro_queue_init(&g_Queue, &g_Sched, g_QueueMem, 16U, sizeof(uint32_t));
+    g_Race.ev   =   &g_RaceEvent;
+    g_Race.q    =   &g_Queue;
+    g_Race.got  =   0;
+    coro_start(&g_Sched, &g_Race.co, race_coro);
+    for(i = 0; (i < 8U) && (CORO_FOREVER != coro_sched_run(&g_Sched, tick)); i++)
+    {
+    }
+    printf("%-24s %s\n", "signal before wait list", (2U == g_Race.got) ? "woken" : "lost");
+
+    return (2U == g_Race.got) ? 0 : 1;
+}
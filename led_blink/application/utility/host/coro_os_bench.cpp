@@ -0,0 +1,252 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro_os_bench.cpp
+ * @brief       host benchmark of the C++20 coroutine layer.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Builds coro_os.cpp and coro.c against cmsis_os2_host.c, measures the cost
+ * of a resume through each awaiter with the host clock and prints the frame
+ * sizes the compiler chose. Run "make" in this directory, then ./coro_os_bench.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+
+#include "coro_os.hpp"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_COROS         (1000U)
+#define BENCH_RING          (32U)
+#define BENCH_ROUNDS        (1000U)
+#define BENCH_QUEUE_LEN     (16U)
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+extern "C" uint32_t host_tick;
+
+static coro_os::StaticFramePool<512, BENCH_COROS + 8U>  g_Pool;
+static coro_os::Executor                                g_Exec;
+static osSemaphoreId_t                                  g_Ring[BENCH_RING];
+static uint32_t                                         g_Received;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static coro_os::Task ring_task  (
+    uint32_t    index   )
+{
+    uint32_t    round;
+
+    for(round = 0; round < BENCH_ROUNDS; round++)
+    {
+        (void)co_await coro_os::acquire(g_Ring[index], osWaitForever);
+        (void)osSemaphoreRelease(g_Ring[(index + 1U) % BENCH_RING]);
+    }
+}
+
+static coro_os::Task producer_task  (
+    osMessageQueueId_t  mq  )
+{
+    uint32_t    item;
+
+    for(item = 0; item < BENCH_COROS * BENCH_ROUNDS; item++)
+    {
+        (void)co_await coro_os::put(mq, &item, 0, osWaitForever);
+    }
+}
+
+static coro_os::Task consumer_task  (
+    osMessageQueueId_t  mq  )
+{
+    uint32_t    item;
+
+    while(g_Received < BENCH_COROS * BENCH_ROUNDS)
+    {
+        if(osOK == co_await coro_os::get(mq, &item, NULL, osWaitForever))
+        {
+            g_Received++;
+        }
+    }
+}
+
+static coro_os::Task flags_task (
+    osEventFlagsId_t    ef,
+    uint32_t            bit )
+{
+    uint32_t    round;
+
+    for(round = 0; round < BENCH_ROUNDS; round++)
+    {
+        (void)co_await coro_os::wait_flags(ef, 1U << bit, osFlagsWaitAny, osWaitForever);
+        (void)osEventFlagsSet(ef, 1U << ((bit + 1U) % 24U));
+    }
+}
+
+static coro_os::Task delay_task (void)
+{
+    uint32_t    round;
+
+    for(round = 0; round < BENCH_ROUNDS; round++)
+    {
+        (void)co_await coro_os::delay(1);
+    }
+}
+
+static coro_os::Task yield_task (void)
+{
+    uint32_t    round;
+
+    for(round = 0; round < BENCH_ROUNDS; round++)
+    {
+        (void)co_await coro_os::yield();
+    }
+}
+
+/* run the executor until every coroutine finished, ops 0 counts resumes */
+static void bench_run   (
+    const char* name,
+    double      start,
+    uint32_t    resumes,
+    uint32_t    ops )
+{
+    uint32_t    wait;
+    uint32_t    last    =   resumes;
+
+    while(g_Exec.tasks())
+    {
+        wait    =   g_Exec.step();
+        if(osWaitForever == wait)
+        {
+            /* the set may hold reports made by this pass */
+            if(last == g_Exec.resumes())
+            {
+                printf("%s: stuck with %u coroutines\n", name, g_Exec.tasks());
+                return;
+            }
+            wait    =   0;
+        }
+        last        =   g_Exec.resumes();
+        host_tick   +=  wait;
+    }
+    resumes =   g_Exec.resumes() - resumes;
+    printf("%-24s %10u resumes %8.1f ns/%s   frames: %3zu bytes, peak %zu\n",
+           name, resumes, (bench_now() - start) / (double)((ops)?ops:resumes),
+           (ops)?"message":"resume ", g_Pool.largest(), g_Pool.peak());
+}
+
+static void bench_spawn (
+    coro_os::Task&& task    )
+{
+    if(osOK != g_Exec.spawn(static_cast<coro_os::Task&&>(task)))
+    {
+        printf("frame pool empty, largest frame %zu bytes\n", g_Pool.largest());
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (void)
+{
+    osWaitSetId_t       set     =   osWaitSetNew(BENCH_RING + BENCH_QUEUE_LEN + 2U + 1U, NULL);
+    osSemaphoreId_t     kick    =   osSemaphoreNew(1, 0, NULL);
+    osMessageQueueId_t  mq      =   osMessageQueueNew(BENCH_QUEUE_LEN, sizeof(uint32_t), NULL);
+    osEventFlagsId_t    ef      =   osEventFlagsNew(NULL);
+    uint32_t            i;
+    double              start;
+
+    g_Pool.install();
+    if(osOK != g_Exec.init(set, kick))
+    {
+        printf("executor init failed\n");
+        return 1;
+    }
+    printf("sizeof(coro_os::Wait)       %zu bytes\n", sizeof(coro_os::Wait));
+    printf("sizeof(coro_os::MessageGet) %zu bytes\n", sizeof(coro_os::MessageGet));
+    printf("sizeof(coro_os::Executor)   %zu bytes\n\n", sizeof(coro_os::Executor));
+
+    /* semaphore ring: every resume goes through a wait set report */
+    for(i = 0; i < BENCH_RING; i++)
+    {
+        g_Ring[i]   =   osSemaphoreNew(1, 0, NULL);
+        bench_spawn(ring_task(i));
+    }
+    (void)g_Exec.step();
+    start   =   bench_now();
+    (void)osSemaphoreRelease(g_Ring[0]);
+    bench_run("semaphore ring", start, g_Exec.resumes(), 0);
+
+    /* one producer and one consumer around a short queue */
+    start   =   bench_now();
+    bench_spawn(consumer_task(mq));
+    bench_spawn(producer_task(mq));
+    bench_run("queue put / get", start, g_Exec.resumes(), BENCH_COROS * BENCH_ROUNDS);
+
+    /* event flags passed around 24 coroutines */
+    for(i = 0; i < 24U; i++)
+    {
+        bench_spawn(flags_task(ef, i));
+    }
+    (void)g_Exec.step();
+    start   =   bench_now();
+    (void)osEventFlagsSet(ef, 1U);
+    bench_run("event flags", start, g_Exec.resumes(), 0);
+
+    start   =   bench_now();
+    for(i = 0; i < BENCH_COROS; i++)
+    {
+        bench_spawn(yield_task());
+    }
+    bench_run("yield", start, g_Exec.resumes(), 0);
+
+    start   =   bench_now();
+    for(i = 0; i < BENCH_COROS; i++)
+    {
+        bench_spawn(delay_task());
+    }
+    bench_run("delay (incl. wheel)", start, g_Exec.resumes(), 0);
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        mpsc_bench.c
+ * @brief       host stress test and benchmark of the multi-producer ring.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Builds mpsc_ring.c against the compare and swap stand in of the exclusive
+ * monitor in stm32l4xx.h. Producer threads put numbered items, half of them
+ * with reserve and commit, and retry when the ring is full. The consumer
+ * checks that every producer's items arrive once each and in order, and
+ * that the drop count matches the full rings the producers saw. Run "make"
+ * in this directory, then ./mpsc_bench [producers] [items].
+ *
+ * The throughput runs let the host schedule the threads. The stress run then
+ * gives up the processor between the load and store exclusive of the claim
+ * and between reserve and commit, so producers overtake each other there even
+ * on a single core. A consumer that gets nothing for 2 s ends the bench as
+ * failed, since its producers may be spinning on a broken ring.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _POSIX_C_SOURCE     200112L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "mpsc_ring.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_RING_ITEMS    (1024U)
+#define BENCH_MAX_PRODUCERS (16U)
+#define BENCH_PREEMPT       (7U)                /*!< stress run yields every 7th claim */
+#define BENCH_STALL_NS      (2e9)               /*!< no item for that long ends the bench */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* what a producer puts into the ring */
+typedef struct
+{
+    uint32_t    producer;
+    uint32_t    seq;
+}BENCH_ITEM;
+
+/* a producer thread */
+typedef struct
+{
+    pthread_t   thread;
+    uint32_t    id;
+    uint32_t    count;      /*!< items to put */
+    uint32_t    full;       /*!< puts refused because the ring was full */
+}BENCH_PRODUCER;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static MPSC_RING        g_Ring;
+static uint32_t         g_RingMem[MPSC_RING_MEM_SIZE(BENCH_RING_ITEMS, sizeof(BENCH_ITEM)) / sizeof(uint32_t)];
+static BENCH_PRODUCER   g_Producers[BENCH_MAX_PRODUCERS];
+static uint32_t         g_Next[BENCH_MAX_PRODUCERS];
+static volatile int     g_Go;
+
+/* read by the stm32l4xx.h stand in, 0 while measuring the throughput */
+volatile uint32_t       g_HostPreempt   =   0;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void* bench_producer (
+    void*   arg )
+{
+    BENCH_PRODUCER* p       =   (BENCH_PRODUCER*)arg;
+    BENCH_ITEM      item;
+    BENCH_ITEM*     slot;
+    uint32_t        seq;
+
+    while(!__atomic_load_n(&g_Go, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+    item.producer   =   p->id;
+    for(seq = 0; seq < p->count; seq++)
+    {
+        item.seq    =   seq;
+        for(;;)
+        {
+            if(p->id & 1U)
+            {
+                slot    =   (BENCH_ITEM*)mpsc_ring_reserve(&g_Ring);
+                if(slot)
+                {
+                    /* the consumer must wait here instead of reading the old item */
+                    if( (0U != g_HostPreempt) && (0U == (seq % g_HostPreempt)) )
+                    {
+                        sched_yield();
+                    }
+                    *slot   =   item;
+                    mpsc_ring_commit(slot);
+                    break;
+                }
+            }
+            else if(0 == mpsc_ring_put(&g_Ring, &item))
+            {
+                break;
+            }
+            p->full++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* runs the producers and consumes their items, returns the number of wrong items */
+static uint32_t bench_run   (
+    uint32_t    producers,
+    uint32_t    items,
+    double*     ns  )
+{
+    BENCH_ITEM  item;
+    uint32_t    total   =   (items / producers) * producers;
+    uint32_t    got     =   0;
+    uint32_t    wrong   =   0;
+    uint32_t    full    =   0;
+    uint32_t    idle    =   0;      /*!< items got when the ring was last seen empty */
+    uint32_t    i;
+    double      start;
+    double      last;
+
+    (void)mpsc_ring_init(&g_Ring, g_RingMem, BENCH_RING_ITEMS, sizeof(BENCH_ITEM));
+    g_Go    =   0;
+    for(i = 0; i < producers; i++)
+    {
+        g_Producers[i].id       =   i;
+        g_Producers[i].count    =   items / producers;
+        g_Producers[i].full     =   0;
+        g_Next[i]               =   0;
+        if(0 != pthread_create(&g_Producers[i].thread, NULL, bench_producer, &g_Producers[i]))
+        {
+            fprintf(stderr, "cannot start producer %u\n", i);
+            exit(1);
+        }
+    }
+
+    start   =   bench_now();
+    last    =   start;
+    __atomic_store_n(&g_Go, 1, __ATOMIC_RELEASE);
+    while(got < total)
+    {
+        if(0 != mpsc_ring_get(&g_Ring, &item))
+        {
+            /* lost items or a ring that producers spin on, they cannot be joined */
+            if(got != idle)
+            {
+                idle    =   got;
+                last    =   bench_now();
+            }
+            else if(bench_now() - last > BENCH_STALL_NS)
+            {
+                printf("%u producer(s) stalled after %u of %u items\n", producers, got, total);
+                exit(1);
+            }
+            sched_yield();
+            continue;
+        }
+        got++;
+        /* one of ours, exactly the next one of its producer */
+        if( (item.producer >= producers) || (item.seq != g_Next[item.producer]) )
+        {
+            wrong++;
+            if(item.producer < producers)
+            {
+                g_Next[item.producer]   =   item.seq + 1U;
+            }
+            continue;
+        }
+        g_Next[item.producer]++;
+    }
+    *ns =   bench_now() - start;
+
+    for(i = 0; i < producers; i++)
+    {
+        (void)pthread_join(g_Producers[i].thread, NULL);
+        full    +=  g_Producers[i].full;
+        /* nothing lost at the end of any producer */
+        if(g_Next[i] != g_Producers[i].count)
+        {
+            wrong++;
+        }
+    }
+    /* nothing left over, and every refused put counted once */
+    if(0 == mpsc_ring_get(&g_Ring, &item))
+    {
+        wrong++;
+    }
+    if(full != mpsc_ring_drops(&g_Ring))
+    {
+        wrong++;
+    }
+    return wrong;
+}
+
+static void bench_report    (
+    const char* name,
+    uint32_t    producers,
+    uint32_t    items,
+    double      ns,
+    uint32_t    wrong   )
+{
+    printf("%-8s %2u producer(s) %9u items %8.2f M items/s %8u full %6u wrong\n",
+           name, producers, items, (double)items * 1e3 / ns, mpsc_ring_drops(&g_Ring), wrong);
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (
+    int     argc,
+    char**  argv    )
+{
+    uint32_t    producers   =   4U;
+    uint32_t    items       =   2000000U;
+    uint32_t    wrong       =   0;
+    uint32_t    n;
+    double      ns;
+
+    if(argc > 1)
+    {
+        producers   =   (uint32_t)strtoul(argv[1], NULL, 0);
+        if( (producers < 1U) || (producers > BENCH_MAX_PRODUCERS) )
+        {
+            fprintf(stderr, "producers must be between 1 and %u\n", BENCH_MAX_PRODUCERS);
+            return 1;
+        }
+    }
+    if(argc > 2)
+    {
+        items   =   (uint32_t)strtoul(argv[2], NULL, 0);
+        if(items < producers)
+        {
+            fprintf(stderr, "items must be at least the producer count\n");
+            return 1;
+        }
+    }
+
+    printf("ring of %u items of %u bytes\n\n", BENCH_RING_ITEMS, (unsigned)sizeof(BENCH_ITEM));
+
+    /* one producer alone as the reference, then all of them at once */
+    n       =   bench_run(1U, items, &ns);
+    bench_report("speed", 1U, items, ns, n);
+    wrong   +=  n;
+    if(producers > 1U)
+    {
+        n       =   bench_run(producers, items, &ns);
+        bench_report("speed", producers, (items / producers) * producers, ns, n);
+        wrong   +=  n;
+    }
+
+    /* producers preempted inside the claim and before the commit */
+    g_HostPreempt   =   BENCH_PREEMPT;
+    n       =   bench_run(producers, items, &ns);
+    bench_report("stress", producers, (items / producers) * producers, ns, n);
+    wrong   +=  n;
+
+    return (0U == wrong) ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        stm32l4xx.h
+ * @brief       host stand in for the core intrinsics of the utility modules.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The exclusive monitor is one reservation per thread. A store exclusive
+ * succeeds when the word still holds the value of the load exclusive, which
+ * is what a compare and swap checks. The words the modules use this way only
+ * count up, so a value seen again means nothing else was stored.
+ *
+ * When g_HostPreempt is not 0, every g_HostPreempt-th load exclusive of a
+ * thread gives up the processor before it returns. Another thread then runs
+ * between the load and the store exclusive, the way an interrupt would.
+ */
+
+#ifndef _STM32L4XX_HOST_H_
+#define _STM32L4XX_HOST_H_
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <sched.h>
+#include <stdint.h>
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+extern volatile uint32_t            g_HostPreempt;      /*!< defined by the bench */
+static __thread volatile uint32_t*  g_HostExclAddr;
+static __thread uint32_t            g_HostExclValue;
+static __thread uint32_t            g_HostExclLoads;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static inline uint32_t __LDREXW (
+    volatile uint32_t*  addr    )
+{
+    g_HostExclAddr  =   addr;
+    g_HostExclValue =   __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+    if( (0U != g_HostPreempt) && (0U == (++g_HostExclLoads % g_HostPreempt)) )
+    {
+        (void)sched_yield();
+    }
+    return g_HostExclValue;
+}
+
+static inline uint32_t __STREXW (
+    uint32_t            value,
+    volatile uint32_t*  addr    )
+{
+    uint32_t    expect  =   g_HostExclValue;
+
+    if(g_HostExclAddr != addr)
+    {
+        return 1U;
+    }
+    g_HostExclAddr  =   (volatile uint32_t*)0;
+    return __atomic_compare_exchange_n(addr, &expect, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 0U : 1U;
+}
+
+static inline void __CLREX (void)
+{
+    g_HostExclAddr  =   (volatile uint32_t*)0;
+}
+
+static inline void __DMB (void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif /* _STM32L4XX_HOST_H_ */
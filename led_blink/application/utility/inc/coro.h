@@ -0,0 +1,439 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro.h
+ * @brief       stackless coroutines run by an executor inside one thread.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * A coroutine is a function that is entered again from the top on every
+ * resume; CORO_BEGIN jumps back to the await it stopped at. It has no stack
+ * of its own, so local variables do not survive an await: keep the state in a
+ * structure whose first member is the CORO and cast the CORO pointer back.
+ * Do not put an await inside a switch statement of the coroutine.
+ *
+ *     typedef struct { CORO co; uint32_t count; } BLINK;
+ *
+ *     static int blink(CORO* co)
+ *     {
+ *         BLINK* b = (BLINK*)co;
+ *         CORO_BEGIN(co);
+ *         for(;;)
+ *         {
+ *             CORO_DELAY(co, 500);
+ *             b->count++;
+ *         }
+ *         CORO_END(co);
+ *     }
+ *
+ * Timeouts, delays and the value passed to \ref coro_sched_run count ticks of
+ * whatever clock the port uses. A coroutine woken for an event or item that
+ * another one took first waits again with the full timeout. Events and queues may be signalled from any
+ * context through the port lock; everything else is for the executor thread.
+ * coro.c has no target dependency and builds on a host, see host/.
+ */
+
+#ifndef _CORO_H_
+#define _CORO_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Return values of a coroutine function, produced by the macros below */
+#define CORO_RET_WAIT       (0)     /*!< suspended until an event, item or timeout */
+#define CORO_RET_YIELD      (1)     /*!< ready again, behind the other ready coroutines */
+#define CORO_RET_DONE       (2)     /*!< finished */
+
+/** Outcome of the last await, see \ref CORO_RESULT */
+#define CORO_OK             (0)
+#define CORO_TIMEOUT        (1)
+
+/** Timeout that never expires */
+#define CORO_FOREVER        (0xFFFFFFFFU)
+
+/** Timer wheel slots, a power of two. Longer delays are checked once per turn */
+#define CORO_WHEEL_SIZE     (32U)
+
+/** Start of a coroutine body */
+#define CORO_BEGIN(co)      switch((co)->line) { case 0:
+
+/** End of a coroutine body, the coroutine finishes if it gets here */
+#define CORO_END(co)        } (co)->line = 0; return CORO_RET_DONE
+
+/** Let the other ready coroutines run */
+#define CORO_YIELD(co)                                                  \
+    do                                                                  \
+    {                                                                   \
+        (co)->line  =   __LINE__;                                       \
+        return CORO_RET_YIELD;                                          \
+        case __LINE__:;                                                 \
+    }while(0)
+
+/** Suspend for ticks ticks */
+#define CORO_DELAY(co, ticks)                                           \
+    do                                                                  \
+    {                                                                   \
+        coro_sleep((co), (ticks));                                      \
+        (co)->line  =   __LINE__;                                       \
+        return CORO_RET_WAIT;                                           \
+        case __LINE__:;                                                 \
+    }while(0)
+
+/** Wait until any of bits is set in ev and take them, see \ref CORO_EVENT_BITS */
+#define CORO_WAIT_EVENT(co, ev, bits, timeout)                          \
+    do                                                                  \
+    {                                                                   \
+        (co)->result    =   CORO_OK;                                    \
+        for(;;)                                                         \
+        {                                                               \
+            (co)->mask  =   coro_event_take((ev), (bits));              \
+            if((co)->mask)                                              \
+            {                                                           \
+                (co)->result    =   CORO_OK;                            \
+                break;                                                  \
+            }                                                           \
+            if( (CORO_TIMEOUT == (co)->result) || (0 == (timeout)) )    \
+            {                                                           \
+                (co)->result    =   CORO_TIMEOUT;                       \
+                break;                                                  \
+            }                                                           \
+            coro_wait_on((co), &(ev)->waiters, &(ev)->flags, (bits),    \
+                         (timeout));                                    \
+            (co)->line  =   __LINE__;                                   \
+            return CORO_RET_WAIT;                                       \
+            case __LINE__:;                                             \
+        }                                                               \
+    }while(0)
+
+/** Wait for an item of q and copy it to item */
+#define CORO_RECV(co, q, item, timeout)                                 \
+    do                                                                  \
+    {                                                                   \
+        (co)->result    =   CORO_OK;                                    \
+        for(;;)                                                         \
+        {                                                               \
+            if(0 == coro_queue_get((q), (item)))                        \
+            {                                                           \
+                (co)->result    =   CORO_OK;                            \
+                break;                                                  \
+            }                                                           \
+            if( (CORO_TIMEOUT == (co)->result) || (0 == (timeout)) )    \
+            {                                                           \
+                (co)->result    =   CORO_TIMEOUT;                       \
+                break;                                                  \
+            }                                                           \
+            coro_wait_on((co), &(q)->waiters, &(q)->used, 0xFFFFFFFFU,  \
+                         (timeout));                                    \
+            (co)->line  =   __LINE__;                                   \
+            return CORO_RET_WAIT;                                       \
+            case __LINE__:;                                             \
+        }                                                               \
+    }while(0)
+
+/** \ref CORO_OK or \ref CORO_TIMEOUT for the last event or queue await */
+#define CORO_RESULT(co)     ((co)->result)
+
+/** Bits taken by the last \ref CORO_WAIT_EVENT */
+#define CORO_EVENT_BITS(co) ((co)->mask)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+typedef struct CORO          CORO;
+typedef struct CORO_SCHED    CORO_SCHED;
+
+/** Coroutine function, returns one of CORO_RET_xxx */
+typedef int (*CORO_FUNC)(CORO* co);
+
+/**
+ * @brief      Coroutine control block, the fields are private except through the macros
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+struct CORO
+{
+    CORO*           next;       /*!< ready list or wait list link */
+    CORO*           tnext;      /*!< timer wheel link */
+    CORO_SCHED*     sched;      /*!< executor */
+    CORO_FUNC       func;       /*!< body */
+    CORO**          wait;       /*!< wait list while waiting on an event or queue */
+    uint32_t        wake;       /*!< tick the delay or timeout expires */
+    uint32_t        mask;       /*!< event bits waited for, then bits taken */
+    uint16_t        line;       /*!< resume point */
+    uint8_t         state;      /*!< CORO_STATE_xxx in coro.c */
+    uint8_t         result;     /*!< CORO_OK or CORO_TIMEOUT */
+};
+
+/**
+ * @brief      Executor, the fields are private
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+struct CORO_SCHED
+{
+    CORO*           ready_head;
+    CORO*           ready_tail;
+    uint32_t        ready_count;
+    CORO*           wheel[CORO_WHEEL_SIZE];
+    uint32_t        timed;      /*!< coroutines in the wheel */
+    uint32_t        now;        /*!< last tick the wheel was advanced to */
+    uint32_t        resumes;    /*!< coroutine function calls */
+    void*           port;       /*!< port data, the executor thread on target */
+};
+
+/**
+ * @brief      Event bits that coroutines wait on
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    CORO_SCHED*         sched;
+    CORO*               waiters;
+    volatile uint32_t   flags;
+}CORO_EVENT;
+
+/**
+ * @brief      Queue of fixed size items that coroutines receive from
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    CORO_SCHED*         sched;
+    CORO*               waiters;
+    uint8_t*            buf;
+    uint32_t            item_size;
+    uint32_t            count;
+    uint32_t            head;       /*!< oldest item */
+    volatile uint32_t   used;
+}CORO_QUEUE;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Initial an executor
+ * @param[out]          sched           executor
+ * @param[in]           now             current tick
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_sched_init (
+    CORO_SCHED* sched,
+    uint32_t    now
+);
+
+/**
+ * @brief               Start a coroutine, it runs at the next \ref coro_sched_run
+ * @param[in]           sched           executor
+ * @param[out]          co              coroutine, first member of the caller's state
+ * @param[in]           func            coroutine function
+ * @return              None
+ * @note                Any context. co must not be running already
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_start  (
+    CORO_SCHED* sched,
+    CORO*       co,
+    CORO_FUNC   func
+);
+
+/**
+ * @brief               Expire timeouts and run the coroutines that are ready
+ * @param[in]           sched           executor
+ * @param[in]           now             current tick
+ * @return              ticks until it should be called again at the latest, 0 to call it
+ *                      again straight away, \ref CORO_FOREVER when nothing is timed
+ * @note                Executor thread. Every coroutine ready on entry runs once
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_sched_run  (
+    CORO_SCHED* sched,
+    uint32_t    now
+);
+
+/**
+ * @brief               Initial an event
+ * @param[out]          ev              event
+ * @param[in]           sched           executor of the coroutines that wait on it
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_event_init (
+    CORO_EVENT* ev,
+    CORO_SCHED* sched
+);
+
+/**
+ * @brief               Set event bits and wake the coroutines waiting for them
+ * @param[in]           ev              event
+ * @param[in]           bits            bits to set
+ * @return              None
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_event_set  (
+    CORO_EVENT* ev,
+    uint32_t    bits
+);
+
+/**
+ * @brief               Clear and return the set bits of mask
+ * @param[in]           ev              event
+ * @param[in]           mask            bits to take
+ * @return              bits taken, 0 if none was set
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_event_take (
+    CORO_EVENT* ev,
+    uint32_t    mask
+);
+
+/**
+ * @brief               Initial a queue
+ * @param[out]          q               queue
+ * @param[in]           sched           executor of the coroutines that receive from it
+ * @param[in]           mem             item memory of count * item_size bytes
+ * @param[in]           count           number of items
+ * @param[in]           item_size       item size in bytes
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_init  (
+    CORO_QUEUE* q,
+    CORO_SCHED* sched,
+    void*       mem,
+    uint32_t    count,
+    uint32_t    item_size
+);
+
+/**
+ * @brief               Copy an item into a queue and wake the first waiting coroutine
+ * @param[in]           q               queue
+ * @param[in]           item            item to copy, item_size bytes
+ * @retval              0               success
+ * @retval              -1              queue full
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_put   (
+    CORO_QUEUE* q,
+    const void* item
+);
+
+/**
+ * @brief               Take the oldest item out of a queue without waiting
+ * @param[in]           q               queue
+ * @param[out]          item            buffer of item_size bytes
+ * @retval              0               success
+ * @retval              -1              queue empty
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_get   (
+    CORO_QUEUE* q,
+    void*       item
+);
+
+/* Used by the macros */
+extern void coro_sleep      (CORO* co, uint32_t ticks);
+extern void coro_wait_on    (CORO* co, CORO** list, const volatile uint32_t* cond, uint32_t mask, uint32_t timeout);
+
+/**************************************************************
+**  Port
+**************************************************************/
+
+/**
+ * @brief               Enter the section that guards ready lists, wait lists, events and queues
+ * @return              key for \ref coro_port_unlock
+ * @note                Provided by the port, may be called from any context that signals
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_port_lock  (void);
+
+/**
+ * @brief               Leave the section entered by \ref coro_port_lock
+ * @param[in]           key             value returned by \ref coro_port_lock
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_port_unlock    (
+    uint32_t    key
+);
+
+/**
+ * @brief               Make the executor call \ref coro_sched_run soon, a coroutine became ready
+ * @param[in]           sched           executor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_port_notify    (
+    CORO_SCHED* sched
+);
+
+/**
+ * @brief               Executor thread of the CMSIS RTOS port, runs sched until the end
+ * @param[in]           argument        CORO_SCHED* initialised with \ref coro_sched_init
+ * @return              None
+ * @note                Create it with \ref osThreadNew
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_thread (
+    void*       argument
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CORO_H_ */
@@ -0,0 +1,364 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro_os.hpp
+ * @brief       C++20 coroutines awaiting CMSIS RTOS objects, resumed by one executor thread.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * A coroutine returns \ref coro_os::Task and awaits delays, message queues,
+ * semaphores and event flags with the usual CMSIS timeouts:
+ *
+ *     static coro_os::Task blink(osMessageQueueId_t q)
+ *     {
+ *         uint32_t cmd;
+ *         for(;;)
+ *         {
+ *             if(osOK == co_await coro_os::get(q, &cmd, NULL, 500))
+ *             {
+ *                 ...
+ *             }
+ *             co_await coro_os::delay(10);
+ *         }
+ *     }
+ *
+ *     static coro_os::StaticFramePool<256, 16> pool;
+ *     static coro_os::Executor exec;
+ *
+ *     pool.install();
+ *     exec.init(set, kick);
+ *     exec.spawn(blink(q));
+ *     osThreadNew(coro_os::Executor::thread, &exec, &attr);
+ *
+ * Frames come from the installed \ref coro_os::FramePool, never from the heap;
+ * a coroutine whose frame does not fit is not created and spawn fails. The
+ * executor is the coro.h executor: awaiters embed a CORO, so timeouts use its
+ * timer wheel and a waiting coroutine costs its frame only.
+ *
+ * The executor thread blocks on one wait set (\ref osWaitSetNew). An object
+ * joins the set the first time a coroutine has to wait for it and stays in
+ * it: from then on only coroutines of this executor may get from that queue,
+ * acquire that semaphore or wait for those flags, while threads and
+ * interrupts keep putting, releasing and setting. Size the set with the
+ * lengths of the queues, the maximum counts of the semaphores, two per event
+ * flags object and one for kick, a binary semaphore that wakes the thread
+ * when a coroutine is spawned. Putting to a full queue is retried every tick.
+ *
+ * Needs -std=c++20 (GCC 10 or later); -fno-exceptions and -fno-rtti are fine.
+ */
+
+#ifndef _CORO_OS_HPP_
+#define _CORO_OS_HPP_
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <coroutine>
+
+#include "cmsis_os2.h"
+#include "cmsis_os2_ext.h"
+#include "coro.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Objects one executor can wait for */
+#ifndef CORO_OS_MEMBERS
+#define CORO_OS_MEMBERS     (16U)
+#endif
+
+/** Event flags a waiting coroutine can be woken by, all of the RTOS */
+#define CORO_OS_FLAGS_MASK  (0x00FFFFFFU)
+
+namespace coro_os
+{
+
+class Executor;
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief   Fixed size blocks for coroutine frames
+ * @note    Any context
+ */
+class FramePool
+{
+public:
+    FramePool   (void* mem, size_t block, size_t count);
+
+    void*       alloc   (size_t size);
+    void        free    (void* frame);
+    void        install (void);
+
+    size_t      used    (void) const    { return used_; }
+    size_t      peak    (void) const    { return peak_; }
+    /** largest frame asked for, to size the blocks */
+    size_t      largest (void) const    { return largest_; }
+
+    static FramePool*   installed   (void)  { return installed_; }
+
+private:
+    struct Block
+    {
+        Block*  next;
+    };
+
+    Block*      free_;
+    size_t      block_;
+    size_t      used_;
+    size_t      peak_;
+    size_t      largest_;
+
+    static FramePool*   installed_;
+};
+
+/**
+ * @brief   FramePool with its own storage, BlockSize bytes for each of Count frames
+ */
+template<size_t BlockSize, size_t Count>
+class StaticFramePool : public FramePool
+{
+public:
+    StaticFramePool (void) : FramePool(mem_, sizeof(mem_) / Count, Count) {}
+
+private:
+    alignas(8) unsigned char    mem_[((BlockSize + 7U) & ~(size_t)7U) * Count];
+};
+
+/**
+ * @brief   A coroutine suspended in the executor, first member is its CORO
+ */
+struct Wait
+{
+    enum Kind : uint8_t
+    {
+        RESUME  =   0,              /*!< resumes when the CORO runs: start, delay, yield */
+        ITEM,                       /*!< message or token of an object in the wait set */
+        FLAGS,                      /*!< event flags in the wait set */
+        POLL,                       /*!< retried every tick */
+    };
+
+    CORO                    co;
+    std::coroutine_handle<> handle;
+    bool                  (*op)(Wait* wait);    /*!< the CMSIS call with a timeout of 0 */
+    struct Member*          member;
+    uint32_t                deadline;
+    uint32_t                timeout;
+    uint32_t                result;
+    Kind                    kind;
+
+    bool        suspend (std::coroutine_handle<> h, Executor* exec, void* object);
+};
+
+/**
+ * @brief   Object of the wait set and the coroutines waiting for it
+ */
+struct Member
+{
+    void*       object;
+    CORO_EVENT  event;              /*!< set when the wait set reports the object */
+    uint32_t    pending;            /*!< reports of ITEM objects not consumed yet */
+    bool        flags;
+};
+
+/**
+ * @brief   Return type of a coroutine, hand it to \ref Executor::spawn
+ */
+class Task
+{
+public:
+    struct promise_type
+    {
+        Executor*   exec    =   nullptr;
+        Wait        start;
+
+        static void*    operator new    (size_t size) noexcept;
+        static void     operator delete (void* frame) noexcept;
+
+        static Task     get_return_object_on_allocation_failure (void) noexcept   { return Task(); }
+
+        Task                get_return_object   (void) noexcept
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend     (void) noexcept   { return {}; }
+        std::suspend_never  final_suspend       (void) noexcept   { return {}; }
+        void                return_void         (void) noexcept   {}
+        void                unhandled_exception (void) noexcept   { for(;;) {} }
+
+        ~promise_type   (void);
+    };
+
+    Task    (void) noexcept : handle_(nullptr) {}
+    Task    (Task&& other) noexcept : handle_(other.handle_)  { other.handle_ = nullptr; }
+    ~Task   (void)  { if(handle_) handle_.destroy(); }
+
+    Task&   operator=   (Task&& other) noexcept;
+    Task    (const Task&) = delete;
+    Task&   operator=   (const Task&) = delete;
+
+    /** false when the frame pool was empty */
+    bool    valid   (void) const    { return (bool)handle_; }
+
+private:
+    explicit Task   (std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+    std::coroutine_handle<promise_type> handle_;
+
+    friend class Executor;
+};
+
+/**
+ * @brief   Runs coroutines inside one thread
+ */
+class Executor
+{
+public:
+    osStatus_t  init    (osWaitSetId_t set, osSemaphoreId_t kick);
+    osStatus_t  spawn   (Task&& task);
+    uint32_t    step    (void);
+    void        run     (void);
+
+    /** coroutines spawned and not finished */
+    uint32_t    tasks   (void) const    { return tasks_; }
+    /** resumes since init */
+    uint32_t    resumes (void) const    { return sched_.resumes; }
+    CORO_SCHED* sched   (void)          { return &sched_; }
+
+    Member*     find    (void* object);
+    Member*     add     (void* object, Wait::Kind kind);
+
+    static void thread  (void* argument);
+
+private:
+    void        dispatch    (void* object);
+
+    CORO_SCHED          sched_;
+    osWaitSetId_t       set_;
+    osSemaphoreId_t     kick_;
+    Member              members_[CORO_OS_MEMBERS];
+    uint32_t            count_;
+    volatile uint32_t   tasks_;
+
+    friend struct Task::promise_type;
+};
+
+/**
+ * @brief   Common part of the awaiters, used by co_await
+ */
+template<class Result>
+struct Awaiter : Wait
+{
+    void*   object;
+
+    bool    await_ready     (void) const noexcept   { return false; }
+    bool    await_suspend   (std::coroutine_handle<Task::promise_type> h) noexcept
+    {
+        return suspend(h, h.promise().exec, object);
+    }
+    Result  await_resume    (void) const noexcept   { return (Result)result; }
+};
+
+/** co_await delay(ticks) suspends for ticks ticks, 0 yields, returns osOK */
+struct Delay : Awaiter<osStatus_t>
+{
+    explicit Delay  (uint32_t ticks) noexcept
+    {
+        object  =   nullptr;
+        op      =   nullptr;
+        timeout =   ticks;
+        result  =   osOK;
+        kind    =   RESUME;
+    }
+};
+
+/** co_await get(...) is osMessageQueueGet, returns its status */
+struct MessageGet : Awaiter<osStatus_t>
+{
+    void*       msg;
+    uint8_t*    prio;
+
+    MessageGet  (osMessageQueueId_t mq, void* msg_ptr, uint8_t* msg_prio, uint32_t ticks) noexcept;
+};
+
+/** co_await put(...) is osMessageQueuePut, returns its status */
+struct MessagePut : Awaiter<osStatus_t>
+{
+    const void* msg;
+    uint8_t     prio;
+
+    MessagePut  (osMessageQueueId_t mq, const void* msg_ptr, uint8_t msg_prio, uint32_t ticks) noexcept;
+};
+
+/** co_await acquire(...) is osSemaphoreAcquire, returns its status */
+struct SemaphoreAcquire : Awaiter<osStatus_t>
+{
+    SemaphoreAcquire    (osSemaphoreId_t sem, uint32_t ticks) noexcept;
+};
+
+/** co_await wait_flags(...) is osEventFlagsWait, returns its flags or error */
+struct FlagsWait : Awaiter<uint32_t>
+{
+    uint32_t    mask;
+    uint32_t    options;
+
+    FlagsWait   (osEventFlagsId_t ef, uint32_t flags, uint32_t opt, uint32_t ticks) noexcept;
+};
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+inline Delay            delay       (uint32_t ticks)    { return Delay(ticks); }
+inline Delay            yield       (void)              { return Delay(0); }
+
+inline MessageGet       get         (osMessageQueueId_t mq, void* msg_ptr, uint8_t* msg_prio, uint32_t timeout)
+{
+    return MessageGet(mq, msg_ptr, msg_prio, timeout);
+}
+
+inline MessagePut       put         (osMessageQueueId_t mq, const void* msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+    return MessagePut(mq, msg_ptr, msg_prio, timeout);
+}
+
+inline SemaphoreAcquire acquire     (osSemaphoreId_t sem, uint32_t timeout)
+{
+    return SemaphoreAcquire(sem, timeout);
+}
+
+inline FlagsWait        wait_flags  (osEventFlagsId_t ef, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+    return FlagsWait(ef, flags, options, timeout);
+}
+
+}   /* namespace coro_os */
+
+#endif /* _CORO_OS_HPP_ */
@@ -0,0 +1,226 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        crc_soft.h
+ * @brief       CRC of any width 1 to 32 in software, slicing by 8.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * A \ref CRC_SPEC gives an algorithm in the parameters of the CRC catalogue:
+ * width, polynomial, initial value, input and output reflection and final
+ * XOR. \ref crc_soft_init builds eight tables of 256 entries for it, and
+ * \ref crc_soft_update takes eight bytes per step with them.
+ *
+ * The register is kept in the bit order of the input, reflected and right
+ * aligned for reflected input, left aligned otherwise.
+ * \ref crc_soft_to_plain and \ref crc_soft_from_plain convert it to and from
+ * the plain right aligned order of the CRC unit, so a CRC may go on from a
+ * value the hardware left. \ref crc_soft_bitwise needs no tables, it serves
+ * a few bytes and is the reference the tables are checked against.
+ */
+
+#ifndef _CRC_SOFT_H_
+#define _CRC_SOFT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      CRC algorithm
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            width;          /*!< bits, 1 to 32 */
+    uint32_t            poly;           /*!< without the top bit, not reflected */
+    uint32_t            init;           /*!< not reflected */
+    uint32_t            refin;          /*!< 1 takes the bytes from bit 0 */
+    uint32_t            refout;         /*!< 1 reflects the register before the final XOR */
+    uint32_t            xorout;
+}CRC_SPEC;
+
+/**
+ * @brief      Algorithm with its tables
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    CRC_SPEC            spec;
+    uint32_t            table[8][256];  /*!< 8 KB, table[k] steps a byte k bytes before the end of a block */
+}CRC_SOFT;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/** CRC-32/ISO-HDLC of Ethernet and zip, check 0xCBF43926 */
+extern const CRC_SPEC g_CrcSpec32;
+/** CRC-32/ISCSI, Castagnoli, check 0xE3069283 */
+extern const CRC_SPEC g_CrcSpec32C;
+/** CRC-16/IBM-3740, also known as CCITT-FALSE, check 0x29B1 */
+extern const CRC_SPEC g_CrcSpec16Ccitt;
+/** CRC-16/MODBUS, check 0x4B37 */
+extern const CRC_SPEC g_CrcSpec16Modbus;
+/** CRC-8/SMBUS, check 0xF4 */
+extern const CRC_SPEC g_CrcSpec8;
+/** CRC-7/MMC of SD cards, check 0x75 */
+extern const CRC_SPEC g_CrcSpec7Mmc;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Check an algorithm and build its tables
+ * @param[out]          soft            algorithm and tables
+ * @param[in]           spec            algorithm
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_soft_init    (
+    CRC_SOFT*           soft,
+    const CRC_SPEC*     spec
+);
+
+/**
+ * @brief               Register before the first byte
+ * @param[in]           spec            algorithm
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_start  (
+    const CRC_SPEC*     spec
+);
+
+/**
+ * @brief               Take bytes with the tables
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           reg             register
+ * @param[in]           data            bytes, any alignment
+ * @param[in]           size            bytes
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_update (
+    const CRC_SOFT*     soft,
+    uint32_t            reg,
+    const void*         data,
+    uint32_t            size
+);
+
+/**
+ * @brief               Take bytes a bit at a time
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              register
+ * @note                About 8 times slower than the tables, for a few bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_bitwise    (
+    const CRC_SPEC*     spec,
+    uint32_t            reg,
+    const void*         data,
+    uint32_t            size
+);
+
+/**
+ * @brief               CRC of the register
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @return              CRC
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_final  (
+    const CRC_SPEC*     spec,
+    uint32_t            reg
+);
+
+/**
+ * @brief               Register in the plain order of the CRC unit
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @return              right aligned, not reflected
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_to_plain   (
+    const CRC_SPEC*     spec,
+    uint32_t            reg
+);
+
+/**
+ * @brief               Register from the plain order of the CRC unit
+ * @param[in]           spec            algorithm
+ * @param[in]           plain           right aligned, not reflected
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_from_plain (
+    const CRC_SPEC*     spec,
+    uint32_t            plain
+);
+
+/**
+ * @brief               CRC of a buffer
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              CRC
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_calc   (
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CRC_SOFT_H_ */
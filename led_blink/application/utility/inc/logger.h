@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        logger.h
+ * @brief       log front end on an mpsc ring with a selectable output sink.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Writers copy text into fixed size records of an \ref MPSC_RING and wake
+ * the logger thread, which hands the text to the selected sink. A sink
+ * may hold text back to send it in larger pieces: when it does, the thread
+ * calls its flush again with force set once the latency given to
+ * \ref logger_init has passed without new text. Text longer than a record
+ * takes several records, which may interleave with other writers.
+ */
+
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Records in the ring, power of two */
+#ifndef LOGGER_RECORDS
+#define LOGGER_RECORDS      64U
+#endif
+
+/** Text bytes of a record */
+#ifndef LOGGER_TEXT
+#define LOGGER_TEXT         31U
+#endif
+
+/** Longest line of \ref logger_printf */
+#ifndef LOGGER_LINE
+#define LOGGER_LINE         128U
+#endif
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Output of the log, called from the logger thread only
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const char*         name;
+    uint32_t            (*write)(void* ctx, const uint8_t* data, uint32_t size);    /*!< returns bytes taken */
+    uint32_t            (*flush)(void* ctx, int force);     /*!< returns bytes still held back, may be NULL */
+    void*               ctx;
+}LOGGER_SINK;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the logger thread
+ * @param[in]           priority        logger thread priority
+ * @param[in]           latency         ms a sink may hold text back
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Text is discarded until a sink is selected
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_init  (
+    osPriority_t        priority,
+    uint32_t            latency
+);
+
+/**
+ * @brief               Select the output
+ * @param[in]           sink            sink, NULL to discard the text
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void logger_select   (
+    const LOGGER_SINK*  sink
+);
+
+/**
+ * @brief               Log text
+ * @param[in]           text            text, need not be terminated
+ * @param[in]           size            bytes
+ * @retval              0               success
+ * @retval              -1              the ring was full, text dropped
+ * @note                Thread context or interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_write (
+    const char*         text,
+    uint32_t            size
+);
+
+/**
+ * @brief               Log formatted text
+ * @param[in]           format          printf format
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, up to \ref LOGGER_LINE bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_printf    (
+    const char*         format,
+    ...
+) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief               Records dropped because the ring was full
+ * @return              drop count
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t logger_drops    (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LOGGER_H_ */
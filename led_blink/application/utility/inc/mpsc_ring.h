@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        mpsc_ring.h
+ * @brief       lock-free multi-producer single-consumer ring of fixed size items.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Producers claim a slot with LDREX/STREX, fill it and mark it committed, so
+ * they never mask interrupts and may run at any interrupt priority, including
+ * above SAFE_IT_PRIO. Only one thread may consume. A producer that is
+ * preempted between reserve and commit holds back the consumer at its slot
+ * until it resumes, items are always consumed in reservation order.
+ */
+
+#ifndef _MPSC_RING_H_
+#define _MPSC_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/** Memory needed for a ring of count items of size bytes each */
+#define MPSC_RING_MEM_SIZE(count, size)     ((count) * (sizeof(uint32_t) + (((size) + 3U) & ~3U)))
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Ring control block, the fields are private
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    volatile uint32_t   head;       /*!< next position reserved by the producers */
+    uint32_t            tail;       /*!< next position read by the consumer */
+    volatile uint32_t   drops;      /*!< items refused because the ring was full */
+    uint32_t            mask;       /*!< item count - 1 */
+    uint32_t            item_size;  /*!< item size in bytes */
+    uint32_t            slot_size;  /*!< sequence word plus item rounded up to 4 bytes */
+    uint8_t*            slots;      /*!< slot memory */
+}MPSC_RING;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Initial a ring
+ * @param[out]          ring            ring control block
+ * @param[in]           mem             slot memory of \ref MPSC_RING_MEM_SIZE bytes, 4 bytes aligned
+ * @param[in]           count           number of items, power of two
+ * @param[in]           item_size       item size in bytes
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_init   (
+    MPSC_RING*  ring,
+    void*       mem,
+    uint32_t    count,
+    uint32_t    item_size
+);
+
+/**
+ * @brief               Reserve a slot for writing an item in place
+ * @param[in]           ring            ring control block
+ * @return              item memory, NULL when the ring is full
+ * @note                Any context. Must be followed by \ref mpsc_ring_commit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void* mpsc_ring_reserve  (
+    MPSC_RING*  ring
+);
+
+/**
+ * @brief               Publish an item obtained from \ref mpsc_ring_reserve
+ * @param[in]           item            item memory
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void mpsc_ring_commit    (
+    void*       item
+);
+
+/**
+ * @brief               Copy an item into the ring
+ * @param[in]           ring            ring control block
+ * @param[in]           item            item to copy, item_size bytes
+ * @retval              0               success
+ * @retval              -1              ring full, the item is dropped and counted
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_put    (
+    MPSC_RING*  ring,
+    const void* item
+);
+
+/**
+ * @brief               Take the oldest item out of the ring
+ * @param[in]           ring            ring control block
+ * @param[out]          item            buffer of item_size bytes
+ * @retval              0               success
+ * @retval              -1              ring empty or oldest item not committed yet
+ * @note                Consumer only
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_get    (
+    MPSC_RING*  ring,
+    void*       item
+);
+
+/**
+ * @brief               Number of items dropped because the ring was full
+ * @param[in]           ring            ring control block
+ * @return              drop count
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t mpsc_ring_drops (
+    const MPSC_RING*    ring
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MPSC_RING_H_ */
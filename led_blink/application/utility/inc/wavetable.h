@@ -0,0 +1,217 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        wavetable.h
+ * @brief       sample tables and phase accumulators for the DAC waveform generator.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Integer only, so a table built on the host is bit for bit the table the
+ * target builds. \ref wavetable_fill writes whole periods, the table loops
+ * without a seam. \ref wavetable_fit picks the table length and the timer
+ * period that come closest to a frequency. For frequencies no table length
+ * fits, and for streams whose frequency changes while they play, a
+ * \ref WAVETABLE_NCO steps through one period of a table with a 32 bit
+ * phase and interpolates, keeping the phase across the blocks it fills.
+ */
+
+#ifndef _WAVETABLE_H_
+#define _WAVETABLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define WAVETABLE_FULL_SCALE    4095U       /*!< 12 bit DAC, samples are clamped to it */
+
+/* WAVETABLE_SPEC shape */
+#define WAVETABLE_SINE          0U
+#define WAVETABLE_SQUARE        1U
+#define WAVETABLE_TRIANGLE      2U          /*!< peaks where the sine peaks */
+#define WAVETABLE_SAWTOOTH      3U          /*!< rises from the minimum */
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      Waveform of a table
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            shape;          /*!< \ref WAVETABLE_SINE, ... */
+    uint32_t            cycles;         /*!< periods in the table, at least 1 */
+    uint32_t            amplitude;      /*!< peak, in LSB */
+    uint32_t            offset;         /*!< middle, in LSB */
+    uint32_t            phase;          /*!< of the first sample, 2^32 is one period */
+    uint32_t            duty;           /*!< square high time, 65536 is one period */
+}WAVETABLE_SPEC;
+
+/**
+ * @brief      Table length and timer period for a frequency
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint32_t            size;           /*!< samples of one period */
+    uint32_t            period;         /*!< timer clocks per sample */
+    uint32_t            mhz;            /*!< frequency it gives, mHz */
+}WAVETABLE_FIT;
+
+/**
+ * @brief      Phase accumulator over one period of a table
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    const uint16_t*     table;
+    uint32_t            bits;           /*!< log2 of the table length */
+    uint32_t            phase;
+    uint32_t            step;           /*!< phase per sample, see \ref wavetable_nco_step */
+}WAVETABLE_NCO;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Sine of a phase
+ * @param[in]           phase           2^32 is one period
+ * @return              sine in Q30, -2^30 to 2^30
+ * @note                Error below 1e-7
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int32_t wavetable_sin    (
+    uint32_t            phase
+);
+
+/**
+ * @brief               Write whole periods of a waveform
+ * @param[out]          table           samples
+ * @param[in]           size            samples, at least 2
+ * @param[in]           spec            waveform
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_fill   (
+    uint16_t*               table,
+    uint32_t                size,
+    const WAVETABLE_SPEC*   spec
+);
+
+/**
+ * @brief               Find the table length and timer period closest to a frequency
+ * @param[in]           mhz             frequency, mHz
+ * @param[in]           tim_clk         Hz of the timer clock
+ * @param[in]           rate_max        highest sample rate, Hz
+ * @param[in]           size_min        shortest table
+ * @param[in]           size_max        longest table
+ * @param[out]          fit             the best one, the longest table of those that fit equally well
+ * @retval              0               success
+ * @retval              -1              no table length gives a period of 1 to 65536 clocks
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_fit    (
+    uint32_t            mhz,
+    uint32_t            tim_clk,
+    uint32_t            rate_max,
+    uint32_t            size_min,
+    uint32_t            size_max,
+    WAVETABLE_FIT*      fit
+);
+
+/**
+ * @brief               Phase step of a frequency
+ * @param[in]           mhz             frequency, mHz
+ * @param[in]           tim_clk         Hz of the timer clock
+ * @param[in]           period          timer clocks per sample
+ * @return              step, 0 when the frequency is not below half the sample rate
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t wavetable_nco_step  (
+    uint32_t            mhz,
+    uint32_t            tim_clk,
+    uint32_t            period
+);
+
+/**
+ * @brief               Start a phase accumulator
+ * @param[out]          nco             accumulator
+ * @param[in]           table           one period
+ * @param[in]           size            power of two, 2 to 65536
+ * @param[in]           step            from \ref wavetable_nco_step
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @note                Changing step later changes the frequency with a continuous phase
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_nco_init   (
+    WAVETABLE_NCO*      nco,
+    const uint16_t*     table,
+    uint32_t            size,
+    uint32_t            step
+);
+
+/**
+ * @brief               Write the next samples
+ * @param[in]           nco             accumulator
+ * @param[out]          out             samples
+ * @param[in]           count           samples
+ * @return              None
+ * @note                Interpolates linearly between neighbouring table samples
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wavetable_nco_fill  (
+    WAVETABLE_NCO*      nco,
+    uint16_t*           out,
+    uint32_t            count
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _WAVETABLE_H_ */
@@ -0,0 +1,617 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro.c
+ * @brief       stackless coroutines run by an executor inside one thread.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The ready list, wait lists, events and queues may be touched by signalling
+ * contexts and are changed under the port lock. The timer wheel is only used
+ * by the executor: a coroutine woken by a signal stays in the wheel until the
+ * executor runs it or meets it there, and is unlinked then.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "coro.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define CORO_STATE_IDLE     (0x00U)     /* not started or finished */
+#define CORO_STATE_READY    (0x01U)
+#define CORO_STATE_SLEEP    (0x02U)     /* delayed, in the wheel only */
+#define CORO_STATE_WAIT     (0x03U)     /* on a wait list, and in the wheel unless waiting forever */
+#define CORO_STATE_MASK     (0x7FU)
+#define CORO_IN_WHEEL       (0x80U)
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Append a coroutine to the ready list
+ * @param[in]           sched           executor
+ * @param[in]           co              coroutine
+ * @return              None
+ * @note                Port lock held
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_ready  (
+    CORO_SCHED* sched,
+    CORO*       co  )
+{
+    co->state   =   (uint8_t)((co->state & CORO_IN_WHEEL) | CORO_STATE_READY);
+    co->next    =   NULL;
+    if(sched->ready_tail)
+    {
+        sched->ready_tail->next =   co;
+    }
+    else
+    {
+        sched->ready_head       =   co;
+    }
+    sched->ready_tail   =   co;
+    sched->ready_count++;
+}
+
+/** 
+ * @brief               Remove a coroutine from a singly linked list
+ * @param[in]           list            list head
+ * @param[in]           co              coroutine
+ * @param[in]           wheel           nonzero for a wheel slot, linked by tnext
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_unlink (
+    CORO**      list,
+    CORO*       co,
+    int         wheel   )
+{
+    CORO**  link    =   list;
+
+    while( (*link) && (*link != co) )
+    {
+        link    =   (wheel)?(&(*link)->tnext):(&(*link)->next);
+    }
+    if(*link)
+    {
+        *link   =   (wheel)?(co->tnext):(co->next);
+    }
+}
+
+/** 
+ * @brief               Put a coroutine in the timer wheel
+ * @param[in]           co              coroutine
+ * @param[in]           ticks           ticks from now, at least 1
+ * @return              None
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_wheel_insert   (
+    CORO*       co,
+    uint32_t    ticks   )
+{
+    CORO_SCHED* sched   =   co->sched;
+    CORO**      slot;
+
+    co->wake    =   sched->now + ticks;
+    slot        =   &sched->wheel[co->wake & (CORO_WHEEL_SIZE - 1U)];
+    co->tnext   =   *slot;
+    *slot       =   co;
+    co->state   |=  CORO_IN_WHEEL;
+    sched->timed++;
+}
+
+/** 
+ * @brief               Take a coroutine out of the timer wheel
+ * @param[in]           co              coroutine in the wheel
+ * @return              None
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_wheel_remove   (
+    CORO*       co  )
+{
+    CORO_SCHED* sched   =   co->sched;
+    uint32_t    key;
+
+    coro_unlink(&sched->wheel[co->wake & (CORO_WHEEL_SIZE - 1U)], co, 1);
+    key         =   coro_port_lock();
+    co->state   &=  (uint8_t)~CORO_IN_WHEEL;
+    coro_port_unlock(key);
+    sched->timed--;
+}
+
+/** 
+ * @brief               Advance the timer wheel and make expired coroutines ready
+ * @param[in]           sched           executor
+ * @param[in]           now             current tick
+ * @return              None
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_wheel_advance  (
+    CORO_SCHED* sched,
+    uint32_t    now )
+{
+    uint32_t    slots   =   now - sched->now;
+    uint32_t    tick    =   sched->now;
+    uint32_t    key;
+    CORO*       co;
+    CORO*       next;
+
+    if(slots > CORO_WHEEL_SIZE)
+    {
+        /* a full turn visits every slot */
+        slots   =   CORO_WHEEL_SIZE;
+    }
+    sched->now  =   now;
+    while( (slots--) && (sched->timed) )
+    {
+        tick++;
+        for(co = sched->wheel[tick & (CORO_WHEEL_SIZE - 1U)]; co; co = next)
+        {
+            next    =   co->tnext;
+            if( (0 < (int32_t)(co->wake - now)) && (CORO_STATE_READY != (co->state & CORO_STATE_MASK)) )
+            {
+                /* due in a later turn */
+                continue;
+            }
+            coro_wheel_remove(co);
+            key =   coro_port_lock();
+            if(CORO_STATE_WAIT == (co->state & CORO_STATE_MASK))
+            {
+                coro_unlink(co->wait, co, 0);
+                co->result  =   CORO_TIMEOUT;
+                coro_ready(sched, co);
+            }
+            else if(CORO_STATE_SLEEP == (co->state & CORO_STATE_MASK))
+            {
+                coro_ready(sched, co);
+            }
+            else
+            {
+                /* signalled already, only had to leave the wheel */
+            }
+            coro_port_unlock(key);
+        }
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Initial an executor
+ * @param[out]          sched           executor
+ * @param[in]           now             current tick
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_sched_init (
+    CORO_SCHED* sched,
+    uint32_t    now )
+{
+    memset(sched, 0, sizeof(CORO_SCHED));
+    sched->now  =   now;
+}
+
+/**
+ * @brief               Start a coroutine, it runs at the next \ref coro_sched_run
+ * @param[in]           sched           executor
+ * @param[out]          co              coroutine, first member of the caller's state
+ * @param[in]           func            coroutine function
+ * @return              None
+ * @note                Any context. co must not be running already
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_start  (
+    CORO_SCHED* sched,
+    CORO*       co,
+    CORO_FUNC   func    )
+{
+    uint32_t    key;
+
+    co->sched   =   sched;
+    co->func    =   func;
+    co->wait    =   NULL;
+    co->line    =   0;
+    co->result  =   CORO_OK;
+    co->mask    =   0;
+    co->state   =   CORO_STATE_IDLE;
+    key =   coro_port_lock();
+    coro_ready(sched, co);
+    coro_port_unlock(key);
+    coro_port_notify(sched);
+}
+
+/**
+ * @brief               Expire timeouts and run the coroutines that are ready
+ * @param[in]           sched           executor
+ * @param[in]           now             current tick
+ * @return              ticks until it should be called again at the latest, 0 to call it
+ *                      again straight away, \ref CORO_FOREVER when nothing is timed
+ * @note                Executor thread. Every coroutine ready on entry runs once
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_sched_run  (
+    CORO_SCHED* sched,
+    uint32_t    now )
+{
+    uint32_t    budget;
+    uint32_t    key;
+    uint32_t    ret;
+    CORO*       co;
+
+    if(now != sched->now)
+    {
+        coro_wheel_advance(sched, now);
+    }
+
+    /* coroutines readied while this pass runs wait for the next one, so a
+       coroutine that keeps yielding can not hold off the timer wheel */
+    key     =   coro_port_lock();
+    budget  =   sched->ready_count;
+    coro_port_unlock(key);
+
+    while(budget--)
+    {
+        key =   coro_port_lock();
+        co  =   sched->ready_head;
+        sched->ready_head   =   co->next;
+        if(!sched->ready_head)
+        {
+            sched->ready_tail   =   NULL;
+        }
+        sched->ready_count--;
+        coro_port_unlock(key);
+
+        if(co->state & CORO_IN_WHEEL)
+        {
+            /* woken by a signal before its timeout */
+            coro_wheel_remove(co);
+        }
+        sched->resumes++;
+        switch(co->func(co))
+        {
+            case CORO_RET_YIELD:
+                key =   coro_port_lock();
+                coro_ready(sched, co);
+                coro_port_unlock(key);
+                break;
+            case CORO_RET_DONE:
+                co->state   =   CORO_STATE_IDLE;
+                break;
+            default:
+                /* coro_sleep or coro_wait_on queued it already */
+                break;
+        }
+    }
+
+    key =   coro_port_lock();
+    if(sched->ready_count)
+    {
+        ret =   0;
+    }
+    else if(sched->timed)
+    {
+        /* the wheel does not know the nearest expiry, look again next tick */
+        ret =   1;
+    }
+    else
+    {
+        ret =   CORO_FOREVER;
+    }
+    coro_port_unlock(key);
+
+    return ret;
+}
+
+/**
+ * @brief               Suspend the running coroutine for some ticks, used by \ref CORO_DELAY
+ * @param[in]           co              running coroutine
+ * @param[in]           ticks           ticks to sleep, 0 yields
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_sleep  (
+    CORO*       co,
+    uint32_t    ticks   )
+{
+    uint32_t    key;
+
+    if(!ticks)
+    {
+        key =   coro_port_lock();
+        coro_ready(co->sched, co);
+        coro_port_unlock(key);
+    }
+    else
+    {
+        co->state   =   CORO_STATE_SLEEP;
+        coro_wheel_insert(co, ticks);
+    }
+}
+
+/**
+ * @brief               Queue the running coroutine on a wait list, used by the await macros
+ * @param[in]           co              running coroutine
+ * @param[in]           list            wait list of the event or queue
+ * @param[in]           cond            flags of the event or used count of the queue
+ * @param[in]           mask            bits of cond waited for
+ * @param[in]           timeout         ticks, \ref CORO_FOREVER for none
+ * @return              None
+ * @note                cond is looked at again under the lock that queues the coroutine, a
+ *                      signal that came after the check of the macro makes it ready at once
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_wait_on    (
+    CORO*                   co,
+    CORO**                  list,
+    const volatile uint32_t* cond,
+    uint32_t                mask,
+    uint32_t                timeout )
+{
+    CORO**      link;
+    uint32_t    key;
+
+    co->wait    =   list;
+    co->mask    =   mask;
+    co->result  =   CORO_OK;
+    if(CORO_FOREVER != timeout)
+    {
+        /* in the wheel before it can be signalled, so the executor always
+           finds it there */
+        coro_wheel_insert(co, timeout);
+    }
+    key =   coro_port_lock();
+    if(*cond & mask)
+    {
+        /* signalled since the caller looked, nobody would wake it from the list */
+        coro_ready(co->sched, co);
+        coro_port_unlock(key);
+        return;
+    }
+    co->state   =   (uint8_t)((co->state & CORO_IN_WHEEL) | CORO_STATE_WAIT);
+    co->next    =   NULL;
+    /* first come first served for queue items */
+    for(link = list; *link; link = &(*link)->next)
+    {
+    }
+    *link       =   co;
+    coro_port_unlock(key);
+}
+
+/**
+ * @brief               Initial an event
+ * @param[out]          ev              event
+ * @param[in]           sched           executor of the coroutines that wait on it
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_event_init (
+    CORO_EVENT* ev,
+    CORO_SCHED* sched   )
+{
+    ev->sched   =   sched;
+    ev->waiters =   NULL;
+    ev->flags   =   0;
+}
+
+/**
+ * @brief               Set event bits and wake the coroutines waiting for them
+ * @param[in]           ev              event
+ * @param[in]           bits            bits to set
+ * @return              None
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_event_set  (
+    CORO_EVENT* ev,
+    uint32_t    bits    )
+{
+    CORO**      link;
+    CORO*       co;
+    int         woken   =   0;
+    uint32_t    key;
+
+    key         =   coro_port_lock();
+    ev->flags   |=  bits;
+    link        =   &ev->waiters;
+    while(*link)
+    {
+        co  =   *link;
+        if(co->mask & ev->flags)
+        {
+            /* every waiter that matches runs, the first to take the bits wins */
+            *link   =   co->next;
+            coro_ready(ev->sched, co);
+            woken   =   1;
+        }
+        else
+        {
+            link    =   &co->next;
+        }
+    }
+    coro_port_unlock(key);
+    if(woken)
+    {
+        coro_port_notify(ev->sched);
+    }
+}
+
+/**
+ * @brief               Clear and return the set bits of mask
+ * @param[in]           ev              event
+ * @param[in]           mask            bits to take
+ * @return              bits taken, 0 if none was set
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_event_take (
+    CORO_EVENT* ev,
+    uint32_t    mask    )
+{
+    uint32_t    key;
+    uint32_t    ret;
+
+    key         =   coro_port_lock();
+    ret         =   ev->flags & mask;
+    ev->flags   &=  ~ret;
+    coro_port_unlock(key);
+
+    return ret;
+}
+
+/**
+ * @brief               Initial a queue
+ * @param[out]          q               queue
+ * @param[in]           sched           executor of the coroutines that receive from it
+ * @param[in]           mem             item memory of count * item_size bytes
+ * @param[in]           count           number of items
+ * @param[in]           item_size       item size in bytes
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_init  (
+    CORO_QUEUE* q,
+    CORO_SCHED* sched,
+    void*       mem,
+    uint32_t    count,
+    uint32_t    item_size   )
+{
+    if( (!q) || (!sched) || (!mem) || (!count) || (!item_size) )
+    {
+        return (-1);
+    }
+    q->sched        =   sched;
+    q->waiters      =   NULL;
+    q->buf          =   (uint8_t*)mem;
+    q->item_size    =   item_size;
+    q->count        =   count;
+    q->head         =   0;
+    q->used         =   0;
+    return (0);
+}
+
+/**
+ * @brief               Copy an item into a queue and wake the first waiting coroutine
+ * @param[in]           q               queue
+ * @param[in]           item            item to copy, item_size bytes
+ * @retval              0               success
+ * @retval              -1              queue full
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_put   (
+    CORO_QUEUE* q,
+    const void* item    )
+{
+    CORO*       co      =   NULL;
+    uint32_t    key;
+    uint32_t    pos;
+
+    key =   coro_port_lock();
+    if(q->used >= q->count)
+    {
+        coro_port_unlock(key);
+        return (-1);
+    }
+    pos =   q->head + q->used;
+    if(pos >= q->count)
+    {
+        pos -=  q->count;
+    }
+    memcpy(q->buf + (pos * q->item_size), item, q->item_size);
+    q->used++;
+    if(q->waiters)
+    {
+        co          =   q->waiters;
+        q->waiters  =   co->next;
+        coro_ready(q->sched, co);
+    }
+    coro_port_unlock(key);
+    if(co)
+    {
+        coro_port_notify(q->sched);
+    }
+    return (0);
+}
+
+/**
+ * @brief               Take the oldest item out of a queue without waiting
+ * @param[in]           q               queue
+ * @param[out]          item            buffer of item_size bytes
+ * @retval              0               success
+ * @retval              -1              queue empty
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int coro_queue_get   (
+    CORO_QUEUE* q,
+    void*       item    )
+{
+    uint32_t    key;
+
+    key =   coro_port_lock();
+    if(!q->used)
+    {
+        coro_port_unlock(key);
+        return (-1);
+    }
+    memcpy(item, q->buf + (q->head * q->item_size), q->item_size);
+    q->head++;
+    if(q->head >= q->count)
+    {
+        q->head =   0;
+    }
+    q->used--;
+    coro_port_unlock(key);
+    return (0);
+}
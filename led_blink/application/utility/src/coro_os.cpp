@@ -0,0 +1,705 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro_os.cpp
+ * @brief       C++20 coroutines awaiting CMSIS RTOS objects, resumed by one executor thread.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Every report the wait set gives for a message queue or semaphore stands
+ * for one message or token: it is counted in the member and a coroutine only
+ * reads the object against such a count, so the set never holds more reports
+ * than it was sized for. Event flags are read whenever a coroutine waits,
+ * which also re-arms their report.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "coro_os.hpp"
+
+namespace coro_os
+{
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+FramePool*  FramePool::installed_   =   nullptr;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Result of a wait that ran out of time
+ * @param[in]           wait            waiting coroutine
+ * @param[in]           expired         true: timeout passed, false: timeout of 0
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void coro_os_fail    (
+    Wait*       wait,
+    bool        expired )
+{
+    if(Wait::FLAGS == wait->kind)
+    {
+        wait->result    =   (expired)?osFlagsErrorTimeout:osFlagsErrorResource;
+    }
+    else
+    {
+        wait->result    =   (uint32_t)((expired)?osErrorTimeout:osErrorResource);
+    }
+}
+
+/** 
+ * @brief               Ticks left until the deadline of a wait
+ * @param[in]           wait            waiting coroutine
+ * @return              ticks, 0 once passed, \ref osWaitForever without timeout
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t coro_os_left    (
+    Wait*       wait    )
+{
+    int32_t     left;
+
+    if(osWaitForever == wait->timeout)
+    {
+        return osWaitForever;
+    }
+    left    =   (int32_t)(wait->deadline - wait->co.sched->now);
+
+    return (0 < left)?(uint32_t)left:0U;
+}
+
+/** 
+ * @brief               CORO function of every awaiter, finishes the wait and resumes the coroutine
+ * @param[in]           co              first member of a \ref Wait
+ * @return              CORO_RET_WAIT, the awaiter or the next one queued itself already
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int coro_os_resume   (
+    CORO*       co  )
+{
+    Wait*       wait    =   reinterpret_cast<Wait*>(co);
+    uint32_t    left;
+
+    switch(wait->kind)
+    {
+        case Wait::ITEM:
+        case Wait::FLAGS:
+            if(CORO_TIMEOUT == co->result)
+            {
+                coro_os_fail(wait, true);
+                break;
+            }
+            if(Wait::FLAGS == wait->kind)
+            {
+                if(wait->op(wait))
+                {
+                    break;
+                }
+            }
+            else if(wait->member->pending)
+            {
+                /* another coroutine may have been woken by the same report */
+                wait->member->pending--;
+                if(wait->op(wait))
+                {
+                    break;
+                }
+            }
+            left    =   coro_os_left(wait);
+            if(!left)
+            {
+                coro_os_fail(wait, true);
+                break;
+            }
+            coro_wait_on(co, &wait->member->event.waiters, &wait->member->event.flags, 1U, left);
+            return CORO_RET_WAIT;
+        case Wait::POLL:
+            if(wait->op(wait))
+            {
+                break;
+            }
+            if(!coro_os_left(wait))
+            {
+                coro_os_fail(wait, true);
+                break;
+            }
+            coro_sleep(co, 1U);
+            return CORO_RET_WAIT;
+        default:
+            break;
+    }
+    /* the frame, this Wait included, may be gone when resume returns */
+    wait->handle.resume();
+
+    return CORO_RET_WAIT;
+}
+
+/** 
+ * @brief               Operations of the awaiters, the CMSIS call with a timeout of 0
+ * @param[in]           wait            awaiter
+ * @return              true when done, the status or flags are in result either way
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static bool coro_os_get (
+    Wait*       wait    )
+{
+    MessageGet* aw  =   static_cast<MessageGet*>(wait);
+    osStatus_t  ret =   osMessageQueueGet((osMessageQueueId_t)aw->object, aw->msg, aw->prio, 0U);
+
+    aw->result  =   (uint32_t)ret;
+    return (osOK == ret);
+}
+
+static bool coro_os_put (
+    Wait*       wait    )
+{
+    MessagePut* aw  =   static_cast<MessagePut*>(wait);
+    osStatus_t  ret =   osMessageQueuePut((osMessageQueueId_t)aw->object, aw->msg, aw->prio, 0U);
+
+    aw->result  =   (uint32_t)ret;
+    return (osOK == ret);
+}
+
+static bool coro_os_acquire (
+    Wait*       wait    )
+{
+    SemaphoreAcquire*   aw  =   static_cast<SemaphoreAcquire*>(wait);
+    osStatus_t          ret =   osSemaphoreAcquire((osSemaphoreId_t)aw->object, 0U);
+
+    aw->result  =   (uint32_t)ret;
+    return (osOK == ret);
+}
+
+static bool coro_os_flags   (
+    Wait*       wait    )
+{
+    FlagsWait*  aw  =   static_cast<FlagsWait*>(wait);
+    uint32_t    ret =   osEventFlagsWait((osEventFlagsId_t)aw->object, aw->mask, aw->options, 0U);
+
+    aw->result  =   ret;
+    return (0U == (ret & osFlagsError));
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Initial a frame pool
+ * @param[in]           mem             count blocks of block bytes, 8 byte aligned
+ * @param[in]           block           block size, a multiple of 8
+ * @param[in]           count           number of blocks
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+FramePool::FramePool    (
+    void*       mem,
+    size_t      block,
+    size_t      count   )
+    :   free_(nullptr), block_(block), used_(0), peak_(0), largest_(0)
+{
+    unsigned char*  p   =   static_cast<unsigned char*>(mem);
+    Block*          b;
+
+    while(count--)
+    {
+        b       =   reinterpret_cast<Block*>(p + count * block);
+        b->next =   free_;
+        free_   =   b;
+    }
+}
+
+/**
+ * @brief               Take a block for a frame
+ * @param[in]           size            frame size
+ * @return              block, nullptr when the pool is empty or size is larger than a block
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void* FramePool::alloc  (
+    size_t      size    )
+{
+    Block*      b       =   nullptr;
+    uint32_t    key     =   coro_port_lock();
+
+    if(size > largest_)
+    {
+        largest_    =   size;
+    }
+    if( (size <= block_) && (free_) )
+    {
+        b       =   free_;
+        free_   =   b->next;
+        if(++used_ > peak_)
+        {
+            peak_   =   used_;
+        }
+    }
+    coro_port_unlock(key);
+
+    return b;
+}
+
+/**
+ * @brief               Give a frame back
+ * @param[in]           frame           block from \ref alloc
+ * @return              None
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void FramePool::free    (
+    void*       frame   )
+{
+    Block*      b   =   static_cast<Block*>(frame);
+    uint32_t    key;
+
+    if(b)
+    {
+        key     =   coro_port_lock();
+        b->next =   free_;
+        free_   =   b;
+        used_--;
+        coro_port_unlock(key);
+    }
+}
+
+/**
+ * @brief               Make this the pool every Task frame comes from
+ * @return              None
+ * @note                Before the first coroutine is created
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void FramePool::install (void)
+{
+    installed_  =   this;
+}
+
+void* Task::promise_type::operator new  (
+    size_t      size    ) noexcept
+{
+    FramePool*  pool    =   FramePool::installed();
+
+    return (pool)?pool->alloc(size):nullptr;
+}
+
+void Task::promise_type::operator delete    (
+    void*       frame   ) noexcept
+{
+    FramePool::installed()->free(frame);
+}
+
+Task::promise_type::~promise_type   (void)
+{
+    uint32_t    key;
+
+    if(exec)
+    {
+        key =   coro_port_lock();
+        exec->tasks_    =   exec->tasks_ - 1U;
+        coro_port_unlock(key);
+    }
+}
+
+Task& Task::operator=   (
+    Task&&      other   ) noexcept
+{
+    if(this != &other)
+    {
+        if(handle_)
+        {
+            handle_.destroy();
+        }
+        handle_         =   other.handle_;
+        other.handle_   =   nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @brief               Start a wait of the running coroutine, from await_suspend
+ * @param[in]           h               coroutine
+ * @param[in]           exec            its executor
+ * @param[in]           object          object waited for, nullptr for a delay
+ * @return              true: suspended, false: done already, result holds the outcome
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+bool Wait::suspend  (
+    std::coroutine_handle<> h,
+    Executor*               exec,
+    void*                   object  )
+{
+    memset(&co, 0, sizeof(co));
+    co.sched    =   exec->sched();
+    co.func     =   coro_os_resume;
+    handle      =   h;
+    member      =   nullptr;
+    deadline    =   co.sched->now + timeout;
+
+    switch(kind)
+    {
+        case RESUME:
+            coro_sleep(&co, timeout);
+            return true;
+        case POLL:
+            if( (op(this)) || (!timeout) )
+            {
+                return false;
+            }
+            coro_sleep(&co, 1U);
+            return true;
+        default:
+            break;
+    }
+
+    member  =   exec->find(object);
+    if(!member)
+    {
+        /* not in the set, the object can be read directly */
+        if(op(this))
+        {
+            return false;
+        }
+        member  =   exec->add(object, kind);
+        if(!member)
+        {
+            /* a message came in meanwhile, or the set is full */
+            if(!op(this))
+            {
+                coro_os_fail(this, false);
+            }
+            return false;
+        }
+    }
+    else if(FLAGS == kind)
+    {
+        if(op(this))
+        {
+            return false;
+        }
+    }
+    else if(member->pending)
+    {
+        member->pending--;
+        if(op(this))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        coro_os_fail(this, false);
+    }
+
+    if(!timeout)
+    {
+        return false;
+    }
+    coro_wait_on(&co, &member->event.waiters, &member->event.flags, 1U, timeout);
+
+    return true;
+}
+
+MessageGet::MessageGet  (
+    osMessageQueueId_t  mq,
+    void*               msg_ptr,
+    uint8_t*            msg_prio,
+    uint32_t            ticks   ) noexcept
+{
+    object  =   mq;
+    msg     =   msg_ptr;
+    prio    =   msg_prio;
+    op      =   coro_os_get;
+    timeout =   ticks;
+    kind    =   ITEM;
+}
+
+MessagePut::MessagePut  (
+    osMessageQueueId_t  mq,
+    const void*         msg_ptr,
+    uint8_t             msg_prio,
+    uint32_t            ticks   ) noexcept
+{
+    object  =   mq;
+    msg     =   msg_ptr;
+    prio    =   msg_prio;
+    op      =   coro_os_put;
+    timeout =   ticks;
+    kind    =   POLL;
+}
+
+SemaphoreAcquire::SemaphoreAcquire  (
+    osSemaphoreId_t     sem,
+    uint32_t            ticks   ) noexcept
+{
+    object  =   sem;
+    op      =   coro_os_acquire;
+    timeout =   ticks;
+    kind    =   ITEM;
+}
+
+FlagsWait::FlagsWait    (
+    osEventFlagsId_t    ef,
+    uint32_t            flags,
+    uint32_t            opt,
+    uint32_t            ticks   ) noexcept
+{
+    object  =   ef;
+    mask    =   flags;
+    options =   opt;
+    op      =   coro_os_flags;
+    timeout =   ticks;
+    kind    =   FLAGS;
+}
+
+/**
+ * @brief               Initial an executor
+ * @param[in]           set             wait set of the executor, see the sizing in coro_os.hpp
+ * @param[in]           kick            binary semaphore without token, joins the set
+ * @retval              osOK
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     kick has a token or is in a set already
+ * @note                Before the executor thread runs
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+osStatus_t Executor::init   (
+    osWaitSetId_t       set,
+    osSemaphoreId_t     kick    )
+{
+    if( (!set) || (!kick) )
+    {
+        return osErrorParameter;
+    }
+    coro_sched_init(&sched_, osKernelGetTickCount());
+    /* woken through kick, the thread flag of coro_port.c is not used */
+    sched_.port =   nullptr;
+    set_        =   set;
+    kick_       =   kick;
+    count_      =   0;
+    tasks_      =   0;
+
+    return osWaitSetAdd(set_, kick_);
+}
+
+/**
+ * @brief               Hand a coroutine to the executor, it starts at the next pass
+ * @param[in]           task            coroutine just created
+ * @retval              osOK
+ * @retval              osErrorNoMemory     the frame pool had no block for it
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+osStatus_t Executor::spawn  (
+    Task&&      task    )
+{
+    std::coroutine_handle<Task::promise_type>   h   =   task.handle_;
+    uint32_t                                    key;
+
+    if(!h)
+    {
+        return osErrorNoMemory;
+    }
+    task.handle_        =   nullptr;
+    h.promise().exec    =   this;
+    key                 =   coro_port_lock();
+    tasks_  =   tasks_ + 1U;
+    coro_port_unlock(key);
+
+    memset(&h.promise().start.co, 0, sizeof(CORO));
+    h.promise().start.handle    =   h;
+    h.promise().start.kind      =   Wait::RESUME;
+    coro_start(&sched_, &h.promise().start.co, coro_os_resume);
+    /* already signalled if it fails */
+    (void)osSemaphoreRelease(kick_);
+
+    return osOK;
+}
+
+/**
+ * @brief               Take the reports of the wait set and run one pass of the coroutines
+ * @return              ticks until the next pass at the latest, 0: straight away,
+ *                      \ref osWaitForever: when the wait set reports something
+ * @note                Executor thread
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+uint32_t Executor::step (void)
+{
+    void*   object;
+
+    while(osOK == osWaitSetWait(set_, &object, 0U))
+    {
+        dispatch(object);
+    }
+
+    return coro_sched_run(&sched_, osKernelGetTickCount());
+}
+
+/**
+ * @brief               Body of the executor thread
+ * @return              None, never returns
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void Executor::run  (void)
+{
+    void*       object;
+    uint32_t    wait;
+
+    for(;;)
+    {
+        wait    =   step();
+        if( (wait) && (osOK == osWaitSetWait(set_, &object, wait)) )
+        {
+            dispatch(object);
+        }
+    }
+}
+
+/**
+ * @brief               Thread function for osThreadNew
+ * @param[in]           argument        Executor, initialised
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void Executor::thread   (
+    void*       argument    )
+{
+    static_cast<Executor*>(argument)->run();
+}
+
+/**
+ * @brief               Member of the wait set for an object
+ * @param[in]           object          queue, semaphore or event flags
+ * @return              member, nullptr if the object did not join
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+Member* Executor::find  (
+    void*       object  )
+{
+    uint32_t    i;
+
+    for(i = 0; i < count_; i++)
+    {
+        if(object == members_[i].object)
+        {
+            return &members_[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief               Make an object join the wait set
+ * @param[in]           object          queue or semaphore without messages or tokens, or event flags
+ * @param[in]           kind            Wait::ITEM or Wait::FLAGS
+ * @return              member, nullptr if the table or the set refused it
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+Member* Executor::add   (
+    void*       object,
+    Wait::Kind  kind    )
+{
+    Member*     m;
+    osStatus_t  ret;
+
+    if(CORO_OS_MEMBERS <= count_)
+    {
+        return nullptr;
+    }
+    if(Wait::FLAGS == kind)
+    {
+        ret =   osWaitSetAddEventFlags(set_, (osEventFlagsId_t)object, CORO_OS_FLAGS_MASK);
+    }
+    else
+    {
+        ret =   osWaitSetAdd(set_, object);
+    }
+    if(osOK != ret)
+    {
+        return nullptr;
+    }
+    m           =   &members_[count_++];
+    m->object   =   object;
+    m->pending  =   0;
+    m->flags    =   (Wait::FLAGS == kind);
+    coro_event_init(&m->event, &sched_);
+
+    return m;
+}
+
+/**
+ * @brief               Handle one report of the wait set
+ * @param[in]           object          object reported
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+void Executor::dispatch (
+    void*       object  )
+{
+    Member*     m;
+
+    if(object == kick_)
+    {
+        (void)osSemaphoreAcquire(kick_, 0U);
+        return;
+    }
+    m   =   find(object);
+    if(!m)
+    {
+        return;
+    }
+    if(!m->flags)
+    {
+        m->pending++;
+    }
+    /* every waiter runs, those that find nothing wait again */
+    coro_event_set(&m->event, 1U);
+    (void)coro_event_take(&m->event, 1U);
+}
+
+}   /* namespace coro_os */
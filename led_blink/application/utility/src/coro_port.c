@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        coro_port.c
+ * @brief       CMSIS RTOS port of the coroutine executor.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The executor runs in one thread that sleeps on a thread flag between
+ * passes, ticks are kernel ticks. The lock masks all interrupts for the few
+ * instructions of a list update, so events and queues can be signalled from
+ * any interrupt that may call \ref osThreadFlagsSet.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include "stm32l4xx.h"
+#include "cmsis_os2.h"
+#include "coro.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+/* Thread flag that wakes the executor thread */
+#define CORO_THREAD_FLAG    (0x00000001U)
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Enter the section that guards ready lists, wait lists, events and queues
+ * @return              key for \ref coro_port_unlock
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t coro_port_lock  (void)
+{
+    uint32_t    key =   __get_PRIMASK();
+
+    __disable_irq();
+    return key;
+}
+
+/**
+ * @brief               Leave the section entered by \ref coro_port_lock
+ * @param[in]           key             value returned by \ref coro_port_lock
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_port_unlock    (
+    uint32_t    key )
+{
+    __set_PRIMASK(key);
+}
+
+/**
+ * @brief               Make the executor call \ref coro_sched_run soon, a coroutine became ready
+ * @param[in]           sched           executor
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_port_notify    (
+    CORO_SCHED* sched   )
+{
+    osThreadId_t    thread  =   (osThreadId_t)sched->port;
+
+    /* the executor itself needs no wakeup, nor does one not started yet */
+    if( (thread) && (thread != osThreadGetId()) )
+    {
+        (void)osThreadFlagsSet(thread, CORO_THREAD_FLAG);
+    }
+}
+
+/**
+ * @brief               Executor thread of the CMSIS RTOS port, runs sched until the end
+ * @param[in]           argument        CORO_SCHED* initialised with \ref coro_sched_init
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void coro_thread (
+    void*       argument    )
+{
+    CORO_SCHED* sched   =   (CORO_SCHED*)argument;
+    uint32_t    wait;
+
+    sched->port =   (void*)osThreadGetId();
+    for(;;)
+    {
+        wait    =   coro_sched_run(sched, osKernelGetTickCount());
+        if(wait)
+        {
+            (void)osThreadFlagsWait(CORO_THREAD_FLAG, osFlagsWaitAny,
+                                    (CORO_FOREVER == wait)?osWaitForever:wait);
+        }
+    }
+}
@@ -0,0 +1,389 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        crc_soft.c
+ * @brief       CRC of any width 1 to 32 in software, slicing by 8.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stddef.h>
+
+#include "crc_soft.h"
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+const CRC_SPEC g_CrcSpec32 =
+{
+    32U,                            /*!< width */
+    0x04C11DB7U,                    /*!< poly */
+    0xFFFFFFFFU,                    /*!< init */
+    1U,                             /*!< refin */
+    1U,                             /*!< refout */
+    0xFFFFFFFFU                     /*!< xorout */
+};
+
+const CRC_SPEC g_CrcSpec32C =
+{
+    32U,                            /*!< width */
+    0x1EDC6F41U,                    /*!< poly */
+    0xFFFFFFFFU,                    /*!< init */
+    1U,                             /*!< refin */
+    1U,                             /*!< refout */
+    0xFFFFFFFFU                     /*!< xorout */
+};
+
+const CRC_SPEC g_CrcSpec16Ccitt =
+{
+    16U,                            /*!< width */
+    0x1021U,                        /*!< poly */
+    0xFFFFU,                        /*!< init */
+    0,                              /*!< refin */
+    0,                              /*!< refout */
+    0                               /*!< xorout */
+};
+
+const CRC_SPEC g_CrcSpec16Modbus =
+{
+    16U,                            /*!< width */
+    0x8005U,                        /*!< poly */
+    0xFFFFU,                        /*!< init */
+    1U,                             /*!< refin */
+    1U,                             /*!< refout */
+    0                               /*!< xorout */
+};
+
+const CRC_SPEC g_CrcSpec8 =
+{
+    8U,                             /*!< width */
+    0x07U,                          /*!< poly */
+    0,                              /*!< init */
+    0,                              /*!< refin */
+    0,                              /*!< refout */
+    0                               /*!< xorout */
+};
+
+const CRC_SPEC g_CrcSpec7Mmc =
+{
+    7U,                             /*!< width */
+    0x09U,                          /*!< poly */
+    0,                              /*!< init */
+    0,                              /*!< refin */
+    0,                              /*!< refout */
+    0                               /*!< xorout */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Mask of the register bits
+ * @param[in]           width           1 to 32
+ * @return              mask
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t crc_soft_mask   (
+    uint32_t            width   )
+{
+    return (width >= 32U) ? 0xFFFFFFFFU : ((1U << width) - 1U);
+}
+
+/** 
+ * @brief               Reverse the order of the low bits
+ * @param[in]           value           bits
+ * @param[in]           width           bits reversed, 1 to 32
+ * @return              reversed, right aligned
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t crc_soft_reflect    (
+    uint32_t            value,
+    uint32_t            width   )
+{
+    uint32_t    out =   0;
+    uint32_t    i;
+
+    for(i = 0; i < width; i++)
+    {
+        out     =   (out << 1) | (value & 1U);
+        value   >>= 1;
+    }
+    return out;
+}
+
+/** 
+ * @brief               Take a byte a bit at a time
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @param[in]           byte            input
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static uint32_t crc_soft_byte   (
+    const CRC_SPEC*     spec,
+    uint32_t            reg,
+    uint8_t             byte    )
+{
+    uint32_t    poly    =   0;
+    uint32_t    i;
+
+    if(spec->refin)
+    {
+        /* input bits above the register shift down into it */
+        poly    =   crc_soft_reflect(spec->poly, spec->width);
+        reg     ^=  byte;
+        for(i = 0; i < 8U; i++)
+        {
+            reg =   (reg & 1U) ? ((reg >> 1) ^ poly) : (reg >> 1);
+        }
+    }
+    else
+    {
+        poly    =   spec->poly << (32U - spec->width);
+        reg     ^=  (uint32_t)byte << 24;
+        for(i = 0; i < 8U; i++)
+        {
+            reg =   (reg & 0x80000000U) ? ((reg << 1) ^ poly) : (reg << 1);
+        }
+    }
+    return reg;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Check an algorithm and build its tables
+ * @param[out]          soft            algorithm and tables
+ * @param[in]           spec            algorithm
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int crc_soft_init    (
+    CRC_SOFT*           soft,
+    const CRC_SPEC*     spec    )
+{
+    uint32_t    mask    =   0;
+    uint32_t    prev    =   0;
+    uint32_t    i;
+    uint32_t    k;
+
+    if( (!soft) || (!spec) || (0 == spec->width) || (spec->width > 32U) )
+    {
+        return (-1);
+    }
+    mask                =   crc_soft_mask(spec->width);
+    soft->spec          =   *spec;
+    soft->spec.poly     &=  mask;
+    soft->spec.init     &=  mask;
+    soft->spec.xorout   &=  mask;
+    for(i = 0; i < 256U; i++)
+    {
+        soft->table[0][i]   =   crc_soft_byte(&soft->spec, 0, (uint8_t)i);
+    }
+    /* table[k] is table[k - 1] followed by a zero byte */
+    for(k = 1U; k < 8U; k++)
+    {
+        for(i = 0; i < 256U; i++)
+        {
+            prev    =   soft->table[k - 1U][i];
+            soft->table[k][i]   =   spec->refin ? ((prev >> 8) ^ soft->table[0][prev & 0xFFU])
+                                                : ((prev << 8) ^ soft->table[0][prev >> 24]);
+        }
+    }
+    return (0);
+}
+
+/**
+ * @brief               Register before the first byte
+ * @param[in]           spec            algorithm
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_start  (
+    const CRC_SPEC*     spec    )
+{
+    return crc_soft_from_plain(spec, spec->init);
+}
+
+/**
+ * @brief               Take bytes with the tables
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           reg             register
+ * @param[in]           data            bytes, any alignment
+ * @param[in]           size            bytes
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_update (
+    const CRC_SOFT*     soft,
+    uint32_t            reg,
+    const void*         data,
+    uint32_t            size    )
+{
+    const uint32_t  (*t)[256]   =   soft->table;
+    const uint8_t*  p           =   (const uint8_t*)data;
+    uint32_t        a           =   0;
+    uint32_t        b           =   0;
+
+    /* the bytes are put together one by one, the order does not depend on the CPU */
+    if(soft->spec.refin)
+    {
+        for(; size >= 8U; size -= 8U, p += 8)
+        {
+            a   =   reg ^ ((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+            b   =   (uint32_t)p[4] | ((uint32_t)p[5] << 8) | ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+            reg =   t[7][a & 0xFFU] ^ t[6][(a >> 8) & 0xFFU] ^ t[5][(a >> 16) & 0xFFU] ^ t[4][a >> 24] ^
+                    t[3][b & 0xFFU] ^ t[2][(b >> 8) & 0xFFU] ^ t[1][(b >> 16) & 0xFFU] ^ t[0][b >> 24];
+        }
+        for(; size > 0; size--, p++)
+        {
+            reg =   t[0][(reg ^ *p) & 0xFFU] ^ (reg >> 8);
+        }
+    }
+    else
+    {
+        for(; size >= 8U; size -= 8U, p += 8)
+        {
+            a   =   reg ^ (((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3]);
+            b   =   ((uint32_t)p[4] << 24) | ((uint32_t)p[5] << 16) | ((uint32_t)p[6] << 8) | (uint32_t)p[7];
+            reg =   t[7][a >> 24] ^ t[6][(a >> 16) & 0xFFU] ^ t[5][(a >> 8) & 0xFFU] ^ t[4][a & 0xFFU] ^
+                    t[3][b >> 24] ^ t[2][(b >> 16) & 0xFFU] ^ t[1][(b >> 8) & 0xFFU] ^ t[0][b & 0xFFU];
+        }
+        for(; size > 0; size--, p++)
+        {
+            reg =   t[0][(reg >> 24) ^ *p] ^ (reg << 8);
+        }
+    }
+    return reg;
+}
+
+/**
+ * @brief               Take bytes a bit at a time
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_bitwise    (
+    const CRC_SPEC*     spec,
+    uint32_t            reg,
+    const void*         data,
+    uint32_t            size    )
+{
+    const uint8_t*  p   =   (const uint8_t*)data;
+
+    for(; size > 0; size--, p++)
+    {
+        reg =   crc_soft_byte(spec, reg, *p);
+    }
+    return reg;
+}
+
+/**
+ * @brief               CRC of the register
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @return              CRC
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_final  (
+    const CRC_SPEC*     spec,
+    uint32_t            reg )
+{
+    uint32_t    plain   =   crc_soft_to_plain(spec, reg);
+
+    if(spec->refout)
+    {
+        plain   =   crc_soft_reflect(plain, spec->width);
+    }
+    return (plain ^ spec->xorout) & crc_soft_mask(spec->width);
+}
+
+/**
+ * @brief               Register in the plain order of the CRC unit
+ * @param[in]           spec            algorithm
+ * @param[in]           reg             register
+ * @return              right aligned, not reflected
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_to_plain   (
+    const CRC_SPEC*     spec,
+    uint32_t            reg )
+{
+    return spec->refin ? crc_soft_reflect(reg, spec->width) : (reg >> (32U - spec->width));
+}
+
+/**
+ * @brief               Register from the plain order of the CRC unit
+ * @param[in]           spec            algorithm
+ * @param[in]           plain           right aligned, not reflected
+ * @return              register
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_from_plain (
+    const CRC_SPEC*     spec,
+    uint32_t            plain   )
+{
+    plain   &=  crc_soft_mask(spec->width);
+    return spec->refin ? crc_soft_reflect(plain, spec->width) : (plain << (32U - spec->width));
+}
+
+/**
+ * @brief               CRC of a buffer
+ * @param[in]           soft            algorithm and tables
+ * @param[in]           data            bytes
+ * @param[in]           size            bytes
+ * @return              CRC
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t crc_soft_calc   (
+    const CRC_SOFT*     soft,
+    const void*         data,
+    uint32_t            size    )
+{
+    return crc_soft_final(&soft->spec, crc_soft_update(soft, crc_soft_start(&soft->spec), data, size));
+}
@@ -0,0 +1,272 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        logger.c
+ * @brief       log front end on an mpsc ring with a selectable output sink.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "mpsc_ring.h"
+#include "logger.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define LOGGER_FLAG         0x1U        /*!< text was written */
+#define LOGGER_STACK_SIZE   (512U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/**
+ * @brief      One record of the ring
+ * @author     agent@local
+ * @date       2026/10/19
+ */
+typedef struct
+{
+    uint8_t             size;
+    char                text[LOGGER_TEXT];
+}LOGGER_RECORD;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static MPSC_RING                g_LoggerRing;
+static uint32_t                 g_LoggerMem[MPSC_RING_MEM_SIZE(LOGGER_RECORDS, sizeof(LOGGER_RECORD)) / sizeof(uint32_t)];
+static const LOGGER_SINK* volatile g_LoggerSink =   NULL;
+static osThreadId_t             g_LoggerThread  =   NULL;
+static uint32_t                 g_LoggerLatency =   0;      /*!< ticks */
+static uint64_t                 g_LoggerStack[LOGGER_STACK_SIZE / sizeof(uint64_t)];
+static uint8_t                  g_LoggerCb[sizeof(StaticTask_t)];
+static osThreadAttr_t           g_LoggerAttr    =
+{
+    "LOG",                  /*!< name of the thread */
+    osThreadDetached,       /*!< attribute bits */
+    (void*)g_LoggerCb,      /*!< memory for control block */
+    sizeof(g_LoggerCb),     /*!< size of provided memory for control block */
+    (void*)g_LoggerStack,   /*!< memory for stack */
+    sizeof(g_LoggerStack),  /*!< size of stack */
+    osPriorityLow,          /*!< initial thread priority, set by logger_init */
+    0,                      /*!< TrustZone module identifier(not used) */
+    0                       /*!< reserved(not used) */
+};
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Logger thread
+ * @param[in]           argument        not used
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static void logger_thread   (
+    void*   argument    )
+{
+    const LOGGER_SINK*  sink    =   NULL;
+    LOGGER_RECORD       record;
+    uint32_t            offset  =   0;
+    uint32_t            held    =   0;
+    uint32_t            flags   =   0;
+    int                 have    =   0;
+
+    (void)argument;
+    for(;;)
+    {
+        /* sleep for good unless a sink holds text back */
+        flags   =   osThreadFlagsWait(LOGGER_FLAG, osFlagsWaitAny, held ? g_LoggerLatency : osWaitForever);
+        sink    =   g_LoggerSink;
+        for(;;)
+        {
+            if(!have)
+            {
+                if(0 != mpsc_ring_get(&g_LoggerRing, &record))
+                {
+                    break;
+                }
+                have    =   1;
+                offset  =   0;
+            }
+            if(sink)
+            {
+                offset  +=  sink->write(sink->ctx, (const uint8_t*)&record.text[offset], record.size - offset);
+                if(offset < record.size)
+                {
+                    /* the sink is full, try again after the latency */
+                    break;
+                }
+            }
+            have    =   0;
+        }
+        held    =   ( (sink) && (sink->flush) ) ? sink->flush(sink->ctx, (flags & osFlagsError) ? 1 : 0) : 0;
+        if(have)
+        {
+            held    =   1;
+        }
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Start the logger thread
+ * @param[in]           priority        logger thread priority
+ * @param[in]           latency         ms a sink may hold text back
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Text is discarded until a sink is selected
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_init  (
+    osPriority_t        priority,
+    uint32_t            latency )
+{
+    if(0 != mpsc_ring_init(&g_LoggerRing, g_LoggerMem, LOGGER_RECORDS, sizeof(LOGGER_RECORD)))
+    {
+        return (-1);
+    }
+    g_LoggerLatency     =   (uint32_t)(((uint64_t)latency * osKernelGetTickFreq() + 999U) / 1000U);
+    if(0 == g_LoggerLatency)
+    {
+        g_LoggerLatency =   1;
+    }
+    g_LoggerAttr.priority   =   priority;
+    g_LoggerThread          =   osThreadNew(logger_thread, NULL, &g_LoggerAttr);
+    return (NULL == g_LoggerThread) ? (-1) : 0;
+}
+
+/**
+ * @brief               Select the output
+ * @param[in]           sink            sink, NULL to discard the text
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void logger_select   (
+    const LOGGER_SINK*  sink    )
+{
+    g_LoggerSink    =   sink;
+}
+
+/**
+ * @brief               Log text
+ * @param[in]           text            text, need not be terminated
+ * @param[in]           size            bytes
+ * @retval              0               success
+ * @retval              -1              the ring was full, text dropped
+ * @note                Thread context or interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_write (
+    const char*         text,
+    uint32_t            size    )
+{
+    LOGGER_RECORD*  record  =   NULL;
+    uint32_t        part    =   0;
+    int             ret     =   0;
+
+    if( (!text) || (!g_LoggerThread) )
+    {
+        return (-1);
+    }
+    while(size)
+    {
+        record  =   (LOGGER_RECORD*)mpsc_ring_reserve(&g_LoggerRing);
+        if(!record)
+        {
+            ret =   -1;
+            break;
+        }
+        part    =   (size > LOGGER_TEXT) ? LOGGER_TEXT : size;
+        memcpy(record->text, text, part);
+        record->size    =   (uint8_t)part;
+        mpsc_ring_commit(record);
+        text    +=  part;
+        size    -=  part;
+    }
+    (void)osThreadFlagsSet(g_LoggerThread, LOGGER_FLAG);
+    return ret;
+}
+
+/**
+ * @brief               Log formatted text
+ * @param[in]           format          printf format
+ * @retval              0               success
+ * @retval              -1              fail
+ * @note                Thread context, up to \ref LOGGER_LINE bytes
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int logger_printf    (
+    const char*         format,
+    ...                 )
+{
+    char        line[LOGGER_LINE];
+    va_list     args;
+    int         size    =   0;
+
+    va_start(args, format);
+    size    =   vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if(size < 0)
+    {
+        return (-1);
+    }
+    if((uint32_t)size >= sizeof(line))
+    {
+        size    =   (int)sizeof(line) - 1;
+    }
+    return logger_write(line, (uint32_t)size);
+}
+
+/**
+ * @brief               Records dropped because the ring was full
+ * @return              drop count
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t logger_drops    (void)
+{
+    return mpsc_ring_drops(&g_LoggerRing);
+}
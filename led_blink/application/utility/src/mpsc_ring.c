@@ -0,0 +1,238 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        mpsc_ring.c
+ * @brief       lock-free multi-producer single-consumer ring of fixed size items.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Every slot starts with a sequence word. A slot at position pos is free for
+ * the producer that reserves pos when its sequence equals pos, holds a
+ * committed item when it equals pos + 1, and is handed back by the consumer
+ * by setting it to pos + count, the position that will use it next.
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <string.h>
+
+#include "stm32l4xx.h"
+#include "mpsc_ring.h"
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Sequence word of the slot used by a position
+ * @param[in]           ring            ring control block
+ * @param[in]           pos             position
+ * @return              sequence word address, the item follows it
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static volatile uint32_t* mpsc_ring_slot    (
+    const MPSC_RING*    ring,
+    uint32_t            pos )
+{
+    return (volatile uint32_t*)(ring->slots + ((pos & ring->mask) * ring->slot_size));
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Initial a ring
+ * @param[out]          ring            ring control block
+ * @param[in]           mem             slot memory of \ref MPSC_RING_MEM_SIZE bytes, 4 bytes aligned
+ * @param[in]           count           number of items, power of two
+ * @param[in]           item_size       item size in bytes
+ * @retval              0               success
+ * @retval              -1              fail
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_init   (
+    MPSC_RING*  ring,
+    void*       mem,
+    uint32_t    count,
+    uint32_t    item_size   )
+{
+    uint32_t    pos;
+
+    if( (!ring) || (!mem) || (!item_size) || (2 > count) || (count & (count - 1)) || ((uintptr_t)mem & 3U) )
+    {
+        return (-1);
+    }
+    ring->head      =   0;
+    ring->tail      =   0;
+    ring->drops     =   0;
+    ring->mask      =   count - 1;
+    ring->item_size =   item_size;
+    ring->slot_size =   sizeof(uint32_t) + ((item_size + 3U) & ~3U);
+    ring->slots     =   (uint8_t*)mem;
+    for(pos = 0; pos < count; pos++)
+    {
+        *mpsc_ring_slot(ring, pos)  =   pos;
+    }
+    return (0);
+}
+
+/**
+ * @brief               Reserve a slot for writing an item in place
+ * @param[in]           ring            ring control block
+ * @return              item memory, NULL when the ring is full
+ * @note                Any context. Must be followed by \ref mpsc_ring_commit
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void* mpsc_ring_reserve  (
+    MPSC_RING*  ring    )
+{
+    uint32_t            pos;
+    uint32_t            drops;
+    int32_t             diff;
+    volatile uint32_t*  seq;
+
+    for(;;)
+    {
+        pos     =   __LDREXW(&ring->head);
+        seq     =   mpsc_ring_slot(ring, pos);
+        diff    =   (int32_t)(*seq - pos);
+        if(0 == diff)
+        {
+            /* slot is free, try to claim it. An exception between LDREX and
+               STREX clears the monitor, so a producer that preempted us makes
+               the store fail and we retry with the new head */
+            if(0 == __STREXW(pos + 1, &ring->head))
+            {
+                break;
+            }
+        }
+        else if(0 > diff)
+        {
+            /* the consumer has not released this slot yet: ring is full */
+            __CLREX();
+            do
+            {
+                drops   =   __LDREXW(&ring->drops);
+            }while(__STREXW(drops + 1, &ring->drops));
+            return NULL;
+        }
+        else
+        {
+            /* head moved after we loaded it, retry */
+            __CLREX();
+        }
+    }
+    return (void*)(seq + 1);
+}
+
+/**
+ * @brief               Publish an item obtained from \ref mpsc_ring_reserve
+ * @param[in]           item            item memory
+ * @return              None
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void mpsc_ring_commit    (
+    void*       item    )
+{
+    volatile uint32_t*  seq =   (volatile uint32_t*)item - 1;
+
+    /* item content must be visible before the slot is marked committed */
+    __DMB();
+    *seq    =   *seq + 1;
+}
+
+/**
+ * @brief               Copy an item into the ring
+ * @param[in]           ring            ring control block
+ * @param[in]           item            item to copy, item_size bytes
+ * @retval              0               success
+ * @retval              -1              ring full, the item is dropped and counted
+ * @note                Any context
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_put    (
+    MPSC_RING*  ring,
+    const void* item    )
+{
+    void*   slot    =   mpsc_ring_reserve(ring);
+
+    if(!slot)
+    {
+        return (-1);
+    }
+    memcpy(slot, item, ring->item_size);
+    mpsc_ring_commit(slot);
+    return (0);
+}
+
+/**
+ * @brief               Take the oldest item out of the ring
+ * @param[in]           ring            ring control block
+ * @param[out]          item            buffer of item_size bytes
+ * @retval              0               success
+ * @retval              -1              ring empty or oldest item not committed yet
+ * @note                Consumer only
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int mpsc_ring_get    (
+    MPSC_RING*  ring,
+    void*       item    )
+{
+    uint32_t            pos =   ring->tail;
+    volatile uint32_t*  seq =   mpsc_ring_slot(ring, pos);
+
+    if(*seq != (pos + 1))
+    {
+        return (-1);
+    }
+    /* read the item only after its commit has been seen */
+    __DMB();
+    memcpy(item, (const void*)(seq + 1), ring->item_size);
+    __DMB();
+    *seq        =   pos + ring->mask + 1;
+    ring->tail  =   pos + 1;
+    return (0);
+}
+
+/**
+ * @brief               Number of items dropped because the ring was full
+ * @param[in]           ring            ring control block
+ * @return              drop count
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t mpsc_ring_drops (
+    const MPSC_RING*    ring    )
+{
+    return ring->drops;
+}
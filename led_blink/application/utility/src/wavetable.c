@@ -0,0 +1,337 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        wavetable.c
+ * @brief       sample tables and phase accumulators for the DAC waveform generator.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stddef.h>
+
+#include "wavetable.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define WAVETABLE_ONE           (1LL << 30)     /*!< 1.0 in Q30 */
+#define WAVETABLE_HALF          (1LL << 29)     /*!< rounding of a Q30 product */
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/* (pi/2)^k / k! in Q30 for k = 11, 9, ..., 1, the Taylor series of sin(pi/2 x) */
+static const int64_t g_WavetableSin[6] = { 3864, 172272, 5026995, 85569306, 693598668, 1686629713 };
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+/** 
+ * @brief               Product of two Q30 numbers
+ * @param[in]           a               Q30
+ * @param[in]           b               Q30
+ * @return              a x b in Q30, rounded
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int64_t wavetable_mul    (
+    int64_t             a,
+    int64_t             b   )
+{
+    return (a * b + WAVETABLE_HALF) >> 30;
+}
+
+/** 
+ * @brief               Value of a waveform at a phase
+ * @param[in]           spec            waveform
+ * @param[in]           phase           2^32 is one period
+ * @return              Q30, -2^30 to 2^30
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+static int64_t wavetable_shape  (
+    const WAVETABLE_SPEC*   spec,
+    uint32_t                phase   )
+{
+    int64_t     p   =   (int64_t)phase;
+
+    switch(spec->shape)
+    {
+        case WAVETABLE_SQUARE:
+            return (p < ((int64_t)spec->duty << 16)) ? WAVETABLE_ONE : -WAVETABLE_ONE;
+        case WAVETABLE_TRIANGLE:
+            if(p < WAVETABLE_ONE)
+            {
+                return p;
+            }
+            return (p < 3 * WAVETABLE_ONE) ? (2 * WAVETABLE_ONE - p) : (p - 4 * WAVETABLE_ONE);
+        case WAVETABLE_SAWTOOTH:
+            return p / 2 - WAVETABLE_ONE;
+        default:
+            return wavetable_sin(phase);
+    }
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/**
+ * @brief               Sine of a phase
+ * @param[in]           phase           2^32 is one period
+ * @return              sine in Q30, -2^30 to 2^30
+ * @note                Error below 1e-7
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int32_t wavetable_sin    (
+    uint32_t            phase   )
+{
+    int64_t     x   =   (int64_t)(phase & 0x3FFFFFFFU);
+    int64_t     x2  =   0;
+    int64_t     r   =   g_WavetableSin[0];
+    uint32_t    i;
+
+    /* fold into the first quarter, x in Q30 of a quarter period */
+    if(phase & 0x40000000U)
+    {
+        x   =   WAVETABLE_ONE - x;
+    }
+    x2  =   wavetable_mul(x, x);
+    for(i = 1; i < sizeof(g_WavetableSin) / sizeof(g_WavetableSin[0]); i++)
+    {
+        r   =   g_WavetableSin[i] - wavetable_mul(r, x2);
+    }
+    r   =   wavetable_mul(r, x);
+    return (int32_t)((phase & 0x80000000U) ? -r : r);
+}
+
+/**
+ * @brief               Write whole periods of a waveform
+ * @param[out]          table           samples
+ * @param[in]           size            samples, at least 2
+ * @param[in]           spec            waveform
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_fill   (
+    uint16_t*               table,
+    uint32_t                size,
+    const WAVETABLE_SPEC*   spec    )
+{
+    uint32_t    phase   =   0;
+    int64_t     value   =   0;
+    uint32_t    i;
+
+    if( (!table) || (size < 2U) || (!spec) || (spec->shape > WAVETABLE_SAWTOOTH) || (0 == spec->cycles) ||
+        (spec->amplitude > WAVETABLE_FULL_SCALE) || (spec->offset > WAVETABLE_FULL_SCALE) || (spec->duty > 0x10000U) )
+    {
+        return (-1);
+    }
+    for(i = 0; i < size; i++)
+    {
+        /* i x cycles / size periods, the whole ones dropped */
+        phase   =   spec->phase + (uint32_t)((((uint64_t)i * spec->cycles) % size << 32) / size);
+        value   =   (int64_t)spec->offset + wavetable_mul(spec->amplitude, wavetable_shape(spec, phase));
+        if(value < 0)
+        {
+            value   =   0;
+        }
+        else if(value > (int64_t)WAVETABLE_FULL_SCALE)
+        {
+            value   =   WAVETABLE_FULL_SCALE;
+        }
+        table[i]    =   (uint16_t)value;
+    }
+    return (0);
+}
+
+/**
+ * @brief               Find the table length and timer period closest to a frequency
+ * @param[in]           mhz             frequency, mHz
+ * @param[in]           tim_clk         Hz of the timer clock
+ * @param[in]           rate_max        highest sample rate, Hz
+ * @param[in]           size_min        shortest table
+ * @param[in]           size_max        longest table
+ * @param[out]          fit             the best one, the longest table of those that fit equally well
+ * @retval              0               success
+ * @retval              -1              no table length gives a period of 1 to 65536 clocks
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_fit    (
+    uint32_t            mhz,
+    uint32_t            tim_clk,
+    uint32_t            rate_max,
+    uint32_t            size_min,
+    uint32_t            size_max,
+    WAVETABLE_FIT*      fit )
+{
+    uint64_t    clock   =   (uint64_t)tim_clk * 1000U;
+    uint64_t    best    =   UINT64_MAX;
+    uint64_t    period  =   0;
+    uint64_t    got     =   0;
+    uint64_t    error   =   0;
+    uint32_t    least   =   0;
+    uint32_t    size;
+
+    if( (0 == mhz) || (0 == tim_clk) || (0 == rate_max) || (!fit) || (size_min < 2U) || (size_min > size_max) )
+    {
+        return (-1);
+    }
+    least   =   (tim_clk + rate_max - 1U) / rate_max;
+    for(size = size_max; size >= size_min; size--)
+    {
+        period  =   (clock + (uint64_t)mhz * size / 2U) / ((uint64_t)mhz * size);
+        if( (period < least) || (0 == period) || (period > 0x10000U) )
+        {
+            continue;
+        }
+        got     =   (clock + period * size / 2U) / (period * size);
+        error   =   (got > mhz) ? (got - mhz) : (mhz - got);
+        if(error < best)
+        {
+            best        =   error;
+            fit->size   =   size;
+            fit->period =   (uint32_t)period;
+            fit->mhz    =   (uint32_t)got;
+        }
+    }
+    return (UINT64_MAX == best) ? (-1) : 0;
+}
+
+/**
+ * @brief               Phase step of a frequency
+ * @param[in]           mhz             frequency, mHz
+ * @param[in]           tim_clk         Hz of the timer clock
+ * @param[in]           period          timer clocks per sample
+ * @return              step, 0 when the frequency is not below half the sample rate
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t wavetable_nco_step  (
+    uint32_t            mhz,
+    uint32_t            tim_clk,
+    uint32_t            period  )
+{
+    uint64_t    num     =   (uint64_t)mhz * period;
+    uint64_t    den     =   (uint64_t)tim_clk * 1000U;
+    uint64_t    step    =   0;
+    uint32_t    i;
+
+    if( (0 == den) || (2U * num >= den) )
+    {
+        return 0;
+    }
+    /* num x 2^32 / den, 16 bits at a time */
+    for(i = 0; i < 2U; i++)
+    {
+        num     <<= 16;
+        step    =   (step << 16) | (num / den);
+        num     %=  den;
+    }
+    return (uint32_t)((2U * num >= den) ? (step + 1U) : step);
+}
+
+/**
+ * @brief               Start a phase accumulator
+ * @param[out]          nco             accumulator
+ * @param[in]           table           one period
+ * @param[in]           size            power of two, 2 to 65536
+ * @param[in]           step            from \ref wavetable_nco_step
+ * @retval              0               success
+ * @retval              -1              bad arguments
+ * @note                Changing step later changes the frequency with a continuous phase
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern int wavetable_nco_init   (
+    WAVETABLE_NCO*      nco,
+    const uint16_t*     table,
+    uint32_t            size,
+    uint32_t            step    )
+{
+    uint32_t    bits    =   0;
+
+    if( (!nco) || (!table) || (size < 2U) || (size > 0x10000U) || (size & (size - 1U)) )
+    {
+        return (-1);
+    }
+    while((1U << bits) < size)
+    {
+        bits++;
+    }
+    nco->table  =   table;
+    nco->bits   =   bits;
+    nco->phase  =   0;
+    nco->step   =   step;
+    return (0);
+}
+
+/**
+ * @brief               Write the next samples
+ * @param[in]           nco             accumulator
+ * @param[out]          out             samples
+ * @param[in]           count           samples
+ * @return              None
+ * @note                Interpolates linearly between neighbouring table samples
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void wavetable_nco_fill  (
+    WAVETABLE_NCO*      nco,
+    uint16_t*           out,
+    uint32_t            count   )
+{
+    uint32_t    mask    =   (1U << nco->bits) - 1U;
+    uint32_t    shift   =   32U - nco->bits;
+    uint32_t    phase   =   nco->phase;
+    uint32_t    index   =   0;
+    int32_t     a       =   0;
+    int32_t     b       =   0;
+    int32_t     frac    =   0;
+    uint32_t    i;
+
+    for(i = 0; i < count; i++)
+    {
+        index   =   phase >> shift;
+        a       =   nco->table[index];
+        b       =   nco->table[(index + 1U) & mask];
+        /* the 16 phase bits below the index */
+        frac    =   (int32_t)((phase << nco->bits) >> 16);
+        out[i]  =   (uint16_t)(a + (((b - a) * frac + 0x8000) >> 16));
+        phase   +=  nco->step;
+    }
+    nco->phase  =   phase;
+}
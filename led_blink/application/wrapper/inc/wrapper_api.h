@@ -53,7 +53,7 @@ extern "C" {
 #define SAFE_IT_PRIO    configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
 
 #define HEAP_MEM_START  (0x10000000)        /*!< Start memory address of heap */
-#define HEAP_MEM_SIZE   (32 * 1024)         /*!< Total memory size of heap */
+#define HEAP_MEM_SIZE   (32 * 1024)         /*!< Total memory size of heap, less the retained section at its start */
 
 /**************************************************************
 **  Interface
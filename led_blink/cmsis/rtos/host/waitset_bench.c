@@ -0,0 +1,379 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  CMSIS RTOS V2 implement via FreeRTOS
+**************************************************************/
+/** 
+ * @file        waitset_bench.c
+ * @brief       host comparison of waiting on a wait set against polling each object.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The kernel does not run on the host, so both ways of waiting for the first
+ * of several semaphores are modelled with threads, one lock standing in for
+ * the kernel critical section:
+ *  - wait set: a give also writes the semaphore's handle to the set, which
+ *    is a queue, and the waiter blocks on the set alone, as osWaitSetWait()
+ *    does on a FreeRTOS queue set.
+ *  - polling: the waiter takes the semaphores in turn, each with a timeout
+ *    of one tick (1 ms at configTICK_RATE_HZ 1000), the loop the wait set
+ *    replaces.
+ * A producer gives a random semaphore every 0 to 2 ticks. The waiter records
+ * the time from each give to its return, and its own CPU time while events
+ * come in and during a second without any. Every event must be taken once.
+ * Run "make" in this directory, then ./waitset_bench [semaphores] [events].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _POSIX_C_SOURCE     200112L
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_TICK_NS       (1000000L)          /*!< one kernel tick */
+#define BENCH_IDLE_NS       (1000000000L)       /*!< quiet time after the events */
+#define BENCH_MAX_OBJS      (32U)
+#define BENCH_MAX_EVENTS    (100000U)
+#define BENCH_RING          (1024U)             /*!< gives outstanding per semaphore, and in the set */
+#define BENCH_SET           (0U)
+#define BENCH_POLL          (1U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* a counting semaphore with the time of each outstanding give */
+typedef struct
+{
+    pthread_cond_t  cond;
+    uint32_t        count;
+    uint32_t        head;
+    uint32_t        tail;
+    double          stamps[BENCH_RING];
+}BENCH_SEM;
+
+/* what the waiter measured */
+typedef struct
+{
+    uint32_t        taken;
+    uint32_t        wrong;
+    double          mean;       /*!< us from give to return */
+    double          p99;
+    double          max;
+    double          busy;       /*!< % of a CPU while events came in */
+    double          idle;       /*!< % of a CPU without events */
+    double          wakeups;    /*!< per second without events */
+}BENCH_RESULT;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static pthread_mutex_t  g_Lock  =   PTHREAD_MUTEX_INITIALIZER;
+static BENCH_SEM        g_Sems[BENCH_MAX_OBJS];
+static pthread_cond_t   g_SetCond;
+static uint32_t         g_Set[BENCH_RING];
+static uint32_t         g_SetHead;
+static uint32_t         g_SetTail;
+static uint32_t         g_Scheme;
+static uint32_t         g_Objs;
+static uint32_t         g_Events;
+static double           g_Latency[BENCH_MAX_EVENTS];
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static double bench_clock   (
+    clockid_t   id  )
+{
+    struct timespec ts;
+
+    clock_gettime(id, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double bench_now (void)
+{
+    return bench_clock(CLOCK_MONOTONIC);
+}
+
+static void bench_sleep (
+    long    ns  )
+{
+    struct timespec ts;
+
+    ts.tv_sec   =   ns / 1000000000L;
+    ts.tv_nsec  =   ns % 1000000000L;
+    (void)nanosleep(&ts, NULL);
+}
+
+/* osSemaphoreRelease(), also posting to the set in the wait set scheme */
+static void bench_give  (
+    uint32_t    id  )
+{
+    BENCH_SEM*  sem =   &g_Sems[id];
+
+    pthread_mutex_lock(&g_Lock);
+    sem->stamps[sem->head++ % BENCH_RING]   =   bench_now();
+    sem->count++;
+    if(BENCH_SET == g_Scheme)
+    {
+        g_Set[g_SetHead++ % BENCH_RING] =   id;
+        pthread_cond_signal(&g_SetCond);
+    }
+    else
+    {
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&g_Lock);
+}
+
+/* takes a token of sem with the lock held, returns the us since its give */
+static double bench_take    (
+    BENCH_SEM*  sem )
+{
+    sem->count--;
+    return (bench_now() - sem->stamps[sem->tail++ % BENCH_RING]) / 1e3;
+}
+
+/* osWaitSetWait() then osSemaphoreAcquire(member, 0) */
+static double bench_wait_set    (
+    uint32_t*   wakeups )
+{
+    uint32_t    id;
+    double      us;
+
+    pthread_mutex_lock(&g_Lock);
+    while(g_SetHead == g_SetTail)
+    {
+        pthread_cond_wait(&g_SetCond, &g_Lock);
+        (*wakeups)++;
+    }
+    id  =   g_Set[g_SetTail++ % BENCH_RING];
+    us  =   bench_take(&g_Sems[id]);
+    pthread_mutex_unlock(&g_Lock);
+    return us;
+}
+
+/* osSemaphoreAcquire(sem, 1) on one semaphore after the other */
+static double bench_wait_poll   (
+    uint32_t*   wakeups )
+{
+    static uint32_t next    =   0;
+    BENCH_SEM*      sem;
+    struct timespec ts;
+    double          due;
+    double          us;
+
+    for(;;)
+    {
+        sem =   &g_Sems[next];
+        next    =   (next + 1U) % g_Objs;
+        pthread_mutex_lock(&g_Lock);
+        if(0U == sem->count)
+        {
+            due         =   bench_now() + (double)BENCH_TICK_NS;
+            ts.tv_sec   =   (time_t)(due / 1e9);
+            ts.tv_nsec  =   (long)(due - (double)ts.tv_sec * 1e9);
+            while( (0U == sem->count) && (0 == pthread_cond_timedwait(&sem->cond, &g_Lock, &ts)) )
+            {
+            }
+            (*wakeups)++;
+        }
+        if(0U != sem->count)
+        {
+            us  =   bench_take(sem);
+            pthread_mutex_unlock(&g_Lock);
+            return us;
+        }
+        pthread_mutex_unlock(&g_Lock);
+    }
+}
+
+static double bench_wait    (
+    uint32_t*   wakeups )
+{
+    return (BENCH_SET == g_Scheme) ? bench_wait_set(wakeups) : bench_wait_poll(wakeups);
+}
+
+static void* bench_producer (
+    void*   arg )
+{
+    uint32_t    rng =   0x9E3779B9U;
+    uint32_t    e;
+
+    (void)arg;
+    for(e = 0; e < g_Events; e++)
+    {
+        rng ^=  rng << 13;
+        rng ^=  rng >> 17;
+        rng ^=  rng << 5;
+        bench_sleep((long)(rng % (2U * BENCH_TICK_NS)));
+        bench_give((rng >> 8) % g_Objs);
+    }
+    /* a quiet second, then one give to end it */
+    bench_sleep(BENCH_IDLE_NS);
+    bench_give(0U);
+    return NULL;
+}
+
+static int bench_cmp    (
+    const void* a,
+    const void* b   )
+{
+    double  x   =   *(const double*)a;
+    double  y   =   *(const double*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void bench_run   (
+    uint32_t        scheme,
+    BENCH_RESULT*   result  )
+{
+    pthread_condattr_t  attr;
+    pthread_t           producer;
+    uint32_t            wakeups =   0;
+    uint32_t            e;
+    uint32_t            i;
+    double              wall;
+    double              cpu;
+    double              sum     =   0;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_SetCond, &attr);
+    for(i = 0; i < g_Objs; i++)
+    {
+        pthread_cond_init(&g_Sems[i].cond, &attr);
+        g_Sems[i].count =   0;
+        g_Sems[i].head  =   0;
+        g_Sems[i].tail  =   0;
+    }
+    g_SetHead   =   0;
+    g_SetTail   =   0;
+    g_Scheme    =   scheme;
+    result->wrong   =   0;
+
+    if(0 != pthread_create(&producer, NULL, bench_producer, NULL))
+    {
+        fprintf(stderr, "cannot start the producer\n");
+        exit(1);
+    }
+    wall    =   bench_now();
+    cpu     =   bench_clock(CLOCK_THREAD_CPUTIME_ID);
+    for(e = 0; e < g_Events; e++)
+    {
+        g_Latency[e]    =   bench_wait(&wakeups);
+        sum             +=  g_Latency[e];
+    }
+    result->taken   =   e;
+    result->busy    =   100.0 * (bench_clock(CLOCK_THREAD_CPUTIME_ID) - cpu) / (bench_now() - wall);
+
+    /* the quiet second, ended by the last give */
+    wakeups =   0;
+    wall    =   bench_now();
+    cpu     =   bench_clock(CLOCK_THREAD_CPUTIME_ID);
+    (void)bench_wait(&wakeups);
+    wall    =   bench_now() - wall;
+    result->idle    =   100.0 * (bench_clock(CLOCK_THREAD_CPUTIME_ID) - cpu) / wall;
+    result->wakeups =   (double)wakeups * 1e9 / wall;
+    pthread_join(producer, NULL);
+
+    /* every give taken exactly once */
+    for(i = 0; i < g_Objs; i++)
+    {
+        if( (0U != g_Sems[i].count) || (g_Sems[i].head != g_Sems[i].tail) )
+        {
+            result->wrong++;
+        }
+        pthread_cond_destroy(&g_Sems[i].cond);
+    }
+    if(g_SetHead != g_SetTail)
+    {
+        result->wrong++;
+    }
+    pthread_cond_destroy(&g_SetCond);
+    pthread_condattr_destroy(&attr);
+
+    qsort(g_Latency, g_Events, sizeof(g_Latency[0]), bench_cmp);
+    result->mean    =   sum / (double)g_Events;
+    result->p99     =   g_Latency[(g_Events * 99U) / 100U];
+    result->max     =   g_Latency[g_Events - 1U];
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (
+    int     argc,
+    char**  argv    )
+{
+    static const char*  names[]     =   { "wait set", "polling" };
+    BENCH_RESULT        result;
+    uint32_t            wrong       =   0;
+    uint32_t            s;
+
+    g_Objs      =   8U;
+    g_Events    =   2000U;
+    if(argc > 1)
+    {
+        g_Objs  =   (uint32_t)strtoul(argv[1], NULL, 0);
+        if( (g_Objs < 1U) || (g_Objs > BENCH_MAX_OBJS) )
+        {
+            fprintf(stderr, "semaphores must be between 1 and %u\n", BENCH_MAX_OBJS);
+            return 1;
+        }
+    }
+    if(argc > 2)
+    {
+        g_Events    =   (uint32_t)strtoul(argv[2], NULL, 0);
+        if( (g_Events < 100U) || (g_Events > BENCH_MAX_EVENTS) )
+        {
+            fprintf(stderr, "events must be between 100 and %u\n", BENCH_MAX_EVENTS);
+            return 1;
+        }
+    }
+
+    printf("%u semaphores, %u gives 0 to 2 ms apart, polled with a 1 ms timeout each\n\n", g_Objs, g_Events);
+    printf("scheme     mean us   p99 us   max us  busy cpu %%  idle cpu %%  idle wakeups/s  wrong\n");
+    for(s = BENCH_SET; s <= BENCH_POLL; s++)
+    {
+        bench_run(s, &result);
+        wrong   +=  result.wrong + (g_Events - result.taken);
+        printf("%-9s %8.1f %8.1f %8.1f %11.2f %11.2f %15.1f %6u\n", names[s], result.mean, result.p99,
+               result.max, result.busy, result.idle, result.wakeups, result.wrong);
+    }
+
+    return (0U == wrong) ? 0 : 1;
+}
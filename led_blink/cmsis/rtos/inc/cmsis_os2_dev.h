@@ -34,6 +34,7 @@
 
 #include "stm32l4xx.h"
 #include "cmsis_os2.h"
+#include "cmsis_os2_ext.h"
 
 /**************************************************************
 **  Symbol
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/**************************************************************
+**  CMSIS RTOS V2 extension
+**************************************************************/
+/** 
+ * @file        cmsis_os2_ext.h
+ * @brief       Project extensions to the CMSIS RTOS V2 API
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+#ifndef CMSIS_OS2_EXT_H_
+#define CMSIS_OS2_EXT_H_
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include "cmsis_os2.h"
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+// Thread attributes (attr_bits in \ref osThreadAttr_t).
+#define osThreadNoFpu           0x00010000U ///< Thread never uses the FPU, its context excludes the FPU registers
+
+/// Size in bytes of the storage \ref osWaitSetNew needs for \a count events.
+#define osWaitSetMemSize(count) ((count) * sizeof(void*))
+
+// Kinds of section timed by \ref osKernelGetMaskTime.
+#define osMaskTimeCritical      0U          ///< interrupts masked by a kernel critical section
+#define osMaskTimeSchedulerLock 1U          ///< scheduler locked by \ref osKernelLock or the kernel itself
+
+/// Callers reported by \ref osKernelGetMaskTime.
+#define osMaskTimeCallers       4U
+
+// Causes of a crash reported by \ref osKernelGetCrashDump.
+#define osCrashHardFault        3U          ///< hard fault, or a configurable fault escalated to one
+#define osCrashMemManage        4U          ///< memory management fault
+#define osCrashBusFault         5U          ///< bus fault
+#define osCrashUsageFault       6U          ///< usage fault
+#define osCrashAssert           0x100U      ///< failed configASSERT
+#define osCrashStackOverflow    0x101U      ///< thread ran out of stack
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+/// \details Wait Set ID identifies the wait set.
+typedef void *osWaitSetId_t;
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/** 
+ * @brief   CPU usage of a thread, see \ref osThreadGetCpuStats.
+ */
+typedef struct {
+  uint64_t                      cycles;     ///< core clock cycles spent running since creation
+  uint32_t                      voluntary;  ///< switches caused by the thread blocking or suspending itself
+  uint32_t                      involuntary;///< switches caused by preemption or yield
+  uint32_t                      load;       ///< share of the last statistics window in 0.1 % units
+} osThreadCpuStats_t;
+
+/** 
+ * @brief   Attributes structure for wait set, see \ref osWaitSetNew.
+ */
+typedef struct {
+  const char                    *name;      ///< name of the wait set
+  uint32_t                      attr_bits;  ///< attribute bits
+  void                          *cb_mem;    ///< memory for control block
+  uint32_t                      cb_size;    ///< size of provided memory for control block
+  void                          *mq_mem;    ///< memory for event storage, \ref osWaitSetMemSize
+  uint32_t                      mq_size;    ///< size of provided memory for event storage
+} osWaitSetAttr_t;
+
+/** 
+ * @brief   Interrupt to thread wake latency of one interrupt, see \ref osKernelGetIrqLatency.
+ */
+typedef struct {
+  int32_t                       irq;        ///< interrupt number (IRQn_Type), negative for system exceptions
+  uint32_t                      count;      ///< wakeups recorded
+  uint32_t                      min;        ///< core clock cycles from the wakeup to the thread running
+  uint32_t                      max;
+  uint32_t                      p50;        ///< percentiles, up to 25 % above the exact value
+  uint32_t                      p90;
+  uint32_t                      p99;
+  uint32_t                      p999;
+} osIrqLatency_t;
+
+/** 
+ * @brief   Time spent in one kind of kernel section, see \ref osKernelGetMaskTime.
+ */
+typedef struct {
+  uint32_t                      count;      ///< sections timed
+  uint32_t                      max;        ///< core clock cycles of the longest
+  uint32_t                      avg;        ///< core clock cycles on average
+  uint32_t                      hist[32];   ///< sections of 2^n to 2^(n+1) - 1 cycles in hist[n]
+  void                          *caller[osMaskTimeCallers];     ///< code that opened the longest sections, longest first
+  uint32_t                      caller_max[osMaskTimeCallers];  ///< cycles of the longest section of each caller
+} osMaskTime_t;
+
+/** 
+ * @brief   Crash that caused the last reset, see \ref osKernelGetCrashDump.
+ */
+typedef struct {
+  uint32_t                      cause;      ///< \ref osCrashHardFault, \ref osCrashAssert, ...
+  uint32_t                      sequence;   ///< crashes recorded since power on
+  uint32_t                      pc;         ///< faulting instruction, or the failed assert
+  uint32_t                      lr;
+  uint32_t                      sp;
+  uint32_t                      cfsr;       ///< configurable fault status register
+  uint32_t                      hfsr;       ///< hard fault status register
+  uint32_t                      address;    ///< faulting data address, 0 if unknown
+  uint32_t                      line;       ///< line of the failed assert
+  osThreadId_t                  thread;     ///< running thread, NULL if none
+  char                          name[16];   ///< its name
+  const void                    *dump;      ///< raw record for tools/crash_decode.py
+  uint32_t                      dump_size;  ///< size of the raw record in bytes
+} osCrashDump_t;
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+extern osStatus_t osThreadGetCpuStats (osThreadId_t thread_id, osThreadCpuStats_t *stats);
+extern uint32_t osKernelGetIdleLoad (void);
+extern void osKernelIrqEnter (void);
+extern osStatus_t osKernelGetIrqLatency (uint32_t index, osIrqLatency_t *latency);
+extern osStatus_t osKernelResetIrqLatency (void);
+extern osStatus_t osKernelGetMaskTime (uint32_t kind, osMaskTime_t *stats);
+extern osStatus_t osKernelResetMaskTime (void);
+extern osStatus_t osKernelGetCrashDump (osCrashDump_t *crash);
+extern osStatus_t osKernelClearCrashDump (void);
+
+// Wait sets, only available when configUSE_QUEUE_SETS is 1.
+extern osWaitSetId_t osWaitSetNew (uint32_t count, const osWaitSetAttr_t *attr);
+extern osStatus_t osWaitSetAdd (osWaitSetId_t set_id, void *object_id);
+extern osStatus_t osWaitSetRemove (osWaitSetId_t set_id, void *object_id);
+extern osStatus_t osWaitSetAddEventFlags (osWaitSetId_t set_id, osEventFlagsId_t ef_id, uint32_t flags);
+extern osStatus_t osWaitSetRemoveEventFlags (osWaitSetId_t set_id, osEventFlagsId_t ef_id);
+extern osStatus_t osWaitSetWait (osWaitSetId_t set_id, void **object_id, uint32_t timeout);
+extern osStatus_t osWaitSetDelete (osWaitSetId_t set_id);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* CMSIS_OS2_EXT_H_ */
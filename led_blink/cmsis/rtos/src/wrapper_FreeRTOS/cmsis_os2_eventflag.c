@@ -116,7 +116,7 @@ extern uint32_t osEventFlagsSet (
     uint32_t            flags   )
 {
     uint32_t    ret     =   0;
-#if( INCLUDE_xTimerPendFunctionCall == 1 )
+#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) || ( configUSE_WORK_QUEUE == 1 ) )
     BaseType_t  yield   =   pdFALSE;
 #endif
 
@@ -129,7 +129,7 @@ extern uint32_t osEventFlagsSet (
         }
         if(IS_IRQ())
         {
-#if( INCLUDE_xTimerPendFunctionCall == 1 )
+#if( ( INCLUDE_xTimerPendFunctionCall == 1 ) || ( configUSE_WORK_QUEUE == 1 ) )
             if(pdPASS != xEventGroupSetBitsFromISR( (EventGroupHandle_t)ef_id, (EventBits_t)flags, &yield ))
             {
                 ret = (uint32_t)osFlagsErrorResource;
@@ -37,6 +37,8 @@
 #include "cmsis_os2_dev.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "wakelatency.h"
+#include "masktime.h"
 
 /**************************************************************
 **  Symbol
@@ -65,8 +67,11 @@
 static osKernelState_t      g_KernelState   =   osKernelInactive;
 static const char*          g_KernalId      =   "FreeRTOSv10.2.0";
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-static const HeapRegion_t   g_HeapRegions[] =   {
-                                                    {   (uint8_t*)0x10000000,   configTOTAL_HEAP_SIZE },
+/* SRAM2 after the retained section, from the linker script */
+extern uint8_t              _eretained[];
+extern uint8_t              _eram2[];
+static HeapRegion_t         g_HeapRegions[] =   {
+                                                    {   _eretained,             0                     },
                                                     {   NULL,                   0                     }
                                                 };
 #endif
@@ -76,6 +81,11 @@ static StackType_t          g_IdleTaskStackBuffer[configMINIMAL_STACK_SIZE];
 static StaticTask_t         g_TimerTaskTCBBuffer;
 static StackType_t          g_TimerTaskStackBuffer[configTIMER_TASK_STACK_DEPTH];
 #endif
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) || ( configUSE_MPU_STACK_GUARD == 1 ) )
+/* Thread that overflowed its stack, kept for the debugger */
+static volatile TaskHandle_t g_StackOverflowThread  =   NULL;
+static char                  g_StackOverflowName[configMAX_TASK_NAME_LEN];
+#endif
 
 /**************************************************************
 **  Interface
@@ -122,6 +132,41 @@ extern void vApplicationGetTimerTaskMemory  (
 
 #endif
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 0 ) || ( configUSE_MPU_STACK_GUARD == 1 ) )
+/**
+ * @brief               Called by the kernel when a thread overflowed its stack.
+ * @param[in]           xTask           handle of the thread.
+ * @param[in]           pcTaskName      name of the thread.
+ * @return              None
+ * @note                The system is stopped, the thread and its name are kept in 
+ *                      g_StackOverflowThread and g_StackOverflowName.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern void vApplicationStackOverflowHook   (
+    TaskHandle_t    xTask,
+    char*           pcTaskName  )
+{
+    taskDISABLE_INTERRUPTS();
+    g_StackOverflowThread   =   xTask;
+    if(pcTaskName)
+    {
+        (void)strncpy(g_StackOverflowName, pcTaskName, sizeof(g_StackOverflowName));
+    }
+#if( configUSE_TRACE_RECORDER == 1 )
+    vTraceRecorderTrigger((uint32_t)xTask);
+#endif
+#if( configUSE_CRASH_DUMP == 1 )
+    /* recorded in retained SRAM2, then reset */
+    vCrashDumpStackOverflow(xTask);
+#else
+    while(1)
+    {
+    }
+#endif
+}
+#endif
+
 /** 
  * @brief               Initialize the RTOS Kernel.
  * @retval              osOK
@@ -146,7 +191,12 @@ extern osStatus_t osKernelInitialize (void)
         }
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
         /* create heap */
+        g_HeapRegions[0].xSizeInBytes   =   (size_t)(_eram2 - _eretained);
         vPortDefineHeapRegions (g_HeapRegions);
+#endif
+#if ( configUSE_TRACE_RECORDER == 1 )
+        /* a frozen capture from before the reset is kept until restarted */
+        (void)ulTraceRecorderInit();
 #endif
         g_KernelState   =   osKernelReady;
     }while(0);
@@ -475,3 +525,263 @@ extern uint32_t osKernelGetSysTimerFreq (void)
 {
     return osKernelGetTickFreq();
 }
+
+/** 
+ * @brief               Get the share of the last statistics window spent in the idle thread.
+ * @return              idle load in 0.1 % units, 0 if no statistics window completed yet.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern uint32_t osKernelGetIdleLoad (void)
+{
+#if ( configUSE_TASK_CPU_STATS == 1 )
+    if(IS_IRQ())
+    {
+        return (0);
+    }
+    return ulTaskGetIdleLoad();
+#else
+    return (0);
+#endif
+}
+
+/** 
+ * @brief               Mark the entry of the running interrupt handler for the wake latency statistics.
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Call it first in the handler on every invocation, or never for that interrupt.
+ *                      Without it the latency is measured from the call that wakes the thread.
+ */
+extern void osKernelIrqEnter (void)
+{
+#if ( configUSE_WAKE_LATENCY == 1 )
+    vWakeLatencyISREnter();
+#endif
+}
+
+/** 
+ * @brief               Get the interrupt to thread wake latency statistics of one interrupt.
+ * @param[in]           index           0 up to the number of interrupts that woke a thread so far.
+ * @param[out]          latency         pointer to the buffer receiving the statistics.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     no interrupt at this index
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Copies a whole histogram on the caller's stack.
+ */
+extern osStatus_t osKernelGetIrqLatency (
+    uint32_t            index,
+    osIrqLatency_t*     latency )
+{
+#if ( configUSE_WAKE_LATENCY == 1 )
+    osStatus_t          ret =   osOK;
+    WakeLatencyStats_t  stats;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if(!latency)
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xWakeLatencyGetStats((UBaseType_t)index, &stats))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        latency->irq    =   (int32_t)stats.ulException - 16;
+        latency->count  =   stats.ulCount;
+        latency->min    =   (stats.ulCount)?stats.ulMinimum:0;
+        latency->max    =   stats.ulMaximum;
+        latency->p50    =   ulWakeLatencyPercentile(&stats, 500);
+        latency->p90    =   ulWakeLatencyPercentile(&stats, 900);
+        latency->p99    =   ulWakeLatencyPercentile(&stats, 990);
+        latency->p999   =   ulWakeLatencyPercentile(&stats, 999);
+    }while(0);
+
+    return ret;
+#else
+    (void)index;
+    (void)latency;
+    return (osError);
+#endif
+}
+
+/** 
+ * @brief               Clear the interrupt to thread wake latency statistics.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osKernelResetIrqLatency (void)
+{
+#if ( configUSE_WAKE_LATENCY == 1 )
+    if(IS_IRQ())
+    {
+        return (osErrorISR);
+    }
+    vWakeLatencyReset();
+    return (osOK);
+#else
+    return (osError);
+#endif
+}
+
+/** 
+ * @brief               Get the time spent in kernel critical sections or with the scheduler locked.
+ * @param[in]           kind            \ref osMaskTimeCritical or \ref osMaskTimeSchedulerLock.
+ * @param[out]          stats           pointer to the buffer receiving the statistics.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Only thread code is timed. Look the callers up in the map file or with addr2line.
+ */
+extern osStatus_t osKernelGetMaskTime (
+    uint32_t            kind,
+    osMaskTime_t*       stats   )
+{
+#if ( configUSE_MASK_TIME == 1 )
+    osStatus_t          ret =   osOK;
+    MaskTimeStats_t     mask;
+    uint32_t            i;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!stats) || (pdPASS != xMaskTimeGetStats((UBaseType_t)kind, &mask)) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        memset(stats, 0, sizeof(osMaskTime_t));
+        stats->count    =   mask.ulCount;
+        stats->max      =   mask.ulMaximum;
+        stats->avg      =   (mask.ulCount)?(uint32_t)(mask.ullTotal / mask.ulCount):0;
+        memcpy(stats->hist, mask.ulBuckets, sizeof(stats->hist));
+        for(i = 0; (i < osMaskTimeCallers) && (i < configMASK_TIME_CALLERS); i++)
+        {
+            stats->caller[i]        =   mask.xWorst[i].pvCaller;
+            stats->caller_max[i]    =   mask.xWorst[i].ulMaximum;
+        }
+    }while(0);
+
+    return ret;
+#else
+    (void)kind;
+    (void)stats;
+    return (osError);
+#endif
+}
+
+/** 
+ * @brief               Clear the statistics of \ref osKernelGetMaskTime.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osKernelResetMaskTime (void)
+{
+#if ( configUSE_MASK_TIME == 1 )
+    if(IS_IRQ())
+    {
+        return (osErrorISR);
+    }
+    vMaskTimeReset();
+    return (osOK);
+#else
+    return (osError);
+#endif
+}
+
+/** 
+ * @brief               Get the crash that caused the last reset.
+ * @param[out]          crash           pointer to the buffer receiving the crash.
+ * @retval              osOK
+ * @retval              osErrorParameter
+ * @retval              osErrorResource no crash recorded, or cleared by \ref osKernelClearCrashDump.
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Pass crash->dump to tools/crash_decode.py for a symbolized backtrace.
+ */
+extern osStatus_t osKernelGetCrashDump (
+    osCrashDump_t*      crash   )
+{
+#if ( configUSE_CRASH_DUMP == 1 )
+    osStatus_t          ret     =   osOK;
+    const CrashDump_t*  dump    =   NULL;
+
+    do
+    {
+        if(!crash)
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        dump    =   pxCrashDumpGet();
+        if(!dump)
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        memset(crash, 0, sizeof(osCrashDump_t));
+        crash->cause        =   dump->ulCause;
+        crash->sequence     =   dump->ulSequence;
+        crash->pc           =   dump->ulRegisters[crashdumpREG_PC];
+        crash->lr           =   dump->ulRegisters[crashdumpREG_LR];
+        crash->sp           =   dump->ulRegisters[crashdumpREG_SP];
+        crash->cfsr         =   dump->ulCfsr;
+        crash->hfsr         =   dump->ulHfsr;
+        if(dump->ulCfsr & (1UL << 7))
+        {
+            /* MMARVALID */
+            crash->address  =   dump->ulMmfar;
+        }
+        else if(dump->ulCfsr & (1UL << 15))
+        {
+            /* BFARVALID */
+            crash->address  =   dump->ulBfar;
+        }
+        crash->line         =   dump->ulLine;
+        crash->thread       =   (osThreadId_t)dump->ulTask;
+        memcpy(crash->name, dump->cTaskName, sizeof(crash->name) - 1);
+        crash->dump         =   dump;
+        crash->dump_size    =   sizeof(CrashDump_t);
+    }while(0);
+
+    return ret;
+#else
+    (void)crash;
+    return (osError);
+#endif
+}
+
+/** 
+ * @brief               Forget the crash returned by \ref osKernelGetCrashDump.
+ * @retval              osOK
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osKernelClearCrashDump (void)
+{
+#if ( configUSE_CRASH_DUMP == 1 )
+    vCrashDumpClear();
+    return (osOK);
+#else
+    return (osError);
+#endif
+}
@@ -109,6 +109,13 @@ extern osMessageQueueId_t osMessageQueueNew (
             /* FreeRTOS do not support this mode */
             ret =   NULL;
         }
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+        /* register the name so kernel aware tools can show it */
+        if( (ret) && (attr) && (attr->name) )
+        {
+            vQueueAddToRegistry(ret, attr->name);
+        }
+#endif
     }while(0);
 
     return (osMessageQueueId_t)ret;
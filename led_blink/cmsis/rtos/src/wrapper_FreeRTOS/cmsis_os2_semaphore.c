@@ -93,6 +93,13 @@ extern osSemaphoreId_t osSemaphoreNew   (
             ret =   NULL;
 #endif
         }
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+        /* register the name so kernel aware tools can show it */
+        if( (ret) && (attr) && (attr->name) )
+        {
+            vQueueAddToRegistry(ret, attr->name);
+        }
+#endif
     }while(0);
 
     return (osSemaphoreId_t)ret;
@@ -104,6 +104,11 @@ extern osThreadId_t osThreadNew (
             ret =   NULL;
             break;
         }
+        /* Integer only thread, ignored when the kernel does not support it */
+        if( attr && (osThreadNoFpu == (attr->attr_bits & osThreadNoFpu)) )
+        {
+            tskPriority |=  portNO_FPU_BIT;
+        }
         if( attr && attr->cb_mem && attr->cb_size )
         {
             dynamic_cb  =   0;
@@ -660,3 +665,53 @@ extern uint32_t osThreadEnumerate   (
     return (0);
 #endif
 }
+
+/** 
+ * @brief               Get CPU usage statistics of a thread.
+ * @param[in]           thread_id       thread ID obtained by \ref osThreadNew or \ref osThreadGetId.
+ * @param[out]          stats           pointer to the buffer receiving the statistics.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     no statistics window completed yet
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osThreadGetCpuStats   (
+    osThreadId_t        thread_id,
+    osThreadCpuStats_t* stats       )
+{
+#if ( configUSE_TASK_CPU_STATS == 1 )
+    osStatus_t      ret =   osOK;
+    TaskCpuStats_t  tskStats;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!thread_id) || (!stats) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xTaskGetCpuStats((TaskHandle_t)thread_id, &tskStats))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        stats->cycles       =   tskStats.ullCycles;
+        stats->voluntary    =   tskStats.ulVoluntarySwitches;
+        stats->involuntary  =   tskStats.ulInvoluntarySwitches;
+        stats->load         =   tskStats.ulWindowLoad;
+    }while(0);
+
+    return ret;
+#else
+    (void)thread_id;
+    (void)stats;
+    return (osError);
+#endif
+}
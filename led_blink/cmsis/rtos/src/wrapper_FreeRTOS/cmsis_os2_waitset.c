@@ -0,0 +1,391 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  CMSIS RTOS V2 implement via FreeRTOS
+**************************************************************/
+/** 
+ * @file        cmsis_os2_waitset.c
+ * @brief       Wait on several Message Queue, Semaphore and Event Flags objects at once,
+ *              built on FreeRTOS queue sets.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include "cmsis_os2_dev.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "event_groups.h"
+
+#if( configUSE_QUEUE_SETS == 1 )
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/** 
+ * @brief               Create and Initialize a Wait Set object.
+ * @param[in]           count           number of events the set can hold: the sum of the lengths of
+ *                                      the member message queues, the maximum counts of the member
+ *                                      semaphores, plus one for each member event flags object.
+ * @param[in]           attr            wait set attributes; NULL: default values.
+ * @return              wait set ID for reference by other functions or NULL in case of error.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osWaitSetId_t osWaitSetNew (
+    uint32_t                    count,
+    const osWaitSetAttr_t*      attr    )
+{
+    QueueSetHandle_t    ret         =   NULL;
+    int32_t             dynamic_cb  =   1;
+    int32_t             dynamic_mq  =   1;
+
+    do
+    {
+        if( (IS_IRQ()) || (!count) )
+        {
+            ret =   NULL;
+            break;
+        }
+        if( (attr) && (attr->cb_mem) && (0 < attr->cb_size) && (sizeof(StaticQueue_t) > attr->cb_size) )
+        {
+            ret =   NULL;
+            break;
+        }
+        if( (attr) && (attr->mq_mem) && (0 < attr->mq_size) && (osWaitSetMemSize(count) > attr->mq_size) )
+        {
+            ret =   NULL;
+            break;
+        }
+        if( attr && attr->cb_mem && attr->cb_size )
+        {
+            dynamic_cb  =   0;
+        }
+        if( attr && attr->mq_mem && attr->mq_size )
+        {
+            dynamic_mq  =   0;
+        }
+        if( (!dynamic_cb) && (!dynamic_mq) )
+        {
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+            /* use memory allowed by user */
+            ret =   xQueueCreateSetStatic(count,
+                                        (uint8_t*)attr->mq_mem,
+                                        (StaticQueue_t*)attr->cb_mem );
+#else
+            ret =   NULL;
+#endif
+        }
+        else if( dynamic_cb && dynamic_mq )
+        {
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            /* use memory alloc in heap */
+            ret =   xQueueCreateSet(count);
+#else
+            ret =   NULL;
+#endif
+        }
+        else
+        {
+            /* FreeRTOS do not support this mode */
+            ret =   NULL;
+        }
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+        /* register the name so kernel aware tools can show it */
+        if( (ret) && (attr) && (attr->name) )
+        {
+            vQueueAddToRegistry(ret, attr->name);
+        }
+#endif
+    }while(0);
+
+    return (osWaitSetId_t)ret;
+}
+
+/** 
+ * @brief               Add a Message Queue or Semaphore object to a Wait Set.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @param[in]           object_id       message queue ID obtained by \ref osMessageQueueNew or
+ *                                      semaphore ID obtained by \ref osSemaphoreNew.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     the object is a member of a set already or is not empty.
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Mutex objects can not be added. A semaphore must have no tokens when added.
+ */
+extern osStatus_t osWaitSetAdd (
+    osWaitSetId_t       set_id,
+    void*               object_id   )
+{
+    osStatus_t  ret =   osError;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!set_id) || (!object_id) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xQueueAddToSet((QueueSetMemberHandle_t)object_id, (QueueSetHandle_t)set_id))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+/** 
+ * @brief               Remove a Message Queue or Semaphore object from a Wait Set.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @param[in]           object_id       object added by \ref osWaitSetAdd.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     the object is not a member of the set or is not empty.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osWaitSetRemove (
+    osWaitSetId_t       set_id,
+    void*               object_id   )
+{
+    osStatus_t  ret =   osError;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!set_id) || (!object_id) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xQueueRemoveFromSet((QueueSetMemberHandle_t)object_id, (QueueSetHandle_t)set_id))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+/** 
+ * @brief               Add an Event Flags object to a Wait Set.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @param[in]           ef_id           event flags ID obtained by \ref osEventFlagsNew.
+ * @param[in]           flags           flags that make the object ready, any of them.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     the object is a member of a set already.
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                The object is reported once, then again only after its flags were read
+ *                      by \ref osEventFlagsWait, \ref osEventFlagsClear or \ref osEventFlagsGet
+ *                      from a thread.
+ */
+extern osStatus_t osWaitSetAddEventFlags (
+    osWaitSetId_t       set_id,
+    osEventFlagsId_t    ef_id,
+    uint32_t            flags   )
+{
+    osStatus_t  ret =   osError;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!set_id) || (!ef_id) || (!flags) || (flags & osFlagsError) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xEventGroupAddToSet((EventGroupHandle_t)ef_id, (EventBits_t)flags, (QueueSetHandle_t)set_id))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+/** 
+ * @brief               Remove an Event Flags object from a Wait Set.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @param[in]           ef_id           event flags ID added by \ref osWaitSetAddEventFlags.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @retval              osErrorResource     the object is not a member of the set.
+ * @author              agent@local
+ * @date                2026/10/19
+ */
+extern osStatus_t osWaitSetRemoveEventFlags (
+    osWaitSetId_t       set_id,
+    osEventFlagsId_t    ef_id   )
+{
+    osStatus_t  ret =   osError;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if( (!set_id) || (!ef_id) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(pdPASS != xEventGroupRemoveFromSet((EventGroupHandle_t)ef_id, (QueueSetHandle_t)set_id))
+        {
+            ret =   osErrorResource;
+            break;
+        }
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+/** 
+ * @brief               Wait until one of the objects of a Wait Set is ready or timeout.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @param[out]          object_id       pointer to buffer for the ID of the ready object.
+ * @param[in]           timeout         \ref CMSIS_RTOS_TimeOutValue or 0 in case of no time-out.
+ * @retval              osOK
+ * @retval              osErrorParameter
+ * @retval              osErrorResource
+ * @retval              osErrorTimeout
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Only reports the object, read it with a timeout of 0 afterwards.
+ *                      A message or token taken without going through the set still leaves
+ *                      its event in the set, so the read can fail.
+ */
+extern osStatus_t osWaitSetWait (
+    osWaitSetId_t       set_id,
+    void**              object_id,
+    uint32_t            timeout )
+{
+    osStatus_t              ret         =   osError;
+    QueueSetMemberHandle_t  member      =   NULL;
+    TickType_t              xBlockTime  =   (osWaitForever==timeout)?portMAX_DELAY:timeout;
+
+    do
+    {
+        if( (!set_id) || (!object_id) )
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        if(IS_IRQ())
+        {
+            if(timeout)
+            {
+                ret =   osErrorParameter;
+                break;
+            }
+            member  =   xQueueSelectFromSetFromISR((QueueSetHandle_t)set_id);
+        }
+        else
+        {
+            member  =   xQueueSelectFromSet((QueueSetHandle_t)set_id, xBlockTime);
+        }
+        *object_id  =   (void*)member;
+        if(!member)
+        {
+            if( (timeout) && (!IS_IRQ()) )
+            {
+                ret =   osErrorTimeout;
+            }
+            else
+            {
+                ret =   osErrorResource;
+            }
+            break;
+        }
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+/** 
+ * @brief               Delete a Wait Set object.
+ * @param[in]           set_id          wait set ID obtained by \ref osWaitSetNew.
+ * @retval              osOK
+ * @retval              osErrorISR
+ * @retval              osErrorParameter
+ * @author              agent@local
+ * @date                2026/10/19
+ * @note                Remove all members first.
+ */
+extern osStatus_t osWaitSetDelete (
+    osWaitSetId_t       set_id  )
+{
+    osStatus_t  ret =   osError;
+
+    do
+    {
+        if(IS_IRQ())
+        {
+            ret =   osErrorISR;
+            break;
+        }
+        if(!set_id)
+        {
+            ret =   osErrorParameter;
+            break;
+        }
+        vQueueDelete((QueueHandle_t)set_id);
+        ret =   osOK;
+    }while(0);
+
+    return ret;
+}
+
+#endif /* configUSE_QUEUE_SETS */
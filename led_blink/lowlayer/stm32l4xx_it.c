@@ -37,6 +37,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32l4xx_it.h"
+#include "FreeRTOSConfig.h"
 
 /** @addtogroup STM32L4xx_LL_Examples
   * @{
@@ -69,9 +70,11 @@ void NMI_Handler(void)
 
 /**
   * @brief  This function handles Hard Fault exception.
+  * @note   Replaced by the FreeRTOS crash dump when it is enabled.
   * @param  None
   * @retval None
   */
+#if( configUSE_CRASH_DUMP == 0 )
 void HardFault_Handler(void)
 {
 
@@ -80,12 +83,16 @@ void HardFault_Handler(void)
   {
   }
 }
+#endif
 
 /**
   * @brief  This function handles Memory Manage exception.
+  * @note   Replaced by the FreeRTOS crash dump or by the MPU stack guard of
+  *         the FreeRTOS port when either of them is enabled.
   * @param  None
   * @retval None
   */
+#if( ( configUSE_CRASH_DUMP == 0 ) && ( configUSE_MPU_STACK_GUARD == 0 ) )
 void MemManage_Handler(void)
 {
   /* Go to infinite loop when Memory Manage exception occurs */
@@ -93,12 +100,15 @@ void MemManage_Handler(void)
   {
   }
 }
+#endif
 
 /**
   * @brief  This function handles Bus Fault exception.
+  * @note   Replaced by the FreeRTOS crash dump when it is enabled.
   * @param  None
   * @retval None
   */
+#if( configUSE_CRASH_DUMP == 0 )
 void BusFault_Handler(void)
 {
   /* Go to infinite loop when Bus Fault exception occurs */
@@ -106,12 +116,15 @@ void BusFault_Handler(void)
   {
   }
 }
+#endif
 
 /**
   * @brief  This function handles Usage Fault exception.
+  * @note   Replaced by the FreeRTOS crash dump when it is enabled.
   * @param  None
   * @retval None
   */
+#if( configUSE_CRASH_DUMP == 0 )
 void UsageFault_Handler(void)
 {
   /* Go to infinite loop when Usage Fault exception occurs */
@@ -119,6 +132,7 @@ void UsageFault_Handler(void)
   {
   }
 }
+#endif
 
 /**
   * @brief  This function handles SVCall exception.
@@ -0,0 +1,377 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        delayed_bench.c
+ * @brief       host benchmark of the delayed task timing wheel against the sorted lists.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * tasks.c needs the Cortex-M port, so this bench copies the two delayed task
+ * paths of configUSE_DELAYED_TASK_WHEEL onto the kernel's own list.c: the
+ * insertion of prvAddCurrentTaskToDelayedList() and the expiry of
+ * xTaskIncrementTick(), including the list switch when the tick overflows.
+ *
+ * Every simulated task delays for a pseudo random 1 to 200 ticks, and delays
+ * again as soon as it wakes. The tick count starts half a run before it
+ * overflows. Both schemes see the same delays and must wake every task on
+ * exactly its wake time, and the same number of times. The tick figure is
+ * the expiry plus the new delays of the tasks it woke, averaged over the
+ * run. The insert figure is one more task inserted among the others at the
+ * end of the run and removed again, the removal costs the same in both.
+ * Run "make" in this directory, then ./delayed_bench [ticks].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#define _POSIX_C_SOURCE     199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_MAX_TASKS     (64U)
+#define BENCH_MAX_DELAY     (200U)
+#define BENCH_INSERTS       (1000000U)
+#define BENCH_WHEEL         (0U)
+#define BENCH_LIST          (1U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* the part of a TCB the delayed lists use */
+typedef struct
+{
+    ListItem_t  item;
+    uint32_t    rng;        /*!< xorshift state of its delays */
+}BENCH_TASK;
+
+/* what one run found */
+typedef struct
+{
+    uint32_t    wakes;
+    uint32_t    wrong;      /*!< tasks woken on another tick than their wake time */
+    double      tick;       /*!< ns per tick */
+    double      insert;     /*!< ns per insertion and removal */
+}BENCH_RESULT;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static BENCH_TASK   g_Tasks[BENCH_MAX_TASKS];
+static BENCH_TASK   g_Probe;
+static BENCH_TASK*  g_Woken[BENCH_MAX_TASKS];
+static uint32_t     g_WokenCount;
+static uint32_t     g_Wrong;
+
+/* configUSE_DELAYED_TASK_WHEEL == 1 */
+static List_t       g_Wheel[configDELAYED_TASK_WHEEL_SIZE];
+
+/* configUSE_DELAYED_TASK_WHEEL == 0 */
+static List_t       g_Delayed1;
+static List_t       g_Delayed2;
+static List_t*      g_pxDelayed;
+static List_t*      g_pxOverflow;
+static TickType_t   g_NextUnblock;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static TickType_t bench_delay   (
+    BENCH_TASK* task    )
+{
+    task->rng   ^=  task->rng << 13;
+    task->rng   ^=  task->rng >> 17;
+    task->rng   ^=  task->rng << 5;
+    return (TickType_t)(1U + (task->rng % BENCH_MAX_DELAY));
+}
+
+/* stands in for prvAddTaskToReadyList(), the task delays again after the tick */
+static void bench_woken (
+    BENCH_TASK* task,
+    TickType_t  now )
+{
+    if(listGET_LIST_ITEM_VALUE(&task->item) != now)
+    {
+        g_Wrong++;
+    }
+    g_Woken[g_WokenCount++] =   task;
+}
+
+/* prvAddCurrentTaskToDelayedWheel() */
+static void bench_wheel_insert  (
+    BENCH_TASK* task,
+    TickType_t  xTimeToWake,
+    TickType_t  xConstTickCount )
+{
+    if(xTimeToWake == xConstTickCount)
+    {
+        xTimeToWake++;
+    }
+    listSET_LIST_ITEM_VALUE(&task->item, xTimeToWake);
+    vListInsertEnd(&g_Wheel[xTimeToWake & (configDELAYED_TASK_WHEEL_SIZE - 1U)], &task->item);
+}
+
+/* the wheel part of xTaskIncrementTick() */
+static void bench_wheel_tick    (
+    TickType_t  xConstTickCount )
+{
+    List_t* const   pxSlot  =   &g_Wheel[xConstTickCount & (configDELAYED_TASK_WHEEL_SIZE - 1U)];
+    ListItem_t*     pxItem;
+    ListItem_t*     pxNextItem;
+
+    pxItem  =   listGET_HEAD_ENTRY(pxSlot);
+    while(pxItem != (ListItem_t*)listGET_END_MARKER(pxSlot))
+    {
+        pxNextItem  =   listGET_NEXT(pxItem);
+        if(listGET_LIST_ITEM_VALUE(pxItem) == xConstTickCount)
+        {
+            (void)uxListRemove(pxItem);
+            bench_woken((BENCH_TASK*)listGET_LIST_ITEM_OWNER(pxItem), xConstTickCount);
+        }
+        pxItem  =   pxNextItem;
+    }
+}
+
+/* prvResetNextTaskUnblockTime() */
+static void bench_list_reset_next   (void)
+{
+    if(listLIST_IS_EMPTY(g_pxDelayed) != pdFALSE)
+    {
+        g_NextUnblock   =   portMAX_DELAY;
+    }
+    else
+    {
+        g_NextUnblock   =   listGET_ITEM_VALUE_OF_HEAD_ENTRY(g_pxDelayed);
+    }
+}
+
+/* the sorted list part of prvAddCurrentTaskToDelayedList() */
+static void bench_list_insert   (
+    BENCH_TASK* task,
+    TickType_t  xTimeToWake,
+    TickType_t  xConstTickCount )
+{
+    listSET_LIST_ITEM_VALUE(&task->item, xTimeToWake);
+    if(xTimeToWake < xConstTickCount)
+    {
+        vListInsert(g_pxOverflow, &task->item);
+    }
+    else
+    {
+        vListInsert(g_pxDelayed, &task->item);
+        if(xTimeToWake < g_NextUnblock)
+        {
+            g_NextUnblock   =   xTimeToWake;
+        }
+    }
+}
+
+/* the sorted list part of xTaskIncrementTick(), with taskSWITCH_DELAYED_LISTS() */
+static void bench_list_tick (
+    TickType_t  xConstTickCount )
+{
+    List_t*     pxTemp;
+    BENCH_TASK* task;
+    TickType_t  xItemValue;
+
+    if(xConstTickCount == (TickType_t)0U)
+    {
+        pxTemp          =   g_pxDelayed;
+        g_pxDelayed     =   g_pxOverflow;
+        g_pxOverflow    =   pxTemp;
+        bench_list_reset_next();
+    }
+    if(xConstTickCount >= g_NextUnblock)
+    {
+        for(;;)
+        {
+            if(listLIST_IS_EMPTY(g_pxDelayed) != pdFALSE)
+            {
+                g_NextUnblock   =   portMAX_DELAY;
+                break;
+            }
+            task        =   (BENCH_TASK*)listGET_OWNER_OF_HEAD_ENTRY(g_pxDelayed);
+            xItemValue  =   listGET_LIST_ITEM_VALUE(&task->item);
+            if(xConstTickCount < xItemValue)
+            {
+                g_NextUnblock   =   xItemValue;
+                break;
+            }
+            (void)uxListRemove(&task->item);
+            bench_woken(task, xConstTickCount);
+        }
+    }
+}
+
+/* delays the task of scheme when it is due at wake */
+static void bench_insert    (
+    uint32_t    scheme,
+    BENCH_TASK* task,
+    TickType_t  wake,
+    TickType_t  now )
+{
+    if(BENCH_WHEEL == scheme)
+    {
+        bench_wheel_insert(task, wake, now);
+    }
+    else
+    {
+        bench_list_insert(task, wake, now);
+    }
+}
+
+/* one run of ticks ticks with tasks tasks */
+static void bench_run   (
+    uint32_t        scheme,
+    uint32_t        tasks,
+    uint32_t        ticks,
+    BENCH_RESULT*   result  )
+{
+    TickType_t  now     =   (TickType_t)0U - (TickType_t)(ticks / 2U);
+    double      start;
+    uint32_t    i;
+    uint32_t    n;
+
+    for(i = 0; i < configDELAYED_TASK_WHEEL_SIZE; i++)
+    {
+        vListInitialise(&g_Wheel[i]);
+    }
+    vListInitialise(&g_Delayed1);
+    vListInitialise(&g_Delayed2);
+    g_pxDelayed     =   &g_Delayed1;
+    g_pxOverflow    =   &g_Delayed2;
+    g_NextUnblock   =   portMAX_DELAY;
+    g_Wrong         =   0;
+    result->wakes   =   0;
+    for(i = 0; i < tasks; i++)
+    {
+        vListInitialiseItem(&g_Tasks[i].item);
+        listSET_LIST_ITEM_OWNER(&g_Tasks[i].item, &g_Tasks[i]);
+        g_Tasks[i].rng  =   0x9E3779B9U * (i + 1U);
+        bench_insert(scheme, &g_Tasks[i], now + bench_delay(&g_Tasks[i]), now);
+    }
+
+    start   =   bench_now();
+    for(n = 0; n < ticks; n++)
+    {
+        now++;
+        g_WokenCount    =   0;
+        if(BENCH_WHEEL == scheme)
+        {
+            bench_wheel_tick(now);
+        }
+        else
+        {
+            bench_list_tick(now);
+        }
+        result->wakes   +=  g_WokenCount;
+        for(i = 0; i < g_WokenCount; i++)
+        {
+            bench_insert(scheme, g_Woken[i], now + bench_delay(g_Woken[i]), now);
+        }
+    }
+    result->tick    =   (bench_now() - start) / (double)ticks;
+    result->wrong   =   g_Wrong;
+
+    /* the others stay where the run left them */
+    vListInitialiseItem(&g_Probe.item);
+    listSET_LIST_ITEM_OWNER(&g_Probe.item, &g_Probe);
+    g_Probe.rng =   0x2545F491U;
+    start   =   bench_now();
+    for(n = 0; n < BENCH_INSERTS; n++)
+    {
+        bench_insert(scheme, &g_Probe, now + bench_delay(&g_Probe), now);
+        (void)uxListRemove(&g_Probe.item);
+    }
+    result->insert  =   (bench_now() - start) / (double)BENCH_INSERTS;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (
+    int     argc,
+    char**  argv    )
+{
+    static const uint32_t   counts[]    =   { 4U, 16U, 64U };
+    static const char*      names[]     =   { "wheel", "sorted" };
+    BENCH_RESULT            result[2];
+    uint32_t                ticks       =   1000000U;
+    uint32_t                wrong       =   0;
+    uint32_t                c;
+    uint32_t                s;
+
+    if(argc > 1)
+    {
+        ticks   =   (uint32_t)strtoul(argv[1], NULL, 0);
+        if(ticks < (2U * BENCH_MAX_DELAY))
+        {
+            fprintf(stderr, "ticks must be at least %u\n", 2U * BENCH_MAX_DELAY);
+            return 1;
+        }
+    }
+
+    printf("wheel of %u slots, delays of 1 to %u ticks, %u ticks across the overflow\n\n",
+           (unsigned)configDELAYED_TASK_WHEEL_SIZE, BENCH_MAX_DELAY, ticks);
+    printf("tasks scheme   ns/tick   ns/insert+remove      wakes  wrong\n");
+    for(c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+        for(s = BENCH_WHEEL; s <= BENCH_LIST; s++)
+        {
+            bench_run(s, counts[c], ticks, &result[s]);
+            wrong   +=  result[s].wrong;
+            printf("%5u %-7s %8.1f %18.1f %10u %6u\n", counts[c], names[s],
+                   result[s].tick, result[s].insert, result[s].wakes, result[s].wrong);
+        }
+        /* same delays, so the same wakeups */
+        if(result[BENCH_WHEEL].wakes != result[BENCH_LIST].wakes)
+        {
+            printf("%5u tasks: the schemes woke tasks a different number of times\n", counts[c]);
+            wrong++;
+        }
+    }
+
+    return (0U == wrong) ? 0 : 1;
+}
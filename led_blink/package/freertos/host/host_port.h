@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        host_port.h
+ * @brief       single threaded host stand in for the Cortex-M portmacro.h.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * The Makefile passes it with -include, so it takes the include guard of
+ * portmacro.h before FreeRTOS.h pulls that in, and the kernel sources build
+ * on the host without the BASEPRI and PendSV code. Masking interrupts only
+ * counts, a yield does nothing. taskDISABLE_INTERRUPTS() is only reached
+ * through a failed configASSERT(), the bench reports it and exits.
+ */
+
+#ifndef _HOST_PORT_H_
+#define _HOST_PORT_H_
+
+#define PORTMACRO_H
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdint.h>
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define portCHAR                                char
+#define portFLOAT                               float
+#define portDOUBLE                              double
+#define portLONG                                long
+#define portSHORT                               short
+#define portSTACK_TYPE                          uint32_t
+#define portBASE_TYPE                           long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY                           ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC                 1
+#define portSTACK_GROWTH                        ( -1 )
+#define portTICK_PERIOD_MS                      ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT                      8
+
+#define portYIELD()
+#define portEND_SWITCHING_ISR( xSwitchRequired ) ( ( void ) ( xSwitchRequired ) )
+#define portYIELD_FROM_ISR( x )                 portEND_SWITCHING_ISR( x )
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ulPortHostRaiseMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortHostSetMask( x )
+#define portDISABLE_INTERRUPTS()                vPortHostAssert()
+#define portENABLE_INTERRUPTS()                 vPortHostSetMask( 0 )
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+#define portINLINE                              __inline
+#define portFORCE_INLINE                        inline __attribute__(( always_inline))
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+/* defined by the bench */
+void vPortEnterCritical( void );
+void vPortExitCritical( void );
+uint32_t ulPortHostRaiseMask( void );
+void vPortHostSetMask( uint32_t ulMask );
+void vPortHostAssert( void );
+
+#endif /* _HOST_PORT_H_ */
@@ -0,0 +1,397 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+ 
+/**************************************************************
+**  STM32 MCU program develop platform
+**************************************************************/
+/** 
+ * @file        stream_bench.c
+ * @brief       host benchmark of the stream buffer zero copy calls against send and receive.
+ * @author      agent@local
+ *
+ * @version     00.00.01 
+ *              - 2026/10/19 : agent@local 
+ *                  -# New
+ *
+ * Runs the kernel's own stream_buffer.c on host_port.h, with the task calls
+ * it makes stubbed out: nothing blocks and no task ever waits, so every call
+ * takes its non blocking path, as it does when the reader keeps up.
+ *
+ * A producer and a consumer take turns on one stream buffer, a chunk at a
+ * time. The producer's data comes from a source block, the way a peripheral
+ * delivers it. The copy scheme fills a staging buffer from the source and
+ * hands it to xStreamBufferSend(), the consumer xStreamBufferReceive()s into
+ * its own buffer and checks that. The zero copy scheme fills the spans of
+ * xStreamBufferAcquireWrite() from the source, xStreamBufferCommitWrite()s
+ * them, and the consumer checks the spans of xStreamBufferAcquireRead() in
+ * place before xStreamBufferReleaseRead(). The mixed scheme alternates a
+ * zero copy producer with a copying consumer and the other way round, so the
+ * spans have to agree with where send and receive put the data. The buffer
+ * size is not a multiple of the chunk, so chunks keep crossing the end of
+ * the storage area. Every byte read must be the byte written at that
+ * position of the stream.
+ * Run "make" in this directory, then ./stream_bench [MiB per run].
+ */
+
+/**************************************************************
+**  Include
+**************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/**************************************************************
+**  Symbol
+**************************************************************/
+
+#define BENCH_BUFFER_SIZE   (1000U)
+#define BENCH_MAX_CHUNK     (768U)
+#define BENCH_SOURCE_SIZE   (4096U)
+#define BENCH_REPEATS       (5U)
+#define BENCH_COPY          (0U)
+#define BENCH_ZERO_COPY     (1U)
+#define BENCH_MIXED         (2U)
+
+/**************************************************************
+**  Structure
+**************************************************************/
+
+/* what one run found */
+typedef struct
+{
+    uint32_t    wrong;      /*!< chunks that did not read back as written */
+    uint32_t    split;      /*!< chunks written across the end of the storage area */
+    double      rate;       /*!< MB/s through the buffer */
+}BENCH_RESULT;
+
+/**************************************************************
+**  Global Param
+**************************************************************/
+
+static uint8_t              g_Storage[BENCH_BUFFER_SIZE];
+static StaticStreamBuffer_t g_Control;
+static uint8_t              g_Source[BENCH_SOURCE_SIZE + BENCH_MAX_CHUNK];
+static uint8_t              g_Staging[BENCH_MAX_CHUNK];
+static uint8_t              g_Received[BENCH_MAX_CHUNK];
+static UBaseType_t          g_Critical;
+static UBaseType_t          g_Suspended;
+
+/**************************************************************
+**  Function
+**************************************************************/
+
+static double bench_now (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* the producer of the copy scheme, returns 1 when the chunk did not fit */
+static uint32_t bench_send  (
+    StreamBufferHandle_t    sb,
+    const uint8_t*          src,
+    size_t                  chunk   )
+{
+    (void)memcpy(g_Staging, src, chunk);
+    return (xStreamBufferSend(sb, g_Staging, chunk, 0) == chunk) ? 0U : 1U;
+}
+
+/* the consumer of the copy scheme, returns 1 when the chunk read back wrong */
+static uint32_t bench_receive   (
+    StreamBufferHandle_t    sb,
+    const uint8_t*          src,
+    size_t                  chunk   )
+{
+    if(xStreamBufferReceive(sb, g_Received, chunk, 0) != chunk)
+    {
+        return 1U;
+    }
+    return (0 == memcmp(g_Received, src, chunk)) ? 0U : 1U;
+}
+
+/* the producer of the zero copy scheme, returns 1 when the chunk did not fit */
+static uint32_t bench_commit    (
+    StreamBufferHandle_t    sb,
+    const uint8_t*          src,
+    size_t                  chunk   )
+{
+    StreamBufferSpans_t spans;
+    size_t              first;
+
+    if(xStreamBufferAcquireWrite(sb, &spans, 0) < chunk)
+    {
+        return 1U;
+    }
+    first   =   (chunk < spans.xLength[0]) ? chunk : spans.xLength[0];
+    (void)memcpy(spans.pucData[0], src, first);
+    (void)memcpy(spans.pucData[1], &src[first], chunk - first);
+    (void)xStreamBufferCommitWrite(sb, chunk);
+    return 0U;
+}
+
+/* the consumer of the zero copy scheme, returns 1 when the chunk read back wrong */
+static uint32_t bench_release   (
+    StreamBufferHandle_t    sb,
+    const uint8_t*          src,
+    size_t                  chunk   )
+{
+    StreamBufferSpans_t spans;
+    size_t              first;
+    uint32_t            wrong   =   0;
+
+    if(xStreamBufferAcquireRead(sb, &spans, 0) != chunk)
+    {
+        return 1U;
+    }
+    first   =   (chunk < spans.xLength[0]) ? chunk : spans.xLength[0];
+    if( (0 != memcmp(spans.pucData[0], src, first))
+     || (0 != memcmp(spans.pucData[1], &src[first], chunk - first)) )
+    {
+        wrong   =   1U;
+    }
+    (void)xStreamBufferReleaseRead(sb, chunk);
+    return wrong;
+}
+
+/* one run of bytes bytes in chunks of chunk */
+static void bench_run   (
+    uint32_t        scheme,
+    size_t          chunk,
+    uint64_t        bytes,
+    BENCH_RESULT*   result  )
+{
+    StreamBufferHandle_t    sb;
+    uint64_t                chunks  =   bytes / chunk;
+    uint64_t                n;
+    const uint8_t*          src;
+    size_t                  offset  =   0;
+    size_t                  head    =   0;
+    double                  start;
+
+    sb  =   xStreamBufferCreateStatic(BENCH_BUFFER_SIZE, 1, g_Storage, &g_Control);
+    result->wrong   =   0;
+    result->split   =   0;
+
+    start   =   bench_now();
+    for(n = 0; n < chunks; n++)
+    {
+        src =   &g_Source[offset];
+        if( (BENCH_COPY == scheme) || ((BENCH_MIXED == scheme) && (0U != (n & 1U))) )
+        {
+            result->wrong   +=  bench_send(sb, src, chunk);
+        }
+        else
+        {
+            result->wrong   +=  bench_commit(sb, src, chunk);
+        }
+        if( (BENCH_COPY == scheme) || ((BENCH_MIXED == scheme) && (0U == (n & 1U))) )
+        {
+            result->wrong   +=  bench_receive(sb, src, chunk);
+        }
+        else
+        {
+            result->wrong   +=  bench_release(sb, src, chunk);
+        }
+        offset  +=  chunk;
+        if(offset >= BENCH_SOURCE_SIZE)
+        {
+            offset  -=  BENCH_SOURCE_SIZE;
+        }
+        head    +=  chunk;
+        if(head >= BENCH_BUFFER_SIZE)
+        {
+            head    -=  BENCH_BUFFER_SIZE;
+            result->split   +=  (0U != head) ? 1U : 0U;
+        }
+    }
+    result->rate    =   (double)(chunks * chunk) * 1e3 / (bench_now() - start);
+
+    vStreamBufferDelete(sb);
+}
+
+/**************************************************************
+**  Kernel
+**************************************************************/
+
+void vPortEnterCritical( void )
+{
+    g_Critical++;
+}
+
+void vPortExitCritical( void )
+{
+    g_Critical--;
+}
+
+uint32_t ulPortHostRaiseMask( void )
+{
+    return 0U;
+}
+
+void vPortHostSetMask( uint32_t ulMask )
+{
+    (void)ulMask;
+}
+
+void vPortHostAssert( void )
+{
+    printf("configASSERT() failed in stream_buffer.c\n");
+    exit(1);
+}
+
+void vTaskSuspendAll( void )
+{
+    g_Suspended++;
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+    g_Suspended--;
+    return pdFALSE;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle( void )
+{
+    return NULL;
+}
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    (void)memset(pxTimeOut, 0, sizeof(*pxTimeOut));
+}
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
+{
+    (void)pxTimeOut;
+    *pxTicksToWait  =   0;
+    return pdTRUE;
+}
+
+BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+{
+    (void)xTask;
+    return pdFALSE;
+}
+
+BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+{
+    (void)ulBitsToClearOnEntry;
+    (void)ulBitsToClearOnExit;
+    (void)pulNotificationValue;
+    (void)xTicksToWait;
+    return pdFALSE;
+}
+
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+{
+    (void)xTaskToNotify;
+    (void)ulValue;
+    (void)eAction;
+    (void)pulPreviousNotificationValue;
+    return pdPASS;
+}
+
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+{
+    (void)xTaskToNotify;
+    (void)ulValue;
+    (void)eAction;
+    (void)pulPreviousNotificationValue;
+    (void)pxHigherPriorityTaskWoken;
+    return pdPASS;
+}
+
+/**************************************************************
+**  Interface
+**************************************************************/
+
+int main    (
+    int     argc,
+    char**  argv    )
+{
+    static const size_t     chunks[]    =   { 16U, 64U, 256U, BENCH_MAX_CHUNK };
+    static const char*      names[]     =   { "copy", "zero copy", "mixed" };
+    BENCH_RESULT            result[3];
+    BENCH_RESULT            run;
+    uint64_t                bytes       =   64U << 20;
+    uint32_t                wrong       =   0;
+    uint32_t                c;
+    uint32_t                s;
+    uint32_t                i;
+    uint32_t                r;
+
+    if(argc > 1)
+    {
+        bytes   =   (uint64_t)strtoul(argv[1], NULL, 0) << 20;
+        if(0U == bytes)
+        {
+            fprintf(stderr, "MiB per run must be at least 1\n");
+            return 1;
+        }
+    }
+
+    /* not periodic in 256, so data read from the wrong position fails the compare */
+    for(i = 0; i < sizeof(g_Source); i++)
+    {
+        g_Source[i] =   (uint8_t)((i % BENCH_SOURCE_SIZE) ^ ((i % BENCH_SOURCE_SIZE) >> 8));
+    }
+
+    printf("stream buffer of %u bytes, %u MiB per run, best of %u runs\n\n",
+           BENCH_BUFFER_SIZE, (unsigned)(bytes >> 20), BENCH_REPEATS);
+    printf("chunk scheme         MB/s     split  wrong\n");
+    for(c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++)
+    {
+        /* the best rate of the repeats, the schemes take turns */
+        (void)memset(result, 0, sizeof(result));
+        for(r = 0; r < BENCH_REPEATS; r++)
+        {
+            for(s = BENCH_COPY; s <= BENCH_MIXED; s++)
+            {
+                bench_run(s, chunks[c], bytes, &run);
+                result[s].wrong +=  run.wrong;
+                result[s].split =   run.split;
+                if(run.rate > result[s].rate)
+                {
+                    result[s].rate  =   run.rate;
+                }
+            }
+        }
+        for(s = BENCH_COPY; s <= BENCH_MIXED; s++)
+        {
+            wrong   +=  result[s].wrong;
+            printf("%5u %-9s %9.1f %9u %6u\n", (unsigned)chunks[c], names[s],
+                   result[s].rate, result[s].split, result[s].wrong);
+        }
+        printf("%5u zero copy is %.2fx the rate of copy\n", (unsigned)chunks[c],
+               result[BENCH_ZERO_COPY].rate / result[BENCH_COPY].rate);
+    }
+    if( (0U != g_Critical) || (0U != g_Suspended) )
+    {
+        printf("critical sections or scheduler suspensions left unbalanced\n");
+        wrong++;
+    }
+
+    return (0U == wrong) ? 0 : 1;
+}
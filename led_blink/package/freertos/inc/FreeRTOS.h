@@ -722,6 +722,44 @@ extern "C" {
 	#define portPRIVILEGE_BIT ( ( UBaseType_t ) 0x00 )
 #endif
 
+#ifndef configUSE_TASK_FPU_OPT_OUT
+	#define configUSE_TASK_FPU_OPT_OUT 0
+#endif
+
+#if( ( configUSE_TASK_FPU_OPT_OUT == 1 ) && !defined( portSELECT_FPU_CONTEXT ) )
+	#error configUSE_TASK_FPU_OPT_OUT is set to 1 but the port in use does not support it
+#endif
+
+#ifndef portNO_FPU_BIT
+	#define portNO_FPU_BIT ( ( UBaseType_t ) 0x00 )
+#endif
+
+#ifndef configUSE_MPU_STACK_GUARD
+	#define configUSE_MPU_STACK_GUARD 0
+#endif
+
+#ifndef configMPU_STACK_GUARD_REGION
+	#define configMPU_STACK_GUARD_REGION 7
+#endif
+
+#ifndef configMPU_STACK_GUARD_SIZE
+	#define configMPU_STACK_GUARD_SIZE 32
+#endif
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	#if( !defined( portSTACK_GUARD_REGION ) || ( portUSING_MPU_WRAPPERS == 1 ) )
+		#error configUSE_MPU_STACK_GUARD is set to 1 but the port in use does not support it
+	#endif
+
+	#if( portSTACK_GROWTH > 0 )
+		#error configUSE_MPU_STACK_GUARD requires a stack that grows down
+	#endif
+
+	#if( ( configMPU_STACK_GUARD_SIZE < 32 ) || ( ( configMPU_STACK_GUARD_SIZE & ( configMPU_STACK_GUARD_SIZE - 1 ) ) != 0 ) )
+		#error configMPU_STACK_GUARD_SIZE must be a power of two of at least 32
+	#endif
+#endif
+
 #ifndef portYIELD_WITHIN_API
 	#define portYIELD_WITHIN_API portYIELD
 #endif
@@ -818,6 +856,106 @@ extern "C" {
 	#define configUSE_POSIX_ERRNO 0
 #endif
 
+#ifndef configUSE_TASK_CPU_STATS
+	#define configUSE_TASK_CPU_STATS 0
+#endif
+
+#ifndef configCPU_STATS_WINDOW_TICKS
+	#define configCPU_STATS_WINDOW_TICKS 1000
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#ifndef configUSE_WORK_QUEUE
+	#define configUSE_WORK_QUEUE 0
+#endif
+
+#ifndef configWORK_QUEUE_LEVELS
+	#define configWORK_QUEUE_LEVELS 2
+#endif
+
+#ifndef configWORK_QUEUE_POOL_SIZE
+	#define configWORK_QUEUE_POOL_SIZE 32
+#endif
+
+#ifndef configWORK_QUEUE_TASK_PRIORITY
+	#define configWORK_QUEUE_TASK_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configWORK_QUEUE_STACK_DEPTH
+	#define configWORK_QUEUE_STACK_DEPTH ( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+#ifndef configUSE_WAKE_LATENCY
+	#define configUSE_WAKE_LATENCY 0
+#endif
+
+#ifndef configWAKE_LATENCY_SOURCES
+	#define configWAKE_LATENCY_SOURCES 4
+#endif
+
+#ifndef configWAKE_LATENCY_MAX_LOG2
+	#define configWAKE_LATENCY_MAX_LOG2 24
+#endif
+
+#ifndef configUSE_SRP_JOBS
+	#define configUSE_SRP_JOBS 0
+#endif
+
+#ifndef configSRP_LEVELS
+	#define configSRP_LEVELS 3
+#endif
+
+#ifndef configSRP_BASE_PRIORITY
+	#define configSRP_BASE_PRIORITY ( configMAX_PRIORITIES - configSRP_LEVELS - 1 )
+#endif
+
+#ifndef configSRP_STACK_POOL_DEPTH
+	#define configSRP_STACK_POOL_DEPTH 1024
+#endif
+
+#ifndef configSRP_EXECUTOR_STACK_DEPTH
+	#define configSRP_EXECUTOR_STACK_DEPTH 96
+#endif
+
+#ifndef configUSE_MASK_TIME
+	#define configUSE_MASK_TIME 0
+#endif
+
+#ifndef configMASK_TIME_CALLERS
+	#define configMASK_TIME_CALLERS 8
+#endif
+
+#ifndef configUSE_CRASH_DUMP
+	#define configUSE_CRASH_DUMP 0
+#endif
+
+#ifndef configCRASH_DUMP_STACK_WORDS
+	#define configCRASH_DUMP_STACK_WORDS 128
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SIZE
+	#define configDELAYED_TASK_WHEEL_SIZE 64
+#endif
+
+#ifndef configUSE_HEAP_ACCOUNTING
+	#define configUSE_HEAP_ACCOUNTING 0
+#endif
+
+#ifndef configHEAP_ACCOUNTING_SLOTS
+	#define configHEAP_ACCOUNTING_SLOTS 16
+#endif
+
+#ifndef configHEAP_ACCOUNTING_LOG_LENGTH
+	#define configHEAP_ACCOUNTING_LOG_LENGTH 64
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -856,6 +994,107 @@ extern "C" {
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( ( configUSE_TASK_CPU_STATS == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+	#error configGENERATE_RUN_TIME_STATS must be set to 1 to use configUSE_TASK_CPU_STATS
+#endif
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	#if( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configGENERATE_RUN_TIME_STATS must be set to 1, the trace recorder timestamps events with the run time counter
+	#endif
+
+	#if( ( configTRACE_RECORDER_LENGTH & ( configTRACE_RECORDER_LENGTH - 1 ) ) != 0 )
+		#error configTRACE_RECORDER_LENGTH must be a power of two
+	#endif
+#endif
+
+#if( configUSE_WORK_QUEUE == 1 )
+	#if( configUSE_TASK_NOTIFICATIONS == 0 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1, the work queue task waits on its notification
+	#endif
+
+	#if( ( configWORK_QUEUE_LEVELS < 1 ) || ( configWORK_QUEUE_LEVELS > 32 ) )
+		#error configWORK_QUEUE_LEVELS must be between 1 and 32
+	#endif
+
+	#if( configWORK_QUEUE_POOL_SIZE < 1 )
+		#error configWORK_QUEUE_POOL_SIZE must be at least 1
+	#endif
+#endif
+
+#if( configUSE_WAKE_LATENCY == 1 )
+	#if( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configGENERATE_RUN_TIME_STATS must be set to 1, wake latencies are measured with the run time counter
+	#endif
+
+	#if( ( configWAKE_LATENCY_SOURCES < 1 ) || ( configWAKE_LATENCY_SOURCES > 255 ) )
+		#error configWAKE_LATENCY_SOURCES must be between 1 and 255
+	#endif
+
+	#if( ( configWAKE_LATENCY_MAX_LOG2 < 3 ) || ( configWAKE_LATENCY_MAX_LOG2 > 32 ) )
+		#error configWAKE_LATENCY_MAX_LOG2 must be between 3 and 32
+	#endif
+#endif
+
+#if( configUSE_SRP_JOBS == 1 )
+	#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+		#error configSUPPORT_STATIC_ALLOCATION must be set to 1, the SRP executors are created in a static stack pool
+	#endif
+
+	#if( ( INCLUDE_vTaskPrioritySet == 0 ) || ( INCLUDE_uxTaskPriorityGet == 0 ) )
+		#error INCLUDE_vTaskPrioritySet and INCLUDE_uxTaskPriorityGet must be set to 1, SRP resources raise the executor priority
+	#endif
+
+	#if( ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 ) )
+		#error INCLUDE_xTaskGetSchedulerState must be set to 1 to use configUSE_SRP_JOBS
+	#endif
+
+	#if( configUSE_TASK_NOTIFICATIONS == 0 )
+		#error configUSE_TASK_NOTIFICATIONS must be set to 1, the SRP executors wait on their notification
+	#endif
+
+	#if( ( configSRP_BASE_PRIORITY < 1 ) || ( ( configSRP_BASE_PRIORITY + configSRP_LEVELS ) > configMAX_PRIORITIES ) )
+		#error configSRP_BASE_PRIORITY + configSRP_LEVELS must be between 2 and configMAX_PRIORITIES
+	#endif
+
+	#if( configSRP_LEVELS > 10 )
+		#error configSRP_LEVELS must not exceed 10
+	#endif
+#endif
+
+#if( configUSE_MASK_TIME == 1 )
+	#if( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configGENERATE_RUN_TIME_STATS must be set to 1, masked sections are timed with the run time counter
+	#endif
+
+	#if( configMASK_TIME_CALLERS < 1 )
+		#error configMASK_TIME_CALLERS must be at least 1
+	#endif
+#endif
+
+#if( configUSE_CRASH_DUMP == 1 )
+	#if( configCRASH_DUMP_STACK_WORDS < 1 )
+		#error configCRASH_DUMP_STACK_WORDS must be at least 1
+	#endif
+#endif
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 when configUSE_DELAYED_TASK_WHEEL is 1 as the wheel keeps no next unblock time
+	#endif
+	#if( ( configDELAYED_TASK_WHEEL_SIZE & ( configDELAYED_TASK_WHEEL_SIZE - 1 ) ) != 0 )
+		#error configDELAYED_TASK_WHEEL_SIZE must be a power of two
+	#endif
+#endif
+
+#if( ( configUSE_HEAP_ACCOUNTING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use configUSE_HEAP_ACCOUNTING
+#endif
+
+#if( ( configUSE_HEAP_ACCOUNTING == 1 ) && ( ( configHEAP_ACCOUNTING_SLOTS < 2 ) || ( configHEAP_ACCOUNTING_SLOTS > 255 ) ) )
+	#error configHEAP_ACCOUNTING_SLOTS must be between 2 and 255
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -1094,6 +1333,9 @@ typedef struct xSTATIC_TCB
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 		xMPU_SETTINGS	xDummy2;
 	#endif
+	#if ( configUSE_MPU_STACK_GUARD == 1 )
+		uint32_t		ulDummy28;
+	#endif
 	StaticListItem_t	xDummy3[ 2 ];
 	UBaseType_t			uxDummy5;
 	void				*pxDummy6;
@@ -1136,6 +1378,21 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configUSE_HEAP_ACCOUNTING == 1 )
+		UBaseType_t		uxDummy23;
+	#endif
+	#if ( configUSE_TASK_CPU_STATS == 1 )
+		uint64_t		ullDummy24[ 2 ];
+		uint32_t		ulDummy25[ 3 ];
+		UBaseType_t		uxDummy26;
+	#endif
+	#if ( configUSE_TASK_FPU_OPT_OUT == 1 )
+		BaseType_t		xDummy27;
+	#endif
+	#if ( configUSE_WAKE_LATENCY == 1 )
+		uint32_t		ulDummy29;
+		UBaseType_t		uxDummy30;
+	#endif
 } StaticTask_t;
 
 /*
@@ -1209,6 +1466,12 @@ typedef struct xSTATIC_EVENT_GROUP
 			uint8_t ucDummy4;
 	#endif
 
+	#if( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy5;
+		TickType_t xDummy6;
+		BaseType_t xDummy7;
+	#endif
+
 } StaticEventGroup_t;
 
 /*
@@ -54,19 +54,26 @@
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES			( 32 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 32 * 1024 ) )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 32 * 1024 ) )	/* SRAM2, the heap is the part after the retained section, see the linker script. */
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		0
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES				1
 #define configQUEUE_REGISTRY_SIZE		8
+/* Needed by the CMSIS wait sets, osWaitSetNew().  Every queue send then checks
+for a set, so it stays off unless wait sets are used. */
+#define configUSE_QUEUE_SETS			0
 #define configCHECK_FOR_STACK_OVERFLOW	0
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configUSE_MALLOC_FAILED_HOOK	0
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
+/* Per-task CPU load and switch counts, see xTaskGetCpuStats().  Needs
+configGENERATE_RUN_TIME_STATS, and replaces its per-task counter when set. */
+#define configUSE_TASK_CPU_STATS		0
+#define configCPU_STATS_WINDOW_TICKS	( 1000 )
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
@@ -82,6 +89,75 @@
 #define configSUPPORT_STATIC_ALLOCATION 1
 #define configUSE_TICKLESS_IDLE         0
 
+/* Tasks created with portNO_FPU_BIT (osThreadNoFpu) must not use the FPU.  The
+FPU registers of the last floating point task are left in place while they run
+and only saved when another floating point task is switched in.  Off until
+validated on target. */
+#define configUSE_TASK_FPU_OPT_OUT		0
+
+/* Stack overflows fault on an MPU no access region at the bottom of the running
+task's stack and are reported through vApplicationStackOverflowHook().  Off
+until validated on target. */
+#define configUSE_MPU_STACK_GUARD		0
+#define configMPU_STACK_GUARD_REGION	( 7 )
+#define configMPU_STACK_GUARD_SIZE		( 32 )
+
+/* Delayed tasks kept in a timing wheel (O(1) insertion) instead of sorted lists. */
+#define configUSE_DELAYED_TASK_WHEEL	0
+#define configDELAYED_TASK_WHEEL_SIZE	( 64 )
+
+/* Per-task heap accounting (heap_5.c only, needs dynamic allocation). */
+#define configUSE_HEAP_ACCOUNTING			0
+#define configHEAP_ACCOUNTING_SLOTS			( 16 )
+#define configHEAP_ACCOUNTING_LOG_LENGTH	( 64 )
+
+/* Binary kernel event recorder in retained SRAM2, see trace_recorder.h. */
+#define configUSE_TRACE_RECORDER			0
+#define configTRACE_RECORDER_MODE			traceMODE_SNAPSHOT
+#define configTRACE_RECORDER_LENGTH			( 512 )
+#define configTRACE_RECORDER_NAMES			( 16 )
+#define configTRACE_RECORDER_POST_TRIGGER	( 128 )
+#define configTRACE_RECORDER_SYNC_TICKS		( 1000 )
+
+/* Deferred work queue for interrupts, see workqueue.h.  When enabled, event
+flags set or cleared from an interrupt run in its task instead of the timer
+daemon. */
+#define configUSE_WORK_QUEUE				0
+#define configWORK_QUEUE_LEVELS				( 2 )
+#define configWORK_QUEUE_POOL_SIZE			( 32 )
+#define configWORK_QUEUE_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configWORK_QUEUE_STACK_DEPTH		( configMINIMAL_STACK_SIZE * 2 )
+
+/* Interrupt to task wake latency histograms, see wakelatency.h.  Stamps every
+wakeup from an interrupt and records it on the next switch in, so it is off
+unless the latencies are being investigated. */
+#define configUSE_WAKE_LATENCY				0
+#define configWAKE_LATENCY_SOURCES			( 4 )
+#define configWAKE_LATENCY_MAX_LOG2			( 24 )
+
+/* Run-to-completion jobs sharing one stack per preemption level, see srp.h.
+The pool must hold ulSrpWorstCaseStack() words plus up to one guard size of
+alignment. */
+#define configUSE_SRP_JOBS					0
+#define configSRP_LEVELS					( 3 )
+#define configSRP_BASE_PRIORITY				( 26 )
+#define configSRP_STACK_POOL_DEPTH			( 1024 )
+#define configSRP_EXECUTOR_STACK_DEPTH		( 96 )
+
+/* A job holding a resource runs at the priority of the ceiling level's
+executor, time slicing would switch that executor in before the unlock. */
+#define configUSE_TIME_SLICING				( configUSE_SRP_JOBS == 0 )
+
+/* Longest interrupt masked and scheduler suspended sections, see masktime.h. */
+#define configUSE_MASK_TIME					0
+#define configMASK_TIME_CALLERS				( 8 )
+
+/* Faults, failed asserts and stack overflows are recorded in retained SRAM2
+and reset the device, see crashdump.h.  Off until the capture path has been
+run on the board. */
+#define configUSE_CRASH_DUMP				0
+#define configCRASH_DUMP_STACK_WORDS		( 128 )
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet		1
@@ -118,15 +194,45 @@ to all Cortex-M ports, and do not rely on any particular library functions. */
 See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY 	( configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS) )
 	
+/* Run time statistics are counted in core clock cycles by the DWT cycle
+counter.  The counter wraps every 2^32 / configCPU_CLOCK_HZ seconds, the kernel
+charges the running task on every tick so the wrap is never missed. */
+#define configDWT_DEMCR_REG				( * ( ( volatile uint32_t * ) 0xe000edfc ) )
+#define configDWT_CTRL_REG				( * ( ( volatile uint32_t * ) 0xe0001000 ) )
+#define configDWT_CYCCNT_REG			( * ( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	{ configDWT_DEMCR_REG |= ( 1UL << 24UL ); configDWT_CYCCNT_REG = 0UL; configDWT_CTRL_REG |= 1UL; }
+#define portGET_RUN_TIME_COUNTER_VALUE()			( configDWT_CYCCNT_REG )
+
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
-#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }	
+#if( configUSE_CRASH_DUMP == 1 )
+	#define configASSERT( x ) if( ( x ) == 0 ) { vCrashDumpAssert( __LINE__ ); }
+#else
+	#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }	
+#endif
 	
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names. */
 #define vPortSVCHandler SVC_Handler
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
+#if( configUSE_CRASH_DUMP == 1 )
+	#define xCrashDumpHardFaultHandler HardFault_Handler
+	#define xCrashDumpMemManageHandler MemManage_Handler
+	#define xCrashDumpBusFaultHandler BusFault_Handler
+	#define xCrashDumpUsageFaultHandler UsageFault_Handler
+	#define xCrashDumpWatchdogHandler WWDG_IRQHandler
+#elif( configUSE_MPU_STACK_GUARD == 1 )
+	#define xPortMemManageHandler MemManage_Handler
+#endif
+
+#if( configUSE_TRACE_RECORDER == 1 )
+	#include "trace_recorder.h"
+#endif
+
+#if( configUSE_CRASH_DUMP == 1 )
+	#include "crashdump.h"
+#endif
 
 #endif /* FREERTOS_CONFIG_H */
 
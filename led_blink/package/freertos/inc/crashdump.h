@@ -0,0 +1,154 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Post-mortem crash capture.
+ *
+ * The HardFault, MemManage, BusFault and UsageFault handlers, configASSERT(),
+ * the stack overflow hook and the watchdog paths all end in prvCrashDumpEnd(),
+ * which writes one CrashDump_t to retained SRAM2 and resets the device.  The
+ * record holds the cause, the fault status and address registers, the
+ * registers of the code that faulted, the running task and the first
+ * configCRASH_DUMP_STACK_WORDS words of its stack above the stack pointer.  Nothing else is done on the way
+ * down, so the device is back up in a few microseconds.
+ *
+ * The capture runs with FAULTMASK set and SCB->CCR.BFHFNMIGN set, so the MPU
+ * stack guard is off and a bad stack pointer or task handle reads garbage
+ * rather than faulting again.  A fault during the capture itself resets at
+ * once.  When a debugger is attached the core halts on a breakpoint before the
+ * reset.
+ *
+ * After the reset pxCrashDumpGet() returns the record until vCrashDumpClear()
+ * is called.  tools/crash_decode.py turns it, or a dump of the whole retained
+ * area, into a symbolized backtrace.  The layout below is shared with that
+ * script and must be kept in sync with it.
+ *
+ * This header is included from the end of FreeRTOSConfig.h when
+ * configUSE_CRASH_DUMP is 1, so it can only use plain C types.
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define crashdumpMAGIC					( 0x48535243UL )	/* "CRSH" */
+#define crashdumpVERSION				( 1UL )
+#define crashdumpNAME_LEN				( 16 )
+
+/* Causes, faults use their exception number. */
+#define crashdumpCAUSE_NONE				( 0x000UL )		/* Cleared by vCrashDumpClear(). */
+#define crashdumpCAUSE_HARD_FAULT		( 0x003UL )
+#define crashdumpCAUSE_MEM_MANAGE		( 0x004UL )
+#define crashdumpCAUSE_BUS_FAULT		( 0x005UL )
+#define crashdumpCAUSE_USAGE_FAULT		( 0x006UL )
+#define crashdumpCAUSE_ASSERT			( 0x100UL )		/* ulLine holds the line of the configASSERT(). */
+#define crashdumpCAUSE_STACK_OVERFLOW	( 0x101UL )		/* Stack guard hit or stack check failed. */
+#define crashdumpCAUSE_WATCHDOG			( 0x102UL )		/* Task stopped making progress, see vCrashDumpTask(). */
+
+/* CrashDump_t.ulFlags. */
+#define crashdumpFLAG_FRAME				( 1UL << 0UL )	/* All of ulRegisters are valid, taken from the exception frame. */
+#define crashdumpFLAG_PSP				( 1UL << 1UL )	/* The code that crashed was running on a task stack. */
+#define crashdumpFLAG_HANDLER			( 1UL << 2UL )	/* The code that crashed was an interrupt handler. */
+#define crashdumpFLAG_FPU				( 1UL << 3UL )	/* The exception frame includes the FPU registers. */
+
+/* Indexes into CrashDump_t.ulRegisters, r0 to r12 come first. */
+#define crashdumpREG_SP					( 13 )
+#define crashdumpREG_LR					( 14 )
+#define crashdumpREG_PC					( 15 )
+#define crashdumpREG_XPSR				( 16 )
+#define crashdumpREGISTERS				( 17 )
+
+typedef struct xCRASH_DUMP
+{
+	uint32_t ulMagic;
+	uint32_t ulVersion;
+	uint32_t ulLength;				/* Number of entries in ulStack. */
+	uint32_t ulSequence;			/* Crashes recorded since the retained area was last lost. */
+	uint32_t ulCause;
+	uint32_t ulFlags;
+	uint32_t ulLine;
+	uint32_t ulTick;				/* Tick count at the crash. */
+	uint32_t ulExcReturn;			/* EXC_RETURN of the fault, 0 for assert and stack check. */
+	uint32_t ulCfsr;				/* SCB fault status and address registers. */
+	uint32_t ulHfsr;
+	uint32_t ulMmfar;
+	uint32_t ulBfar;
+	uint32_t ulAfsr;
+	uint32_t ulRegisters[ crashdumpREGISTERS ];	/* Only sp, lr and pc without crashdumpFLAG_FRAME. */
+	uint32_t ulTask;				/* Running task handle, 0 before the scheduler has a task. */
+	char cTaskName[ crashdumpNAME_LEN ];
+	uint32_t ulStackLimit;			/* Lowest address of the task stack, 0 if unknown. */
+	uint32_t ulStackAddress;		/* Address ulStack[ 0 ] was copied from. */
+	uint32_t ulStackWords;			/* Entries of ulStack that hold a copy. */
+	uint32_t ulChecksum;			/* Over all the words above and the copied part of ulStack. */
+	uint32_t ulStack[ configCRASH_DUMP_STACK_WORDS ];
+} CrashDump_t;
+
+/*
+ * The record of the crash that caused the last reset, or NULL if there was
+ * none or it has been cleared.
+ */
+const CrashDump_t *pxCrashDumpGet( void );
+
+/*
+ * Forget the record, the sequence number is kept.
+ */
+void vCrashDumpClear( void );
+
+/*
+ * Record a failed configASSERT() and reset, called by configASSERT().
+ */
+void vCrashDumpAssert( uint32_t ulLine ) __attribute__( ( noreturn ) );
+
+/*
+ * Record a stack overflow of pvTask found by the kernel stack check and reset,
+ * called by vApplicationStackOverflowHook().
+ */
+void vCrashDumpStackOverflow( void *pvTask ) __attribute__( ( noreturn ) );
+
+/*
+ * Record the task pvTask as it was last switched out, with its registers and
+ * stack, and reset.  Meant for a supervisor that found pvTask stuck, ulCause
+ * is normally crashdumpCAUSE_WATCHDOG.  If pvTask is NULL or the calling task
+ * the caller is recorded as for vCrashDumpAssert().
+ */
+void vCrashDumpTask( uint32_t ulCause, void *pvTask ) __attribute__( ( noreturn ) );
+
+/*
+ * Fault handlers, mapped to their CMSIS names in FreeRTOSConfig.h.
+ */
+void xCrashDumpHardFaultHandler( void );
+void xCrashDumpMemManageHandler( void );
+void xCrashDumpBusFaultHandler( void );
+void xCrashDumpUsageFaultHandler( void );
+
+/*
+ * Window watchdog early warning handler, records whatever was running when
+ * the watchdog was about to expire as crashdumpCAUSE_WATCHDOG.
+ */
+void xCrashDumpWatchdogHandler( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRASH_DUMP_H */
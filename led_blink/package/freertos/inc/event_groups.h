@@ -35,6 +35,21 @@
 /* FreeRTOS includes. */
 #include "timers.h"
 
+#if( configUSE_QUEUE_SETS == 1 )
+	#include "queue.h"
+#endif
+
+#if( configUSE_WORK_QUEUE == 1 )
+	#include "workqueue.h"
+
+	/* Set and clear requests from interrupts run in the work queue task. */
+	#define eventgroupsPEND_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, pxHigherPriorityTaskWoken ) \
+		xWorkQueuePostFromISR( workqueueLEVEL_HIGHEST, ( xFunctionToPend ), ( pvParameter1 ), ( ulParameter2 ), ( pxHigherPriorityTaskWoken ) )
+#else
+	#define eventgroupsPEND_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, pxHigherPriorityTaskWoken ) \
+		xTimerPendFunctionCallFromISR( ( xFunctionToPend ), ( pvParameter1 ), ( ulParameter2 ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -407,7 +422,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
 #if( configUSE_TRACE_FACILITY == 1 )
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 #else
-	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
+	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) eventgroupsPEND_FROM_ISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
 #endif
 
 /**
@@ -559,7 +574,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
 #if( configUSE_TRACE_FACILITY == 1 )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
-	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
+	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) eventgroupsPEND_FROM_ISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
 #endif
 
 /**
@@ -732,12 +747,60 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup ) PRIVILEG
  *
  * Delete an event group that was previously created by a call to
  * xEventGroupCreate().  Tasks that are blocked on the event group will be
- * unblocked and obtain 0 as the event group's value.
+ * unblocked and obtain 0 as the event group's value.  An event group added to
+ * a queue set is removed from it first.
  *
  * @param xEventGroup The event group being deleted.
  */
 void vEventGroupDelete( EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
 
+/**
+ * event_groups.h
+ *<pre>
+	BaseType_t xEventGroupAddToSet( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToNotify, QueueSetHandle_t xQueueSet );
+ </pre>
+ *
+ * Adds an event group to a queue set, so a task blocked in
+ * xQueueSelectFromSet() can also wait for any of uxBitsToNotify to be set.
+ * configUSE_QUEUE_SETS must be set to 1.
+ *
+ * The event group handle is posted to the set at most once until the bits are
+ * next read with xEventGroupWaitBits(), xEventGroupClearBits() or
+ * xEventGroupGetBits(), so it takes a single entry of the set's length.  It is
+ * posted straight away if one of the bits is already set.  As with queues, the
+ * bits may have been consumed by another task by the time the handle is
+ * selected, so read them without blocking.
+ *
+ * @param xEventGroup The event group being added.
+ *
+ * @param uxBitsToNotify The bits that notify the set.
+ *
+ * @param xQueueSet The queue set the event group is added to.
+ *
+ * @return pdPASS if the event group was added, pdFAIL if it is already a member
+ * of a queue set.
+ */
+#if( configUSE_QUEUE_SETS == 1 )
+	BaseType_t xEventGroupAddToSet( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToNotify, QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups.h
+ *<pre>
+	BaseType_t xEventGroupRemoveFromSet( EventGroupHandle_t xEventGroup, QueueSetHandle_t xQueueSet );
+ </pre>
+ *
+ * Removes an event group added by xEventGroupAddToSet().  A notification that
+ * is still held by the set is withdrawn.  vEventGroupDelete() removes the event
+ * group from its set.
+ *
+ * @return pdPASS if the event group was removed, pdFAIL if it is not a member
+ * of xQueueSet.
+ */
+#if( configUSE_QUEUE_SETS == 1 )
+	BaseType_t xEventGroupRemoveFromSet( EventGroupHandle_t xEventGroup, QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
+#endif
+
 /* For internal use only. */
 void vEventGroupSetBitsCallback( void *pvEventGroup, const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
 void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Maximum interrupt masked time.
+ *
+ * Times every outermost taskENTER_CRITICAL() / taskEXIT_CRITICAL() pair of
+ * task code, during which interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * are masked, and every outermost vTaskSuspendAll() / xTaskResumeAll() pair,
+ * during which no task switch can happen, with the run time counter.  Each
+ * kind keeps a count, the total, the maximum, a histogram and a table of the
+ * configMASK_TIME_CALLERS code addresses whose sections took longest.
+ *
+ * The address is the return address of the vPortEnterCritical() or
+ * vTaskSuspendAll() call that opened the section, so it points into the
+ * function that did, look it up with addr2line.  Sections that open in one
+ * function and close in another are charged to the opener.
+ *
+ * Interrupt handlers masking with portSET_INTERRUPT_MASK_FROM_ISR() are not
+ * timed, and neither is the copy made by xMaskTimeGetStats().  The timing
+ * itself adds a few cycles to every section it measures.
+ *
+ * Histogram bucket n counts sections of 2^n to 2^(n+1) - 1 cycles, bucket 0
+ * also those of 0 cycles.
+ */
+
+#ifndef MASK_TIME_H
+#define MASK_TIME_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include masktime.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Kinds of section. */
+#define masktimeCRITICAL		( ( UBaseType_t ) 0U )
+#define masktimeSCHEDULER		( ( UBaseType_t ) 1U )
+#define masktimeKINDS			( 2 )
+
+#define masktimeBUCKETS			( 32 )
+
+typedef struct xMASK_TIME_CALLER
+{
+	void *pvCaller;								/* Address that opened the section, NULL for an unused entry. */
+	uint32_t ulMaximum;							/* Cycles of its longest section. */
+} MaskTimeCaller_t;
+
+typedef struct xMASK_TIME_STATS
+{
+	uint32_t ulCount;							/* Sections recorded. */
+	uint32_t ulMaximum;							/* Cycles. */
+	uint64_t ullTotal;							/* Cycles of all sections. */
+	uint32_t ulBuckets[ masktimeBUCKETS ];
+	MaskTimeCaller_t xWorst[ configMASK_TIME_CALLERS ];	/* Longest first. */
+} MaskTimeStats_t;
+
+/*
+ * Copy the statistics of uxKind, masktimeCRITICAL or masktimeSCHEDULER.
+ * Returns pdFAIL for any other kind.  Interrupts are masked while they are
+ * copied.
+ */
+BaseType_t xMaskTimeGetStats( UBaseType_t uxKind, MaskTimeStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear the statistics of both kinds.
+ */
+void vMaskTimeReset( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called by the kernel when an outermost section of
+ * uxKind opens and closes, from task code and with no other task able to run.
+ * vMaskTimeExit() is called with interrupts masked.
+ */
+void vMaskTimeEnter( UBaseType_t uxKind, void *pvCaller ) PRIVILEGED_FUNCTION;
+void vMaskTimeExit( UBaseType_t uxKind ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MASK_TIME_H */
@@ -140,6 +140,69 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* Slot states reported in HeapSlotStats_t::ucState. */
+	#define heapSLOT_FREE		( ( uint8_t ) 0 )
+	#define heapSLOT_ACTIVE		( ( uint8_t ) 1 )
+	#define heapSLOT_ORPHAN		( ( uint8_t ) 2 )	/* Owner deleted, blocks still live. */
+
+	/* Operations reported in HeapLogEntry_t::ucOperation. */
+	#define heapLOG_MALLOC		( ( uint8_t ) 0 )
+	#define heapLOG_FREE		( ( uint8_t ) 1 )
+	#define heapLOG_DENIED		( ( uint8_t ) 2 )	/* Refused by the slot limit. */
+
+	/* Allocation statistics of one heap accounting slot. */
+	typedef struct xHEAP_SLOT_STATS
+	{
+		char pcName[ configMAX_TASK_NAME_LEN ];	/* Name of the owning task. */
+		size_t xCurrentBytes;		/* Bytes held now, block headers included. */
+		size_t xPeakBytes;			/* Highest value xCurrentBytes reached. */
+		size_t xLimitBytes;			/* Allocation cap, 0 for none. */
+		UBaseType_t uxLiveBlocks;	/* Blocks allocated and not yet freed. */
+		uint32_t ulDenied;			/* Allocations refused by the cap. */
+		uint8_t ucState;			/* heapSLOT_xxx. */
+	} HeapSlotStats_t;
+
+	/* One record of the allocation log. */
+	typedef struct xHEAP_LOG_ENTRY
+	{
+		void *pvAddress;			/* Block returned to / by the application. */
+		TickType_t xTick;			/* Tick count at the time of the operation. */
+		uint16_t usSize;			/* Block size, saturated at 0xFFFF. */
+		uint8_t ucSlot;				/* Slot the block is charged to. */
+		uint8_t ucOperation;		/* heapLOG_xxx. */
+	} HeapLogEntry_t;
+
+	/*
+	 * Used by tasks.c to bind a new task to a free accounting slot.  Returns 0,
+	 * the shared slot, when all slots are in use.
+	 */
+	UBaseType_t uxPortHeapSlotAcquire( const char *pcName ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Used by tasks.c when a task is deleted.  The slot becomes free once the
+	 * last block charged to it has been returned.
+	 */
+	void vPortHeapSlotRelease( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+	/* Copy the statistics of uxSlot.  Returns pdFAIL if uxSlot is out of range. */
+	BaseType_t xPortGetHeapSlotStats( UBaseType_t uxSlot, HeapSlotStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+	/* Cap the bytes uxSlot may hold at once, 0 removes the cap. */
+	BaseType_t xPortSetHeapSlotLimit( UBaseType_t uxSlot, size_t xLimitBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copy at most uxMaxEntries log records with sequence number *pulSequence
+	 * onwards into pxEntries, oldest first.  On return *pulSequence holds the
+	 * sequence number to pass on the next call, so successive dumps contain
+	 * exactly the operations made in between.  Records already overwritten are
+	 * skipped.  Returns the number of records copied.
+	 */
+	UBaseType_t uxPortGetHeapLog( HeapLogEntry_t *pxEntries, UBaseType_t uxMaxEntries, uint32_t *pulSequence ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -105,6 +105,40 @@ extern void vPortExitCritical( void );
 
 /*-----------------------------------------------------------*/
 
+/* Integer only tasks, see configUSE_TASK_FPU_OPT_OUT. */
+#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	/* Set in the priority passed to xTaskCreate() to mark a task that never
+	uses the FPU. */
+	#define portNO_FPU_BIT							( ( UBaseType_t ) 0x40000000UL )
+
+	/* Non zero if the context saved at pxTopOfStack includes FPU registers.
+	Bit 4 of the EXC_RETURN value that xPortPendSVHandler() stores above r4-r11
+	is then clear. */
+	#define portCONTEXT_USES_FPU( pxTopOfStack )	( ( ( pxTopOfStack )[ 8 ] & 0x10UL ) == 0UL )
+
+	extern void vPortSelectFpuContext( void *pvOutgoingTCB, BaseType_t xOutgoingNoFpu, void *pvIncomingTCB, BaseType_t xIncomingNoFpu );
+	extern void vPortReleaseFpuContext( void *pvTCB );
+	#define portSELECT_FPU_CONTEXT( pxOutgoingTCB, xOutgoingNoFpu, pxIncomingTCB, xIncomingNoFpu ) vPortSelectFpuContext( ( void * ) ( pxOutgoingTCB ), ( xOutgoingNoFpu ), ( void * ) ( pxIncomingTCB ), ( xIncomingNoFpu ) )
+	#define portCLEAN_UP_TCB( pxTCB )				vPortReleaseFpuContext( ( void * ) ( pxTCB ) )
+#endif
+
+/* Stack guard, see configUSE_MPU_STACK_GUARD. */
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	/* Base of the guard region of the stack that starts at pxStack, the first
+	configMPU_STACK_GUARD_SIZE aligned block of it. */
+	#define portSTACK_GUARD_BASE( pxStack )		( ( ( uint32_t ) ( pxStack ) + ( ( uint32_t ) configMPU_STACK_GUARD_SIZE - 1UL ) ) & ~( ( uint32_t ) configMPU_STACK_GUARD_SIZE - 1UL ) )
+
+	/* MPU region base address register value that moves the guard region
+	there, kept in the TCB so a context switch is a single register write. */
+	#define portSTACK_GUARD_REGION( pxStack )	( portSTACK_GUARD_BASE( pxStack ) | 0x10UL | ( uint32_t ) configMPU_STACK_GUARD_REGION )
+
+	/* Called from a MemManage fault handler, pdTRUE if the fault was caused by
+	the running task reaching its guard. */
+	extern BaseType_t xPortStackGuardFault( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
 not necessary for to use this port.  They are defined so the common demo files
 (which build with all the ports) will build. */
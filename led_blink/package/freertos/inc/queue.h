@@ -1555,6 +1555,15 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  */
 QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength ) PRIVILEGED_FUNCTION;
 
+/*
+ * Version of xQueueCreateSet() that uses memory provided by the caller.
+ * pucQueueStorage must hold uxEventQueueLength queue handles,
+ * uxEventQueueLength * sizeof( QueueSetMemberHandle_t ) bytes.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	QueueSetHandle_t xQueueCreateSetStatic( const UBaseType_t uxEventQueueLength, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Adds a queue or semaphore to a queue set that was previously created by a
  * call to xQueueCreateSet().
@@ -1646,6 +1655,15 @@ void vQueueSetQueueNumber( QueueHandle_t xQueue, UBaseType_t uxQueueNumber ) PRI
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Not a public API function.  Drop the entries for xMember that xQueueSet
+ * still holds, keeping the order of the others, so the set cannot return the
+ * handle of an event group that has left it.
+ */
+#if( configUSE_QUEUE_SETS == 1 )
+	void vQueueSetWithdraw( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t xMember ) PRIVILEGED_FUNCTION;
+#endif
+
 
 #ifdef __cplusplus
 }
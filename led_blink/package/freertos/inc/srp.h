@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Run-to-completion jobs scheduled under the Stack Resource Policy.
+ *
+ * A job is a function that is activated by tasks or interrupts and returns
+ * when done, it never blocks.  Each job has a preemption level between 0 and
+ * configSRP_LEVELS - 1.  All jobs of one level are run, in activation order,
+ * by one executor task of priority configSRP_BASE_PRIORITY + level, so they
+ * share that task's stack.  Jobs of a higher level preempt lower ones, normal
+ * tasks are scheduled around the executors by priority as usual.
+ *
+ * Jobs share data through SrpResource_t objects with an immediate priority
+ * ceiling: locking a resource raises the executor to the level of the highest
+ * job that uses it, so a job that could touch the resource cannot start until
+ * it is unlocked.  A job is therefore never blocked once it started, and at
+ * most one job per level is ever in progress.  The holder then shares its
+ * priority with the ceiling level's executor, so configUSE_TIME_SLICING must
+ * be 0.  Jobs must not wait on queues,
+ * semaphores, mutexes or delays, and resources are not shared with tasks.
+ *
+ * Worst case stack.  As at most one job per level is in progress, the stack
+ * needed by all jobs is the sum over the levels of the deepest job of each
+ * level, the same bound as a single SRP stack.  The executor stacks are carved
+ * from a pool of configSRP_STACK_POOL_DEPTH words when the scheduler starts,
+ * level n getting
+ *
+ *     configSRP_EXECUTOR_STACK_DEPTH + max( usStackDepth of the jobs of n )
+ *
+ * words, plus room for the stack guard when configUSE_MPU_STACK_GUARD is 1.
+ * usStackDepth is the deepest stack use of the job function and everything it
+ * calls, in words, for example from the -fstack-usage output.
+ * configSRP_EXECUTOR_STACK_DEPTH covers the executor loop and the context
+ * saved on a switch, FPU registers included.  ulSrpWorstCaseStack() returns
+ * the total and startup asserts that it fits in the pool.
+ *
+ * For example 20 periodic activities as threads with a 1 KB stack each use
+ * 20 * ( 1024 + sizeof( StaticTask_t ) ) bytes.  As 20 jobs on 4 levels whose
+ * deepest job needs 160 words, they use 4 * ( ( 96 + 160 + 16 ) * 4 +
+ * sizeof( StaticTask_t ) ) bytes of stack and TCBs plus 20 SrpJob_t.
+ */
+
+#ifndef SRP_H
+#define SRP_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include srp.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SrpJobFunction_t)( void * );
+
+/*
+ * A job, allocated by the application and initialised by xSrpJobCreate().
+ * The members are private to srp.c.
+ */
+typedef struct xSRP_JOB
+{
+	struct xSRP_JOB *pxNextPending;		/* Next job to run on the level. */
+	struct xSRP_JOB *pxNextOnLevel;		/* Next job of the level, used to size the stack. */
+	SrpJobFunction_t pxFunction;
+	void *pvParameter;
+	UBaseType_t uxLevel;
+	configSTACK_DEPTH_TYPE usStackDepth;
+	UBaseType_t uxActivations;			/* Activations not completed yet, the job is pending while not 0. */
+	uint32_t ulRuns;
+} SrpJob_t;
+
+/*
+ * A resource shared by jobs.  The members are private to srp.c.
+ */
+typedef struct xSRP_RESOURCE
+{
+	UBaseType_t uxCeiling;				/* Highest level of the jobs that lock it. */
+	UBaseType_t uxSavedPriority;		/* Executor priority before the lock, 0 while unlocked. */
+} SrpResource_t;
+
+/*
+ * Register pxJob to run pxFunction( pvParameter ) on level uxLevel, needing
+ * usStackDepth words of stack.  Must be called before the scheduler starts.
+ */
+BaseType_t xSrpJobCreate( SrpJob_t *pxJob, SrpJobFunction_t pxFunction, void *pvParameter, UBaseType_t uxLevel, configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+
+/*
+ * Request one run of pxJob.  Activations of a job that has not finished yet
+ * are counted and run back to back.  Returns pdFAIL before the scheduler has
+ * started.
+ */
+BaseType_t xSrpJobActivate( SrpJob_t *pxJob ) PRIVILEGED_FUNCTION;
+BaseType_t xSrpJobActivateFromISR( SrpJob_t *pxJob, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Number of completed runs of pxJob.
+ */
+uint32_t ulSrpJobGetRuns( const SrpJob_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise a resource used by jobs up to level uxCeiling.
+ */
+void vSrpResourceInit( SrpResource_t *pxResource, UBaseType_t uxCeiling ) PRIVILEGED_FUNCTION;
+
+/*
+ * Lock and unlock a resource from a job, locks must be nested.
+ */
+void vSrpResourceLock( SrpResource_t *pxResource ) PRIVILEGED_FUNCTION;
+void vSrpResourceUnlock( SrpResource_t *pxResource ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stack carved for uxLevel, 0 if it has no jobs, and the total over all
+ * levels, in words.
+ */
+uint32_t ulSrpLevelStackDepth( UBaseType_t uxLevel ) PRIVILEGED_FUNCTION;
+uint32_t ulSrpWorstCaseStack( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only, called by vTaskStartScheduler().
+ */
+BaseType_t xSrpCreateTasks( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRP_H */
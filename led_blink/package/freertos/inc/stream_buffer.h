@@ -829,6 +829,78 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * The contiguous regions of a stream buffer's storage area handed out by the
+ * zero copy API.  The free or used part of the ring can wrap around the end of
+ * the storage area, in which case it is described by two spans, otherwise
+ * xLength[ 1 ] is 0.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+	uint8_t *pucData[ 2 ];
+	size_t xLength[ 2 ];
+} StreamBufferSpans_t;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans );
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xCount );
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xCount, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy alternative to xStreamBufferSend().  Acquire returns the free
+ * part of the storage area as up to two spans that the writer (for example a
+ * DMA channel) fills in place, waiting up to xTicksToWait for at least one
+ * free byte.  Commit then makes the first xCount of those bytes visible to the
+ * reader and, exactly like xStreamBufferSend(), unblocks a waiting reader once
+ * the trigger level is reached.  Nothing is reserved between the two calls, so
+ * the usual single writer rule applies, and xCount must not exceed the value
+ * returned by acquire.  Not available for message buffers.
+ *
+ * @return Acquire returns the number of free bytes described by pxSpans,
+ * commit returns xCount.
+ *
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans );
+size_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xCount );
+size_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xCount, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Zero copy alternative to xStreamBufferReceive().  Acquire returns the data
+ * held in the buffer as up to two spans, waiting up to xTicksToWait for at
+ * least one byte.  The reader consumes the data in place (for example by
+ * starting a DMA transfer from it) and then releases the first xCount bytes,
+ * which unblocks a writer waiting for space.  xCount must not exceed the value
+ * returned by acquire.  Not available for message buffers.
+ *
+ * @return Acquire returns the number of bytes described by pxSpans, release
+ * returns xCount.
+ *
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xCount ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
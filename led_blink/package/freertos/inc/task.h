@@ -2411,6 +2411,53 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TASK_CPU_STATS == 1 )
+
+	/* CPU usage of one task, see xTaskGetCpuStats(). */
+	typedef struct xTASK_CPU_STATS
+	{
+		uint64_t ullCycles;				/* Cycles spent running since the task was created. */
+		uint32_t ulVoluntarySwitches;	/* Times the task left the Running state by blocking, suspending or deleting itself. */
+		uint32_t ulInvoluntarySwitches;	/* Times the task was switched out while still Ready (preempted or yielded). */
+		uint32_t ulWindowLoad;			/* Share of the last complete statistics window, in 0.1 % units. */
+	} TaskCpuStats_t;
+
+	/*
+	 * Copy the CPU usage of xTask, or of the calling task if xTask is NULL.
+	 * Statistics windows last configCPU_STATS_WINDOW_TICKS ticks.  Returns pdFAIL
+	 * before the first window has completed.  Only available when
+	 * configUSE_TASK_CPU_STATS is 1.
+	 */
+	BaseType_t xTaskGetCpuStats( TaskHandle_t xTask, TaskCpuStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Share of the last complete statistics window spent in the idle task, in
+	 * 0.1 % units.
+	 */
+	uint32_t ulTaskGetIdleLoad( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_CPU_STATS */
+
+/*
+ * For internal use only.  Return the heap accounting slot of xTask, or of the
+ * running task if xTask is NULL.  Slot 0 is returned before the scheduler has
+ * created any task.  Only available when configUSE_HEAP_ACCOUNTING is 1.
+ */
+UBaseType_t uxTaskGetHeapSlot( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  The timer daemon and the work queue task relay
+ * functions pended from interrupts, they are marked with
+ * vTaskSetWakeLatencyRelay() when created and are not stamped themselves.
+ * Around each pended function they call vTaskSetWakeLatencyCarry() with the
+ * stamp and source uxWakeLatencyStampFromISR() returned when the function was
+ * pended, so a task the function makes ready is stamped as if the interrupt
+ * had made it ready, then with a uxSource of 0.  Only available when
+ * configUSE_WAKE_LATENCY is 1.
+ */
+void vTaskSetWakeLatencyRelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+void vTaskSetWakeLatencyCarry( UBaseType_t uxSource, uint32_t ulStamp ) PRIVILEGED_FUNCTION;
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,224 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Binary kernel event recorder.
+ *
+ * Kernel trace hooks append fixed size timestamped records to a ring buffer
+ * that lives in retained SRAM2.  In traceMODE_STREAM the application drains the
+ * ring with ulTraceRecorderRead() and new events are dropped (and counted) when
+ * the reader falls behind.  In traceMODE_SNAPSHOT the ring is overwritten
+ * continuously until vTraceRecorderTrigger() is called, after which
+ * configTRACE_RECORDER_POST_TRIGGER more events are recorded and the buffer is
+ * frozen.  A frozen capture survives a reset and is kept by
+ * xTraceRecorderInit() until vTraceRecorderStart() is called.
+ *
+ * tools/trace_decode.py converts a capture to Chrome trace / Perfetto JSON.
+ * The layout of the structures below and the event codes are shared with that
+ * script and must be kept in sync with it.
+ *
+ * This header is included from the end of FreeRTOSConfig.h when
+ * configUSE_TRACE_RECORDER is 1, so it can only use plain C types.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define traceRECORDER_MAGIC				( 0x43525452UL )	/* "RTRC" */
+#define traceRECORDER_VERSION			( 1UL )
+#define traceRECORDER_NAME_LEN			( 12 )
+
+/* Recording modes. */
+#define traceMODE_STREAM				( 0UL )
+#define traceMODE_SNAPSHOT				( 1UL )
+
+/* Recorder states. */
+#define traceSTATE_STOPPED				( 0UL )
+#define traceSTATE_RUNNING				( 1UL )
+#define traceSTATE_TRIGGERED			( 2UL )
+#define traceSTATE_FROZEN				( 3UL )
+
+/* Event codes, stored in the top 8 bits of TraceEvent_t.ulEventParam. */
+#define traceEVT_SYNC					( 0x01UL )	/* ulObject = tick count. */
+#define traceEVT_TASK_SWITCHED_IN		( 0x10UL )	/* param = priority. */
+#define traceEVT_TASK_READY				( 0x11UL )
+#define traceEVT_TASK_CREATE			( 0x12UL )	/* param = priority. */
+#define traceEVT_TASK_DELETE			( 0x13UL )
+#define traceEVT_TASK_DELAY				( 0x14UL )	/* param = ticks to delay. */
+#define traceEVT_TASK_DELAY_UNTIL		( 0x15UL )	/* param = wake tick. */
+#define traceEVT_TASK_SUSPEND			( 0x16UL )
+#define traceEVT_TASK_RESUME			( 0x17UL )
+#define traceEVT_TASK_PRIORITY_SET		( 0x18UL )	/* param = new priority. */
+#define traceEVT_TASK_PRIORITY_INHERIT	( 0x19UL )	/* param = inherited priority. */
+#define traceEVT_TASK_PRIORITY_DISINHERIT	( 0x1AUL )	/* param = restored priority. */
+#define traceEVT_TASK_NOTIFY			( 0x1BUL )
+#define traceEVT_TASK_NOTIFY_FROM_ISR	( 0x1CUL )
+#define traceEVT_TASK_NOTIFY_BLOCK		( 0x1DUL )
+#define traceEVT_QUEUE_SEND				( 0x20UL )	/* param = items in queue. */
+#define traceEVT_QUEUE_SEND_FAILED		( 0x21UL )
+#define traceEVT_QUEUE_SEND_FROM_ISR	( 0x22UL )
+#define traceEVT_QUEUE_RECEIVE			( 0x23UL )
+#define traceEVT_QUEUE_RECEIVE_FAILED	( 0x24UL )
+#define traceEVT_QUEUE_RECEIVE_FROM_ISR	( 0x25UL )
+#define traceEVT_QUEUE_BLOCK_SEND		( 0x26UL )
+#define traceEVT_QUEUE_BLOCK_RECEIVE	( 0x27UL )
+#define traceEVT_EVENT_GROUP_SET		( 0x28UL )	/* param = bits set. */
+#define traceEVT_EVENT_GROUP_BLOCK		( 0x29UL )	/* param = bits waited for. */
+#define traceEVT_ISR_ENTER				( 0x30UL )	/* param = ISR number. */
+#define traceEVT_ISR_EXIT				( 0x31UL )	/* param = ISR number. */
+#define traceEVT_USER					( 0x40UL )	/* param = channel, ulObject = value. */
+#define traceEVT_TRIGGER				( 0x41UL )	/* param = reason. */
+#define traceEVT_NAME					( 0x42UL )	/* param = next three name characters. */
+
+typedef struct xTRACE_EVENT
+{
+	uint32_t ulTimestamp;			/* Run time counter (DWT cycle counter). */
+	uint32_t ulObject;				/* Task, queue or event group handle. */
+	uint32_t ulEventParam;			/* Event code in bits 31..24, parameter in bits 23..0. */
+} TraceEvent_t;
+
+typedef struct xTRACE_NAME
+{
+	uint32_t ulObject;
+	char cName[ traceRECORDER_NAME_LEN ];
+} TraceName_t;
+
+typedef struct xTRACE_RECORDER
+{
+	uint32_t ulMagic;
+	uint32_t ulVersion;
+	uint32_t ulClockHz;
+	uint32_t ulTickRateHz;
+	uint32_t ulLength;				/* Number of entries in xEvents. */
+	uint32_t ulNameCount;			/* Number of entries in xNames. */
+	uint32_t ulMode;
+	volatile uint32_t ulState;
+	volatile uint32_t ulHead;		/* Events written since the recorder was started. */
+	volatile uint32_t ulTail;		/* Events consumed by the reader, stream mode only. */
+	volatile uint32_t ulDropped;	/* Events lost because the reader fell behind. */
+	volatile uint32_t ulPostTrigger;/* Events still to be recorded before freezing. */
+	uint32_t ulTriggerReason;
+	uint32_t ulNextName;
+	TraceName_t xNames[ configTRACE_RECORDER_NAMES ];
+	TraceEvent_t xEvents[ configTRACE_RECORDER_LENGTH ];
+} TraceRecorder_t;
+
+/*
+ * Prepare the recorder, called by osKernelInitialize().  Returns 1 if a frozen
+ * capture from before the last reset was found, in which case nothing is
+ * recorded until vTraceRecorderStart() is called, otherwise starts recording
+ * in configTRACE_RECORDER_MODE and returns 0.
+ */
+uint32_t ulTraceRecorderInit( void );
+
+/*
+ * Discard the current capture and start recording in ulMode.
+ */
+void vTraceRecorderStart( uint32_t ulMode );
+
+/*
+ * Stop recording, the capture is kept.
+ */
+void vTraceRecorderStop( void );
+
+/*
+ * Snapshot mode only: record a trigger event, then freeze the capture after
+ * configTRACE_RECORDER_POST_TRIGGER further events.  Can be called from an
+ * ISR.
+ */
+void vTraceRecorderTrigger( uint32_t ulReason );
+
+/*
+ * Stream mode only: copy up to ulMaxEvents unread events into pxBuffer.
+ * Returns the number of events copied.  Must only be called from one task.
+ */
+uint32_t ulTraceRecorderRead( TraceEvent_t *pxBuffer, uint32_t ulMaxEvents );
+
+/*
+ * The recorder image, for dumping a snapshot over a debug link.
+ */
+const TraceRecorder_t *pxTraceRecorderGet( void );
+
+/*
+ * Associate a name with a kernel object handle.
+ */
+void vTraceRecorderName( const void *pvObject, const char *pcName );
+
+/*
+ * Application hooks for interrupt handlers and user events.  Interrupts
+ * above configMAX_SYSCALL_INTERRUPT_PRIORITY must not call these.
+ */
+#define vTraceIsrEnter( ulIsr )				vTraceRecorderEvent( traceEVT_ISR_ENTER, 0, ( uint32_t ) ( ulIsr ) )
+#define vTraceIsrExit( ulIsr )				vTraceRecorderEvent( traceEVT_ISR_EXIT, 0, ( uint32_t ) ( ulIsr ) )
+#define vTraceUserEvent( ulChannel, ulValue )	vTraceRecorderEvent( traceEVT_USER, ( const void * ) ( uintptr_t ) ( ulValue ), ( uint32_t ) ( ulChannel ) )
+
+void vTraceRecorderEvent( uint32_t ulEvent, const void *pvObject, uint32_t ulParam );
+void vTraceRecorderTaskCreate( const void *pvTask, const char *pcName, uint32_t ulPriority );
+
+/* Kernel trace hooks.  These are expanded inside the kernel sources, where
+the TCB and queue structures are visible. */
+#define traceTASK_INCREMENT_TICK( xTickCount )								\
+	if( ( ( xTickCount ) % configTRACE_RECORDER_SYNC_TICKS ) == 0 )			\
+	{																		\
+		vTraceRecorderEvent( traceEVT_SYNC, ( const void * ) ( uintptr_t ) ( xTickCount ), 0 );	\
+	}
+
+#define traceTASK_SWITCHED_IN()						vTraceRecorderEvent( traceEVT_TASK_SWITCHED_IN, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )		vTraceRecorderEvent( traceEVT_TASK_READY, ( pxTCB ), 0 )
+#define traceTASK_CREATE( pxNewTCB )				vTraceRecorderTaskCreate( ( pxNewTCB ), ( pxNewTCB )->pcTaskName, ( uint32_t ) ( pxNewTCB )->uxPriority )
+#define traceTASK_DELETE( pxTaskToDelete )			vTraceRecorderEvent( traceEVT_TASK_DELETE, ( pxTaskToDelete ), 0 )
+#define traceTASK_DELAY()							vTraceRecorderEvent( traceEVT_TASK_DELAY, pxCurrentTCB, ( uint32_t ) xTicksToDelay )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )		vTraceRecorderEvent( traceEVT_TASK_DELAY_UNTIL, pxCurrentTCB, ( uint32_t ) ( xTimeToWake ) )
+#define traceTASK_SUSPEND( pxTaskToSuspend )		vTraceRecorderEvent( traceEVT_TASK_SUSPEND, ( pxTaskToSuspend ), 0 )
+#define traceTASK_RESUME( pxTaskToResume )			vTraceRecorderEvent( traceEVT_TASK_RESUME, ( pxTaskToResume ), 0 )
+#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )	vTraceRecorderEvent( traceEVT_TASK_RESUME, ( pxTaskToResume ), 0 )
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )	vTraceRecorderEvent( traceEVT_TASK_PRIORITY_SET, ( pxTask ), ( uint32_t ) ( uxNewPriority ) )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )	vTraceRecorderEvent( traceEVT_TASK_PRIORITY_INHERIT, ( pxTCBOfMutexHolder ), ( uint32_t ) ( uxInheritedPriority ) )
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )	vTraceRecorderEvent( traceEVT_TASK_PRIORITY_DISINHERIT, ( pxTCBOfMutexHolder ), ( uint32_t ) ( uxOriginalPriority ) )
+#define traceTASK_NOTIFY()							vTraceRecorderEvent( traceEVT_TASK_NOTIFY, pxTCB, 0 )
+#define traceTASK_NOTIFY_FROM_ISR()					vTraceRecorderEvent( traceEVT_TASK_NOTIFY_FROM_ISR, pxTCB, 0 )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()			vTraceRecorderEvent( traceEVT_TASK_NOTIFY_FROM_ISR, pxTCB, 0 )
+#define traceTASK_NOTIFY_TAKE_BLOCK()				vTraceRecorderEvent( traceEVT_TASK_NOTIFY_BLOCK, pxCurrentTCB, 0 )
+#define traceTASK_NOTIFY_WAIT_BLOCK()				vTraceRecorderEvent( traceEVT_TASK_NOTIFY_BLOCK, pxCurrentTCB, 0 )
+
+#define traceQUEUE_SEND( pxQueue )					vTraceRecorderEvent( traceEVT_QUEUE_SEND, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )			vTraceRecorderEvent( traceEVT_QUEUE_SEND_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )			vTraceRecorderEvent( traceEVT_QUEUE_SEND_FROM_ISR, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )	vTraceRecorderEvent( traceEVT_QUEUE_SEND_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )				vTraceRecorderEvent( traceEVT_QUEUE_RECEIVE, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )		vTraceRecorderEvent( traceEVT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )		vTraceRecorderEvent( traceEVT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )	vTraceRecorderEvent( traceEVT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )		vTraceRecorderEvent( traceEVT_QUEUE_BLOCK_SEND, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	vTraceRecorderEvent( traceEVT_QUEUE_BLOCK_RECEIVE, ( pxQueue ), ( uint32_t ) ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )	vTraceRecorderName( ( xQueue ), ( pcQueueName ) )
+
+#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )				vTraceRecorderEvent( traceEVT_EVENT_GROUP_SET, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )		vTraceRecorderEvent( traceEVT_EVENT_GROUP_SET, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )	vTraceRecorderEvent( traceEVT_EVENT_GROUP_BLOCK, ( xEventGroup ), ( uint32_t ) ( uxBitsToWaitFor ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
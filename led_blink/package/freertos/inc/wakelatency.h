@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Interrupt to task wake latency.
+ *
+ * When an interrupt makes a blocked task ready, through a queue, semaphore or
+ * stream buffer (xTaskRemoveFromEventList()), a task notification or
+ * xTaskResumeFromISR(), the cycle counter is stored in the task.  When the task
+ * is next switched in the elapsed cycles are added to the histogram of that
+ * interrupt.
+ *
+ * Event flags set or cleared from an interrupt, and other functions pended
+ * with xTimerPendFunctionCallFromISR() or xWorkQueuePostFromISR(), run in the
+ * timer daemon or the work queue task.  The stamp is taken when the function
+ * is pended and carried to the task the function makes ready, so the latency
+ * covers the whole path from the interrupt to that task.  The daemon and the
+ * work queue task are never stamped themselves: an interrupt that only wakes
+ * one of them, xTimerStartFromISR() for example, is not measured.
+ *
+ * Interrupts are told apart by the exception number in IPSR.  The first
+ * configWAKE_LATENCY_SOURCES interrupts that wake a task get a histogram
+ * each, wakeups from any further interrupt are only counted as dropped.
+ *
+ * The stamp is taken when the task is made ready.  A handler that calls
+ * vWakeLatencyISREnter() as its first statement, on every invocation, is
+ * stamped on entry instead, so its own run time is included.
+ *
+ * Histogram buckets are log-linear: exact below 4 cycles, then four buckets
+ * per power of two up to 2^configWAKE_LATENCY_MAX_LOG2 - 1 cycles, so a
+ * percentile there is at most 25 % above the true value.  Longer latencies
+ * share the extra overflow bucket at the end, a percentile that falls into it
+ * is reported as ulMaximum, which is always exact.
+ */
+
+#ifndef WAKE_LATENCY_H
+#define WAKE_LATENCY_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include wakelatency.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define wakelatencyBUCKETS		( ( ( configWAKE_LATENCY_MAX_LOG2 - 1 ) * 4 ) + 1 )
+
+typedef struct xWAKE_LATENCY_STATS
+{
+	uint32_t ulException;						/* Exception number of the interrupt, IRQn + 16. */
+	uint32_t ulCount;							/* Wakeups recorded. */
+	uint32_t ulMinimum;							/* Cycles, 0xffffffff when ulCount is 0. */
+	uint32_t ulMaximum;							/* Cycles. */
+	uint32_t ulBuckets[ wakelatencyBUCKETS ];
+} WakeLatencyStats_t;
+
+/*
+ * Stamp the entry of the running interrupt handler, see above.
+ */
+void vWakeLatencyISREnter( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the histogram of source uxSource, 0 to configWAKE_LATENCY_SOURCES - 1.
+ * Returns pdFAIL if no interrupt has been assigned to the source yet.
+ * Interrupts are masked while the histogram is copied.
+ */
+BaseType_t xWakeLatencyGetStats( UBaseType_t uxSource, WakeLatencyStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * The latency in cycles below which ulPermille thousandths of the wakeups in
+ * pxStats fall, for example 990 for the 99th percentile.  Returns 0 when
+ * nothing was recorded.
+ */
+uint32_t ulWakeLatencyPercentile( const WakeLatencyStats_t *pxStats, uint32_t ulPermille ) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakeups not recorded because every source was already assigned.
+ */
+uint32_t ulWakeLatencyGetDropped( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear the histograms, the sources keep their interrupts.
+ */
+void vWakeLatencyReset( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  uxWakeLatencyStampFromISR() is called by the kernel
+ * with interrupts masked when a task is made ready, it writes the stamp and
+ * returns the source + 1, or 0 when not called from an interrupt or the
+ * wakeup is dropped.  vWakeLatencyRecord() is called when the task is
+ * switched in.
+ */
+UBaseType_t uxWakeLatencyStampFromISR( uint32_t *pulStamp ) PRIVILEGED_FUNCTION;
+void vWakeLatencyRecord( UBaseType_t uxSource, uint32_t ulStamp ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAKE_LATENCY_H */
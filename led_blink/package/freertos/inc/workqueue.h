@@ -0,0 +1,92 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Deferred work queue.
+ *
+ * Interrupts and tasks post function calls that are executed later by a
+ * dedicated worker task, created by vTaskStartScheduler() when
+ * configUSE_WORK_QUEUE is 1.  It takes over the job that
+ * xTimerPendFunctionCall() does through the timer command queue, without
+ * sharing that short queue or the timer task's priority.
+ *
+ * Work items come from a pool of configWORK_QUEUE_POOL_SIZE preallocated
+ * items, posting is O(1) with interrupts masked only to unlink one item.
+ * Items are queued on configWORK_QUEUE_LEVELS levels, the worker always runs
+ * the highest non-empty level first and drains a level as one batch, checking
+ * for higher level work between items.
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include workqueue.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The lowest and highest work levels. */
+#define workqueueLEVEL_LOWEST		( ( UBaseType_t ) 0U )
+#define workqueueLEVEL_HIGHEST		( ( UBaseType_t ) ( configWORK_QUEUE_LEVELS - 1 ) )
+
+/* Same prototype as PendedFunction_t, so the functions passed to
+xTimerPendFunctionCall() can be posted unchanged. */
+typedef void (*WorkFunction_t)( void *, uint32_t );
+
+typedef struct xWORK_QUEUE_STATS
+{
+	uint32_t ulPosted[ configWORK_QUEUE_LEVELS ];		/* Items accepted per level. */
+	uint32_t ulExecuted[ configWORK_QUEUE_LEVELS ];		/* Items run per level. */
+	uint32_t ulOverflows[ configWORK_QUEUE_LEVELS ];	/* Posts refused because the pool was empty. */
+	UBaseType_t uxPoolSize;
+	UBaseType_t uxMinimumFree;							/* Low water mark of free items. */
+	UBaseType_t uxLargestBatch;							/* Most items run from one level without a break. */
+} WorkQueueStats_t;
+
+/*
+ * Queue a call to pxFunction( pvParameter1, ulParameter2 ) on level uxLevel.
+ * Returns pdFAIL if the pool is empty or the scheduler has not been started.
+ */
+BaseType_t xWorkQueuePost( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * Interrupt safe version of xWorkQueuePost().  *pxHigherPriorityTaskWoken is
+ * set to pdTRUE if the worker task should run when the interrupt exits, it
+ * can be NULL.
+ */
+BaseType_t xWorkQueuePostFromISR( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy the work queue statistics.
+ */
+void vWorkQueueGetStats( WorkQueueStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only, called by vTaskStartScheduler().
+ */
+BaseType_t xWorkQueueCreateTask( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORK_QUEUE_H */
@@ -0,0 +1,489 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Post-mortem crash capture, see crashdump.h.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_CRASH_DUMP == 1 )
+
+/* System control block registers. */
+#define crashdumpAIRCR_REG				( * ( ( volatile uint32_t * ) 0xe000ed0c ) )
+#define crashdumpCCR_REG				( * ( ( volatile uint32_t * ) 0xe000ed14 ) )
+#define crashdumpCFSR_REG				( * ( ( volatile uint32_t * ) 0xe000ed28 ) )
+#define crashdumpHFSR_REG				( * ( ( volatile uint32_t * ) 0xe000ed2c ) )
+#define crashdumpMMFAR_REG				( * ( ( volatile uint32_t * ) 0xe000ed34 ) )
+#define crashdumpBFAR_REG				( * ( ( volatile uint32_t * ) 0xe000ed38 ) )
+#define crashdumpAFSR_REG				( * ( ( volatile uint32_t * ) 0xe000ed3c ) )
+#define crashdumpDHCSR_REG				( * ( ( volatile uint32_t * ) 0xe000edf0 ) )
+
+#define crashdumpAIRCR_VECTKEY			( 0x05faUL << 16UL )
+#define crashdumpAIRCR_PRIGROUP			( 0x7UL << 8UL )
+#define crashdumpAIRCR_SYSRESETREQ		( 1UL << 2UL )
+#define crashdumpCCR_BFHFNMIGN			( 1UL << 8UL )
+#define crashdumpCFSR_MSTKERR			( 1UL << 4UL )
+#define crashdumpCFSR_STKERR			( 1UL << 12UL )
+#define crashdumpDHCSR_C_DEBUGEN		( 1UL << 0UL )
+
+#define crashdumpIPSR_MASK				( 0x1ffUL )
+#define crashdumpEXC_RETURN_PSP			( 1UL << 2UL )
+#define crashdumpEXC_RETURN_THREAD		( 1UL << 3UL )
+#define crashdumpEXC_RETURN_NO_FPU		( 1UL << 4UL )
+#define crashdumpXPSR_STACK_ALIGN		( 1UL << 9UL )
+
+/* Words of the basic and the extended exception frame. */
+#define crashdumpFRAME_WORDS			( 8UL )
+#define crashdumpFPU_FRAME_WORDS		( 26UL )
+
+/* Words of a saved task context below its exception frame, r4-r11 and
+EXC_RETURN, and of the s16-s31 slot that follows for a floating point task. */
+#define crashdumpCONTEXT_WORDS			( 9UL )
+#define crashdumpFPU_SLOT_WORDS			( 16UL )
+
+/* Exception number of the first external interrupt. */
+#define crashdumpFIRST_IRQ				( 16UL )
+
+/* Words of the record covered by the checksum before ulStack. */
+#define crashdumpHEADER_WORDS			( offsetof( CrashDump_t, ulChecksum ) / sizeof( uint32_t ) )
+
+/* The record lives in the retained part of SRAM2 which is not touched by the
+startup code, so it survives the reset that follows the capture.  It is linked
+after the trace recorder, which stays at the start of the area. */
+PRIVILEGED_DATA static CrashDump_t xCrashDump __attribute__( ( section( ".retained.crash" ) ) );
+
+/* Set while a capture is in progress, a second crash resets at once. */
+PRIVILEGED_DATA static volatile uint32_t ulCrashDumpBusy = 0UL;
+
+/* r4 to r11 as they were when the fault was taken, stored by the fault handler
+before any C code can change them.  Not static as it is accessed from asm. */
+PRIVILEGED_DATA uint32_t ulCrashDumpCallee[ 8 ];
+
+/* The running task, accessed here to find its name and stack. */
+extern TaskHandle_t volatile pxCurrentTCB;
+
+/*
+ * Common fault handler, the CMSIS handler names are aliases of it.
+ */
+void xCrashDumpFaultHandler( void ) __attribute__( ( naked ) );
+
+/*
+ * Second half of the fault handler, pulFrame is the exception frame and
+ * ulExcReturn the EXC_RETURN value.  Not static as it is branched to from asm.
+ */
+void vCrashDumpCaptureFault( const uint32_t *pulFrame, uint32_t ulExcReturn ) __attribute__( ( noreturn, used ) ) PRIVILEGED_FUNCTION;
+
+/*
+ * Keep any further fault from being taken, claim the record and start it.
+ * Resets at once if a capture is already in progress.
+ */
+static void prvCrashDumpBegin( uint32_t ulCause ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fill the registers from the exception frame at pulFrame, taken with
+ * ulExcReturn, and return the stack pointer from before the exception.
+ */
+static uint32_t prvCrashDumpFrame( const uint32_t *pulFrame, uint32_t ulExcReturn ) PRIVILEGED_FUNCTION;
+
+/*
+ * Complete the record with the task and the stack above ulSp, then reset.
+ */
+static void prvCrashDumpEnd( uint32_t ulSp, void *pvTask ) __attribute__( ( noreturn ) ) PRIVILEGED_FUNCTION;
+
+/*
+ * pdTRUE if the record is intact, whether cleared or not.
+ */
+static BaseType_t prvCrashDumpValid( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Checksum of the header and the copied part of the stack.
+ */
+static uint32_t prvCrashDumpChecksum( const CrashDump_t *pxDump ) PRIVILEGED_FUNCTION;
+
+/*
+ * Halt for an attached debugger, then reset the device.
+ */
+static void prvCrashDumpReset( void ) __attribute__( ( noreturn ) ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCrashDumpChecksum( const CrashDump_t *pxDump )
+{
+const uint32_t *pulWord = ( const uint32_t * ) pxDump;
+uint32_t ulSum = 0xffffffffUL, ulIndex;
+
+	/* Only meant to tell a record from what was left in SRAM2 by a power
+	cycle or an older image, a rotate and xor is enough for that. */
+	for( ulIndex = 0UL; ulIndex < crashdumpHEADER_WORDS; ulIndex++ )
+	{
+		ulSum = ( ( ulSum << 1UL ) | ( ulSum >> 31UL ) ) ^ pulWord[ ulIndex ];
+	}
+
+	for( ulIndex = 0UL; ulIndex < pxDump->ulStackWords; ulIndex++ )
+	{
+		ulSum = ( ( ulSum << 1UL ) | ( ulSum >> 31UL ) ) ^ pxDump->ulStack[ ulIndex ];
+	}
+
+	return ulSum;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCrashDumpValid( void )
+{
+BaseType_t xReturn = pdFALSE;
+
+	if( ( xCrashDump.ulMagic == crashdumpMAGIC ) &&
+		( xCrashDump.ulVersion == crashdumpVERSION ) &&
+		( xCrashDump.ulLength == ( uint32_t ) configCRASH_DUMP_STACK_WORDS ) &&
+		( xCrashDump.ulStackWords <= ( uint32_t ) configCRASH_DUMP_STACK_WORDS ) &&
+		( xCrashDump.ulChecksum == prvCrashDumpChecksum( &xCrashDump ) ) )
+	{
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCrashDumpReset( void )
+{
+	if( ( crashdumpDHCSR_REG & crashdumpDHCSR_C_DEBUGEN ) != 0UL )
+	{
+		/* Stop where the record is complete, continuing resets. */
+		__asm volatile( "bkpt #0" );
+	}
+
+	__asm volatile( "dsb" ::: "memory" );
+	crashdumpAIRCR_REG = crashdumpAIRCR_VECTKEY | ( crashdumpAIRCR_REG & crashdumpAIRCR_PRIGROUP ) | crashdumpAIRCR_SYSRESETREQ;
+	__asm volatile( "dsb" ::: "memory" );
+
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCrashDumpBegin( uint32_t ulCause )
+{
+uint32_t ulSequence = 1UL;
+
+	/* Only NMI can preempt from here.  With FAULTMASK set the MPU is bypassed
+	and precise data bus faults are ignored once BFHFNMIGN is set, so reading a
+	corrupt stack cannot fault again. */
+	__asm volatile( "cpsid f" ::: "memory" );
+	crashdumpCCR_REG |= crashdumpCCR_BFHFNMIGN;
+	__asm volatile( "dsb" ::: "memory" );
+	__asm volatile( "isb" );
+
+	if( ulCrashDumpBusy != 0UL )
+	{
+		prvCrashDumpReset();
+	}
+	ulCrashDumpBusy = 1UL;
+
+	if( prvCrashDumpValid() != pdFALSE )
+	{
+		/* Carry on counting from the last record, cleared or not. */
+		ulSequence = xCrashDump.ulSequence + 1UL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memset( &xCrashDump, 0x00, offsetof( CrashDump_t, ulStack ) );
+	xCrashDump.ulMagic = crashdumpMAGIC;
+	xCrashDump.ulVersion = crashdumpVERSION;
+	xCrashDump.ulLength = configCRASH_DUMP_STACK_WORDS;
+	xCrashDump.ulSequence = ulSequence;
+	xCrashDump.ulCause = ulCause;
+	xCrashDump.ulTick = ( uint32_t ) xTaskGetTickCount();
+	xCrashDump.ulCfsr = crashdumpCFSR_REG;
+	xCrashDump.ulHfsr = crashdumpHFSR_REG;
+	xCrashDump.ulMmfar = crashdumpMMFAR_REG;
+	xCrashDump.ulBfar = crashdumpBFAR_REG;
+	xCrashDump.ulAfsr = crashdumpAFSR_REG;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCrashDumpEnd( uint32_t ulSp, void *pvTask )
+{
+const uint32_t *pulStack = ( const uint32_t * ) ( ulSp & ~3UL );
+const char *pcName;
+uint32_t ulIndex;
+
+	xCrashDump.ulRegisters[ crashdumpREG_SP ] = ulSp;
+
+	if( pvTask != NULL )
+	{
+		xCrashDump.ulTask = ( uint32_t ) pvTask;
+
+		/* The second member of a TCB is the lowest address of its stack. */
+		xCrashDump.ulStackLimit = ( ( uint32_t * ) pvTask )[ 1 ];
+
+		pcName = pcTaskGetName( ( TaskHandle_t ) pvTask );
+		for( ulIndex = 0UL; ( ulIndex < ( uint32_t ) crashdumpNAME_LEN - 1UL ) && ( ulIndex < ( uint32_t ) configMAX_TASK_NAME_LEN ); ulIndex++ )
+		{
+			if( pcName[ ulIndex ] == 0x00 )
+			{
+				break;
+			}
+			xCrashDump.cTaskName[ ulIndex ] = pcName[ ulIndex ];
+		}
+	}
+
+	/* Bounded copy from the stack pointer up, the frames of the callers. */
+	xCrashDump.ulStackAddress = ( uint32_t ) pulStack;
+	for( ulIndex = 0UL; ulIndex < ( uint32_t ) configCRASH_DUMP_STACK_WORDS; ulIndex++ )
+	{
+		xCrashDump.ulStack[ ulIndex ] = pulStack[ ulIndex ];
+	}
+	xCrashDump.ulStackWords = ulIndex;
+
+	xCrashDump.ulChecksum = prvCrashDumpChecksum( &xCrashDump );
+
+	prvCrashDumpReset();
+}
+/*-----------------------------------------------------------*/
+
+void xCrashDumpFaultHandler( void )
+{
+	__asm volatile
+	(
+	"	cpsid f								\n"
+	"	ldr r2, ulCrashDumpCalleeConst		\n" /* Save r4-r11 before C code can touch them. */
+	"	stmia r2, {r4-r11}					\n"
+	"	tst lr, #4							\n" /* Find the exception frame. */
+	"	ite eq								\n"
+	"	mrseq r0, msp						\n"
+	"	mrsne r0, psp						\n"
+	"	mov r1, lr							\n"
+	"	b vCrashDumpCaptureFault			\n"
+	"										\n"
+	"	.align 4							\n"
+	"ulCrashDumpCalleeConst: .word ulCrashDumpCallee	\n"
+	);
+}
+
+/* The handlers are mapped to their CMSIS names in FreeRTOSConfig.h. */
+void xCrashDumpHardFaultHandler( void ) __attribute__( ( alias( "xCrashDumpFaultHandler" ) ) );
+void xCrashDumpMemManageHandler( void ) __attribute__( ( alias( "xCrashDumpFaultHandler" ) ) );
+void xCrashDumpBusFaultHandler( void ) __attribute__( ( alias( "xCrashDumpFaultHandler" ) ) );
+void xCrashDumpUsageFaultHandler( void ) __attribute__( ( alias( "xCrashDumpFaultHandler" ) ) );
+void xCrashDumpWatchdogHandler( void ) __attribute__( ( alias( "xCrashDumpFaultHandler" ) ) );
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCrashDumpFrame( const uint32_t *pulFrame, uint32_t ulExcReturn )
+{
+uint32_t ulSp, ulIndex;
+
+	xCrashDump.ulExcReturn = ulExcReturn;
+
+	if( ( ulExcReturn & crashdumpEXC_RETURN_PSP ) != 0UL )
+	{
+		xCrashDump.ulFlags |= crashdumpFLAG_PSP;
+	}
+	if( ( ulExcReturn & crashdumpEXC_RETURN_THREAD ) == 0UL )
+	{
+		xCrashDump.ulFlags |= crashdumpFLAG_HANDLER;
+	}
+
+	for( ulIndex = 0UL; ulIndex < 4UL; ulIndex++ )
+	{
+		xCrashDump.ulRegisters[ ulIndex ] = pulFrame[ ulIndex ];
+	}
+	xCrashDump.ulRegisters[ 12 ] = pulFrame[ 4 ];
+	xCrashDump.ulRegisters[ crashdumpREG_LR ] = pulFrame[ 5 ];
+	xCrashDump.ulRegisters[ crashdumpREG_PC ] = pulFrame[ 6 ];
+	xCrashDump.ulRegisters[ crashdumpREG_XPSR ] = pulFrame[ 7 ];
+
+	/* The stack pointer of the code that was interrupted is above the frame. */
+	if( ( ulExcReturn & crashdumpEXC_RETURN_NO_FPU ) == 0UL )
+	{
+		xCrashDump.ulFlags |= crashdumpFLAG_FPU;
+		ulSp = ( uint32_t ) ( pulFrame + crashdumpFPU_FRAME_WORDS );
+	}
+	else
+	{
+		ulSp = ( uint32_t ) ( pulFrame + crashdumpFRAME_WORDS );
+	}
+	if( ( pulFrame[ 7 ] & crashdumpXPSR_STACK_ALIGN ) != 0UL )
+	{
+		ulSp += 4UL;
+	}
+
+	return ulSp;
+}
+/*-----------------------------------------------------------*/
+
+void vCrashDumpCaptureFault( const uint32_t *pulFrame, uint32_t ulExcReturn )
+{
+uint32_t ulIpsr, ulSp, ulIndex;
+
+	__asm volatile( "mrs %0, ipsr" : "=r" ( ulIpsr ) );
+	ulIpsr &= crashdumpIPSR_MASK;
+
+	/* Only the watchdog early warning interrupt is routed here. */
+	prvCrashDumpBegin( ( ulIpsr >= crashdumpFIRST_IRQ ) ? crashdumpCAUSE_WATCHDOG : ulIpsr );
+
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	{
+		if( ( xCrashDump.ulCause == crashdumpCAUSE_MEM_MANAGE ) && ( xPortStackGuardFault() != pdFALSE ) )
+		{
+			xCrashDump.ulCause = crashdumpCAUSE_STACK_OVERFLOW;
+		}
+	}
+	#endif
+
+	/* A frame that could not be stacked holds whatever was there before. */
+	if( ( xCrashDump.ulCfsr & ( crashdumpCFSR_MSTKERR | crashdumpCFSR_STKERR ) ) == 0UL )
+	{
+		xCrashDump.ulFlags |= crashdumpFLAG_FRAME;
+	}
+
+	for( ulIndex = 0UL; ulIndex < 8UL; ulIndex++ )
+	{
+		xCrashDump.ulRegisters[ 4UL + ulIndex ] = ulCrashDumpCallee[ ulIndex ];
+	}
+	ulSp = prvCrashDumpFrame( pulFrame, ulExcReturn );
+
+	/* The task is only of interest if it was the one running. */
+	prvCrashDumpEnd( ulSp, ( ( xCrashDump.ulFlags & crashdumpFLAG_PSP ) != 0UL ) ? ( void * ) pxCurrentTCB : NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vCrashDumpAssert( uint32_t ulLine )
+{
+uint32_t ulSp, ulIpsr, ulControl;
+uint32_t ulReturn = ( uint32_t ) __builtin_return_address( 0 );
+
+	__asm volatile( "mov %0, sp" : "=r" ( ulSp ) );
+	__asm volatile( "mrs %0, ipsr" : "=r" ( ulIpsr ) );
+	__asm volatile( "mrs %0, control" : "=r" ( ulControl ) );
+
+	prvCrashDumpBegin( crashdumpCAUSE_ASSERT );
+	xCrashDump.ulLine = ulLine;
+
+	/* Point the pc into the call of this function, where the assert is, and
+	keep the return address as the link register. */
+	xCrashDump.ulRegisters[ crashdumpREG_LR ] = ulReturn;
+	xCrashDump.ulRegisters[ crashdumpREG_PC ] = ( ulReturn & ~1UL ) - 2UL;
+
+	if( ( ulIpsr & crashdumpIPSR_MASK ) != 0UL )
+	{
+		xCrashDump.ulFlags |= crashdumpFLAG_HANDLER;
+		prvCrashDumpEnd( ulSp, NULL );
+	}
+	else if( ( ulControl & 0x2UL ) != 0UL )
+	{
+		/* Thread mode on the process stack, a task failed the assert. */
+		xCrashDump.ulFlags |= crashdumpFLAG_PSP;
+		prvCrashDumpEnd( ulSp, ( void * ) pxCurrentTCB );
+	}
+	else
+	{
+		/* Before the scheduler was started. */
+		prvCrashDumpEnd( ulSp, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vCrashDumpStackOverflow( void *pvTask )
+{
+uint32_t ulSp;
+uint32_t ulReturn = ( uint32_t ) __builtin_return_address( 0 );
+
+	/* Called from the context switch, the process stack pointer is where the
+	context of the task was saved. */
+	__asm volatile( "mrs %0, psp" : "=r" ( ulSp ) );
+
+	prvCrashDumpBegin( crashdumpCAUSE_STACK_OVERFLOW );
+	xCrashDump.ulFlags |= crashdumpFLAG_PSP;
+	xCrashDump.ulRegisters[ crashdumpREG_LR ] = ulReturn;
+	xCrashDump.ulRegisters[ crashdumpREG_PC ] = ( ulReturn & ~1UL ) - 2UL;
+
+	prvCrashDumpEnd( ulSp, pvTask );
+}
+/*-----------------------------------------------------------*/
+
+void vCrashDumpTask( uint32_t ulCause, void *pvTask )
+{
+const uint32_t *pulContext;
+uint32_t ulIndex, ulSp;
+uint32_t ulReturn = ( uint32_t ) __builtin_return_address( 0 );
+
+	__asm volatile( "mov %0, sp" : "=r" ( ulSp ) );
+
+	prvCrashDumpBegin( ulCause );
+
+	if( ( pvTask == NULL ) || ( pvTask == ( void * ) pxCurrentTCB ) )
+	{
+		/* The caller itself, there is no saved context. */
+		xCrashDump.ulFlags |= crashdumpFLAG_PSP;
+		xCrashDump.ulRegisters[ crashdumpREG_LR ] = ulReturn;
+		xCrashDump.ulRegisters[ crashdumpREG_PC ] = ( ulReturn & ~1UL ) - 2UL;
+		prvCrashDumpEnd( ulSp, ( void * ) pxCurrentTCB );
+	}
+
+	/* The first member of a TCB is the top of stack saved by
+	xPortPendSVHandler(): r4-r11, EXC_RETURN, the s16-s31 slot of a floating
+	point context, then the exception frame. */
+	pulContext = *( ( const uint32_t * const * ) pvTask );
+	for( ulIndex = 0UL; ulIndex < 8UL; ulIndex++ )
+	{
+		xCrashDump.ulRegisters[ 4UL + ulIndex ] = pulContext[ ulIndex ];
+	}
+	xCrashDump.ulFlags |= crashdumpFLAG_FRAME;
+	if( ( pulContext[ 8 ] & crashdumpEXC_RETURN_NO_FPU ) == 0UL )
+	{
+		ulSp = prvCrashDumpFrame( pulContext + crashdumpCONTEXT_WORDS + crashdumpFPU_SLOT_WORDS, pulContext[ 8 ] );
+	}
+	else
+	{
+		ulSp = prvCrashDumpFrame( pulContext + crashdumpCONTEXT_WORDS, pulContext[ 8 ] );
+	}
+
+	prvCrashDumpEnd( ulSp, pvTask );
+}
+/*-----------------------------------------------------------*/
+
+const CrashDump_t *pxCrashDumpGet( void )
+{
+const CrashDump_t *pxDump = NULL;
+
+	if( ( prvCrashDumpValid() != pdFALSE ) && ( xCrashDump.ulCause != crashdumpCAUSE_NONE ) )
+	{
+		pxDump = &xCrashDump;
+	}
+
+	return pxDump;
+}
+/*-----------------------------------------------------------*/
+
+void vCrashDumpClear( void )
+{
+	if( pxCrashDumpGet() != NULL )
+	{
+		xCrashDump.ulCause = crashdumpCAUSE_NONE;
+		xCrashDump.ulChecksum = prvCrashDumpChecksum( &xCrashDump );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_CRASH_DUMP */
@@ -72,10 +72,25 @@ typedef struct EventGroupDef_t
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
+
+	#if( configUSE_QUEUE_SETS == 1 )
+		QueueSetHandle_t xQueueSetContainer;	/*< The queue set the event group is a member of, or NULL. */
+		EventBits_t uxQueueSetBits;				/*< The bits that notify the queue set. */
+		BaseType_t xInQueueSet;					/*< pdTRUE while the handle is posted to the set and the bits have not been read since. */
+	#endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Post the event group to the queue set it is a member of if one of the bits
+ * the set waits for is set and it is not already posted.  Called with the
+ * scheduler suspended.
+ */
+#if( configUSE_QUEUE_SETS == 1 )
+	static void prvNotifyQueueSet( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Test the bits set in uxCurrentEventBits to see if the wait condition is met.
  * The wait condition is defined by xWaitForAllBits.  If xWaitForAllBits is
@@ -115,6 +130,14 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_QUEUE_SETS == 1 )
+			{
+				pxEventBits->xQueueSetContainer = NULL;
+				pxEventBits->uxQueueSetBits = 0;
+				pxEventBits->xInQueueSet = pdFALSE;
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note that
@@ -166,6 +189,14 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_QUEUE_SETS == 1 )
+			{
+				pxEventBits->xQueueSetContainer = NULL;
+				pxEventBits->uxQueueSetBits = 0;
+				pxEventBits->xInQueueSet = pdFALSE;
+			}
+			#endif /* configUSE_QUEUE_SETS */
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note this
@@ -330,6 +361,14 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 	{
 		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
+		#if( configUSE_QUEUE_SETS == 1 )
+		{
+			/* The bits are being read, the next bit set notifies the queue
+			set again. */
+			pxEventBits->xInQueueSet = pdFALSE;
+		}
+		#endif
+
 		/* Check to see if the wait condition is already met or not. */
 		xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
 
@@ -478,6 +517,14 @@ EventBits_t uxReturn;
 
 		/* Clear the bits. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		#if( configUSE_QUEUE_SETS == 1 )
+		{
+			/* The bits are being read, the next bit set notifies the queue
+			set again. */
+			pxEventBits->xInQueueSet = pdFALSE;
+		}
+		#endif
 	}
 	taskEXIT_CRITICAL();
 
@@ -485,14 +532,14 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) || ( configUSE_WORK_QUEUE == 1 ) ) )
 
 	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
 	{
 		BaseType_t xReturn;
 
 		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+		xReturn = eventgroupsPEND_FROM_ISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
 		return xReturn;
 	}
@@ -603,6 +650,12 @@ BaseType_t xMatchFound = pdFALSE;
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
 		pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+		#if( configUSE_QUEUE_SETS == 1 )
+		{
+			prvNotifyQueueSet( pxEventBits );
+		}
+		#endif
 	}
 	( void ) xTaskResumeAll();
 
@@ -619,6 +672,21 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
+		#if( configUSE_QUEUE_SETS == 1 )
+		{
+			/* The set must not hold, or later receive, the handle of the freed
+			event group. */
+			if( pxEventBits->xQueueSetContainer != NULL )
+			{
+				( void ) xEventGroupRemoveFromSet( xEventGroup, pxEventBits->xQueueSetContainer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_QUEUE_SETS */
+
 		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
 		{
 			/* Unblock the task, returning 0 as the event list is being deleted
@@ -668,6 +736,116 @@ void vEventGroupClearBitsCallback( void *pvEventGroup, const uint32_t ulBitsToCl
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_SETS == 1 )
+
+	BaseType_t xEventGroupAddToSet( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToNotify, QueueSetHandle_t xQueueSet )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	BaseType_t xReturn;
+
+		configASSERT( xEventGroup );
+		configASSERT( xQueueSet );
+		configASSERT( ( uxBitsToNotify & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+		configASSERT( uxBitsToNotify != 0 );
+
+		vTaskSuspendAll();
+		{
+			if( pxEventBits->xQueueSetContainer != NULL )
+			{
+				/* Cannot add an event group to more than one queue set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxEventBits->xQueueSetContainer = xQueueSet;
+				pxEventBits->uxQueueSetBits = uxBitsToNotify;
+				pxEventBits->xInQueueSet = pdFALSE;
+
+				/* Bits that are already set notify the set straight away. */
+				prvNotifyQueueSet( pxEventBits );
+				xReturn = pdPASS;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_SETS == 1 )
+
+	BaseType_t xEventGroupRemoveFromSet( EventGroupHandle_t xEventGroup, QueueSetHandle_t xQueueSet )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	BaseType_t xReturn;
+
+		configASSERT( xEventGroup );
+
+		vTaskSuspendAll();
+		{
+			if( pxEventBits->xQueueSetContainer != xQueueSet )
+			{
+				/* The event group was not a member of the set. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				if( pxEventBits->xInQueueSet != pdFALSE )
+				{
+					/* Withdraw the notification the set still holds. */
+					vQueueSetWithdraw( xQueueSet, ( QueueSetMemberHandle_t ) xEventGroup );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxEventBits->xQueueSetContainer = NULL;
+				pxEventBits->uxQueueSetBits = 0;
+				pxEventBits->xInQueueSet = pdFALSE;
+				xReturn = pdPASS;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_SETS == 1 )
+
+	static void prvNotifyQueueSet( EventGroup_t *pxEventBits )
+	{
+	EventGroupHandle_t xEventGroup = pxEventBits;
+
+		if( ( pxEventBits->xQueueSetContainer != NULL ) &&
+			( pxEventBits->xInQueueSet == pdFALSE ) &&
+			( ( pxEventBits->uxEventBits & pxEventBits->uxQueueSetBits ) != ( EventBits_t ) 0 ) )
+		{
+			/* The set has room for one entry per event group, so this does
+			not block even though the scheduler is suspended. */
+			if( xQueueSend( pxEventBits->xQueueSetContainer, &xEventGroup, ( TickType_t ) 0 ) != pdFALSE )
+			{
+				pxEventBits->xInQueueSet = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
 {
 BaseType_t xWaitConditionMet = pdFALSE;
@@ -703,14 +881,14 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( ( ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) || ( configUSE_WORK_QUEUE == 1 ) ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	BaseType_t xReturn;
 
 		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+		xReturn = eventgroupsPEND_FROM_ISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
 		return xReturn;
 	}
@@ -95,8 +95,27 @@ typedef struct A_BLOCK_LINK
 {
 	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
 	size_t xBlockSize;						/*<< The size of the free block. */
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+		UBaseType_t uxSlot;					/*<< Accounting slot the allocated block is charged to. */
+	#endif
 } BlockLink_t;
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* Per-task allocation counters, indexed by the slot stored in the TCB. */
+	typedef struct A_HEAP_SLOT
+	{
+		char pcName[ configMAX_TASK_NAME_LEN ];
+		size_t xCurrentBytes;
+		size_t xPeakBytes;
+		size_t xLimitBytes;
+		UBaseType_t uxLiveBlocks;
+		uint32_t ulDenied;
+		uint8_t ucState;
+	} HeapSlot_t;
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -107,6 +126,16 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/*
+	 * Append one record to the allocation log, overwriting the oldest record
+	 * once the log is full.  Must be called with the scheduler suspended.
+	 */
+	static void prvHeapLogAppend( void *pvAddress, size_t xSize, UBaseType_t uxSlot, uint8_t ucOperation );
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -127,12 +156,30 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	/* Slot 0 is shared by allocations made before the scheduler starts and by
+	tasks created once every other slot was taken.  It is never released. */
+	static HeapSlot_t xHeapSlots[ configHEAP_ACCOUNTING_SLOTS ] = { { "", 0U, 0U, 0U, 0U, 0U, heapSLOT_ACTIVE } };
+
+	/* Ring of the latest allocation operations.  ulHeapLogSequence counts every
+	record ever written, the record with sequence n lives at index
+	n % configHEAP_ACCOUNTING_LOG_LENGTH. */
+	static HeapLogEntry_t xHeapLog[ configHEAP_ACCOUNTING_LOG_LENGTH ];
+	static uint32_t ulHeapLogSequence = 0U;
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
 {
 BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
 void *pvReturn = NULL;
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+	UBaseType_t uxSlot;
+	HeapSlot_t *pxSlot;
+#endif
 
 	/* The heap must be initialised before the first call to
 	prvPortMalloc(). */
@@ -140,6 +187,13 @@ void *pvReturn = NULL;
 
 	vTaskSuspendAll();
 	{
+		#if( configUSE_HEAP_ACCOUNTING == 1 )
+		{
+			uxSlot = uxTaskGetHeapSlot( NULL );
+			pxSlot = &( xHeapSlots[ uxSlot ] );
+		}
+		#endif
+
 		/* Check the requested block size is not so large that the top bit is
 		set.  The top bit of the block size member of the BlockLink_t structure
 		is used to determine who owns the block - the application or the
@@ -169,6 +223,26 @@ void *pvReturn = NULL;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if( configUSE_HEAP_ACCOUNTING == 1 )
+			{
+				/* Refuse the request up front if it would take the task over
+				its cap.  The check uses the rounded size, not the size of the
+				block finally carved, so a split remainder may let the task end
+				up at most heapMINIMUM_BLOCK_SIZE bytes over. */
+				if( ( pxSlot->xLimitBytes != 0U ) && ( xWantedSize > 0 ) &&
+					( ( pxSlot->xCurrentBytes + xWantedSize ) > pxSlot->xLimitBytes ) )
+				{
+					( pxSlot->ulDenied )++;
+					prvHeapLogAppend( NULL, xWantedSize, uxSlot, heapLOG_DENIED );
+					xWantedSize = 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
 			if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
 			{
 				/* Traverse the list from the start	(lowest address) block until
@@ -229,6 +303,25 @@ void *pvReturn = NULL;
 
 					/* The block is being returned - it is allocated and owned
 					by the application and has no "next" block. */
+					#if( configUSE_HEAP_ACCOUNTING == 1 )
+					{
+						pxBlock->uxSlot = uxSlot;
+						pxSlot->xCurrentBytes += pxBlock->xBlockSize;
+						( pxSlot->uxLiveBlocks )++;
+
+						if( pxSlot->xCurrentBytes > pxSlot->xPeakBytes )
+						{
+							pxSlot->xPeakBytes = pxSlot->xCurrentBytes;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						prvHeapLogAppend( pvReturn, pxBlock->xBlockSize, uxSlot, heapLOG_MALLOC );
+					}
+					#endif
+
 					pxBlock->xBlockSize |= xBlockAllocatedBit;
 					pxBlock->pxNextFreeBlock = NULL;
 				}
@@ -297,6 +390,27 @@ BlockLink_t *pxLink;
 
 				vTaskSuspendAll();
 				{
+					#if( configUSE_HEAP_ACCOUNTING == 1 )
+					{
+					HeapSlot_t *pxSlot = &( xHeapSlots[ pxLink->uxSlot ] );
+
+						configASSERT( pxSlot->uxLiveBlocks > 0U );
+						pxSlot->xCurrentBytes -= pxLink->xBlockSize;
+						( pxSlot->uxLiveBlocks )--;
+						prvHeapLogAppend( pv, pxLink->xBlockSize, pxLink->uxSlot, heapLOG_FREE );
+
+						/* The last block of a deleted task has been returned. */
+						if( ( pxSlot->ucState == heapSLOT_ORPHAN ) && ( pxSlot->uxLiveBlocks == 0U ) )
+						{
+							pxSlot->ucState = heapSLOT_FREE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif
+
 					/* Add this block to the list of free blocks. */
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
@@ -483,3 +597,170 @@ const HeapRegion_t *pxHeapRegion;
 	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
 }
 
+#if( configUSE_HEAP_ACCOUNTING == 1 )
+
+	static void prvHeapLogAppend( void *pvAddress, size_t xSize, UBaseType_t uxSlot, uint8_t ucOperation )
+	{
+	HeapLogEntry_t *pxEntry = &( xHeapLog[ ulHeapLogSequence % ( uint32_t ) configHEAP_ACCOUNTING_LOG_LENGTH ] );
+
+		pxEntry->pvAddress = pvAddress;
+		pxEntry->xTick = xTaskGetTickCount();
+		pxEntry->usSize = ( xSize > ( size_t ) 0xFFFFU ) ? ( uint16_t ) 0xFFFFU : ( uint16_t ) xSize;
+		pxEntry->ucSlot = ( uint8_t ) uxSlot;
+		pxEntry->ucOperation = ucOperation;
+		ulHeapLogSequence++;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortHeapSlotAcquire( const char *pcName )
+	{
+	UBaseType_t uxSlot, x;
+
+		vTaskSuspendAll();
+		{
+			for( uxSlot = 1U; uxSlot < ( UBaseType_t ) configHEAP_ACCOUNTING_SLOTS; uxSlot++ )
+			{
+				if( xHeapSlots[ uxSlot ].ucState == heapSLOT_FREE )
+				{
+					break;
+				}
+			}
+
+			if( uxSlot < ( UBaseType_t ) configHEAP_ACCOUNTING_SLOTS )
+			{
+				for( x = 0U; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+				{
+					xHeapSlots[ uxSlot ].pcName[ x ] = pcName[ x ];
+
+					if( pcName[ x ] == ( char ) 0x00 )
+					{
+						break;
+					}
+				}
+				xHeapSlots[ uxSlot ].pcName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+				xHeapSlots[ uxSlot ].xCurrentBytes = 0U;
+				xHeapSlots[ uxSlot ].xPeakBytes = 0U;
+				xHeapSlots[ uxSlot ].xLimitBytes = 0U;
+				xHeapSlots[ uxSlot ].uxLiveBlocks = 0U;
+				xHeapSlots[ uxSlot ].ulDenied = 0U;
+				xHeapSlots[ uxSlot ].ucState = heapSLOT_ACTIVE;
+			}
+			else
+			{
+				/* Out of slots - share the anonymous slot. */
+				uxSlot = 0U;
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return uxSlot;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortHeapSlotRelease( UBaseType_t uxSlot )
+	{
+		if( ( uxSlot != 0U ) && ( uxSlot < ( UBaseType_t ) configHEAP_ACCOUNTING_SLOTS ) )
+		{
+			vTaskSuspendAll();
+			{
+				xHeapSlots[ uxSlot ].ucState = ( xHeapSlots[ uxSlot ].uxLiveBlocks == 0U ) ? heapSLOT_FREE : heapSLOT_ORPHAN;
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortGetHeapSlotStats( UBaseType_t uxSlot, HeapSlotStats_t *pxStats )
+	{
+	BaseType_t xReturn = pdFAIL;
+	UBaseType_t x;
+
+		if( ( uxSlot < ( UBaseType_t ) configHEAP_ACCOUNTING_SLOTS ) && ( pxStats != NULL ) )
+		{
+			vTaskSuspendAll();
+			{
+				for( x = 0U; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+				{
+					pxStats->pcName[ x ] = xHeapSlots[ uxSlot ].pcName[ x ];
+				}
+				pxStats->xCurrentBytes = xHeapSlots[ uxSlot ].xCurrentBytes;
+				pxStats->xPeakBytes = xHeapSlots[ uxSlot ].xPeakBytes;
+				pxStats->xLimitBytes = xHeapSlots[ uxSlot ].xLimitBytes;
+				pxStats->uxLiveBlocks = xHeapSlots[ uxSlot ].uxLiveBlocks;
+				pxStats->ulDenied = xHeapSlots[ uxSlot ].ulDenied;
+				pxStats->ucState = xHeapSlots[ uxSlot ].ucState;
+			}
+			( void ) xTaskResumeAll();
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortSetHeapSlotLimit( UBaseType_t uxSlot, size_t xLimitBytes )
+	{
+	BaseType_t xReturn = pdFAIL;
+
+		if( uxSlot < ( UBaseType_t ) configHEAP_ACCOUNTING_SLOTS )
+		{
+			vTaskSuspendAll();
+			{
+				xHeapSlots[ uxSlot ].xLimitBytes = xLimitBytes;
+			}
+			( void ) xTaskResumeAll();
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetHeapLog( HeapLogEntry_t *pxEntries, UBaseType_t uxMaxEntries, uint32_t *pulSequence )
+	{
+	UBaseType_t uxCopied = 0U;
+	uint32_t ulSequence;
+
+		configASSERT( pulSequence );
+
+		vTaskSuspendAll();
+		{
+			ulSequence = *pulSequence;
+
+			/* Records older than one log length have been overwritten. */
+			if( ( ulHeapLogSequence - ulSequence ) > ( uint32_t ) configHEAP_ACCOUNTING_LOG_LENGTH )
+			{
+				ulSequence = ulHeapLogSequence - ( uint32_t ) configHEAP_ACCOUNTING_LOG_LENGTH;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			while( ( ulSequence != ulHeapLogSequence ) && ( uxCopied < uxMaxEntries ) )
+			{
+				pxEntries[ uxCopied ] = xHeapLog[ ulSequence % ( uint32_t ) configHEAP_ACCOUNTING_LOG_LENGTH ];
+				uxCopied++;
+				ulSequence++;
+			}
+
+			*pulSequence = ulSequence;
+		}
+		( void ) xTaskResumeAll();
+
+		return uxCopied;
+	}
+
+#endif /* configUSE_HEAP_ACCOUNTING */
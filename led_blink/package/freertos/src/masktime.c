@@ -0,0 +1,211 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Maximum interrupt masked time, see masktime.h.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "masktime.h"
+
+#if( configUSE_MASK_TIME == 1 )
+
+typedef struct xMASK_TIME_SECTION
+{
+	uint32_t ulStart;							/* Run time counter when the open section started. */
+	void *pvCaller;								/* Address that opened it. */
+	BaseType_t xOpen;							/* pdTRUE between vMaskTimeEnter() and vMaskTimeExit(). */
+	uint32_t ulFloor;							/* Shortest maximum in xStats.xWorst, 0 while an entry is free. */
+	MaskTimeStats_t xStats;
+} MaskTimeSection_t;
+
+PRIVILEGED_DATA static MaskTimeSection_t xMaskTime[ masktimeKINDS ];
+
+/*
+ * Charge a section that took longer than the shortest entry of the worst
+ * offenders table to its caller.  Called with interrupts masked.
+ */
+static void prvMaskTimeWorst( MaskTimeSection_t *pxSection, uint32_t ulCycles ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvMaskTimeWorst( MaskTimeSection_t *pxSection, uint32_t ulCycles )
+{
+MaskTimeCaller_t *pxWorst = pxSection->xStats.xWorst;
+UBaseType_t uxEntry, uxShortest = ( UBaseType_t ) 0U;
+
+	for( uxEntry = ( UBaseType_t ) 0U; uxEntry < ( UBaseType_t ) configMASK_TIME_CALLERS; uxEntry++ )
+	{
+		if( pxWorst[ uxEntry ].pvCaller == pxSection->pvCaller )
+		{
+			break;
+		}
+
+		if( pxWorst[ uxEntry ].ulMaximum < pxWorst[ uxShortest ].ulMaximum )
+		{
+			uxShortest = uxEntry;
+		}
+	}
+
+	if( uxEntry < ( UBaseType_t ) configMASK_TIME_CALLERS )
+	{
+		if( ulCycles > pxWorst[ uxEntry ].ulMaximum )
+		{
+			pxWorst[ uxEntry ].ulMaximum = ulCycles;
+		}
+	}
+	else
+	{
+		pxWorst[ uxShortest ].pvCaller = pxSection->pvCaller;
+		pxWorst[ uxShortest ].ulMaximum = ulCycles;
+	}
+
+	pxSection->ulFloor = pxWorst[ 0 ].ulMaximum;
+
+	for( uxEntry = ( UBaseType_t ) 1U; uxEntry < ( UBaseType_t ) configMASK_TIME_CALLERS; uxEntry++ )
+	{
+		if( pxWorst[ uxEntry ].ulMaximum < pxSection->ulFloor )
+		{
+			pxSection->ulFloor = pxWorst[ uxEntry ].ulMaximum;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMaskTimeEnter( UBaseType_t uxKind, void *pvCaller )
+{
+MaskTimeSection_t *pxSection = &( xMaskTime[ uxKind ] );
+
+	pxSection->pvCaller = pvCaller;
+	pxSection->xOpen = pdTRUE;
+
+	/* Last, so the bookkeeping above is not part of the section. */
+	pxSection->ulStart = portGET_RUN_TIME_COUNTER_VALUE();
+}
+/*-----------------------------------------------------------*/
+
+void vMaskTimeExit( UBaseType_t uxKind )
+{
+const uint32_t ulEnd = portGET_RUN_TIME_COUNTER_VALUE();
+MaskTimeSection_t *pxSection = &( xMaskTime[ uxKind ] );
+uint32_t ulCycles;
+UBaseType_t uxBucket;
+
+	if( pxSection->xOpen != pdFALSE )
+	{
+		pxSection->xOpen = pdFALSE;
+		ulCycles = ulEnd - pxSection->ulStart;
+
+		if( ulCycles < 2UL )
+		{
+			uxBucket = ( UBaseType_t ) 0U;
+		}
+		else
+		{
+			uxBucket = ( UBaseType_t ) ( 31UL - ( uint32_t ) __builtin_clz( ulCycles ) );
+		}
+
+		( pxSection->xStats.ulCount )++;
+		( pxSection->xStats.ulBuckets[ uxBucket ] )++;
+		pxSection->xStats.ullTotal += ulCycles;
+
+		if( ulCycles > pxSection->xStats.ulMaximum )
+		{
+			pxSection->xStats.ulMaximum = ulCycles;
+		}
+
+		/* Most sections are short, only the long ones pay for the table. */
+		if( ulCycles > pxSection->ulFloor )
+		{
+			prvMaskTimeWorst( pxSection, ulCycles );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* Opened before the scheduler started or before a reset. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMaskTimeGetStats( UBaseType_t uxKind, MaskTimeStats_t *pxStats )
+{
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus, uxEntry, uxLonger;
+MaskTimeCaller_t xCaller;
+
+	configASSERT( pxStats );
+
+	if( uxKind < ( UBaseType_t ) masktimeKINDS )
+	{
+		/* Not taskENTER_CRITICAL(), which would time itself. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			( void ) memcpy( pxStats, &( xMaskTime[ uxKind ].xStats ), sizeof( MaskTimeStats_t ) );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		/* Longest first, the table is short. */
+		for( uxEntry = ( UBaseType_t ) 1U; uxEntry < ( UBaseType_t ) configMASK_TIME_CALLERS; uxEntry++ )
+		{
+			xCaller = pxStats->xWorst[ uxEntry ];
+
+			for( uxLonger = uxEntry; uxLonger > ( UBaseType_t ) 0U; uxLonger-- )
+			{
+				if( pxStats->xWorst[ uxLonger - ( UBaseType_t ) 1U ].ulMaximum >= xCaller.ulMaximum )
+				{
+					break;
+				}
+
+				pxStats->xWorst[ uxLonger ] = pxStats->xWorst[ uxLonger - ( UBaseType_t ) 1U ];
+			}
+
+			pxStats->xWorst[ uxLonger ] = xCaller;
+		}
+
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMaskTimeReset( void )
+{
+UBaseType_t uxKind, uxSavedInterruptStatus;
+
+	for( uxKind = ( UBaseType_t ) 0U; uxKind < ( UBaseType_t ) masktimeKINDS; uxKind++ )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			/* A section open now is not recorded. */
+			xMaskTime[ uxKind ].xOpen = pdFALSE;
+			xMaskTime[ uxKind ].ulFloor = 0UL;
+			( void ) memset( &( xMaskTime[ uxKind ].xStats ), 0x00, sizeof( MaskTimeStats_t ) );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+}
+
+#endif /* configUSE_MASK_TIME */
@@ -32,6 +32,7 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "masktime.h"
 
 #ifndef __VFP_FP__
 	#error This port can only be used when the project options are configured to enable hardware floating point support.
@@ -84,6 +85,30 @@ r0p1 port. */
 /* Constants required to manipulate the VFP. */
 #define portFPCCR							( ( volatile uint32_t * ) 0xe000ef34 ) /* Floating point context control register. */
 #define portASPEN_AND_LSPEN_BITS			( 0x3UL << 30UL )
+#define portLSPACT_BIT						( 0x1UL )
+
+/* Constants required to program the stack guard MPU region. */
+#define portMPU_TYPE_REG					( * ( ( volatile uint32_t * ) 0xe000ed90 ) )
+#define portMPU_CTRL_REG					( * ( ( volatile uint32_t * ) 0xe000ed94 ) )
+#define portMPU_REGION_BASE_ADDRESS_REG		( * ( ( volatile uint32_t * ) 0xe000ed9c ) )
+#define portMPU_REGION_ATTRIBUTE_REG		( * ( ( volatile uint32_t * ) 0xe000eda0 ) )
+#define portNVIC_SYS_CTRL_STATE_REG			( * ( ( volatile uint32_t * ) 0xe000ed24 ) )
+#define portSCB_MMFSR_REG					( * ( ( volatile uint8_t * ) 0xe000ed28 ) )
+#define portSCB_MMFAR_REG					( * ( ( volatile uint32_t * ) 0xe000ed34 ) )
+#define portEXPECTED_MPU_TYPE_VALUE			( 8UL << 8UL ) /* 8 regions, unified. */
+#define portMPU_ENABLE						( 0x01UL )
+#define portMPU_BACKGROUND_ENABLE			( 1UL << 2UL )
+#define portMPU_REGION_ENABLE				( 0x01UL )
+#define portMPU_REGION_EXECUTE_NEVER		( 1UL << 28UL )
+#define portMPU_REGION_ADDRESS_MASK			( ~0x1fUL )
+#define portNVIC_MEM_FAULT_ENABLE			( 1UL << 16UL )
+#define portMMFSR_DACCVIOL					( 1UL << 1UL )
+#define portMMFSR_MSTKERR					( 1UL << 4UL )
+#define portMMFSR_MMARVALID					( 1UL << 7UL )
+
+/* Word offset of the s16-s31 slot from the top of stack of a task whose
+context includes FPU registers, above the saved r4-r11 and EXC_RETURN. */
+#define portFPU_SLOT_OFFSET					( 9 )
 
 /* Constants required to set up the initial stack. */
 #define portINITIAL_XPSR					( 0x01000000 )
@@ -139,12 +164,42 @@ static void vPortEnableVFP( void ) __attribute__ (( naked ));
  */
 static void prvTaskExitError( void );
 
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	/*
+	 * Set up the stack guard region for the first task and enable the MPU.
+	 */
+	static void prvSetupStackGuard( void );
+
+	/*
+	 * Report tasks that ran into their stack guard.
+	 */
+	void xPortMemManageHandler( void );
+
+	/* Supplied by the application. */
+	extern void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName );
+
+	/* The running task, accessed here to find its stack guard. */
+	extern TaskHandle_t volatile pxCurrentTCB;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Each task maintains its own interrupt status in the critical nesting
 variable. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	/* The task whose s16-s31 are still held in the FPU.  Its slot for them has
+	been reserved but not written, which is only the case while integer only
+	tasks run.  NULL when the registers hold no unsaved task state. */
+	static void * volatile pvFpuOwnerTCB = NULL;
+
+	/* Set by vPortSelectFpuContext() for xPortPendSVHandler(): where to save
+	the s16-s31 left in the FPU and where to load the incoming task's from.
+	Either is NULL when there is nothing to do. */
+	StackType_t * volatile pxPortFpuSlots[ 2 ] = { NULL, NULL };
+#endif
+
 /*
  * The number of SysTick increments that make up one tick period.
  */
@@ -375,6 +430,12 @@ BaseType_t xPortStartScheduler( void )
 	/* Lazy save always. */
 	*( portFPCCR ) |= portASPEN_AND_LSPEN_BITS;
 
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	{
+		prvSetupStackGuard();
+	}
+	#endif
+
 	/* Start the first task. */
 	prvPortStartFirstTask();
 
@@ -413,6 +474,12 @@ void vPortEnterCritical( void )
 	if( uxCriticalNesting == 1 )
 	{
 		configASSERT( ( portNVIC_INT_CTRL_REG & portVECTACTIVE_MASK ) == 0 );
+
+		#if( configUSE_MASK_TIME == 1 )
+		{
+			vMaskTimeEnter( masktimeCRITICAL, __builtin_return_address( 0 ) );
+		}
+		#endif
 	}
 }
 /*-----------------------------------------------------------*/
@@ -423,6 +490,12 @@ void vPortExitCritical( void )
 	uxCriticalNesting--;
 	if( uxCriticalNesting == 0 )
 	{
+		#if( configUSE_MASK_TIME == 1 )
+		{
+			vMaskTimeExit( masktimeCRITICAL );
+		}
+		#endif
+
 		portENABLE_INTERRUPTS();
 	}
 }
@@ -442,7 +515,11 @@ void xPortPendSVHandler( void )
 	"										\n"
 	"	tst r14, #0x10						\n" /* Is the task using the FPU context?  If so, push high vfp registers. */
 	"	it eq								\n"
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	"	subeq r0, r0, #64					\n" /* Only reserve the slot, vPortSelectFpuContext() decides when it is written. */
+	#else
 	"	vstmdbeq r0!, {s16-s31}				\n"
+	#endif
 	"										\n"
 	"	stmdb r0!, {r4-r11, r14}			\n" /* Save the core registers. */
 	"	str r0, [r2]						\n" /* Save the new top of stack into the first member of the TCB. */
@@ -457,14 +534,36 @@ void xPortPendSVHandler( void )
 	"	msr basepri, r0						\n"
 	"	ldmia sp!, {r0, r3}					\n"
 	"										\n"
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	"	ldr r2, pxPortFpuSlotsConst			\n"
+	"	ldr r1, [r2]						\n" /* Save the high vfp registers left by the last floating point task? */
+	"	cmp r1, #0							\n"
+	"	it ne								\n"
+	"	vstmiane r1, {s16-s31}				\n"
+	"	ldr r1, [r2, #4]					\n" /* Load the high vfp registers of the new task? */
+	"	cmp r1, #0							\n"
+	"	it ne								\n"
+	"	vldmiane r1, {s16-s31}				\n"
+	"										\n"
+	#endif
 	"	ldr r1, [r3]						\n" /* The first item in pxCurrentTCB is the task top of stack. */
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	"	ldr r2, [r1, #4]					\n" /* Move the stack guard to the new task, the region base address is the second item in pxCurrentTCB. */
+	"	ldr r0, portMPU_RBARConst			\n"
+	"	str r2, [r0]						\n"
+	"	dsb									\n"
+	#endif
 	"	ldr r0, [r1]						\n"
 	"										\n"
 	"	ldmia r0!, {r4-r11, r14}			\n" /* Pop the core registers. */
 	"										\n"
 	"	tst r14, #0x10						\n" /* Is the task using the FPU context?  If so, pop the high vfp registers too. */
 	"	it eq								\n"
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	"	addeq r0, r0, #64					\n" /* Already loaded above, or still held in the FPU. */
+	#else
 	"	vldmiaeq r0!, {s16-s31}				\n"
+	#endif
 	"										\n"
 	"	msr psp, r0							\n"
 	"	isb									\n"
@@ -480,11 +579,165 @@ void xPortPendSVHandler( void )
 	"										\n"
 	"	.align 4							\n"
 	"pxCurrentTCBConst: .word pxCurrentTCB	\n"
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	"pxPortFpuSlotsConst: .word pxPortFpuSlots	\n"
+	#endif
+	#if( configUSE_MPU_STACK_GUARD == 1 )
+	"portMPU_RBARConst: .word 0xe000ed9c		\n"
+	#endif
 	::"i"(configMAX_SYSCALL_INTERRUPT_PRIORITY)
 	);
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	static void prvSetupStackGuard( void )
+	{
+	uint32_t ulSizeBits = 0UL, ulSize;
+
+		/* The guard uses one region of the ARMv7-M MPU. */
+		configASSERT( portMPU_TYPE_REG == portEXPECTED_MPU_TYPE_VALUE );
+
+		/* The SIZE field of the attribute register holds log2( size ) - 1. */
+		for( ulSize = ( uint32_t ) configMPU_STACK_GUARD_SIZE; ulSize > 2UL; ulSize >>= 1UL )
+		{
+			ulSizeBits++;
+		}
+
+		/* Select the region and place it below the first task's stack, then
+		make it no access and never executable.  Every other access by the
+		privileged kernel and tasks goes through the default memory map. */
+		portMPU_REGION_BASE_ADDRESS_REG = ( ( uint32_t * ) pxCurrentTCB )[ 1 ];
+		portMPU_REGION_ATTRIBUTE_REG = portMPU_REGION_EXECUTE_NEVER | ( ulSizeBits << 1UL ) | portMPU_REGION_ENABLE;
+
+		/* Take guard hits as MemManage faults rather than hard faults. */
+		portNVIC_SYS_CTRL_STATE_REG |= portNVIC_MEM_FAULT_ENABLE;
+		portMPU_CTRL_REG |= ( portMPU_BACKGROUND_ENABLE | portMPU_ENABLE );
+
+		__asm volatile( "dsb" ::: "memory" );
+		__asm volatile( "isb" );
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MPU_STACK_GUARD == 1 )
+
+	BaseType_t xPortStackGuardFault( void )
+	{
+	uint32_t ulStatus = ( uint32_t ) portSCB_MMFSR_REG;
+	uint32_t ulGuard = ( ( uint32_t * ) pxCurrentTCB )[ 1 ] & portMPU_REGION_ADDRESS_MASK;
+	BaseType_t xOverflow = pdFALSE;
+
+		if( ( ulStatus & portMMFSR_MSTKERR ) != 0UL )
+		{
+			/* Exception entry could not stack the context of the running task,
+			the guard is the only region that can refuse it. */
+			xOverflow = pdTRUE;
+		}
+		else if( ( ulStatus & ( portMMFSR_DACCVIOL | portMMFSR_MMARVALID ) ) == ( portMMFSR_DACCVIOL | portMMFSR_MMARVALID ) )
+		{
+			/* A load or store by the task, or by xPortPendSVHandler() saving
+			its context, hit the guard. */
+			if( ( portSCB_MMFAR_REG - ulGuard ) < ( uint32_t ) configMPU_STACK_GUARD_SIZE )
+			{
+				xOverflow = pdTRUE;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xOverflow;
+	}
+/*-----------------------------------------------------------*/
+
+	void xPortMemManageHandler( void )
+	{
+		if( xPortStackGuardFault() != pdFALSE )
+		{
+			vApplicationStackOverflowHook( pxCurrentTCB, pcTaskGetName( pxCurrentTCB ) );
+		}
+
+		/* Nothing can be recovered from a memory management fault. */
+		portDISABLE_INTERRUPTS();
+		for( ;; );
+	}
+
+#endif /* configUSE_MPU_STACK_GUARD */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+
+	void vPortSelectFpuContext( void *pvOutgoingTCB, BaseType_t xOutgoingNoFpu, void *pvIncomingTCB, BaseType_t xIncomingNoFpu )
+	{
+	/* The first member of a TCB is the top of stack saved by
+	xPortPendSVHandler(). */
+	StackType_t * const pxOutgoingStack = *( ( StackType_t ** ) pvOutgoingTCB );
+	StackType_t * const pxIncomingStack = *( ( StackType_t ** ) pvIncomingTCB );
+
+		pxPortFpuSlots[ 0 ] = NULL;
+		pxPortFpuSlots[ 1 ] = NULL;
+
+		if( portCONTEXT_USES_FPU( pxOutgoingStack ) )
+		{
+			/* A task created with portNO_FPU_BIT used the FPU, so it may have
+			corrupted the registers of the task that owns them. */
+			configASSERT( xOutgoingNoFpu == pdFALSE );
+
+			/* The registers stay in the FPU until a task that can use it is
+			switched in. */
+			pvFpuOwnerTCB = pvOutgoingTCB;
+		}
+
+		if( xIncomingNoFpu == pdFALSE )
+		{
+			if( pvFpuOwnerTCB != pvIncomingTCB )
+			{
+				if( pvFpuOwnerTCB != NULL )
+				{
+					pxPortFpuSlots[ 0 ] = *( ( StackType_t ** ) pvFpuOwnerTCB ) + portFPU_SLOT_OFFSET;
+				}
+
+				if( portCONTEXT_USES_FPU( pxIncomingStack ) )
+				{
+					pxPortFpuSlots[ 1 ] = pxIncomingStack + portFPU_SLOT_OFFSET;
+				}
+			}
+
+			/* Either the incoming task owned the registers, so only integer
+			only tasks ran since it was switched out and they are still
+			valid, or they have been handed over above. */
+			pvFpuOwnerTCB = NULL;
+		}
+	}
+
+#endif /* configUSE_TASK_FPU_OPT_OUT */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+
+	void vPortReleaseFpuContext( void *pvTCB )
+	{
+		portENTER_CRITICAL();
+		{
+			if( pvFpuOwnerTCB == pvTCB )
+			{
+				/* The registers are never going to be saved, and the lazily
+				stacked s0-s15 still pending from the context switch must not
+				be written to the stack of a deleted task. */
+				pvFpuOwnerTCB = NULL;
+				*( portFPCCR ) &= ~portLSPACT_BIT;
+			}
+		}
+		portEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_FPU_OPT_OUT */
+/*-----------------------------------------------------------*/
+
 void xPortSysTickHandler( void )
 {
 	/* The SysTick runs at the lowest interrupt priority, so when this interrupt
@@ -2778,6 +2778,21 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueSetHandle_t xQueueCreateSetStatic( const UBaseType_t uxEventQueueLength, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue )
+	{
+	QueueSetHandle_t pxQueue;
+
+		configASSERT( pucQueueStorage );
+		pxQueue = xQueueGenericCreateStatic( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_SET );
+
+		return pxQueue;
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 	BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet )
@@ -2847,6 +2862,70 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_SETS == 1 )
+
+	void vQueueSetWithdraw( QueueSetHandle_t xQueueSet, QueueSetMemberHandle_t xMember )
+	{
+	Queue_t * const pxQueueSet = ( Queue_t * ) xQueueSet;
+	QueueSetMemberHandle_t xEntry;
+	int8_t *pcReadFrom, *pcKeptTo;
+	UBaseType_t uxEntry, uxKept = ( UBaseType_t ) 0;
+
+		configASSERT( pxQueueSet );
+		configASSERT( pxQueueSet->uxItemSize == ( UBaseType_t ) sizeof( QueueSetMemberHandle_t ) );
+
+		taskENTER_CRITICAL();
+		{
+			/* Walk the entries from the oldest and copy the ones that are kept
+			back over the ring, so they stay in order and contiguous.  The
+			read pointer is left where it is, pcKeptTo ends on the last entry
+			kept, or on the read pointer if none is. */
+			pcReadFrom = pxQueueSet->u.xQueue.pcReadFrom;
+			pcKeptTo = pcReadFrom;
+
+			for( uxEntry = ( UBaseType_t ) 0; uxEntry < pxQueueSet->uxMessagesWaiting; uxEntry++ )
+			{
+				pcReadFrom += pxQueueSet->uxItemSize;
+				if( pcReadFrom >= pxQueueSet->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+				{
+					pcReadFrom = pxQueueSet->pcHead;
+				}
+
+				( void ) memcpy( ( void * ) &xEntry, ( void * ) pcReadFrom, ( size_t ) pxQueueSet->uxItemSize );
+
+				if( xEntry != xMember )
+				{
+					pcKeptTo += pxQueueSet->uxItemSize;
+					if( pcKeptTo >= pxQueueSet->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+					{
+						pcKeptTo = pxQueueSet->pcHead;
+					}
+
+					( void ) memcpy( ( void * ) pcKeptTo, ( void * ) &xEntry, ( size_t ) pxQueueSet->uxItemSize );
+					uxKept++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			/* The next free slot follows the last entry kept. */
+			pcKeptTo += pxQueueSet->uxItemSize;
+			if( pcKeptTo >= pxQueueSet->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+			{
+				pcKeptTo = pxQueueSet->pcHead;
+			}
+
+			pxQueueSet->pcWriteTo = pcKeptTo;
+			pxQueueSet->uxMessagesWaiting = uxKept;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 	QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet, TickType_t const xTicksToWait )
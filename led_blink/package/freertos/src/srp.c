@@ -0,0 +1,448 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Run-to-completion jobs under the Stack Resource Policy, see srp.h.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "srp.h"
+
+#if( configUSE_SRP_JOBS == 1 )
+
+/* vSrpResourceLock() raises the job to the priority of the ceiling level's
+executor, which must not get a time slice while the resource is held. */
+#if( configUSE_TIME_SLICING != 0 )
+	#error configUSE_TIME_SLICING must be 0 when configUSE_SRP_JOBS is 1
+#endif
+
+/* Stack reserved below each executor's stack for the MPU guard, which takes
+up to two guard sizes depending on alignment, and the granularity the pool is
+carved in. */
+#if( configUSE_MPU_STACK_GUARD == 1 )
+	#define srpGUARD_DEPTH			( ( 2UL * ( uint32_t ) configMPU_STACK_GUARD_SIZE ) / ( uint32_t ) sizeof( StackType_t ) )
+	#define srpSTACK_ALIGNMENT		( ( uint32_t ) configMPU_STACK_GUARD_SIZE / ( uint32_t ) sizeof( StackType_t ) )
+#else
+	#define srpGUARD_DEPTH			( 0UL )
+	#define srpSTACK_ALIGNMENT		( 8UL / ( uint32_t ) sizeof( StackType_t ) )
+#endif
+
+typedef struct xSRP_LEVEL
+{
+	SrpJob_t *pxJobs;					/* Every job of the level. */
+	SrpJob_t *pxPendingHead;			/* Jobs with activations, in order. */
+	SrpJob_t *pxPendingTail;
+	TaskHandle_t xExecutor;
+	uint32_t ulStackDepth;
+} SrpLevel_t;
+
+PRIVILEGED_DATA static SrpLevel_t xSrpLevels[ configSRP_LEVELS ];
+PRIVILEGED_DATA static StackType_t xSrpStackPool[ configSRP_STACK_POOL_DEPTH ];
+PRIVILEGED_DATA static StaticTask_t xSrpExecutorTCBs[ configSRP_LEVELS ];
+
+/*
+ * The executor of one level, pvParameters is the level.
+ */
+static portTASK_FUNCTION_PROTO( prvSrpExecutor, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make pxJob pending once more, returns pdTRUE if the executor has to be
+ * notified.  Must be called with interrupts masked.
+ */
+static BaseType_t prvSrpActivate( SrpJob_t *pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stack needed by uxLevel, 0 if it has no jobs.
+ */
+static uint32_t prvSrpLevelNeed( UBaseType_t uxLevel ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xSrpJobCreate( SrpJob_t *pxJob, SrpJobFunction_t pxFunction, void *pvParameter, UBaseType_t uxLevel, configSTACK_DEPTH_TYPE usStackDepth )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxJob );
+	configASSERT( pxFunction );
+	configASSERT( uxLevel < ( UBaseType_t ) configSRP_LEVELS );
+
+	/* The stacks are carved when the scheduler starts. */
+	if( ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED ) && ( uxLevel < ( UBaseType_t ) configSRP_LEVELS ) )
+	{
+		pxJob->pxNextPending = NULL;
+		pxJob->pxFunction = pxFunction;
+		pxJob->pvParameter = pvParameter;
+		pxJob->uxLevel = uxLevel;
+		pxJob->usStackDepth = usStackDepth;
+		pxJob->uxActivations = ( UBaseType_t ) 0U;
+		pxJob->ulRuns = 0UL;
+
+		pxJob->pxNextOnLevel = xSrpLevels[ uxLevel ].pxJobs;
+		xSrpLevels[ uxLevel ].pxJobs = pxJob;
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSrpLevelNeed( UBaseType_t uxLevel )
+{
+const SrpJob_t *pxJob;
+uint32_t ulDeepest = 0UL, ulNeed = 0UL;
+
+	pxJob = xSrpLevels[ uxLevel ].pxJobs;
+
+	if( pxJob != NULL )
+	{
+		while( pxJob != NULL )
+		{
+			if( ( uint32_t ) pxJob->usStackDepth > ulDeepest )
+			{
+				ulDeepest = ( uint32_t ) pxJob->usStackDepth;
+			}
+
+			pxJob = pxJob->pxNextOnLevel;
+		}
+
+		ulNeed = ( uint32_t ) configSRP_EXECUTOR_STACK_DEPTH + ulDeepest + srpGUARD_DEPTH;
+		ulNeed = ( ulNeed + ( srpSTACK_ALIGNMENT - 1UL ) ) & ~( srpSTACK_ALIGNMENT - 1UL );
+	}
+
+	return ulNeed;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSrpLevelStackDepth( UBaseType_t uxLevel )
+{
+	configASSERT( uxLevel < ( UBaseType_t ) configSRP_LEVELS );
+
+	return prvSrpLevelNeed( uxLevel );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSrpWorstCaseStack( void )
+{
+UBaseType_t uxLevel;
+uint32_t ulTotal = 0UL;
+
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configSRP_LEVELS; uxLevel++ )
+	{
+		ulTotal += prvSrpLevelNeed( uxLevel );
+	}
+
+	return ulTotal;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSrpCreateTasks( void )
+{
+UBaseType_t uxLevel;
+uint32_t ulUsed = 0UL, ulNeed;
+StackType_t *pxStack;
+char cName[ 5 ] = { 'S', 'R', 'P', '0', '\0' };
+BaseType_t xReturn = pdPASS;
+
+	/* The pool is carved from an aligned offset so every stack keeps the
+	alignment of its size. */
+	pxStack = &( xSrpStackPool[ 0 ] );
+	while( ( ( ( uint32_t ) pxStack ) & ( ( srpSTACK_ALIGNMENT * ( uint32_t ) sizeof( StackType_t ) ) - 1UL ) ) != 0UL )
+	{
+		pxStack++;
+		ulUsed++;
+	}
+
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configSRP_LEVELS; uxLevel++ )
+	{
+		ulNeed = prvSrpLevelNeed( uxLevel );
+
+		if( ulNeed == 0UL )
+		{
+			/* No jobs, no executor. */
+			continue;
+		}
+
+		/* The pool must hold the worst case stack, see srp.h. */
+		configASSERT( ( ulUsed + ulNeed ) <= ( uint32_t ) configSRP_STACK_POOL_DEPTH );
+
+		if( ( ulUsed + ulNeed ) > ( uint32_t ) configSRP_STACK_POOL_DEPTH )
+		{
+			xReturn = pdFAIL;
+			break;
+		}
+
+		cName[ 3 ] = ( char ) ( '0' + ( char ) uxLevel );
+		xSrpLevels[ uxLevel ].ulStackDepth = ulNeed;
+		xSrpLevels[ uxLevel ].xExecutor = xTaskCreateStatic( prvSrpExecutor,
+															  cName,
+															  ulNeed,
+															  ( void * ) uxLevel,
+															  ( ( UBaseType_t ) configSRP_BASE_PRIORITY + uxLevel ) | portPRIVILEGE_BIT,
+															  pxStack,
+															  &( xSrpExecutorTCBs[ uxLevel ] ) );
+
+		if( xSrpLevels[ uxLevel ].xExecutor == NULL )
+		{
+			xReturn = pdFAIL;
+			break;
+		}
+
+		pxStack += ulNeed;
+		ulUsed += ulNeed;
+	}
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSrpActivate( SrpJob_t *pxJob )
+{
+SrpLevel_t * const pxLevel = &( xSrpLevels[ pxJob->uxLevel ] );
+BaseType_t xNotify = pdFALSE;
+
+	/* A job already pending or running only counts the activation, the
+	executor queues it again when the run in progress completes. */
+	if( pxJob->uxActivations == ( UBaseType_t ) 0U )
+	{
+		pxJob->pxNextPending = NULL;
+
+		if( pxLevel->pxPendingHead == NULL )
+		{
+			pxLevel->pxPendingHead = pxJob;
+		}
+		else
+		{
+			pxLevel->pxPendingTail->pxNextPending = pxJob;
+		}
+
+		pxLevel->pxPendingTail = pxJob;
+		xNotify = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( pxJob->uxActivations )++;
+
+	return xNotify;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSrpJobActivate( SrpJob_t *pxJob )
+{
+BaseType_t xReturn = pdFAIL, xNotify;
+
+	configASSERT( pxJob );
+
+	if( xSrpLevels[ pxJob->uxLevel ].xExecutor != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			xNotify = prvSrpActivate( pxJob );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xNotify != pdFALSE )
+		{
+			( void ) xTaskNotifyGive( xSrpLevels[ pxJob->uxLevel ].xExecutor );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSrpJobActivateFromISR( SrpJob_t *pxJob, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn = pdFAIL, xNotify;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxJob );
+
+	if( xSrpLevels[ pxJob->uxLevel ].xExecutor != NULL )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xNotify = prvSrpActivate( pxJob );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xNotify != pdFALSE )
+		{
+			vTaskNotifyGiveFromISR( xSrpLevels[ pxJob->uxLevel ].xExecutor, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulSrpJobGetRuns( const SrpJob_t *pxJob )
+{
+	configASSERT( pxJob );
+
+	return pxJob->ulRuns;
+}
+/*-----------------------------------------------------------*/
+
+void vSrpResourceInit( SrpResource_t *pxResource, UBaseType_t uxCeiling )
+{
+	configASSERT( pxResource );
+	configASSERT( uxCeiling < ( UBaseType_t ) configSRP_LEVELS );
+
+	pxResource->uxCeiling = uxCeiling;
+	pxResource->uxSavedPriority = ( UBaseType_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vSrpResourceLock( SrpResource_t *pxResource )
+{
+const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+const UBaseType_t uxCeilingPriority = ( UBaseType_t ) configSRP_BASE_PRIORITY + pxResource->uxCeiling;
+
+	/* Only jobs lock resources, and this one is not locked already as the job
+	holding it would have kept the caller from starting.  The caller may run
+	above the ceiling while it holds another resource. */
+	configASSERT( uxPriority >= ( UBaseType_t ) configSRP_BASE_PRIORITY );
+	configASSERT( pxResource->uxSavedPriority == ( UBaseType_t ) 0U );
+
+	pxResource->uxSavedPriority = uxPriority;
+
+	if( uxCeilingPriority > uxPriority )
+	{
+		vTaskPrioritySet( NULL, uxCeilingPriority );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vSrpResourceUnlock( SrpResource_t *pxResource )
+{
+const UBaseType_t uxSavedPriority = pxResource->uxSavedPriority;
+
+	configASSERT( uxSavedPriority != ( UBaseType_t ) 0U );
+
+	pxResource->uxSavedPriority = ( UBaseType_t ) 0U;
+
+	/* Dropping back lets the jobs activated meanwhile preempt. */
+	if( uxTaskPriorityGet( NULL ) != uxSavedPriority )
+	{
+		vTaskPrioritySet( NULL, uxSavedPriority );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvSrpExecutor, pvParameters )
+{
+SrpLevel_t * const pxLevel = &( xSrpLevels[ ( UBaseType_t ) pvParameters ] );
+SrpJob_t *pxJob;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxJob = pxLevel->pxPendingHead;
+
+				if( pxJob != NULL )
+				{
+					pxLevel->pxPendingHead = pxJob->pxNextPending;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxJob == NULL )
+			{
+				break;
+			}
+
+			pxJob->pxFunction( pxJob->pvParameter );
+
+			taskENTER_CRITICAL();
+			{
+				( pxJob->ulRuns )++;
+				( pxJob->uxActivations )--;
+
+				/* Activated again while running, queue it behind the jobs
+				that are already pending. */
+				if( pxJob->uxActivations != ( UBaseType_t ) 0U )
+				{
+					pxJob->pxNextPending = NULL;
+
+					if( pxLevel->pxPendingHead == NULL )
+					{
+						pxLevel->pxPendingHead = pxJob;
+					}
+					else
+					{
+						pxLevel->pxPendingTail->pxNextPending = pxJob;
+					}
+
+					pxLevel->pxPendingTail = pxJob;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+}
+
+#endif /* configUSE_SRP_JOBS */
@@ -38,6 +38,10 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "workqueue.h"
+#include "wakelatency.h"
+#include "masktime.h"
+#include "srp.h"
 #include "stack_macros.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
@@ -193,6 +197,22 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* The timing wheel is indexed by the absolute wake time, so nothing moves
+	when the tick count overflows - only the overflow count used by the time out
+	functions has to be maintained. */
+	#define taskSWITCH_DELAYED_LISTS()	xNumOfOverflows++
+
+	/* The wheel slot holding the tasks that wake at tick xTime.  The wheel size
+	is a power of two so the slot of a wake time survives tick overflow. */
+	#define taskDELAYED_WHEEL_SLOT( xTime )	( &( xDelayedTaskWheel[ ( xTime ) & ( ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE - ( TickType_t ) 1 ) ] ) )
+
+	/* pdTRUE if pxList is one of the wheel slots. */
+	#define taskIS_DELAYED_LIST( pxList )	( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) <= &( xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SIZE - 1 ] ) ) )
+
+#else
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
@@ -209,6 +229,8 @@ count overflows. */
 	prvResetNextTaskUnblockTime();																	\
 }
 
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -222,6 +244,32 @@ count overflows. */
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
+/*
+ * Stamp a blocked task that is made ready, the wake latency is recorded when
+ * it next runs.  Outside interrupts only a function pended from an interrupt
+ * stamps, with the stamp the relay task running it carries, see
+ * vTaskSetWakeLatencyCarry().  Relay tasks are never stamped themselves, and a
+ * task made ready again before it ran keeps its first stamp.
+ */
+#if( configUSE_WAKE_LATENCY == 1 )
+	#define prvWakeLatencyStamp( pxTCB )																\
+		if( ( ( pxTCB )->uxWakeSource == ( UBaseType_t ) 0U ) && ( ( pxTCB )->ucWakeRelay == ( uint8_t ) pdFALSE ) ) \
+		{																							\
+			if( xPortIsInsideInterrupt() != pdFALSE )												\
+			{																						\
+				( pxTCB )->uxWakeSource = uxWakeLatencyStampFromISR( &( ( pxTCB )->ulWakeStamp ) );	\
+			}																						\
+			else																					\
+			{																						\
+				( pxTCB )->uxWakeSource = pxCurrentTCB->uxWakeCarrySource;							\
+				( pxTCB )->ulWakeStamp = pxCurrentTCB->ulWakeCarryStamp;							\
+			}																						\
+		}
+#else
+	#define prvWakeLatencyStamp( pxTCB )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Several functions take an TaskHandle_t parameter that can optionally be NULL,
  * where NULL is used to indicate that the handle of the currently executing
@@ -257,6 +305,10 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		xMPU_SETTINGS	xMPUSettings;		/*< The MPU settings are defined as part of the port layer.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
 	#endif
 
+	#if ( configUSE_MPU_STACK_GUARD == 1 )
+		uint32_t		ulStackGuard;		/*< Stack guard MPU region written by the port on every context switch.  THIS MUST BE THE SECOND MEMBER OF THE TCB STRUCT. */
+	#endif
+
 	ListItem_t			xStateListItem;	/*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
 	ListItem_t			xEventListItem;		/*< Used to reference a task from an event list. */
 	UBaseType_t			uxPriority;			/*< The priority of the task.  0 is the lowest priority. */
@@ -289,7 +341,9 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		void			*pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 
-	#if( configGENERATE_RUN_TIME_STATS == 1 )
+	/* With configUSE_TASK_CPU_STATS the run time counter is the low word of
+	ullCpuCycles, so only one counter is charged on a context switch. */
+	#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TASK_CPU_STATS == 0 ) )
 		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
@@ -323,6 +377,31 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+		UBaseType_t		uxHeapSlot;			/*< Index of the heap accounting slot that blocks allocated by this task are charged to. */
+	#endif
+
+	#if( configUSE_TASK_CPU_STATS == 1 )
+		uint64_t		ullCpuCycles;		/*< Cycles spent in the Running state, never wraps in practice. */
+		uint64_t		ullCpuWindowStart;	/*< ullCpuCycles when the statistics window uxCpuWindow began. */
+		uint32_t		ulCpuLastWindow;	/*< Cycles used in the window before uxCpuWindow. */
+		uint32_t		ulVoluntarySwitches;
+		uint32_t		ulInvoluntarySwitches;
+		UBaseType_t		uxCpuWindow;		/*< Statistics window the task was last charged in. */
+	#endif
+
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+		BaseType_t		xNoFpu;				/*< pdTRUE if the task was created with portNO_FPU_BIT set and must not use the FPU. */
+	#endif
+
+	#if( configUSE_WAKE_LATENCY == 1 )
+		uint32_t		ulWakeStamp;		/*< Run time counter value when an interrupt made the task ready. */
+		UBaseType_t		uxWakeSource;		/*< Wake latency source of that interrupt + 1, 0 if no stamp is pending. */
+		uint32_t		ulWakeCarryStamp;	/*< Stamp of the interrupt that pended the function a relay task is running. */
+		UBaseType_t		uxWakeCarrySource;	/*< Its source + 1, 0 when the task is not running a pended function. */
+		uint8_t			ucWakeRelay;		/*< pdTRUE for the timer daemon and the work queue task. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -338,10 +417,14 @@ xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SIZE ];	/*< Delayed tasks, unsorted, in the slot selected by their wake time. */
+#else
 PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -385,7 +468,7 @@ when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TASK_CPU_STATS == 0 ) )
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
@@ -394,6 +477,16 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if ( configUSE_TASK_CPU_STATS == 1 )
+
+	PRIVILEGED_DATA static uint32_t ulCpuStatsStamp = 0UL;			/*< Counter value when the running task was last charged. */
+	PRIVILEGED_DATA static uint32_t ulCpuStatsWindowStamp = 0UL;	/*< Counter value when the current window began. */
+	PRIVILEGED_DATA static uint32_t ulCpuStatsWindowCycles = 0UL;	/*< Length of the last complete window, 0 until one completed. */
+	PRIVILEGED_DATA static UBaseType_t uxCpuStatsWindow = 0U;		/*< Index of the current window. */
+	PRIVILEGED_DATA static TCB_t * pxCpuStatsPreviousTCB = NULL;	/*< Task that was running when vTaskSwitchContext() was entered. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -475,6 +568,33 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TASK_CPU_STATS == 1 )
+
+	/*
+	 * Charge the cycles elapsed since the last charge to the running task.
+	 * Called on every tick and every context switch, from the kernel only.
+	 */
+	static void prvCpuStatsCharge( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Cycles pxTCB used in the last complete window.  Tasks are only brought up
+	 * to date when they run, so a task last charged in an older window did not
+	 * run in the last one.
+	 */
+	static uint32_t prvCpuStatsLastWindow( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/*
+	 * Used by prvAddCurrentTaskToDelayedList() to place the running task in the
+	 * timing wheel slot of its wake time.  O(1), the slot is not sorted.
+	 */
+	static void prvAddCurrentTaskToDelayedWheel( TickType_t xTimeToWake, const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -844,6 +964,22 @@ UBaseType_t x;
 		uxPriority &= ~portPRIVILEGE_BIT;
 	#endif /* portUSING_MPU_WRAPPERS == 1 */
 
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	{
+		/* Integer only tasks are flagged by a bit in the priority, in the same
+		way as privileged tasks. */
+		if( ( uxPriority & portNO_FPU_BIT ) != 0U )
+		{
+			pxNewTCB->xNoFpu = pdTRUE;
+		}
+		else
+		{
+			pxNewTCB->xNoFpu = pdFALSE;
+		}
+		uxPriority &= ~portNO_FPU_BIT;
+	}
+	#endif /* configUSE_TASK_FPU_OPT_OUT */
+
 	/* Avoid dependency on memset() if it is not required. */
 	#if( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
 	{
@@ -871,6 +1007,15 @@ UBaseType_t x;
 			pxNewTCB->pxEndOfStack = pxTopOfStack;
 		}
 		#endif /* configRECORD_STACK_HIGH_ADDRESS */
+
+		#if( configUSE_MPU_STACK_GUARD == 1 )
+		{
+			/* The guard takes up to two guard sizes from the bottom of the
+			stack, leave some room for the task above it. */
+			pxNewTCB->ulStackGuard = portSTACK_GUARD_REGION( pxNewTCB->pxStack );
+			configASSERT( ( portSTACK_GUARD_BASE( pxNewTCB->pxStack ) + ( uint32_t ) configMPU_STACK_GUARD_SIZE ) < ( uint32_t ) pxTopOfStack );
+		}
+		#endif /* configUSE_MPU_STACK_GUARD */
 	}
 	#else /* portSTACK_GROWTH */
 	{
@@ -958,12 +1103,33 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_APPLICATION_TASK_TAG */
 
-	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TASK_CPU_STATS == 0 ) )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_TASK_CPU_STATS == 1 )
+	{
+		pxNewTCB->ullCpuCycles = 0ULL;
+		pxNewTCB->ullCpuWindowStart = 0ULL;
+		pxNewTCB->ulCpuLastWindow = 0UL;
+		pxNewTCB->ulVoluntarySwitches = 0UL;
+		pxNewTCB->ulInvoluntarySwitches = 0UL;
+		pxNewTCB->uxCpuWindow = uxCpuStatsWindow;
+	}
+	#endif /* configUSE_TASK_CPU_STATS */
+
+	#if ( configUSE_WAKE_LATENCY == 1 )
+	{
+		pxNewTCB->ulWakeStamp = 0UL;
+		pxNewTCB->uxWakeSource = ( UBaseType_t ) 0U;
+		pxNewTCB->ulWakeCarryStamp = 0UL;
+		pxNewTCB->uxWakeCarrySource = ( UBaseType_t ) 0U;
+		pxNewTCB->ucWakeRelay = ( uint8_t ) pdFALSE;
+	}
+	#endif /* configUSE_WAKE_LATENCY */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1004,6 +1170,14 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_HEAP_ACCOUNTING == 1 )
+	{
+		/* Blocks allocated while this task is running are charged to its own
+		slot.  The TCB and stack themselves were charged to the creator. */
+		pxNewTCB->uxHeapSlot = uxPortHeapSlotAcquire( pxNewTCB->pcTaskName );
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1378,7 +1552,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+		List_t const *pxDelayedList, *pxOverflowedDelayedList;
+	#endif
 	const TCB_t * const pxTCB = xTask;
 
 		configASSERT( pxTCB );
@@ -1393,12 +1570,20 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					pxDelayedList = pxDelayedTaskList;
+					pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				}
+				#endif
 			}
 			taskEXIT_CRITICAL();
 
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+			if( taskIS_DELAYED_LIST( pxStateList ) )
+			#else
 			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1925,6 +2110,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
 				traceTASK_RESUME_FROM_ISR( pxTCB );
+				prvWakeLatencyStamp( pxTCB );
 
 				/* Check the ready lists can be accessed. */
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
@@ -2020,6 +2206,32 @@ BaseType_t xReturn;
 	}
 	#endif /* configUSE_TIMERS */
 
+	#if ( configUSE_WORK_QUEUE == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xWorkQueueCreateTask();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_WORK_QUEUE */
+
+	#if ( configUSE_SRP_JOBS == 1 )
+	{
+		if( xReturn == pdPASS )
+		{
+			xReturn = xSrpCreateTasks();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_SRP_JOBS */
+
 	if( xReturn == pdPASS )
 	{
 		/* freertos_tasks_c_additions_init() should only be called if the user
@@ -2058,6 +2270,13 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			ulCpuStatsStamp = portGET_RUN_TIME_COUNTER_VALUE();
+			ulCpuStatsWindowStamp = ulCpuStatsStamp;
+		}
+		#endif
+
 		traceTASK_SWITCHED_IN();
 
 		/* Setting up the timer tick is hardware specific and thus in the
@@ -2104,6 +2323,16 @@ void vTaskSuspendAll( void )
 	post in the FreeRTOS support forum before reporting this as a bug! -
 	http://goo.gl/wu4acr */
 	++uxSchedulerSuspended;
+
+	#if( configUSE_MASK_TIME == 1 )
+	{
+		/* Timed once suspended, no other task can open a section meanwhile. */
+		if( ( uxSchedulerSuspended == ( UBaseType_t ) 1U ) && ( xSchedulerRunning != pdFALSE ) )
+		{
+			vMaskTimeEnter( masktimeSCHEDULER, __builtin_return_address( 0 ) );
+		}
+	}
+	#endif
 }
 /*----------------------------------------------------------*/
 
@@ -2190,6 +2419,12 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
+			#if( configUSE_MASK_TIME == 1 )
+			{
+				vMaskTimeExit( masktimeSCHEDULER );
+			}
+			#endif
+
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 			{
 				/* Move any readied tasks from the pending list into the
@@ -2441,15 +2676,26 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				for( uxQueue = 0U; ( pxTCB == NULL ) && ( uxQueue < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxQueue ] ), pcNameToQuery );
+				}
 			}
-
-			if( pxTCB == NULL )
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2501,8 +2747,19 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+				{
+					for( uxQueue = 0U; uxQueue < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2681,6 +2938,25 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			/* Charging on every tick keeps the elapsed cycles far below the
+			counter wrap even if the same task runs for a long time. */
+			prvCpuStatsCharge();
+
+			if( ( xConstTickCount % ( TickType_t ) configCPU_STATS_WINDOW_TICKS ) == ( TickType_t ) 0 )
+			{
+				ulCpuStatsWindowCycles = ulCpuStatsStamp - ulCpuStatsWindowStamp;
+				ulCpuStatsWindowStamp = ulCpuStatsStamp;
+				uxCpuStatsWindow++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_CPU_STATS */
+
 		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 		{
 			taskSWITCH_DELAYED_LISTS();
@@ -2690,6 +2966,65 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+		List_t * const pxSlot = taskDELAYED_WHEEL_SLOT( xConstTickCount );
+		ListItem_t *pxItem, *pxNextItem;
+
+			/* Only the slot of the current tick can hold tasks that wake now.
+			Tasks in it that were delayed for more than a full turn of the
+			wheel are skipped until their own wake time comes round. */
+			pxItem = listGET_HEAD_ENTRY( pxSlot );
+			while( pxItem != ( ListItem_t * ) listGET_END_MARKER( pxSlot ) )
+			{
+				pxNextItem = listGET_NEXT( pxItem );
+
+				if( listGET_LIST_ITEM_VALUE( pxItem ) == xConstTickCount )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					/* It is time to remove the item from the Blocked state. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+					/* Is the task waiting on an event also?  If so remove
+					it from the event list. */
+					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* Place the unblocked task into the appropriate ready
+					list. */
+					prvAddTaskToReadyList( pxTCB );
+
+					#if (  configUSE_PREEMPTION == 1 )
+					{
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxItem = pxNextItem;
+			}
+
+			( void ) xItemValue;
+		}
+		#else /* configUSE_DELAYED_TASK_WHEEL */
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
 		has been found whose block time has not expired there is no need to
@@ -2771,6 +3106,7 @@ BaseType_t xSwitchRequired = pdFALSE;
 				}
 			}
 		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
@@ -2945,6 +3281,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	TCB_t * const pxOutgoingTCB = pxCurrentTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2956,7 +3296,7 @@ void vTaskSwitchContext( void )
 		xYieldPending = pdFALSE;
 		traceTASK_SWITCHED_OUT();
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TASK_CPU_STATS == 0 ) )
 		{
 			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
 				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
@@ -2983,6 +3323,13 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			prvCpuStatsCharge();
+			pxCpuStatsPreviousTCB = pxCurrentTCB;
+		}
+		#endif
+
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -2998,6 +3345,43 @@ void vTaskSwitchContext( void )
 		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		traceTASK_SWITCHED_IN();
 
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			/* A task that is still referenced from its ready list was
+			preempted or yielded, otherwise it blocked, suspended or deleted
+			itself. */
+			if( pxCpuStatsPreviousTCB != pxCurrentTCB )
+			{
+				if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCpuStatsPreviousTCB->uxPriority ] ), &( pxCpuStatsPreviousTCB->xStateListItem ) ) != pdFALSE )
+				{
+					( pxCpuStatsPreviousTCB->ulInvoluntarySwitches )++;
+				}
+				else
+				{
+					( pxCpuStatsPreviousTCB->ulVoluntarySwitches )++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_CPU_STATS */
+
+		#if( configUSE_WAKE_LATENCY == 1 )
+		{
+			if( pxCurrentTCB->uxWakeSource != ( UBaseType_t ) 0U )
+			{
+				vWakeLatencyRecord( pxCurrentTCB->uxWakeSource, pxCurrentTCB->ulWakeStamp );
+				pxCurrentTCB->uxWakeSource = ( UBaseType_t ) 0U;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_WAKE_LATENCY */
+
 		/* After the new task is switched in, update the global errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
@@ -3013,6 +3397,14 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
+
+	#if( configUSE_TASK_FPU_OPT_OUT == 1 )
+	{
+		/* Decide which FPU registers the port has to save and restore, this is
+		also done when the same task keeps running. */
+		portSELECT_FPU_CONTEXT( pxOutgoingTCB, pxOutgoingTCB->xNoFpu, pxCurrentTCB, pxCurrentTCB->xNoFpu );
+	}
+	#endif /* configUSE_TASK_FPU_OPT_OUT */
 }
 /*-----------------------------------------------------------*/
 
@@ -3111,6 +3503,7 @@ BaseType_t xReturn;
 	pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 	configASSERT( pxUnblockedTCB );
 	( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+	prvWakeLatencyStamp( pxUnblockedTCB );
 
 	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 	{
@@ -3174,6 +3567,7 @@ TCB_t *pxUnblockedTCB;
 	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 	configASSERT( pxUnblockedTCB );
 	( void ) uxListRemove( pxEventListItem );
+	prvWakeLatencyStamp( pxUnblockedTCB );
 
 	/* Remove the task from the delayed list and add it to the ready list.  The
 	scheduler is suspended so interrupts will not be accessing the ready
@@ -3551,8 +3945,19 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE; uxPriority++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxPriority ] ) );
+		}
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3567,10 +3972,14 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3628,7 +4037,11 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = ( uint32_t ) pxTCB->ullCpuCycles;
+		}
+		#elif ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
 			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
 		}
@@ -3829,6 +4242,14 @@ static void prvCheckTasksWaitingTermination( void )
 		want to allocate and clean RAM statically. */
 		portCLEAN_UP_TCB( pxTCB );
 
+		#if( configUSE_HEAP_ACCOUNTING == 1 )
+		{
+			/* The slot is kept as an orphan while blocks the task allocated are
+			still live, so leaks of deleted tasks remain visible. */
+			vPortHeapSlotRelease( pxTCB->uxHeapSlot );
+		}
+		#endif
+
 		/* Free up the memory allocated by the scheduler for the task.  It is up
 		to the task to free any memory allocated at the application level. */
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -3878,6 +4299,11 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvResetNextTaskUnblockTime( void )
 {
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	/* The wheel visits the slot of every tick, there is no next unblock time
+	to maintain. */
+	xNextTaskUnblockTime = portMAX_DELAY;
+#else
 TCB_t *pxTCB;
 
 	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
@@ -3897,6 +4323,7 @@ TCB_t *pxTCB;
 		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -4560,6 +4987,153 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_ACCOUNTING == 1 )
+
+	UBaseType_t uxTaskGetHeapSlot( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		/* Called from pvPortMalloc() with the scheduler suspended, so
+		pxCurrentTCB cannot change under us.  Allocations made before the
+		scheduler starts are charged to the shared slot 0. */
+		if( xTask == NULL )
+		{
+			pxTCB = ( xSchedulerRunning != pdFALSE ) ? pxCurrentTCB : NULL;
+		}
+		else
+		{
+			pxTCB = ( TCB_t * ) xTask;
+		}
+
+		return ( pxTCB != NULL ) ? pxTCB->uxHeapSlot : ( UBaseType_t ) 0U;
+	}
+
+#endif /* configUSE_HEAP_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAKE_LATENCY == 1 )
+
+	void vTaskSetWakeLatencyRelay( TaskHandle_t xTask )
+	{
+	TCB_t * const pxTCB = ( TCB_t * ) xTask;
+
+		configASSERT( pxTCB );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB->ucWakeRelay = ( uint8_t ) pdTRUE;
+			pxTCB->uxWakeSource = ( UBaseType_t ) 0U;
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskSetWakeLatencyCarry( UBaseType_t uxSource, uint32_t ulStamp )
+	{
+		/* Only the running task reads its carry, and only from task level, so
+		no critical section is needed. */
+		pxCurrentTCB->ulWakeCarryStamp = ulStamp;
+		pxCurrentTCB->uxWakeCarrySource = uxSource;
+	}
+
+#endif /* configUSE_WAKE_LATENCY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_CPU_STATS == 1 )
+
+	static void prvCpuStatsCharge( void )
+	{
+	const uint32_t ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+
+		/* Roll the task into the current window before charging it. */
+		if( pxCurrentTCB->uxCpuWindow != uxCpuStatsWindow )
+		{
+			pxCurrentTCB->ulCpuLastWindow = prvCpuStatsLastWindow( pxCurrentTCB );
+			pxCurrentTCB->ullCpuWindowStart = pxCurrentTCB->ullCpuCycles;
+			pxCurrentTCB->uxCpuWindow = uxCpuStatsWindow;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Unsigned subtraction handles the counter wrapping once. */
+		pxCurrentTCB->ullCpuCycles += ( uint64_t ) ( ulNow - ulCpuStatsStamp );
+		ulCpuStatsStamp = ulNow;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvCpuStatsLastWindow( const TCB_t * const pxTCB )
+	{
+	uint32_t ulReturn;
+
+		if( pxTCB->uxCpuWindow == uxCpuStatsWindow )
+		{
+			ulReturn = pxTCB->ulCpuLastWindow;
+		}
+		else if( ( pxTCB->uxCpuWindow + ( UBaseType_t ) 1U ) == uxCpuStatsWindow )
+		{
+			ulReturn = ( uint32_t ) ( pxTCB->ullCpuCycles - pxTCB->ullCpuWindowStart );
+		}
+		else
+		{
+			ulReturn = 0UL;
+		}
+
+		return ulReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xTaskGetCpuStats( TaskHandle_t xTask, TaskCpuStats_t *pxStats )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxStats );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			if( ulCpuStatsWindowCycles != 0UL )
+			{
+				pxStats->ullCycles = pxTCB->ullCpuCycles;
+				pxStats->ulVoluntarySwitches = pxTCB->ulVoluntarySwitches;
+				pxStats->ulInvoluntarySwitches = pxTCB->ulInvoluntarySwitches;
+				pxStats->ulWindowLoad = ( uint32_t ) ( ( ( uint64_t ) prvCpuStatsLastWindow( pxTCB ) * 1000ULL ) / ( uint64_t ) ulCpuStatsWindowCycles );
+				xReturn = pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulTaskGetIdleLoad( void )
+	{
+	TaskCpuStats_t xStats;
+	uint32_t ulReturn = 0UL;
+
+		if( ( xIdleTaskHandle != NULL ) && ( xTaskGetCpuStats( xIdleTaskHandle, &xStats ) != pdFAIL ) )
+		{
+			ulReturn = xStats.ulWindowLoad;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ulReturn;
+	}
+
+#endif /* configUSE_TASK_CPU_STATS */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
 	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
@@ -4910,6 +5484,7 @@ TickType_t uxReturn;
 			{
 				/* The task should not have been on an event list. */
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+				prvWakeLatencyStamp( pxTCB );
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
@@ -4998,6 +5573,7 @@ TickType_t uxReturn;
 			{
 				/* The task should not have been on an event list. */
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+				prvWakeLatencyStamp( pxTCB );
 
 				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 				{
@@ -5072,11 +5648,42 @@ TickType_t uxReturn;
 #if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 	TickType_t xTaskGetIdleRunTimeCounter( void )
 	{
-		return xIdleTaskHandle->ulRunTimeCounter;
+		#if ( configUSE_TASK_CPU_STATS == 1 )
+		{
+			return ( TickType_t ) xIdleTaskHandle->ullCpuCycles;
+		}
+		#else
+		{
+			return xIdleTaskHandle->ulRunTimeCounter;
+		}
+		#endif
 	}
 #endif
 /*-----------------------------------------------------------*/
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	static void prvAddCurrentTaskToDelayedWheel( TickType_t xTimeToWake, const TickType_t xConstTickCount )
+	{
+		/* The slot of the current tick has already been processed, a zero
+		length block therefore wakes on the next tick as it does with the
+		sorted lists. */
+		if( xTimeToWake == xConstTickCount )
+		{
+			xTimeToWake++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+		vListInsertEnd( taskDELAYED_WHEEL_SLOT( xTimeToWake ), &( pxCurrentTCB->xStateListItem ) );
+	}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
@@ -5120,6 +5727,9 @@ const TickType_t xConstTickCount = xTickCount;
 			kernel will manage it correctly. */
 			xTimeToWake = xConstTickCount + xTicksToWait;
 
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+				prvAddCurrentTaskToDelayedWheel( xTimeToWake, xConstTickCount );
+			#else
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
@@ -5147,6 +5757,7 @@ const TickType_t xConstTickCount = xTickCount;
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5156,6 +5767,9 @@ const TickType_t xConstTickCount = xTickCount;
 		will manage it correctly. */
 		xTimeToWake = xConstTickCount + xTicksToWait;
 
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+			prvAddCurrentTaskToDelayedWheel( xTimeToWake, xConstTickCount );
+		#else
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
@@ -5181,6 +5795,7 @@ const TickType_t xConstTickCount = xTickCount;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
@@ -37,6 +37,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "wakelatency.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -104,6 +105,10 @@ typedef struct tmrCallbackParameters
 	PendedFunction_t	pxCallbackFunction;	/* << The callback function to execute. */
 	void *pvParameter1;						/* << The value that will be used as the callback functions first parameter. */
 	uint32_t ulParameter2;					/* << The value that will be used as the callback functions second parameter. */
+	#if( configUSE_WAKE_LATENCY == 1 )
+		uint32_t ulWakeStamp;				/* << Wake latency stamp of the interrupt that pended the call. */
+		UBaseType_t uxWakeSource;			/* << Its source + 1, 0 if the call was not pended from an interrupt. */
+	#endif
 } CallbackParameters_t;
 
 /* The structure that contains the two message types, along with an identifier
@@ -266,6 +271,17 @@ BaseType_t xReturn = pdFAIL;
 									&xTimerTaskHandle );
 		}
 		#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+		#if( configUSE_WAKE_LATENCY == 1 )
+		{
+			/* Functions pended from interrupts carry the wake latency stamp to
+			the task they make ready. */
+			if( xReturn != pdFAIL )
+			{
+				vTaskSetWakeLatencyRelay( xTimerTaskHandle );
+			}
+		}
+		#endif /* configUSE_WAKE_LATENCY */
 	}
 	else
 	{
@@ -728,7 +744,17 @@ TickType_t xTimeNow;
 				configASSERT( pxCallback );
 
 				/* Call the function. */
-				pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				#if( configUSE_WAKE_LATENCY == 1 )
+				{
+					vTaskSetWakeLatencyCarry( pxCallback->uxWakeSource, pxCallback->ulWakeStamp );
+					pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+					vTaskSetWakeLatencyCarry( ( UBaseType_t ) 0U, 0UL );
+				}
+				#else
+				{
+					pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+				}
+				#endif /* configUSE_WAKE_LATENCY */
 			}
 			else
 			{
@@ -1026,6 +1052,9 @@ Timer_t * const pxTimer = xTimer;
 	{
 	DaemonTaskMessage_t xMessage;
 	BaseType_t xReturn;
+	#if( configUSE_WAKE_LATENCY == 1 )
+		UBaseType_t uxSavedInterruptStatus;
+	#endif
 
 		/* Complete the message with the function parameters and post it to the
 		daemon task. */
@@ -1034,6 +1063,16 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
+		#if( configUSE_WAKE_LATENCY == 1 )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xMessage.u.xCallbackParameters.uxWakeSource = uxWakeLatencyStampFromISR( &( xMessage.u.xCallbackParameters.ulWakeStamp ) );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#endif /* configUSE_WAKE_LATENCY */
+
 		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
 		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
@@ -1063,6 +1102,13 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
+		#if( configUSE_WAKE_LATENCY == 1 )
+		{
+			xMessage.u.xCallbackParameters.ulWakeStamp = 0UL;
+			xMessage.u.xCallbackParameters.uxWakeSource = ( UBaseType_t ) 0U;
+		}
+		#endif /* configUSE_WAKE_LATENCY */
+
 		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 
 		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
@@ -0,0 +1,293 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Binary kernel event recorder, see trace_recorder.h.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+#define traceEVENT_MASK		( ( uint32_t ) configTRACE_RECORDER_LENGTH - 1UL )
+#define traceENCODE( ulEvent, ulParam )	( ( ( ulEvent ) << 24UL ) | ( ( ulParam ) & 0x00ffffffUL ) )
+
+/* The recorder lives in the retained part of SRAM2 which is not touched by the
+startup code, so a frozen capture survives a reset. */
+PRIVILEGED_DATA static TraceRecorder_t xTraceRecorder __attribute__( ( section( ".retained" ) ) );
+
+/*
+ * Clear the capture and set the fixed part of the header.  Must be called with
+ * interrupts masked.
+ */
+static void prvTraceRecorderReset( uint32_t ulMode ) PRIVILEGED_FUNCTION;
+
+/*
+ * Store one event, interrupts must already be masked.
+ */
+static void prvTraceRecorderStore( uint32_t ulEvent, const void *pvObject, uint32_t ulParam ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvTraceRecorderReset( uint32_t ulMode )
+{
+	xTraceRecorder.ulState = traceSTATE_STOPPED;
+	xTraceRecorder.ulMagic = traceRECORDER_MAGIC;
+	xTraceRecorder.ulVersion = traceRECORDER_VERSION;
+	xTraceRecorder.ulClockHz = configCPU_CLOCK_HZ;
+	xTraceRecorder.ulTickRateHz = configTICK_RATE_HZ;
+	xTraceRecorder.ulLength = configTRACE_RECORDER_LENGTH;
+	xTraceRecorder.ulNameCount = configTRACE_RECORDER_NAMES;
+	xTraceRecorder.ulMode = ulMode;
+	xTraceRecorder.ulHead = 0UL;
+	xTraceRecorder.ulTail = 0UL;
+	xTraceRecorder.ulDropped = 0UL;
+	xTraceRecorder.ulPostTrigger = 0UL;
+	xTraceRecorder.ulTriggerReason = 0UL;
+	xTraceRecorder.ulNextName = 0UL;
+	( void ) memset( xTraceRecorder.xNames, 0x00, sizeof( xTraceRecorder.xNames ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceRecorderStore( uint32_t ulEvent, const void *pvObject, uint32_t ulParam )
+{
+TraceEvent_t *pxEvent;
+const uint32_t ulState = xTraceRecorder.ulState;
+
+	if( ( ulState == traceSTATE_RUNNING ) || ( ulState == traceSTATE_TRIGGERED ) )
+	{
+		if( ( xTraceRecorder.ulMode == traceMODE_STREAM ) && ( ( xTraceRecorder.ulHead - xTraceRecorder.ulTail ) >= ( uint32_t ) configTRACE_RECORDER_LENGTH ) )
+		{
+			/* The reader has fallen behind, keep what it has not read yet. */
+			( xTraceRecorder.ulDropped )++;
+		}
+		else
+		{
+			pxEvent = &( xTraceRecorder.xEvents[ xTraceRecorder.ulHead & traceEVENT_MASK ] );
+			pxEvent->ulTimestamp = portGET_RUN_TIME_COUNTER_VALUE();
+			pxEvent->ulObject = ( uint32_t ) ( uintptr_t ) pvObject;
+			pxEvent->ulEventParam = traceENCODE( ulEvent, ulParam );
+			( xTraceRecorder.ulHead )++;
+
+			if( ulState == traceSTATE_TRIGGERED )
+			{
+				( xTraceRecorder.ulPostTrigger )--;
+
+				if( xTraceRecorder.ulPostTrigger == 0UL )
+				{
+					xTraceRecorder.ulState = traceSTATE_FROZEN;
+				}
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTraceRecorderInit( void )
+{
+uint32_t ulReturn = 0UL;
+
+	if( ( xTraceRecorder.ulMagic == traceRECORDER_MAGIC ) &&
+		( xTraceRecorder.ulVersion == traceRECORDER_VERSION ) &&
+		( xTraceRecorder.ulLength == ( uint32_t ) configTRACE_RECORDER_LENGTH ) &&
+		( xTraceRecorder.ulState == traceSTATE_FROZEN ) )
+	{
+		/* Keep the capture taken before the reset until it has been read. */
+		ulReturn = 1UL;
+	}
+	else
+	{
+		vTraceRecorderStart( configTRACE_RECORDER_MODE );
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( uint32_t ulMode )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	/* Also called before the scheduler is started, where the critical
+	section API would leave interrupts masked. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvTraceRecorderReset( ulMode );
+		xTraceRecorder.ulState = traceSTATE_RUNNING;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xTraceRecorder.ulState = traceSTATE_STOPPED;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderTrigger( uint32_t ulReason )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( xTraceRecorder.ulMode == traceMODE_SNAPSHOT ) && ( xTraceRecorder.ulState == traceSTATE_RUNNING ) )
+		{
+			prvTraceRecorderStore( traceEVT_TRIGGER, NULL, ulReason );
+			xTraceRecorder.ulTriggerReason = ulReason;
+
+			if( configTRACE_RECORDER_POST_TRIGGER == 0 )
+			{
+				xTraceRecorder.ulState = traceSTATE_FROZEN;
+			}
+			else
+			{
+				xTraceRecorder.ulPostTrigger = configTRACE_RECORDER_POST_TRIGGER;
+				xTraceRecorder.ulState = traceSTATE_TRIGGERED;
+			}
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTraceRecorderRead( TraceEvent_t *pxBuffer, uint32_t ulMaxEvents )
+{
+uint32_t ulTail = xTraceRecorder.ulTail;
+uint32_t ulCount;
+uint32_t ulIndex;
+
+	configASSERT( pxBuffer );
+
+	/* Only the writer moves ulHead and only the reader moves ulTail, and the
+	writer never touches the slots between them, so no lock is needed. */
+	ulCount = xTraceRecorder.ulHead - ulTail;
+
+	if( ulCount > ulMaxEvents )
+	{
+		ulCount = ulMaxEvents;
+	}
+
+	for( ulIndex = 0UL; ulIndex < ulCount; ulIndex++ )
+	{
+		pxBuffer[ ulIndex ] = xTraceRecorder.xEvents[ ( ulTail + ulIndex ) & traceEVENT_MASK ];
+	}
+
+	/* The copies must be complete before the slots are handed back. */
+	__asm volatile( "" ::: "memory" );
+	xTraceRecorder.ulTail = ulTail + ulCount;
+
+	return ulCount;
+}
+/*-----------------------------------------------------------*/
+
+const TraceRecorder_t *pxTraceRecorderGet( void )
+{
+	return &xTraceRecorder;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderName( const void *pvObject, const char *pcName )
+{
+UBaseType_t uxSavedInterruptStatus;
+TraceName_t *pxName = NULL;
+uint32_t ulIndex, ulChars, ulParam;
+const uint32_t ulObject = ( uint32_t ) ( uintptr_t ) pvObject;
+
+	if( pcName == NULL )
+	{
+		return;
+	}
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Handles are reused after an object is deleted, so replace an existing
+		entry for the same handle, otherwise take the next slot round robin. */
+		for( ulIndex = 0UL; ulIndex < ( uint32_t ) configTRACE_RECORDER_NAMES; ulIndex++ )
+		{
+			if( xTraceRecorder.xNames[ ulIndex ].ulObject == ulObject )
+			{
+				pxName = &( xTraceRecorder.xNames[ ulIndex ] );
+				break;
+			}
+		}
+
+		if( pxName == NULL )
+		{
+			pxName = &( xTraceRecorder.xNames[ xTraceRecorder.ulNextName ] );
+			xTraceRecorder.ulNextName = ( xTraceRecorder.ulNextName + 1UL ) % ( uint32_t ) configTRACE_RECORDER_NAMES;
+		}
+
+		pxName->ulObject = ulObject;
+		( void ) strncpy( pxName->cName, pcName, traceRECORDER_NAME_LEN );
+
+		/* A stream reader never sees the name table, so the name is also sent
+		inline, three characters per event, up to and including the
+		terminator. */
+		if( xTraceRecorder.ulMode == traceMODE_STREAM )
+		{
+			ulIndex = 0UL;
+
+			do
+			{
+				ulParam = 0UL;
+
+				for( ulChars = 0UL; ulChars < 3UL; ulChars++ )
+				{
+					if( ( ulIndex < ( uint32_t ) traceRECORDER_NAME_LEN ) && ( pxName->cName[ ulIndex ] != '\0' ) )
+					{
+						ulParam |= ( ( uint32_t ) ( uint8_t ) pxName->cName[ ulIndex ] ) << ( ulChars * 8UL );
+						ulIndex++;
+					}
+				}
+
+				prvTraceRecorderStore( traceEVT_NAME, pvObject, ulParam );
+			} while( ( ulParam & 0x00ff0000UL ) != 0UL );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderEvent( uint32_t ulEvent, const void *pvObject, uint32_t ulParam )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvTraceRecorderStore( ulEvent, pvObject, ulParam );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderTaskCreate( const void *pvTask, const char *pcName, uint32_t ulPriority )
+{
+	vTraceRecorderName( pvTask, pcName );
+	vTraceRecorderEvent( traceEVT_TASK_CREATE, pvTask, ulPriority );
+}
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -0,0 +1,325 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Interrupt to task wake latency, see wakelatency.h.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wakelatency.h"
+
+#if( configUSE_WAKE_LATENCY == 1 )
+
+/* prvWakeLatencySource() results that are not a source. */
+#define wakelatencyNO_SOURCE_FREE	( ( UBaseType_t ) configWAKE_LATENCY_SOURCES )
+#define wakelatencyNOT_IN_ISR		( ( UBaseType_t ) configWAKE_LATENCY_SOURCES + 1U )
+
+/* Latencies of 2^configWAKE_LATENCY_MAX_LOG2 cycles or more, after the last
+bucket of the log-linear range. */
+#define wakelatencyOVERFLOW			( ( UBaseType_t ) ( wakelatencyBUCKETS - 1 ) )
+
+PRIVILEGED_DATA static WakeLatencyStats_t xWakeLatency[ configWAKE_LATENCY_SOURCES ];
+PRIVILEGED_DATA static uint32_t ulEntryStamp[ configWAKE_LATENCY_SOURCES ];
+PRIVILEGED_DATA static uint8_t ucEntryStamped[ configWAKE_LATENCY_SOURCES ];
+PRIVILEGED_DATA static volatile UBaseType_t uxSourcesUsed = 0U;
+PRIVILEGED_DATA static volatile uint32_t ulDropped = 0UL;
+
+/*
+ * The source the running interrupt is assigned to, assigning the next free
+ * one on its first use.  Returns wakelatencyNO_SOURCE_FREE or
+ * wakelatencyNOT_IN_ISR if there is none.  Must be called with interrupts
+ * masked.
+ */
+static UBaseType_t prvWakeLatencySource( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Histogram bucket of a latency, and the highest latency the bucket holds.
+ */
+static UBaseType_t prvWakeLatencyBucket( uint32_t ulCycles ) PRIVILEGED_FUNCTION;
+static uint32_t prvWakeLatencyBucketLimit( UBaseType_t uxBucket ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvWakeLatencySource( void )
+{
+uint32_t ulException;
+UBaseType_t uxSource;
+
+	__asm volatile( "mrs %0, ipsr" : "=r"( ulException ) );
+	ulException &= 0x1ffUL;
+
+	if( ulException == 0UL )
+	{
+		uxSource = wakelatencyNOT_IN_ISR;
+	}
+	else
+	{
+		for( uxSource = ( UBaseType_t ) 0U; uxSource < uxSourcesUsed; uxSource++ )
+		{
+			if( xWakeLatency[ uxSource ].ulException == ulException )
+			{
+				break;
+			}
+		}
+
+		if( uxSource == uxSourcesUsed )
+		{
+			if( uxSource < ( UBaseType_t ) configWAKE_LATENCY_SOURCES )
+			{
+				xWakeLatency[ uxSource ].ulException = ulException;
+				xWakeLatency[ uxSource ].ulMinimum = 0xffffffffUL;
+				uxSourcesUsed = uxSource + ( UBaseType_t ) 1U;
+			}
+			else
+			{
+				uxSource = wakelatencyNO_SOURCE_FREE;
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxSource;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvWakeLatencyBucket( uint32_t ulCycles )
+{
+uint32_t ulLog2;
+UBaseType_t uxBucket;
+
+	if( ulCycles < 4UL )
+	{
+		uxBucket = ( UBaseType_t ) ulCycles;
+	}
+	else
+	{
+		ulLog2 = 31UL - ( uint32_t ) __builtin_clz( ulCycles );
+
+		if( ulLog2 >= ( uint32_t ) configWAKE_LATENCY_MAX_LOG2 )
+		{
+			uxBucket = wakelatencyOVERFLOW;
+		}
+		else
+		{
+			/* Four buckets per power of two, selected by the two bits below
+			the most significant one. */
+			uxBucket = ( UBaseType_t ) ( ( ( ulLog2 - 1UL ) * 4UL ) + ( ( ulCycles >> ( ulLog2 - 2UL ) ) & 3UL ) );
+		}
+	}
+
+	return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvWakeLatencyBucketLimit( UBaseType_t uxBucket )
+{
+uint32_t ulLimit;
+
+	if( uxBucket >= wakelatencyOVERFLOW )
+	{
+		/* No upper bound, the percentile is clamped to ulMaximum. */
+		ulLimit = 0xffffffffUL;
+	}
+	else if( uxBucket < ( UBaseType_t ) 3U )
+	{
+		ulLimit = ( uint32_t ) uxBucket;
+	}
+	else
+	{
+		/* One below the lowest latency of the next bucket. */
+		uxBucket++;
+		ulLimit = ( ( 4UL + ( ( uint32_t ) uxBucket & 3UL ) ) << ( ( ( uint32_t ) uxBucket / 4UL ) - 1UL ) ) - 1UL;
+	}
+
+	return ulLimit;
+}
+/*-----------------------------------------------------------*/
+
+void vWakeLatencyISREnter( void )
+{
+uint32_t ulStamp = portGET_RUN_TIME_COUNTER_VALUE();
+UBaseType_t uxSavedInterruptStatus, uxSource;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxSource = prvWakeLatencySource();
+
+		if( uxSource < ( UBaseType_t ) configWAKE_LATENCY_SOURCES )
+		{
+			ulEntryStamp[ uxSource ] = ulStamp;
+			ucEntryStamped[ uxSource ] = ( uint8_t ) pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxWakeLatencyStampFromISR( uint32_t *pulStamp )
+{
+UBaseType_t uxSource;
+
+	uxSource = prvWakeLatencySource();
+
+	if( uxSource < ( UBaseType_t ) configWAKE_LATENCY_SOURCES )
+	{
+		if( ucEntryStamped[ uxSource ] != ( uint8_t ) pdFALSE )
+		{
+			*pulStamp = ulEntryStamp[ uxSource ];
+		}
+		else
+		{
+			*pulStamp = portGET_RUN_TIME_COUNTER_VALUE();
+		}
+
+		uxSource++;
+	}
+	else
+	{
+		if( uxSource == wakelatencyNO_SOURCE_FREE )
+		{
+			ulDropped++;
+		}
+
+		uxSource = ( UBaseType_t ) 0U;
+	}
+
+	return uxSource;
+}
+/*-----------------------------------------------------------*/
+
+void vWakeLatencyRecord( UBaseType_t uxSource, uint32_t ulStamp )
+{
+WakeLatencyStats_t *pxStats = &( xWakeLatency[ uxSource - ( UBaseType_t ) 1U ] );
+const uint32_t ulCycles = portGET_RUN_TIME_COUNTER_VALUE() - ulStamp;
+
+	( pxStats->ulCount )++;
+	( pxStats->ulBuckets[ prvWakeLatencyBucket( ulCycles ) ] )++;
+
+	if( ulCycles < pxStats->ulMinimum )
+	{
+		pxStats->ulMinimum = ulCycles;
+	}
+
+	if( ulCycles > pxStats->ulMaximum )
+	{
+		pxStats->ulMaximum = ulCycles;
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWakeLatencyGetStats( UBaseType_t uxSource, WakeLatencyStats_t *pxStats )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxStats );
+
+	taskENTER_CRITICAL();
+	{
+		if( uxSource < uxSourcesUsed )
+		{
+			( void ) memcpy( pxStats, &( xWakeLatency[ uxSource ] ), sizeof( WakeLatencyStats_t ) );
+			xReturn = pdPASS;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulWakeLatencyPercentile( const WakeLatencyStats_t *pxStats, uint32_t ulPermille )
+{
+uint64_t ullRank, ullSeen = 0ULL;
+UBaseType_t uxBucket;
+uint32_t ulReturn = 0UL;
+
+	configASSERT( pxStats );
+
+	if( ulPermille > 1000UL )
+	{
+		ulPermille = 1000UL;
+	}
+
+	if( pxStats->ulCount != 0UL )
+	{
+		/* The rank of the wakeup sought, rounded up, at least the first. */
+		ullRank = ( ( ( uint64_t ) pxStats->ulCount * ulPermille ) + 999ULL ) / 1000ULL;
+
+		if( ullRank == 0ULL )
+		{
+			ullRank = 1ULL;
+		}
+
+		for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) wakelatencyBUCKETS; uxBucket++ )
+		{
+			ullSeen += pxStats->ulBuckets[ uxBucket ];
+
+			if( ullSeen >= ullRank )
+			{
+				ulReturn = prvWakeLatencyBucketLimit( uxBucket );
+				break;
+			}
+		}
+
+		/* The bucket limit can exceed anything actually recorded. */
+		if( ulReturn > pxStats->ulMaximum )
+		{
+			ulReturn = pxStats->ulMaximum;
+		}
+	}
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulWakeLatencyGetDropped( void )
+{
+	return ulDropped;
+}
+/*-----------------------------------------------------------*/
+
+void vWakeLatencyReset( void )
+{
+UBaseType_t uxSource;
+
+	/* One source at a time to keep the critical sections short. */
+	for( uxSource = ( UBaseType_t ) 0U; uxSource < ( UBaseType_t ) configWAKE_LATENCY_SOURCES; uxSource++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			xWakeLatency[ uxSource ].ulCount = 0UL;
+			xWakeLatency[ uxSource ].ulMinimum = 0xffffffffUL;
+			xWakeLatency[ uxSource ].ulMaximum = 0UL;
+			( void ) memset( xWakeLatency[ uxSource ].ulBuckets, 0x00, sizeof( xWakeLatency[ uxSource ].ulBuckets ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	ulDropped = 0UL;
+}
+
+#endif /* configUSE_WAKE_LATENCY */
@@ -0,0 +1,416 @@
+/*
+ *  Copyright (C) 2026, agent@local
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Deferred work queue, see workqueue.h.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workqueue.h"
+#include "wakelatency.h"
+
+#if( configUSE_WORK_QUEUE == 1 )
+
+typedef struct xWORK_ITEM
+{
+	struct xWORK_ITEM *pxNext;
+	WorkFunction_t pxFunction;
+	void *pvParameter1;
+	uint32_t ulParameter2;
+	#if( configUSE_WAKE_LATENCY == 1 )
+		uint32_t ulWakeStamp;		/* Wake latency stamp of the interrupt that posted the item. */
+		UBaseType_t uxWakeSource;	/* Its source + 1, 0 if the item was not posted from an interrupt. */
+	#endif
+} WorkItem_t;
+
+typedef struct xWORK_LIST
+{
+	WorkItem_t *pxHead;
+	WorkItem_t *pxTail;
+} WorkList_t;
+
+PRIVILEGED_DATA static WorkItem_t xWorkItems[ configWORK_QUEUE_POOL_SIZE ];
+PRIVILEGED_DATA static WorkItem_t *pxFreeWorkItems = NULL;
+PRIVILEGED_DATA static WorkList_t xPendingWork[ configWORK_QUEUE_LEVELS ];
+PRIVILEGED_DATA static volatile uint32_t ulPendingLevels = 0UL;	/* Bit n set when level n is not empty. */
+PRIVILEGED_DATA static UBaseType_t uxFreeWorkItems = 0U;
+PRIVILEGED_DATA static WorkQueueStats_t xWorkQueueStats;
+PRIVILEGED_DATA static TaskHandle_t xWorkQueueTask = NULL;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	PRIVILEGED_DATA static StaticTask_t xWorkQueueTaskTCB;
+	PRIVILEGED_DATA static StackType_t xWorkQueueTaskStack[ configWORK_QUEUE_STACK_DEPTH ];
+#endif
+
+/*
+ * The worker task.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkQueueTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run pending work until every level is empty.
+ */
+static void prvWorkQueueDrain( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take an item from the pool and append it to uxLevel.  Must be called with
+ * interrupts masked.
+ */
+static BaseType_t prvWorkQueueInsert( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+
+/*
+ * The highest level that has pending work.  ulPendingLevels must not be 0.
+ */
+static UBaseType_t prvWorkQueueHighestLevel( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueCreateTask( void )
+{
+UBaseType_t uxItem;
+BaseType_t xReturn = pdFAIL;
+
+	/* Link the pool into the free list. */
+	for( uxItem = ( UBaseType_t ) 0U; uxItem < ( UBaseType_t ) configWORK_QUEUE_POOL_SIZE; uxItem++ )
+	{
+		xWorkItems[ uxItem ].pxNext = pxFreeWorkItems;
+		pxFreeWorkItems = &( xWorkItems[ uxItem ] );
+	}
+
+	uxFreeWorkItems = ( UBaseType_t ) configWORK_QUEUE_POOL_SIZE;
+	( void ) memset( xPendingWork, 0x00, sizeof( xPendingWork ) );
+	( void ) memset( &xWorkQueueStats, 0x00, sizeof( xWorkQueueStats ) );
+	xWorkQueueStats.uxPoolSize = ( UBaseType_t ) configWORK_QUEUE_POOL_SIZE;
+	xWorkQueueStats.uxMinimumFree = ( UBaseType_t ) configWORK_QUEUE_POOL_SIZE;
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xWorkQueueTask = xTaskCreateStatic( prvWorkQueueTask,
+											"WorkQ",
+											configWORK_QUEUE_STACK_DEPTH,
+											NULL,
+											( ( UBaseType_t ) configWORK_QUEUE_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+											xWorkQueueTaskStack,
+											&xWorkQueueTaskTCB );
+
+		if( xWorkQueueTask != NULL )
+		{
+			xReturn = pdPASS;
+		}
+	}
+	#else
+	{
+		xReturn = xTaskCreate( prvWorkQueueTask,
+							   "WorkQ",
+							   configWORK_QUEUE_STACK_DEPTH,
+							   NULL,
+							   ( ( UBaseType_t ) configWORK_QUEUE_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+							   &xWorkQueueTask );
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	#if( configUSE_WAKE_LATENCY == 1 )
+	{
+		/* Work posted from interrupts carries the wake latency stamp to the
+		task it makes ready. */
+		if( xReturn != pdFAIL )
+		{
+			vTaskSetWakeLatencyRelay( xWorkQueueTask );
+		}
+	}
+	#endif /* configUSE_WAKE_LATENCY */
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueuePost( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( uxLevel < ( UBaseType_t ) configWORK_QUEUE_LEVELS );
+	configASSERT( pxFunction );
+
+	if( xWorkQueueTask != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvWorkQueueInsert( uxLevel, pxFunction, pvParameter1, ulParameter2 );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xReturn != pdFAIL )
+		{
+			( void ) xTaskNotifyGive( xWorkQueueTask );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueuePostFromISR( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn = pdFAIL;
+UBaseType_t uxSavedInterruptStatus;
+#if( configUSE_WAKE_LATENCY == 1 )
+	WorkItem_t *pxItem;
+#endif
+
+	configASSERT( uxLevel < ( UBaseType_t ) configWORK_QUEUE_LEVELS );
+	configASSERT( pxFunction );
+
+	if( xWorkQueueTask != NULL )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = prvWorkQueueInsert( uxLevel, pxFunction, pvParameter1, ulParameter2 );
+
+			#if( configUSE_WAKE_LATENCY == 1 )
+			{
+				if( xReturn != pdFAIL )
+				{
+					pxItem = xPendingWork[ uxLevel ].pxTail;
+					pxItem->uxWakeSource = uxWakeLatencyStampFromISR( &( pxItem->ulWakeStamp ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_WAKE_LATENCY */
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xReturn != pdFAIL )
+		{
+			vTaskNotifyGiveFromISR( xWorkQueueTask, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueGetStats( WorkQueueStats_t *pxStats )
+{
+	configASSERT( pxStats );
+
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xWorkQueueStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWorkQueueInsert( UBaseType_t uxLevel, WorkFunction_t pxFunction, void *pvParameter1, uint32_t ulParameter2 )
+{
+WorkItem_t *pxItem = pxFreeWorkItems;
+WorkList_t * const pxList = &( xPendingWork[ uxLevel ] );
+BaseType_t xReturn;
+
+	if( pxItem == NULL )
+	{
+		( xWorkQueueStats.ulOverflows[ uxLevel ] )++;
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		pxFreeWorkItems = pxItem->pxNext;
+		uxFreeWorkItems--;
+
+		if( uxFreeWorkItems < xWorkQueueStats.uxMinimumFree )
+		{
+			xWorkQueueStats.uxMinimumFree = uxFreeWorkItems;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxItem->pxNext = NULL;
+		pxItem->pxFunction = pxFunction;
+		pxItem->pvParameter1 = pvParameter1;
+		pxItem->ulParameter2 = ulParameter2;
+
+		#if( configUSE_WAKE_LATENCY == 1 )
+		{
+			pxItem->ulWakeStamp = 0UL;
+			pxItem->uxWakeSource = ( UBaseType_t ) 0U;
+		}
+		#endif /* configUSE_WAKE_LATENCY */
+
+		if( pxList->pxHead == NULL )
+		{
+			pxList->pxHead = pxItem;
+			ulPendingLevels |= ( 1UL << uxLevel );
+		}
+		else
+		{
+			pxList->pxTail->pxNext = pxItem;
+		}
+
+		pxList->pxTail = pxItem;
+		( xWorkQueueStats.ulPosted[ uxLevel ] )++;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvWorkQueueHighestLevel( void )
+{
+UBaseType_t uxLevel = workqueueLEVEL_HIGHEST;
+
+	while( ( ulPendingLevels & ( 1UL << uxLevel ) ) == 0UL )
+	{
+		configASSERT( uxLevel );
+		--uxLevel;
+	}
+
+	return uxLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkQueueDrain( void )
+{
+WorkItem_t *pxBatch, *pxBatchTail, *pxItem;
+UBaseType_t uxLevel, uxCount;
+
+	for( ;; )
+	{
+		/* Detach the whole list of the highest pending level. */
+		taskENTER_CRITICAL();
+		{
+			if( ulPendingLevels == 0UL )
+			{
+				taskEXIT_CRITICAL();
+				break;
+			}
+
+			uxLevel = prvWorkQueueHighestLevel();
+			pxBatch = xPendingWork[ uxLevel ].pxHead;
+			pxBatchTail = xPendingWork[ uxLevel ].pxTail;
+			xPendingWork[ uxLevel ].pxHead = NULL;
+			xPendingWork[ uxLevel ].pxTail = NULL;
+			ulPendingLevels &= ~( 1UL << uxLevel );
+		}
+		taskEXIT_CRITICAL();
+
+		uxCount = ( UBaseType_t ) 0U;
+
+		while( pxBatch != NULL )
+		{
+			pxItem = pxBatch;
+			pxBatch = pxItem->pxNext;
+			#if( configUSE_WAKE_LATENCY == 1 )
+			{
+				vTaskSetWakeLatencyCarry( pxItem->uxWakeSource, pxItem->ulWakeStamp );
+				pxItem->pxFunction( pxItem->pvParameter1, pxItem->ulParameter2 );
+				vTaskSetWakeLatencyCarry( ( UBaseType_t ) 0U, 0UL );
+			}
+			#else
+			{
+				pxItem->pxFunction( pxItem->pvParameter1, pxItem->ulParameter2 );
+			}
+			#endif /* configUSE_WAKE_LATENCY */
+			uxCount++;
+
+			taskENTER_CRITICAL();
+			{
+				/* Return the item to the pool. */
+				pxItem->pxNext = pxFreeWorkItems;
+				pxFreeWorkItems = pxItem;
+				uxFreeWorkItems++;
+				( xWorkQueueStats.ulExecuted[ uxLevel ] )++;
+
+				/* If higher level work arrived, put the rest of the batch back
+				in front of its level so the higher level is served first. */
+				if( ( pxBatch != NULL ) && ( ( ulPendingLevels >> uxLevel ) > 1UL ) )
+				{
+					pxBatchTail->pxNext = xPendingWork[ uxLevel ].pxHead;
+
+					if( xPendingWork[ uxLevel ].pxHead == NULL )
+					{
+						xPendingWork[ uxLevel ].pxTail = pxBatchTail;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xPendingWork[ uxLevel ].pxHead = pxBatch;
+					ulPendingLevels |= ( 1UL << uxLevel );
+					pxBatch = NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		if( uxCount > xWorkQueueStats.uxLargestBatch )
+		{
+			xWorkQueueStats.uxLargestBatch = uxCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkQueueTask, pvParameters )
+{
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Every post gives the notification, so work posted while the queue
+		is being drained is picked up by the next pass. */
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvWorkQueueDrain();
+	}
+}
+
+#endif /* configUSE_WORK_QUEUE */
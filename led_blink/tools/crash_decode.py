@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+#
+#   Copyright (C) 2026, agent@local
+#   SPDX-License-Identifier: Apache-2.0
+#
+"""Turn a crash dump into a readable report with a symbolized backtrace.
+
+The dump is the CrashDump_t of package/freertos/inc/crashdump.h, little
+endian, found anywhere in the input so a dump of the whole retained SRAM2
+area works as well as the record alone:
+
+  gdb> dump binary memory crash.bin &_sretained &_eretained
+
+or the dump / dump_size bytes of osCrashDump_t sent by the application, as
+a binary file or as a text file of hex bytes.
+
+With the ELF of the image the pc, lr and return addresses found in the stack
+copy are resolved to function, file and line with addr2line.  A stack word is
+taken as a return address when it points just behind a BL or BLX instruction,
+so the backtrace needs no frame pointers but may show a stale caller.
+"""
+
+import argparse
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x48535243
+VERSION = 1
+HEADER = struct.Struct('<14I17II16s3II')
+CHECKSUM_WORDS = (HEADER.size - 4) // 4
+
+CAUSES = {
+    0x000: 'record cleared',
+    0x003: 'hard fault',
+    0x004: 'memory management fault',
+    0x005: 'bus fault',
+    0x006: 'usage fault',
+    0x100: 'assert failed',
+    0x101: 'stack overflow',
+    0x102: 'watchdog, task stopped making progress',
+}
+
+FLAG_FRAME = 1 << 0
+FLAG_PSP = 1 << 1
+FLAG_HANDLER = 1 << 2
+FLAG_FPU = 1 << 3
+
+CFSR_BITS = [
+    (0, 'IACCVIOL', 'instruction fetch from a no access or never execute region'),
+    (1, 'DACCVIOL', 'data access to a no access region'),
+    (3, 'MUNSTKERR', 'MPU fault while unstacking on exception return'),
+    (4, 'MSTKERR', 'MPU fault while stacking on exception entry'),
+    (5, 'MLSPERR', 'MPU fault during lazy FPU state preservation'),
+    (7, 'MMARVALID', 'MMFAR holds the faulting address'),
+    (8, 'IBUSERR', 'bus error on instruction fetch'),
+    (9, 'PRECISERR', 'precise data bus error'),
+    (10, 'IMPRECISERR', 'imprecise data bus error, the pc is past the access'),
+    (11, 'UNSTKERR', 'bus error while unstacking on exception return'),
+    (12, 'STKERR', 'bus error while stacking on exception entry'),
+    (13, 'LSPERR', 'bus error during lazy FPU state preservation'),
+    (15, 'BFARVALID', 'BFAR holds the faulting address'),
+    (16, 'UNDEFINSTR', 'undefined instruction'),
+    (17, 'INVSTATE', 'invalid EPSR state, e.g. a call through an even address'),
+    (18, 'INVPC', 'invalid EXC_RETURN on exception return'),
+    (19, 'NOCP', 'coprocessor access, e.g. the FPU while it is disabled'),
+    (24, 'UNALIGNED', 'unaligned access'),
+    (25, 'DIVBYZERO', 'division by zero'),
+]
+
+HFSR_BITS = [
+    (1, 'VECTTBL', 'bus error reading the vector table'),
+    (30, 'FORCED', 'escalated configurable fault, see CFSR'),
+    (31, 'DEBUGEVT', 'debug event'),
+]
+
+REGISTER_NAMES = ['r%d' % index for index in range(13)] + ['sp', 'lr', 'pc', 'xpsr']
+
+# Where code can be when no ELF is given: the internal flash.
+FLASH = (0x08000000, 0x08100000)
+
+
+class Elf:
+    """Executable sections and function symbols of an ELF32 little endian image."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as handle:
+            data = handle.read()
+        if data[:4] != b'\x7fELF' or data[4] != 1 or data[5] != 1:
+            raise ValueError('%s is not a 32 bit little endian ELF' % path)
+        shoff, = struct.unpack_from('<I', data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', data, 0x2e)
+        sections = [struct.unpack_from('<10I', data, shoff + index * shentsize) for index in range(shnum)]
+        self.code = []
+        self.functions = []
+        for _, kind, flags, addr, offset, size, link, _, _, entsize in sections:
+            if kind == 1 and flags & 0x4 and size:
+                # SHT_PROGBITS with SHF_EXECINSTR
+                self.code.append((addr, data[offset:offset + size]))
+            elif kind == 2 and entsize:
+                # SHT_SYMTAB
+                strtab = sections[link]
+                for index in range(size // entsize):
+                    st_name, value, st_size, info, _, _ = struct.unpack_from('<IIIBBH', data, offset + index * entsize)
+                    if info & 0xf == 2:
+                        start = strtab[4] + st_name
+                        label = data[start:data.index(b'\0', start)].decode('ascii', 'replace')
+                        self.functions.append((value & ~1, st_size, label))
+        self.functions.sort()
+
+    def halfword(self, addr):
+        for start, code in self.code:
+            if start <= addr < start + len(code) - 1:
+                return struct.unpack_from('<H', code, addr - start)[0]
+        return None
+
+    def is_code(self, addr):
+        return self.halfword(addr) is not None
+
+    def follows_call(self, addr):
+        """True if the Thumb return address addr is right behind a BL or BLX."""
+        addr &= ~1
+        hw1, hw2 = self.halfword(addr - 4), self.halfword(addr - 2)
+        if hw1 is not None and hw2 is not None and (hw1 & 0xf800) == 0xf000 and (hw2 & 0xc000) == 0xc000:
+            return True
+        return hw2 is not None and (hw2 & 0xff87) == 0x4780
+
+    def function(self, addr):
+        for start, size, label in self.functions:
+            if start <= addr < start + max(size, 2):
+                return '%s+0x%x' % (label, addr - start)
+        return None
+
+
+class Symbolizer:
+    def __init__(self, elf_path, addr2line, elf):
+        self.elf_path = elf_path
+        self.addr2line = addr2line if elf_path and shutil.which(addr2line) else None
+        self.elf = elf
+
+    def lookup(self, addrs):
+        result = {addr: [] for addr in addrs}
+        if self.addr2line and addrs:
+            out = subprocess.run([self.addr2line, '-e', self.elf_path, '-f', '-i', '-C', '-a'] +
+                                 ['0x%08x' % addr for addr in addrs],
+                                 stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+            current = None
+            lines = out.splitlines()
+            index = 0
+            while index < len(lines):
+                line = lines[index]
+                if re.match(r'^0x[0-9a-f]+$', line):
+                    current = int(line, 16)
+                    index += 1
+                    continue
+                location = lines[index + 1] if index + 1 < len(lines) else '??:0'
+                if current in result and line != '??':
+                    result[current].append('%s at %s' % (line, location))
+                index += 2
+        elif self.elf:
+            for addr in addrs:
+                label = self.elf.function(addr)
+                if label:
+                    result[addr].append(label)
+        return result
+
+
+def find_dump(data):
+    """Offset of the first intact record in data."""
+    magic = struct.pack('<I', MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0 and offset + HEADER.size <= len(data):
+            fields = HEADER.unpack_from(data, offset)
+            length, words = fields[2], fields[35]
+            if fields[1] == VERSION and words <= length and offset + HEADER.size + 4 * length <= len(data):
+                if checksum(data, offset, words) == fields[36]:
+                    return offset
+        offset = data.find(magic, offset + 1)
+    raise ValueError('no intact crash dump found')
+
+
+def checksum(data, offset, words):
+    total = 0xffffffff
+    values = struct.unpack_from('<%dI' % CHECKSUM_WORDS, data, offset)
+    values += struct.unpack_from('<%dI' % words, data, offset + HEADER.size)
+    for value in values:
+        total = (((total << 1) | (total >> 31)) & 0xffffffff) ^ value
+    return total
+
+
+def bits(value, table):
+    return [(name, text) for bit, name, text in table if value & (1 << bit)]
+
+
+def read_input(path):
+    with open(path, 'rb') as handle:
+        data = handle.read()
+    text = re.sub(rb'0x|[\s,]', b'', data)
+    if text and re.fullmatch(rb'[0-9a-fA-F]+', text) and len(text) % 2 == 0:
+        # Hex bytes, as the application would print the record.
+        return bytes.fromhex(text.decode('ascii'))
+    return data
+
+
+def report(data, elf_path=None, addr2line='arm-none-eabi-addr2line', depth=16):
+    offset = find_dump(data)
+    (_, _, length, sequence, cause, flags, line, tick, exc_return, cfsr, hfsr, mmfar, bfar, afsr,
+     *rest) = HEADER.unpack_from(data, offset)
+    regs = rest[:17]
+    task, name, stack_limit, stack_addr, stack_words, _ = rest[17:]
+    stack = struct.unpack_from('<%dI' % stack_words, data, offset + HEADER.size)
+    name = name.split(b'\0', 1)[0].decode('ascii', 'replace')
+
+    elf = Elf(elf_path) if elf_path else None
+    symbols = Symbolizer(elf_path, addr2line, elf)
+
+    out = []
+    where = 'interrupt handler' if flags & FLAG_HANDLER else (
+        'task "%s" (0x%08x)' % (name, task) if flags & FLAG_PSP and task else 'thread mode, no task')
+    out.append('crash #%u: %s in %s at tick %u' % (sequence, CAUSES.get(cause, 'cause 0x%x' % cause), where, tick))
+    if cause == 0x100:
+        out.append('  configASSERT() on line %u' % line)
+    if exc_return:
+        out.append('  EXC_RETURN 0x%08x%s' % (exc_return, ', FPU frame' if flags & FLAG_FPU else ''))
+    if cfsr or hfsr:
+        out.append('  CFSR 0x%08x  HFSR 0x%08x  AFSR 0x%08x' % (cfsr, hfsr, afsr))
+        for reg, table in ((cfsr, CFSR_BITS), (hfsr, HFSR_BITS)):
+            for bit_name, text in bits(reg, table):
+                out.append('    %-11s %s' % (bit_name, text))
+        if cfsr & (1 << 7):
+            out.append('  MMFAR 0x%08x' % mmfar)
+        if cfsr & (1 << 15):
+            out.append('  BFAR  0x%08x' % bfar)
+    if not flags & FLAG_FRAME and exc_return:
+        out.append('  the exception frame could not be stacked, r0-r3, r12, lr, pc and xpsr are not valid')
+
+    out.append('')
+    out.append('registers:')
+    shown = range(17) if flags & FLAG_FRAME else (13, 14, 15)
+    row = []
+    for index in shown:
+        row.append('%4s 0x%08x' % (REGISTER_NAMES[index], regs[index]))
+        if len(row) == 4:
+            out.append('  ' + '  '.join(row))
+            row = []
+    if row:
+        out.append('  ' + '  '.join(row))
+    if stack_limit:
+        out.append('  stack limit 0x%08x, %d bytes free below sp' % (stack_limit, regs[13] - stack_limit))
+
+    # Frame 0 is the pc, then the lr unless it is an EXC_RETURN, then return
+    # addresses found in the stack copy.  Return addresses are looked up two
+    # bytes back so they resolve to the calling line.
+    frames = [('pc', regs[15], regs[15] & ~1)]
+    lr = regs[14]
+    if lr < 0xf0000000 and (elf is None or elf.is_code(lr & ~1)):
+        frames.append(('lr', lr, (lr & ~1) - 2))
+    for index, word in enumerate(stack):
+        if len(frames) >= depth:
+            break
+        if not word & 1:
+            continue
+        if elf:
+            if not elf.follows_call(word):
+                continue
+        elif not FLASH[0] <= word < FLASH[1]:
+            continue
+        frames.append(('sp+0x%x' % (stack_addr + 4 * index - regs[13]), word, (word & ~1) - 2))
+
+    lookup = symbols.lookup(sorted({frame[2] for frame in frames}))
+    out.append('')
+    out.append('backtrace:' if elf_path else 'backtrace (no ELF given, stack words only guessed):')
+    for number, (source, value, addr) in enumerate(frames):
+        names = lookup.get(addr) or ['??']
+        out.append('  #%-2d 0x%08x %-8s %s' % (number, value, source, names[0]))
+        for inlined in names[1:]:
+            out.append('      %-19s %s' % ('', inlined))
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('dump', help='binary dump or hex text file')
+    parser.add_argument('-e', '--elf', help='ELF of the image that crashed, for symbols')
+    parser.add_argument('--addr2line', default='arm-none-eabi-addr2line', help='addr2line to use, default %(default)s')
+    parser.add_argument('-n', '--depth', type=int, default=16, help='most frames to show, default %(default)s')
+    args = parser.parse_args()
+
+    try:
+        sys.stdout.write(report(read_input(args.dump), args.elf, args.addr2line, args.depth))
+    except (ValueError, struct.error, OSError, subprocess.CalledProcessError) as error:
+        sys.exit('%s: %s' % (args.dump, error))
+
+
+if __name__ == '__main__':
+    main()
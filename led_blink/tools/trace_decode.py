@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+#
+#   Copyright (C) 2026, agent@local
+#   SPDX-License-Identifier: Apache-2.0
+#
+"""Convert a kernel trace recorder capture to Chrome trace / Perfetto JSON.
+
+Two capture layouts are understood, both little endian and following
+package/freertos/inc/trace_recorder.h:
+
+  snapshot  raw image of TraceRecorder_t, e.g. dumped from the retained SRAM2
+            area with  gdb> dump binary memory trace.bin &_sretained &_eretained
+  stream    the header and name table of TraceRecorder_t (everything before
+            xEvents) followed by the records returned by ulTraceRecorderRead()
+
+Open the output in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x43525452
+VERSION = 1
+HEADER = struct.Struct('<14I')
+NAME = struct.Struct('<I12s')
+EVENT = struct.Struct('<III')
+
+MODE_STREAM = 0
+MODE_SNAPSHOT = 1
+STATES = {0: 'stopped', 1: 'running', 2: 'triggered', 3: 'frozen'}
+
+EVT_SYNC = 0x01
+EVT_TASK_SWITCHED_IN = 0x10
+EVT_TASK_READY = 0x11
+EVT_TASK_CREATE = 0x12
+EVT_TASK_DELETE = 0x13
+EVT_ISR_ENTER = 0x30
+EVT_ISR_EXIT = 0x31
+EVT_USER = 0x40
+EVT_TRIGGER = 0x41
+EVT_NAME = 0x42
+
+# Events shown as instants on the track of the task they concern.
+TASK_EVENTS = {
+    0x14: 'delay',
+    0x15: 'delay until',
+    0x16: 'suspend',
+    0x17: 'resume',
+    0x18: 'priority set',
+    0x19: 'priority inherit',
+    0x1A: 'priority disinherit',
+    0x1B: 'notify',
+    0x1C: 'notify from ISR',
+    0x1D: 'wait notification',
+}
+
+# Events shown as instants on the track of whatever is running.
+OBJECT_EVENTS = {
+    0x20: 'queue send',
+    0x21: 'queue send failed',
+    0x22: 'queue send from ISR',
+    0x23: 'queue receive',
+    0x24: 'queue receive failed',
+    0x25: 'queue receive from ISR',
+    0x26: 'block on queue send',
+    0x27: 'block on queue receive',
+    0x28: 'event group set',
+    0x29: 'block on event group',
+}
+
+PID = 1
+ISR_TID = 0
+
+
+class Decoder:
+    def __init__(self, header, names):
+        (magic, version, self.clock_hz, self.tick_hz, self.length,
+         self.name_count, self.mode, self.state, self.head, self.tail,
+         self.dropped, _, self.trigger_reason, _) = header
+        if magic != MAGIC or version != VERSION:
+            raise ValueError('not a trace recorder capture (magic %08x, version %u)' % (magic, version))
+        self.names = dict(names)
+        self.pending_names = {}
+        self.out = []
+        self.tids = {}
+        self.running = None
+        self.run_start = 0.0
+        self.isr_stack = []
+        self.cycles = 0
+        self.last_ts = None
+        self.last_sync = None
+
+    def name(self, obj):
+        return self.names.get(obj, '0x%08x' % obj)
+
+    def tid(self, task):
+        if task not in self.tids:
+            self.tids[task] = len(self.tids) + 1
+        return self.tids[task]
+
+    def us(self):
+        return self.cycles * 1e6 / self.clock_hz
+
+    def timestamp(self, ts, event, obj):
+        if self.last_ts is None:
+            self.cycles = 0
+        else:
+            self.cycles += (ts - self.last_ts) & 0xffffffff
+        self.last_ts = ts
+        # Periodic tick sync events tell how many times the cycle counter
+        # wrapped during a long quiet period.
+        if event == EVT_SYNC:
+            if self.last_sync is not None:
+                tick_cycles, tick = self.last_sync
+                expected = (obj - tick) * self.clock_hz // self.tick_hz
+                wraps = round(((tick_cycles + expected) - self.cycles) / 2 ** 32)
+                if wraps > 0:
+                    self.cycles += wraps * 2 ** 32
+            self.last_sync = (self.cycles, obj)
+
+    def current_tid(self):
+        if self.isr_stack:
+            return ISR_TID
+        return self.tid(self.running) if self.running is not None else ISR_TID
+
+    def instant(self, tid, name, args=None):
+        entry = {'ph': 'i', 's': 't', 'pid': PID, 'tid': tid, 'ts': self.us(), 'name': name}
+        if args:
+            entry['args'] = args
+        self.out.append(entry)
+
+    def end_run(self):
+        if self.running is not None:
+            self.out.append({'ph': 'X', 'pid': PID, 'tid': self.tid(self.running),
+                             'ts': self.run_start, 'dur': self.us() - self.run_start,
+                             'name': self.name(self.running)})
+
+    def feed(self, ts, obj, event_param):
+        event = event_param >> 24
+        param = event_param & 0xffffff
+        self.timestamp(ts, event, obj)
+
+        if event == EVT_TASK_SWITCHED_IN:
+            if obj != self.running:
+                self.end_run()
+                self.running = obj
+                self.run_start = self.us()
+        elif event == EVT_TASK_READY:
+            self.instant(self.tid(obj), 'ready')
+        elif event == EVT_TASK_CREATE:
+            self.instant(self.tid(obj), 'create', {'priority': param})
+        elif event == EVT_TASK_DELETE:
+            self.instant(self.tid(obj), 'delete')
+        elif event in TASK_EVENTS:
+            self.instant(self.tid(obj), TASK_EVENTS[event], {'param': param})
+        elif event in OBJECT_EVENTS:
+            self.instant(self.current_tid(), OBJECT_EVENTS[event],
+                         {'object': self.name(obj), 'param': param})
+        elif event == EVT_ISR_ENTER:
+            self.isr_stack.append(param)
+            self.out.append({'ph': 'B', 'pid': PID, 'tid': ISR_TID, 'ts': self.us(), 'name': 'IRQ %d' % param})
+        elif event == EVT_ISR_EXIT:
+            if self.isr_stack:
+                self.isr_stack.pop()
+                self.out.append({'ph': 'E', 'pid': PID, 'tid': ISR_TID, 'ts': self.us()})
+        elif event == EVT_USER:
+            self.out.append({'ph': 'C', 'pid': PID, 'ts': self.us(), 'name': 'user %d' % param,
+                             'args': {'value': obj}})
+        elif event == EVT_TRIGGER:
+            self.out.append({'ph': 'i', 's': 'g', 'pid': PID, 'ts': self.us(),
+                             'name': 'trigger', 'args': {'reason': param}})
+        elif event == EVT_NAME:
+            text = self.pending_names.get(obj, '')
+            for shift in (0, 8, 16):
+                char = (param >> shift) & 0xff
+                if char:
+                    text += chr(char)
+            if param & 0xff0000:
+                self.pending_names[obj] = text
+            else:
+                self.pending_names.pop(obj, None)
+                self.names[obj] = text
+        elif event != EVT_SYNC:
+            self.instant(self.current_tid(), 'event 0x%02x' % event, {'object': obj, 'param': param})
+
+    def finish(self):
+        self.end_run()
+        meta = [{'ph': 'M', 'pid': PID, 'name': 'process_name', 'args': {'name': 'CPU'}},
+                {'ph': 'M', 'pid': PID, 'tid': ISR_TID, 'name': 'thread_name', 'args': {'name': 'ISR'}}]
+        for task, tid in self.tids.items():
+            meta.append({'ph': 'M', 'pid': PID, 'tid': tid, 'name': 'thread_name',
+                         'args': {'name': self.name(task)}})
+            meta.append({'ph': 'M', 'pid': PID, 'tid': tid, 'name': 'thread_sort_index',
+                         'args': {'sort_index': tid}})
+        return {
+            'traceEvents': meta + self.out,
+            'displayTimeUnit': 'ns',
+            'otherData': {
+                'mode': 'stream' if self.mode == MODE_STREAM else 'snapshot',
+                'state': STATES.get(self.state, str(self.state)),
+                'clock_hz': self.clock_hz,
+                'dropped': self.dropped,
+                'trigger_reason': self.trigger_reason,
+            },
+        }
+
+
+def records(data, offset, count):
+    for index in range(count):
+        yield EVENT.unpack_from(data, offset + index * EVENT.size)
+
+
+def decode(data):
+    header = HEADER.unpack_from(data, 0)
+    length, name_count, mode, head = header[4], header[5], header[6], header[8]
+    offset = HEADER.size
+    names = []
+    for _ in range(name_count):
+        obj, raw = NAME.unpack_from(data, offset)
+        offset += NAME.size
+        if obj:
+            names.append((obj, raw.split(b'\0', 1)[0].decode('ascii', 'replace')))
+
+    decoder = Decoder(header, names)
+    if mode == MODE_STREAM:
+        events = records(data, offset, (len(data) - offset) // EVENT.size)
+    else:
+        if len(data) < offset + length * EVENT.size:
+            raise ValueError('snapshot is truncated')
+        if head <= length:
+            events = records(data, offset, head)
+        else:
+            start = head % length
+            events = list(records(data, offset + start * EVENT.size, length - start))
+            events += list(records(data, offset, start))
+    for ts, obj, event_param in events:
+        decoder.feed(ts, obj, event_param)
+    return decoder.finish()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('capture', help='binary capture file')
+    parser.add_argument('-o', '--output', help='JSON output file, default stdout')
+    args = parser.parse_args()
+
+    with open(args.capture, 'rb') as handle:
+        data = handle.read()
+    try:
+        result = decode(data)
+    except (ValueError, struct.error) as error:
+        sys.exit('%s: %s' % (args.capture, error))
+
+    if args.output:
+        with open(args.output, 'w') as handle:
+            json.dump(result, handle)
+    else:
+        json.dump(result, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()